@@ -75,11 +75,21 @@
 #define APP_LOGGER_TRACE(message)
 #define APP_LOGGER_TRACE_WITH_TAG(message, tag)
 #endif
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
 #include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <random>
 #include <string>
+#include <thread>
 
 #include "ccapi_cpp/ccapi_logger.h"
 #include "ccapi_cpp/ccapi_util_private.h"
@@ -179,55 +189,335 @@ class CcapiLogger : public Logger {
   // private:
   //  AppLogger* appLogger;
 };
+/**
+ * Writes CSV rows, and optionally the same rows in a compact binary format, from a background thread. The calling thread only copies the row into a node
+ * and pushes the node onto a lock-free multi-producer single-consumer queue, so writing never waits on the file system. The background thread appends the
+ * rows to a large aligned buffer, which it hands to the kernel when it is full, when flush is called, and at least every writeIntervalMilliseconds.
+ *
+ * The binary file has the same name as the CSV file with the extension replaced by ".bin". Each row is encoded as the number of columns followed by, for each
+ * column, its length and its bytes, with all numbers encoded as LEB128 varints.
+ *
+ * flush doesn't wait for the background thread, so rows are only guaranteed to have reached the kernel once close (or the destructor) returns. If open
+ * fails, no thread is started and writes are dropped.
+ *
+ * Options must be set before open. fsyncIntervalMilliseconds: negative means never fsync, 0 means fsync on every flush, and positive means fsync on flush at
+ * most once per interval, and once the interval has passed after a write that no flush has synced. An idle writer's thread sleeps until the next write.
+ */
 class CsvWriter {
  public:
   CsvWriter() {}
-  void open(const std::string& filename, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out) { this->f.open(filename, mode); }
+  CsvWriter(const CsvWriter&) = delete;
+  CsvWriter& operator=(const CsvWriter&) = delete;
+  ~CsvWriter() {
+    this->close();
+    while (Node* node = this->pop()) {
+      delete node;
+    }
+  }
+  void open(const std::string& filename, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out) {
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+    if (mode & std::ios_base::app) {
+      flags |= O_APPEND;
+    } else if ((mode & std::ios_base::trunc) || !(mode & std::ios_base::in)) {
+      flags |= O_TRUNC;
+    }
+    if (this->thread.joinable()) {
+      APP_LOGGER_ERROR("Failed to open " + filename + ": the writer is already open.");
+      return;
+    }
+    this->fd = ::open(filename.c_str(), flags, 0644);
+    if (this->fd < 0) {
+      APP_LOGGER_ERROR("Failed to open " + filename + ": " + std::strerror(errno) + ".");
+      return;
+    }
+    if (this->writeBinary) {
+      auto foundDot = filename.rfind('.');
+      auto foundSlash = filename.rfind('/');
+      std::string binaryFilename =
+          (foundDot != std::string::npos && (foundSlash == std::string::npos || foundDot > foundSlash) ? filename.substr(0, foundDot) : filename) + ".bin";
+      this->binaryFd = ::open(binaryFilename.c_str(), flags, 0644);
+      if (this->binaryFd < 0) {
+        APP_LOGGER_ERROR("Failed to open " + binaryFilename + ": " + std::strerror(errno) + ".");
+        ::close(this->fd);
+        this->fd = -1;
+        return;
+      }
+    }
+    this->buffer.reset(this->allocateBuffer());
+    if (this->writeBinary) {
+      this->binaryBuffer.reset(this->allocateBuffer());
+    }
+    this->thread = std::thread(&CsvWriter::run, this);
+  }
+  // false if open hasn't been called, or failed, or close has been called; writes are then dropped
+  bool isOpen() const { return this->thread.joinable(); }
+  // blocks until everything that was written before has reached the kernel
   void close() {
-    std::lock_guard<std::mutex> lock(m);
-    this->f.close();
+    if (!this->thread.joinable()) {
+      return;
+    }
+    this->push(new Node(Node::Type::CLOSE));
+    this->thread.join();
   }
   void writeString(const std::string& str) {
-    std::lock_guard<std::mutex> lock(m);
-    this->f << str.c_str();
+    if (!this->isOpen()) {
+      return;
+    }
+    auto node = new Node(Node::Type::STRING);
+    node->str = str;
+    this->push(node);
   }
   void writeRow(const std::vector<std::string>& row) {
-    std::lock_guard<std::mutex> lock(m);
-    size_t numCol = row.size();
-    int i = 0;
-    for (const auto& column : row) {
-      this->f << column.c_str();
-      if (i < numCol - 1) {
-        this->f << ",";
-      }
-      ++i;
+    if (!this->isOpen()) {
+      return;
     }
-    this->f << "\n";
+    auto node = new Node(Node::Type::ROWS);
+    node->rows.push_back(row);
+    this->push(node);
   }
   void writeRows(const std::vector<std::vector<std::string>>& rows) {
-    std::lock_guard<std::mutex> lock(m);
-    for (const auto& row : rows) {
-      size_t numCol = row.size();
-      int i = 0;
-      for (const auto& column : row) {
-        this->f << column.c_str();
-        if (i < numCol - 1) {
-          this->f << ",";
-        }
-        ++i;
-      }
-      this->f << "\n";
+    if (!this->isOpen()) {
+      return;
     }
+    auto node = new Node(Node::Type::ROWS);
+    node->rows = rows;
+    this->push(node);
   }
+  // asks the background thread to hand what has been written so far to the kernel; doesn't wait for it, use close for that
   void flush() {
-    std::lock_guard<std::mutex> lock(m);
-    this->f.flush();
+    if (!this->isOpen()) {
+      return;
+    }
+    this->push(new Node(Node::Type::FLUSH));
   }
-  std::ofstream& getFileStream() { return f; }
+  bool writeBinary{};
+  int fsyncIntervalMilliseconds{-1}, writeIntervalMilliseconds{100};
+  size_t bufferSize{1 << 20};
 
  private:
-  std::ofstream f;
+  struct Node {
+    enum class Type {
+      STRING,
+      ROWS,
+      FLUSH,
+      CLOSE,
+    };
+    explicit Node(Type type) : type(type) {}
+    std::atomic<Node*> next{nullptr};
+    Type type;
+    std::string str;
+    std::vector<std::vector<std::string>> rows;
+  };
+  struct BufferDeleter {
+    void operator()(char* p) const { std::free(p); }
+  };
+  static constexpr size_t bufferAlignment = 4096;
+  char* allocateBuffer() {
+    this->bufferSize = std::max<size_t>((this->bufferSize + bufferAlignment - 1) / bufferAlignment * bufferAlignment, bufferAlignment);
+    void* p = nullptr;
+    if (posix_memalign(&p, bufferAlignment, this->bufferSize) != 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<char*>(p);
+  }
+  // wakes the background thread only if it is sleeping, so that a write costs no system call while rows keep coming
+  void push(Node* node) {
+    this->link(node);
+    if (this->isWaiting.load(std::memory_order_seq_cst) && this->isWaiting.exchange(false, std::memory_order_seq_cst)) {
+      std::lock_guard<std::mutex> lock(this->m);
+      this->cv.notify_one();
+    }
+  }
+  // see https://www.1024cores.net/home/lock-free-algorithms/queues/non-intrusive-mpsc-node-based-queue
+  void link(Node* node) {
+    // the node may be consumed as soon as it is linked
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* previous = this->queueHead.exchange(node, std::memory_order_seq_cst);
+    previous->next.store(node, std::memory_order_release);
+  }
+  // after pop has returned nullptr: whether a node has been pushed since (or was being pushed)
+  bool hasNode() const { return this->queueHead.load(std::memory_order_seq_cst) != this->queueTail || this->queueTail->next.load(std::memory_order_acquire); }
+  Node* pop() {
+    Node* tail = this->queueTail;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &this->stub) {
+      if (!next) {
+        return nullptr;
+      }
+      this->queueTail = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      this->queueTail = next;
+      return tail;
+    }
+    if (tail != this->queueHead.load(std::memory_order_acquire)) {
+      // a producer is in the middle of a push
+      return nullptr;
+    }
+    this->link(&this->stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+      this->queueTail = next;
+      return tail;
+    }
+    return nullptr;
+  }
+  void run() {
+    auto lastWriteTp = std::chrono::steady_clock::now();
+    auto lastFsyncTp = lastWriteTp;
+    while (true) {
+      Node* node = this->pop();
+      if (!node) {
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastWriteTp >= std::chrono::milliseconds(this->writeIntervalMilliseconds)) {
+          this->writeBuffers();
+          lastWriteTp = now;
+        }
+        if (this->fsyncIntervalMilliseconds > 0 && this->hasUnsyncedWrite && now - lastFsyncTp >= std::chrono::milliseconds(this->fsyncIntervalMilliseconds)) {
+          this->fsync();
+          lastFsyncTp = now;
+        }
+        // sleep until a push, or until the buffered rows or the written rows are due to be handed to the kernel or synced
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        if (this->bufferLength > 0 || this->binaryBufferLength > 0) {
+          deadline = lastWriteTp + std::chrono::milliseconds(this->writeIntervalMilliseconds);
+        }
+        if (this->fsyncIntervalMilliseconds > 0 && this->hasUnsyncedWrite) {
+          deadline = std::min(deadline, lastFsyncTp + std::chrono::milliseconds(this->fsyncIntervalMilliseconds));
+        }
+        std::unique_lock<std::mutex> lock(this->m);
+        this->isWaiting.store(true, std::memory_order_seq_cst);
+        if (!this->hasNode()) {
+          auto isWoken = [this] { return !this->isWaiting.load(std::memory_order_seq_cst); };
+          if (deadline == std::chrono::steady_clock::time_point::max()) {
+            this->cv.wait(lock, isWoken);
+          } else {
+            this->cv.wait_until(lock, deadline, isWoken);
+          }
+        }
+        this->isWaiting.store(false, std::memory_order_seq_cst);
+        continue;
+      }
+      std::unique_ptr<Node> nodePtr(node);
+      if (node->type == Node::Type::STRING) {
+        this->append(this->buffer.get(), this->bufferLength, this->fd, node->str.data(), node->str.size());
+      } else if (node->type == Node::Type::ROWS) {
+        for (const auto& row : node->rows) {
+          this->appendRow(row);
+        }
+      } else {
+        this->writeBuffers();
+        auto now = std::chrono::steady_clock::now();
+        lastWriteTp = now;
+        if (this->fsyncIntervalMilliseconds >= 0 && (node->type == Node::Type::CLOSE || this->fsyncIntervalMilliseconds == 0 ||
+                                                     now - lastFsyncTp >= std::chrono::milliseconds(this->fsyncIntervalMilliseconds))) {
+          this->fsync();
+          lastFsyncTp = now;
+        }
+        if (node->type == Node::Type::CLOSE) {
+          for (int* x : {&this->fd, &this->binaryFd}) {
+            if (*x >= 0) {
+              ::close(*x);
+              *x = -1;
+            }
+          }
+          return;
+        }
+      }
+    }
+  }
+  void appendRow(const std::vector<std::string>& row) {
+    size_t numCol = row.size();
+    for (size_t i = 0; i < numCol; ++i) {
+      this->append(this->buffer.get(), this->bufferLength, this->fd, row[i].data(), row[i].size());
+      if (i < numCol - 1) {
+        this->append(this->buffer.get(), this->bufferLength, this->fd, ",", 1);
+      }
+    }
+    this->append(this->buffer.get(), this->bufferLength, this->fd, "\n", 1);
+    if (this->binaryFd >= 0) {
+      this->appendVarint(numCol);
+      for (const auto& column : row) {
+        this->appendVarint(column.size());
+        this->append(this->binaryBuffer.get(), this->binaryBufferLength, this->binaryFd, column.data(), column.size());
+      }
+    }
+  }
+  void appendVarint(uint64_t value) {
+    char data[10];
+    size_t length = 0;
+    do {
+      data[length] = static_cast<char>(value & 0x7f);
+      value >>= 7;
+      if (value) {
+        data[length] |= 0x80;
+      }
+      ++length;
+    } while (value);
+    this->append(this->binaryBuffer.get(), this->binaryBufferLength, this->binaryFd, data, length);
+  }
+  void append(char* buffer, size_t& bufferLength, int fd, const char* data, size_t length) {
+    if (bufferLength + length > this->bufferSize) {
+      this->writeFully(fd, buffer, bufferLength);
+      bufferLength = 0;
+      if (length > this->bufferSize) {
+        this->writeFully(fd, data, length);
+        return;
+      }
+    }
+    std::memcpy(buffer + bufferLength, data, length);
+    bufferLength += length;
+  }
+  void writeBuffers() {
+    this->writeFully(this->fd, this->buffer.get(), this->bufferLength);
+    this->bufferLength = 0;
+    if (this->binaryBuffer) {
+      this->writeFully(this->binaryFd, this->binaryBuffer.get(), this->binaryBufferLength);
+      this->binaryBufferLength = 0;
+    }
+  }
+  void fsync() {
+    for (int x : {this->fd, this->binaryFd}) {
+      if (x >= 0) {
+        ::fsync(x);
+      }
+    }
+    this->hasUnsyncedWrite = false;
+  }
+  void writeFully(int fd, const char* data, size_t length) {
+    if (fd < 0) {
+      return;
+    }
+    if (length > 0) {
+      this->hasUnsyncedWrite = true;
+    }
+    while (length > 0) {
+      ssize_t n = ::write(fd, data, length);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        APP_LOGGER_ERROR(std::string("Failed to write: ") + std::strerror(errno) + ".");
+        return;
+      }
+      data += n;
+      length -= n;
+    }
+  }
+  Node stub{Node::Type::STRING};
+  std::atomic<Node*> queueHead{&stub};
+  Node* queueTail{&stub};
+  std::unique_ptr<char, BufferDeleter> buffer, binaryBuffer;
+  size_t bufferLength{}, binaryBufferLength{};
+  int fd{-1}, binaryFd{-1};
+  std::thread thread;
+  bool hasUnsyncedWrite{};
+  // set by the background thread before it sleeps, and cleared by the push that wakes it
+  std::atomic<bool> isWaiting{};
   std::mutex m;
+  std::condition_variable cv;
 };
 } /* namespace ccapi */
 #endif  // APP_INCLUDE_APP_COMMON_H_
@@ -29,6 +29,8 @@
 #include "app/common.h"
 #include "app/historical_market_data_event_processor.h"
 #include "app/order.h"
+#include "app/rolling_price_series.h"
+#include "app/simulated_exchange.h"
 #include "boost/optional/optional.hpp"
 #ifndef CCAPI_APP_IS_BACKTEST
 #include "ccapi_cpp/ccapi_session.h"
@@ -81,7 +83,7 @@ class EventHandlerBase : public EventHandler {
     POV,
     IS,
   };
-  virtual ~EventHandlerBase() {}
+  virtual ~EventHandlerBase() { this->closeCsvWriters(); }
   virtual void onInit(Session* session) {}
   bool processEvent(const Event& event, Session* session) override {
     if (this->skipProcessEvent) {
@@ -99,6 +101,11 @@ class EventHandlerBase : public EventHandler {
                      " balance is " + Decimal(UtilString::printDoubleScientific(this->quoteBalance)).toString() + ".");
     auto eventType = event.getType();
     std::vector<Request> requestList;
+    if (this->enableSimulatedExchange && !this->simulatedExchangePtr &&
+        (this->tradingMode == TradingMode::PAPER || this->tradingMode == TradingMode::BACKTEST) && !this->orderPriceIncrement.empty() &&
+        !this->orderQuantityIncrement.empty()) {
+      this->createSimulatedExchange();
+    }
     if (eventType == Event::Type::SUBSCRIPTION_DATA) {
       const auto& messageList = event.getMessageList();
       int index = -1;
@@ -138,7 +145,7 @@ class EventHandlerBase : public EventHandler {
             double feeQuantity = feeQuantityStr.empty() ? 0 : std::stod(feeQuantityStr);
             std::string feeAsset = element.getValue(CCAPI_EM_ORDER_FEE_ASSET);
             bool isMaker = element.getValue(CCAPI_IS_MAKER) == "1";
-            if (this->tradingMode == TradingMode::LIVE) {
+            if (this->tradingMode == TradingMode::LIVE || this->simulatedExchangePtr) {
               std::string side = element.getValue(CCAPI_EM_ORDER_SIDE);
               if (side == CCAPI_EM_ORDER_SIDE_BUY) {
                 this->baseBalance += lastExecutedSize;
@@ -160,6 +167,12 @@ class EventHandlerBase : public EventHandler {
             }
           }
         } else if (message.getType() == Message::Type::EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE) {
+          if (this->simulatedExchangePtr) {
+            for (const auto& element : message.getElementList()) {
+              this->syncOpenOrder(element, this->openBuyOrder);
+              this->syncOpenOrder(element, this->openSellOrder);
+            }
+          }
           if (this->numOpenOrders > 0) {
             for (const auto& element : message.getElementList()) {
               auto quantity = element.getValue(CCAPI_EM_ORDER_QUANTITY);
@@ -209,7 +222,11 @@ class EventHandlerBase : public EventHandler {
         } else if (message.getType() == Message::Type::MARKET_DATA_EVENTS_TRADE || message.getType() == Message::Type::MARKET_DATA_EVENTS_AGG_TRADE) {
           const auto& messageTime = message.getTime();
           if (message.getRecapType() == Message::RecapType::NONE) {
-            if (this->tradingMode == TradingMode::PAPER || this->tradingMode == TradingMode::BACKTEST) {
+            if (this->simulatedExchangePtr) {
+              std::vector<Event> simulatedEventList;
+              this->simulatedExchangePtr->processMarketDataMessage(message, simulatedEventList);
+              this->processSimulatedEventList(simulatedEventList, session);
+            } else if (this->tradingMode == TradingMode::PAPER || this->tradingMode == TradingMode::BACKTEST) {
               for (const auto& element : message.getElementList()) {
                 bool isBuyerMaker = element.getValue(CCAPI_IS_BUYER_MAKER) == "1";
                 const auto& takerPrice = Decimal(element.getValue(CCAPI_LAST_PRICE));
@@ -366,7 +383,11 @@ class EventHandlerBase : public EventHandler {
             this->midPrice = 0;
           }
         }
-        if (this->tradingMode == TradingMode::PAPER || this->tradingMode == TradingMode::BACKTEST) {
+        if (this->simulatedExchangePtr) {
+          std::vector<Event> simulatedEventList;
+          this->simulatedExchangePtr->processMarketDataMessage(message, simulatedEventList);
+          this->processSimulatedEventList(simulatedEventList, session);
+        } else if (this->tradingMode == TradingMode::PAPER || this->tradingMode == TradingMode::BACKTEST) {
           bool buySideCrossed = !this->bestAskPrice.empty() && this->openBuyOrder && Decimal(this->bestAskPrice) <= this->openBuyOrder.get().limitPrice;
           bool sellSideCrossed = !this->bestBidPrice.empty() && this->openSellOrder && Decimal(this->bestBidPrice) >= this->openSellOrder.get().limitPrice;
           if ((buySideCrossed || sellSideCrossed) && this->marketImpfactFactor > 0) {
@@ -420,6 +441,8 @@ class EventHandlerBase : public EventHandler {
           CsvWriter* accountBalanceCsvWriter = nullptr;
           if (!privateDataOnlySaveFinalSummary) {
             privateTradeCsvWriter = new CsvWriter();
+            privateTradeCsvWriter->writeBinary = this->privateDataSaveBinary;
+            privateTradeCsvWriter->fsyncIntervalMilliseconds = this->privateDataFsyncIntervalMilliseconds;
             {
               struct stat buffer;
               if (stat(privateTradeCsvFilename.c_str(), &buffer) != 0) {
@@ -442,6 +465,8 @@ class EventHandlerBase : public EventHandler {
               }
             }
             orderUpdateCsvWriter = new CsvWriter();
+            orderUpdateCsvWriter->writeBinary = this->privateDataSaveBinary;
+            orderUpdateCsvWriter->fsyncIntervalMilliseconds = this->privateDataFsyncIntervalMilliseconds;
             {
               struct stat buffer;
               if (stat(orderUpdateCsvFilename.c_str(), &buffer) != 0) {
@@ -466,6 +491,8 @@ class EventHandlerBase : public EventHandler {
           }
           if (!this->privateDataOnlySaveFinalSummary) {
             accountBalanceCsvWriter = new CsvWriter();
+            accountBalanceCsvWriter->writeBinary = this->privateDataSaveBinary;
+            accountBalanceCsvWriter->fsyncIntervalMilliseconds = this->privateDataFsyncIntervalMilliseconds;
             {
               struct stat buffer;
               if (stat(accountBalanceCsvFilename.c_str(), &buffer) != 0) {
@@ -484,14 +511,17 @@ class EventHandlerBase : public EventHandler {
             }
           }
           if (this->privateTradeCsvWriter) {
+            this->privateTradeCsvWriter->close();
             delete this->privateTradeCsvWriter;
           }
           this->privateTradeCsvWriter = privateTradeCsvWriter;
           if (this->orderUpdateCsvWriter) {
+            this->orderUpdateCsvWriter->close();
             delete this->orderUpdateCsvWriter;
           }
           this->orderUpdateCsvWriter = orderUpdateCsvWriter;
           if (this->accountBalanceCsvWriter) {
+            this->accountBalanceCsvWriter->close();
             delete this->accountBalanceCsvWriter;
           }
           this->accountBalanceCsvWriter = accountBalanceCsvWriter;
@@ -539,6 +569,8 @@ class EventHandlerBase : public EventHandler {
         } else {
           this->openSellOrder = order;
         }
+      } else if (this->simulatedExchangePtr && firstMessage.getType() == Message::Type::RESPONSE_ERROR) {
+        // e.g. the order to be canceled was filled while the cancel request was in flight; the order updates have already been processed
       } else if (std::find(correlationIdList.begin(), correlationIdList.end(), this->cancelBuyOrderRequestCorrelationId) != correlationIdList.end() ||
                  std::find(correlationIdList.begin(), correlationIdList.end(), this->cancelSellOrderRequestCorrelationId) != correlationIdList.end() ||
                  (std::find(correlationIdList.begin(), correlationIdList.end(), PRIVATE_SUBSCRIPTION_DATA_CORRELATION_ID) != correlationIdList.end() &&
@@ -617,6 +649,7 @@ class EventHandlerBase : public EventHandler {
             privateDataSummaryCsvFilename = this->privateDataDirectory + "/" + privateDataSummaryCsvFilename;
           }
           CsvWriter* privateDataFinalSummaryCsvWriter = new CsvWriter();
+          privateDataFinalSummaryCsvWriter->fsyncIntervalMilliseconds = this->privateDataFsyncIntervalMilliseconds;
           {
             struct stat buffer;
             if (stat(privateDataSummaryCsvFilename.c_str(), &buffer) != 0) {
@@ -646,8 +679,9 @@ class EventHandlerBase : public EventHandler {
               Decimal(UtilString::printDoubleScientific(this->privateTradeFeeInBaseSum)).toString(),
               Decimal(UtilString::printDoubleScientific(this->privateTradeFeeInQuoteSum)).toString(),
           });
-          privateDataFinalSummaryCsvWriter->flush();
+          privateDataFinalSummaryCsvWriter->close();
           delete privateDataFinalSummaryCsvWriter;
+          this->closeCsvWriters();
           try {
             this->promisePtr->set_value();
           } catch (const std::future_error& e) {
@@ -688,6 +722,14 @@ class EventHandlerBase : public EventHandler {
     if (!requestList.empty()) {
       if (this->tradingMode == TradingMode::PAPER || this->tradingMode == TradingMode::BACKTEST) {
         for (const auto& request : requestList) {
+          const auto& operation = request.getOperation();
+          if (this->simulatedExchangePtr && (operation == Request::Operation::CREATE_ORDER || operation == Request::Operation::CANCEL_ORDER ||
+                                             operation == Request::Operation::CANCEL_OPEN_ORDERS)) {
+            std::vector<Event> simulatedEventList;
+            this->simulatedExchangePtr->sendRequest(request, simulatedEventList);
+            this->processSimulatedEventList(simulatedEventList, session);
+            continue;
+          }
           bool createdBuyOrder = false;
           const auto& now = request.getTimeSent();
           Event virtualEvent;
@@ -701,7 +743,6 @@ class EventHandlerBase : public EventHandler {
           message_2.setTimeReceived(now);
           message_2.setCorrelationIdList({request.getCorrelationId()});
           std::vector<Element> elementList;
-          const auto& operation = request.getOperation();
           if (operation == Request::Operation::GET_ACCOUNT_BALANCES || operation == Request::Operation::GET_ACCOUNTS) {
             virtualEvent.setType(Event::Type::RESPONSE);
             message.setCorrelationIdList({request.getCorrelationId()});
@@ -1008,14 +1049,14 @@ class EventHandlerBase : public EventHandler {
       adverseSelectionGuardTriggerRocMinimum{}, adverseSelectionGuardTriggerRocMaximum{}, adverseSelectionGuardTriggerRsiMinimum{},
       adverseSelectionGuardTriggerRsiMaximum{}, privateTradeVolumeInBaseSum{}, privateTradeVolumeInQuoteSum{}, privateTradeFeeInBaseSum{},
       privateTradeFeeInQuoteSum{}, midPrice{};
-  int orderRefreshIntervalSeconds{}, orderRefreshIntervalOffsetSeconds{}, accountBalanceRefreshWaitSeconds{}, clockStepMilliseconds{},
+  int orderRefreshIntervalSeconds{}, orderRefreshIntervalOffsetSeconds{}, accountBalanceRefreshWaitSeconds{}, clockStepMilliseconds{}, privateDataFsyncIntervalMilliseconds{-1},
       adverseSelectionGuardActionOrderRefreshIntervalSeconds{}, originalOrderRefreshIntervalSeconds{}, adverseSelectionGuardMarketDataSampleIntervalSeconds{},
       adverseSelectionGuardMarketDataSampleBufferSizeSeconds{}, adverseSelectionGuardTriggerRollCorrelationCoefficientNumObservations{},
       adverseSelectionGuardTriggerRocNumObservations{}, adverseSelectionGuardTriggerRsiNumObservations{};
   TimePoint orderRefreshLastTime{std::chrono::seconds{0}}, cancelOpenOrdersLastTime{std::chrono::seconds{0}},
       getAccountBalancesLastTime{std::chrono::seconds{0}};
   bool useGetAccountsToGetAccountBalances{}, useCancelOrderToCancelOpenOrders{}, useWebsocketToExecuteOrder{}, useWeightedMidPrice{},
-      privateDataOnlySaveFinalSummary{}, enableAdverseSelectionGuard{}, enableAdverseSelectionGuardByInventoryLimit{},
+      privateDataOnlySaveFinalSummary{}, privateDataSaveBinary{}, enableAdverseSelectionGuard{}, enableAdverseSelectionGuardByInventoryLimit{},
       enableAdverseSelectionGuardByInventoryDepletion{}, enableAdverseSelectionGuardByRollCorrelationCoefficient{},
       adverseSelectionGuardActionOrderQuantityProportionRelativeToOneAsset{}, enableAdverseSelectionGuardByRoc{}, enableAdverseSelectionGuardByRsi{},
       enableUpdateOrderBookTickByTick{}, immediatelyPlaceNewOrders{}, adverseSelectionGuardTriggerRocOrderDirectionReverse{},
@@ -1041,6 +1082,9 @@ class EventHandlerBase : public EventHandler {
   // start: only applicable to paper trade and backtest
   double makerFee{}, takerFee{}, marketImpfactFactor{};
   std::string makerBuyerFeeAsset, makerSellerFeeAsset, takerBuyerFeeAsset, takerSellerFeeAsset;
+  bool enableSimulatedExchange{};
+  int simulatedOrderEntryLatencyMicroseconds{}, simulatedOrderEntryLatencyJitterMicroseconds{}, simulatedMarketDataLatencyMicroseconds{},
+      simulatedMarketDataLatencyJitterMicroseconds{};
   // end: only applicable to paper trade and backtest
 
   // start: only applicable to backtest
@@ -1049,6 +1093,16 @@ class EventHandlerBase : public EventHandler {
   // end: only applicable to backtest
 
  protected:
+  // the writers only hand rows to the kernel from a background thread, so they must be closed before the promise is fulfilled and the process may exit
+  void closeCsvWriters() {
+    for (CsvWriter** csvWriter : {&this->privateTradeCsvWriter, &this->orderUpdateCsvWriter, &this->accountBalanceCsvWriter}) {
+      if (*csvWriter) {
+        (*csvWriter)->close();
+        delete *csvWriter;
+        *csvWriter = nullptr;
+      }
+    }
+  }
   virtual void processEventFurther(const Event& event, Session* session, std::vector<Request>& requestList) {}
   virtual void createSubscriptionList(std::vector<Subscription>& subscriptionList) {
     {
@@ -1088,14 +1142,22 @@ class EventHandlerBase : public EventHandler {
     if (this->enableAdverseSelectionGuard) {
       int intervalStart = UtilTime::getUnixTimestamp(messageTime) / this->adverseSelectionGuardMarketDataSampleIntervalSeconds *
                           this->adverseSelectionGuardMarketDataSampleIntervalSeconds;
-      for (auto& kv : this->publicTradeMap) {
-        kv.second.erase(kv.second.begin(), kv.second.upper_bound(intervalStart - this->adverseSelectionGuardMarketDataSampleBufferSizeSeconds));
+      if (this->rollCorrelationCoefficientPriceSeries.getCapacity() == 0) {
+        this->rollCorrelationCoefficientPriceSeries = RollingPriceSeries(this->adverseSelectionGuardTriggerRollCorrelationCoefficientNumObservations);
+        this->rocPriceSeries = RollingPriceSeries(this->adverseSelectionGuardTriggerRocNumObservations);
+        this->rsiPriceSeries = RollingPriceSeries(this->adverseSelectionGuardTriggerRsiNumObservations);
+      }
+      for (auto* priceSeries : {&this->rollCorrelationCoefficientPriceSeries, &this->rocPriceSeries, &this->rsiPriceSeries}) {
+        priceSeries->eraseUpTo(intervalStart - this->adverseSelectionGuardMarketDataSampleBufferSizeSeconds);
       }
       const auto& elementList = message.getElementList();
       auto rit = elementList.rbegin();
       if (rit != elementList.rend()) {
 #if APP_PUBLIC_TRADE_LAST != -1
-        this->publicTradeMap[APP_PUBLIC_TRADE_LAST][intervalStart] = std::stod(rit->getValue(CCAPI_LAST_PRICE));
+        double lastPrice = std::stod(rit->getValue(CCAPI_LAST_PRICE));
+        for (auto* priceSeries : {&this->rollCorrelationCoefficientPriceSeries, &this->rocPriceSeries, &this->rsiPriceSeries}) {
+          priceSeries->update(intervalStart, lastPrice);
+        }
 #endif
       }
     }
@@ -1221,6 +1283,7 @@ class EventHandlerBase : public EventHandler {
     this->orderRefreshIntervalIndex += 1;
     if (now >= this->startTimeTp + std::chrono::seconds(this->totalDurationSeconds)) {
       APP_LOGGER_INFO("Exit.");
+      this->closeCsvWriters();
       this->promisePtr->set_value();
       this->skipProcessEvent = true;
     }
@@ -1230,6 +1293,7 @@ class EventHandlerBase : public EventHandler {
     if (now >= this->startTimeTp + std::chrono::seconds(this->totalDurationSeconds) ||
         (this->quoteTotalTargetQuantity > 0 ? this->theoreticalQuoteRemainingQuantity <= 0 : this->theoreticalRemainingQuantity <= 0)) {
       APP_LOGGER_INFO("Exit.");
+      this->closeCsvWriters();
       this->promisePtr->set_value();
       this->skipProcessEvent = true;
     }
@@ -1260,6 +1324,7 @@ class EventHandlerBase : public EventHandler {
     }
     if ((this->totalBalancePeak - totalBalance) / this->totalBalancePeak > this->killSwitchMaximumDrawdown) {
       APP_LOGGER_INFO("Kill switch triggered - Maximum drawdown. Exit.");
+      this->closeCsvWriters();
       this->promisePtr->set_value();
       this->skipProcessEvent = true;
       return;
@@ -1553,39 +1618,49 @@ class EventHandlerBase : public EventHandler {
     element.insert(CCAPI_EM_ORDER_REMAINING_QUANTITY, order.remainingQuantity.toString());
     element.insert(CCAPI_EM_ORDER_STATUS, order.status);
   }
+  virtual void createSimulatedExchange() {
+    this->simulatedExchangePtr =
+        std::make_shared<SimulatedExchange>(this->orderPriceIncrement, this->orderQuantityIncrement, this->baseAsset, this->quoteAsset);
+    auto& latencyModel = this->simulatedExchangePtr->latencyModel;
+    latencyModel.orderEntryLatency = std::chrono::microseconds(this->simulatedOrderEntryLatencyMicroseconds);
+    latencyModel.orderEntryLatencyJitter = std::chrono::microseconds(this->simulatedOrderEntryLatencyJitterMicroseconds);
+    latencyModel.marketDataLatency = std::chrono::microseconds(this->simulatedMarketDataLatencyMicroseconds);
+    latencyModel.marketDataLatencyJitter = std::chrono::microseconds(this->simulatedMarketDataLatencyJitterMicroseconds);
+    this->simulatedExchangePtr->makerFee = this->makerFee;
+    this->simulatedExchangePtr->takerFee = this->takerFee;
+    this->simulatedExchangePtr->makerBuyerFeeAsset = this->makerBuyerFeeAsset;
+    this->simulatedExchangePtr->makerSellerFeeAsset = this->makerSellerFeeAsset;
+    this->simulatedExchangePtr->takerBuyerFeeAsset = this->takerBuyerFeeAsset;
+    this->simulatedExchangePtr->takerSellerFeeAsset = this->takerSellerFeeAsset;
+    APP_LOGGER_INFO("Created a simulated exchange.");
+  }
+  virtual void processSimulatedEventList(const std::vector<Event>& simulatedEventList, Session* session) {
+    for (const auto& simulatedEvent : simulatedEventList) {
+      APP_LOGGER_DEBUG("Generated a virtual event: " + simulatedEvent.toStringPretty());
+      this->processEvent(simulatedEvent, session);
+    }
+  }
+  virtual void syncOpenOrder(const Element& element, boost::optional<Order>& openOrder) {
+    if (!openOrder || openOrder.get().orderId != element.getValue(CCAPI_EM_ORDER_ID)) {
+      return;
+    }
+    const auto& status = element.getValue(CCAPI_EM_ORDER_STATUS);
+    if (status == APP_EVENT_HANDLER_BASE_ORDER_STATUS_FILLED || status == APP_EVENT_HANDLER_BASE_ORDER_STATUS_CANCELED) {
+      openOrder = boost::none;
+    } else {
+      openOrder.get().cumulativeFilledQuantity = Decimal(element.getValue(CCAPI_EM_ORDER_CUMULATIVE_FILLED_QUANTITY));
+      openOrder.get().remainingQuantity = Decimal(element.getValue(CCAPI_EM_ORDER_REMAINING_QUANTITY));
+      openOrder.get().status = status;
+    }
+  }
   virtual void checkAdverseSelectionGuardByRollCorrelationCoefficient(AdverseSelectionGuardInformedTraderSide& adverseSelectionGuardInformedTraderSide) {
-    if (this->publicTradeMap[APP_PUBLIC_TRADE_LAST].size() >= this->adverseSelectionGuardTriggerRollCorrelationCoefficientNumObservations) {
-      int size = this->adverseSelectionGuardTriggerRollCorrelationCoefficientNumObservations - 1;
-      double deltaPt[size];
-      double deltaPtPlusOne[size];
-      auto rit = this->publicTradeMap[APP_PUBLIC_TRADE_LAST].rbegin();
-      std::advance(rit, size);
-      int i = 0;
-      double previousP = rit->second;
-      while (i < size) {
-        rit--;
-        deltaPt[i] = (rit->second - previousP) / previousP;
-        previousP = rit->second;
-        i++;
-      }
-      std::copy(deltaPt, deltaPt + size, deltaPtPlusOne);
-      double deltaPtBar = std::accumulate(deltaPt, deltaPt + size - 1, 0.0) / (size - 1);
-      double deltaPtPlusOneBar = std::accumulate(deltaPt + 1, deltaPt + size, 0.0) / (size - 1);
-      double deltaPtMinusDeltaPtBar[size - 1];
-      double deltaPtPlusOneMinusDeltaPtPlusOneBar[size - 1];
-      std::transform(deltaPt, deltaPt + size - 1, deltaPtMinusDeltaPtBar, [deltaPtBar](double a) -> double { return a - deltaPtBar; });
-      std::transform(deltaPtPlusOne + 1, deltaPtPlusOne + size, deltaPtPlusOneMinusDeltaPtPlusOneBar,
-                     [deltaPtPlusOneBar](double a) -> double { return a - deltaPtPlusOneBar; });
-      double denominator = std::sqrt(std::accumulate(deltaPtMinusDeltaPtBar, deltaPtMinusDeltaPtBar + size - 1, 0.0,
-                                                     [](double accu, double elem) -> double { return accu + std::pow(elem, 2); }) *
-                                     std::accumulate(deltaPtPlusOneMinusDeltaPtPlusOneBar, deltaPtPlusOneMinusDeltaPtPlusOneBar + size - 1, 0.0,
-                                                     [](double accu, double elem) -> double { return accu + std::pow(elem, 2); }));
-      if (denominator > 0) {
-        double numerator = std::inner_product(deltaPtMinusDeltaPtBar, deltaPtMinusDeltaPtBar + size - 1, deltaPtPlusOneMinusDeltaPtPlusOneBar, 0.0);
-        double r = numerator / denominator;
+    const auto& priceSeries = this->rollCorrelationCoefficientPriceSeries;
+    if (priceSeries.size() >= this->adverseSelectionGuardTriggerRollCorrelationCoefficientNumObservations) {
+      double r;
+      if (priceSeries.getLagOneCorrelationCoefficient(r)) {
         APP_LOGGER_DEBUG("Roll coefficient is " + std::to_string(r) + ".");
         if (r > this->adverseSelectionGuardTriggerRollCorrelationCoefficientMaximum) {
-          if (deltaPt[size - 1] - deltaPt[0] > 0) {
+          if (priceSeries.getReturn(priceSeries.getNumReturn() - 1) - priceSeries.getReturn(0) > 0) {
             if (this->adverseSelectionGuardTriggerRollCorrelationCoefficientOrderDirectionReverse) {
               adverseSelectionGuardInformedTraderSide = AdverseSelectionGuardInformedTraderSide::SELL;
             } else {
@@ -1603,12 +1678,10 @@ class EventHandlerBase : public EventHandler {
     }
   }
   virtual void checkAdverseSelectionGuardByRoc(AdverseSelectionGuardInformedTraderSide& adverseSelectionGuardInformedTraderSide) {
-    if (this->publicTradeMap[APP_PUBLIC_TRADE_LAST].size() >= this->adverseSelectionGuardTriggerRocNumObservations) {
-      int size = this->adverseSelectionGuardTriggerRocNumObservations - 1;
-      auto rit2 = this->publicTradeMap[APP_PUBLIC_TRADE_LAST].rbegin();
-      auto rit = this->publicTradeMap[APP_PUBLIC_TRADE_LAST].rbegin();
-      std::advance(rit, size);
-      double roc = (rit2->second - rit->second) / rit->second * 100;
+    const auto& priceSeries = this->rocPriceSeries;
+    if (priceSeries.size() >= this->adverseSelectionGuardTriggerRocNumObservations) {
+      double firstPrice = priceSeries.getPrice(0);
+      double roc = (priceSeries.getPrice(priceSeries.size() - 1) - firstPrice) / firstPrice * 100;
       APP_LOGGER_DEBUG("ROC is " + std::to_string(roc) + ".");
       if (roc > this->adverseSelectionGuardTriggerRocMaximum) {
         if (this->adverseSelectionGuardTriggerRocOrderDirectionReverse) {
@@ -1626,32 +1699,12 @@ class EventHandlerBase : public EventHandler {
     }
   }
   virtual void checkAdverseSelectionGuardByRsi(AdverseSelectionGuardInformedTraderSide& adverseSelectionGuardInformedTraderSide) {
-    if (this->publicTradeMap[APP_PUBLIC_TRADE_LAST].size() >= this->adverseSelectionGuardTriggerRsiNumObservations) {
-      int size = this->adverseSelectionGuardTriggerRsiNumObservations - 1;
-      double deltaPt[size];
-      auto rit = this->publicTradeMap[APP_PUBLIC_TRADE_LAST].rbegin();
-      std::advance(rit, size);
-      int i = 0;
-      double previousP = rit->second;
-      while (i < size) {
-        rit--;
-        deltaPt[i] = (rit->second - previousP) / previousP;
-        previousP = rit->second;
-        i++;
-      }
-      double sumGain = 0;
-      int countGain = 0;
-      double sumLoss = 0;
-      int countLoss = 0;
-      for (const auto& x : deltaPt) {
-        if (x > 0) {
-          sumGain += x;
-          countGain++;
-        } else if (x < 0) {
-          sumLoss += (-x);
-          countLoss++;
-        }
-      }
+    const auto& priceSeries = this->rsiPriceSeries;
+    if (priceSeries.size() >= this->adverseSelectionGuardTriggerRsiNumObservations) {
+      double sumGain = priceSeries.getSumGain();
+      int countGain = priceSeries.getNumGain();
+      double sumLoss = priceSeries.getSumLoss();
+      int countLoss = priceSeries.getNumLoss();
       double rsi;
       if (countGain == 0 && countLoss == 0) {
         rsi = 50;
@@ -1682,7 +1735,8 @@ class EventHandlerBase : public EventHandler {
   CsvWriter* orderUpdateCsvWriter = nullptr;
   CsvWriter* accountBalanceCsvWriter = nullptr;
   int64_t virtualTradeId{}, virtualOrderId{};
-  std::map<int, std::map<int, double>> publicTradeMap;
+  std::shared_ptr<SimulatedExchange> simulatedExchangePtr;
+  RollingPriceSeries rollCorrelationCoefficientPriceSeries, rocPriceSeries, rsiPriceSeries;
   std::map<Decimal, std::string> snapshotBid, snapshotAsk;
   bool skipProcessEvent{};
 };
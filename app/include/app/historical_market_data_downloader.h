@@ -0,0 +1,323 @@
+#ifndef APP_INCLUDE_APP_HISTORICAL_MARKET_DATA_DOWNLOADER_H_
+#define APP_INCLUDE_APP_HISTORICAL_MARKET_DATA_DOWNLOADER_H_
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "app/common.h"
+#include "ccapi_cpp/ccapi_event.h"
+#include "ccapi_cpp/ccapi_queue.h"
+#include "ccapi_cpp/ccapi_request.h"
+namespace ccapi {
+/**
+ * Downloads historical trades or candlesticks into the daily CSV files that HistoricalMarketDataEventProcessor reads, e.g.
+ * gemini__eth-usd__2021-07-01__trade.csv. Each day is cut into windows of windowSeconds, each window is paged through by time with requests of at most limit
+ * rows, and up to maxNumConcurrentRequest windows are in flight at a time over the session's pooled http connections, paced by its rate limiter if
+ * SessionOptions::enableRateLimiter is set: the responses are read from Session::getEventQueue and each one frees its slot for the window's next page right
+ * away. A window ends with a page that brings no new rows or reaches its edge, since exchanges may cap a page below limit. Whether an exchange pages from the
+ * oldest or the newest row of a window is read from the order of its responses. A day's file is written (through a temporary file and a rename) only once all
+ * of its windows are complete, so an interrupted download resumes by skipping the days whose files exist. Days that haven't ended yet are skipped.
+ */
+class HistoricalMarketDataDownloader {
+ public:
+  // returns the number of files written
+  template <class SessionType>
+  int download(SessionType& session) {
+    this->numFileWritten = 0;
+    this->dayList.clear();
+    this->hasWarnedShortPage = false;
+    std::deque<Window> pendingWindowList;
+    auto now = UtilTime::now();
+    for (auto dateTp = this->historicalMarketDataStartDateTp; dateTp < this->historicalMarketDataEndDateTp; dateTp += std::chrono::hours(24)) {
+      const auto& filePath = this->getFilePath(dateTp);
+      if (std::ifstream(filePath)) {
+        APP_LOGGER_INFO("Skip " + filePath + " because it exists.");
+        continue;
+      }
+      if (dateTp + std::chrono::hours(24) > now) {
+        APP_LOGGER_INFO("Skip " + filePath + " because the day hasn't ended.");
+        continue;
+      }
+      int dayIndex = this->dayList.size();
+      Day day;
+      day.dateTp = dateTp;
+      for (auto startTp = dateTp; startTp < dateTp + std::chrono::hours(24); startTp += std::chrono::seconds(this->windowSeconds)) {
+        Window window;
+        window.dayIndex = dayIndex;
+        window.startTp = startTp;
+        window.endTp = std::min(startTp + std::chrono::seconds(this->windowSeconds), dateTp + std::chrono::hours(24));
+        window.cursorStartTp = window.startTp;
+        window.cursorEndTp = window.endTp;
+        pendingWindowList.push_back(std::move(window));
+        ++day.numWindowPending;
+      }
+      this->dayList.push_back(std::move(day));
+    }
+    std::map<std::string, Window> activeWindowByCorrelationIdMap;
+    std::deque<Window> retryWindowList;
+    int requestIndex = 0;
+    Queue<Event>& eventQueue = session.getEventQueue();
+    while (true) {
+      // a slot freed by a response is refilled right away: with a window whose retry is due, or else with a window that hasn't started
+      now = UtilTime::now();
+      while (static_cast<int>(activeWindowByCorrelationIdMap.size()) < this->maxNumConcurrentRequest) {
+        std::deque<Window>* windowListPtr = nullptr;
+        if (!retryWindowList.empty() && retryWindowList.front().retryTp <= now) {
+          windowListPtr = &retryWindowList;
+        } else if (!pendingWindowList.empty()) {
+          windowListPtr = &pendingWindowList;
+        } else {
+          break;
+        }
+        Window window = std::move(windowListPtr->front());
+        windowListPtr->pop_front();
+        if (!this->dayList.at(window.dayIndex).isFailed) {
+          this->sendRequest(session, activeWindowByCorrelationIdMap, std::move(window), requestIndex);
+        }
+      }
+      if (activeWindowByCorrelationIdMap.empty() && retryWindowList.empty()) {
+        break;
+      }
+      long timeoutMilliseconds = 1000;
+      if (!retryWindowList.empty()) {
+        timeoutMilliseconds = std::max<long>(std::chrono::duration_cast<std::chrono::milliseconds>(retryWindowList.front().retryTp - now).count(), 1);
+      }
+      eventQueue.waitUntilNonEmpty(timeoutMilliseconds);
+      for (const auto& event : eventQueue.purge()) {
+        const auto& messageList = event.getMessageList();
+        if (messageList.empty() || messageList.front().getCorrelationIdList().empty()) {
+          continue;
+        }
+        // the messages of a response belong to its request
+        auto it = activeWindowByCorrelationIdMap.find(messageList.front().getCorrelationIdList().front());
+        if (it == activeWindowByCorrelationIdMap.end()) {
+          continue;
+        }
+        Window window = std::move(it->second);
+        activeWindowByCorrelationIdMap.erase(it);
+        Day& day = this->dayList.at(window.dayIndex);
+        if (day.isFailed) {
+          continue;
+        }
+        if (!this->processPage(window, messageList)) {
+          if (++window.numRetry > this->maxNumRetry) {
+            APP_LOGGER_ERROR("Give up " + this->getFilePath(day.dateTp) + " after " + std::to_string(this->maxNumRetry) + " retries.");
+            day.isFailed = true;
+            day.rowList.clear();
+            continue;
+          }
+          window.retryTp = UtilTime::now() + std::chrono::milliseconds(this->retryDelayMilliseconds);
+          retryWindowList.push_back(std::move(window));
+          continue;
+        }
+        window.numRetry = 0;
+        if (window.isDone) {
+          if (--day.numWindowPending == 0) {
+            this->writeFile(day);
+          }
+        } else {
+          // the next page of a window takes the slot of its previous page
+          this->sendRequest(session, activeWindowByCorrelationIdMap, std::move(window), requestIndex);
+        }
+      }
+    }
+    return this->numFileWritten;
+  }
+  std::string getFilePath(const TimePoint& dateTp) const {
+    return (this->historicalMarketDataDirectory.empty() ? "." : this->historicalMarketDataDirectory) + "/" + this->historicalMarketDataFilePrefix +
+           this->exchange + "__" + UtilString::toLower(this->baseAsset) + "-" + UtilString::toLower(this->quoteAsset) + "__" +
+           UtilTime::getISOTimestamp<std::chrono::seconds>(dateTp).substr(0, 10) + "__" + (this->isCandlestick() ? "candlestick" : "trade") +
+           this->historicalMarketDataFileSuffix + ".csv";
+  }
+  // e.g. 1625097621.647
+  static std::string convertTimePointToSecondsString(const TimePoint& tp) {
+    auto timePair = UtilTime::divide(tp);
+    if (timePair.second == 0) {
+      return std::to_string(timePair.first);
+    }
+    std::string nanoseconds = std::to_string(timePair.second);
+    nanoseconds = std::string(9 - nanoseconds.length(), '0') + nanoseconds;
+    return std::to_string(timePair.first) + "." + nanoseconds.substr(0, nanoseconds.find_last_not_of('0') + 1);
+  }
+  std::string exchange, instrument, baseAsset, quoteAsset, historicalMarketDataDirectory, historicalMarketDataFilePrefix, historicalMarketDataFileSuffix;
+  // GET_HISTORICAL_TRADES, GET_HISTORICAL_AGG_TRADES (e.g. for binance, whose GET_HISTORICAL_TRADES can't be paged by time), or GET_HISTORICAL_CANDLESTICKS
+  Request::Operation operation{Request::Operation::GET_HISTORICAL_TRADES};
+  TimePoint historicalMarketDataStartDateTp{std::chrono::seconds{0}}, historicalMarketDataEndDateTp{std::chrono::seconds{0}};
+  std::map<std::string, std::string> param;  // additional request parameters, e.g. {"type", "2"} to make okx page its trades by time
+  int windowSeconds{1800};                   // should be shorter than the longest time range that the exchange accepts in one request
+  int limit{1000};                           // should be the largest page size that the exchange accepts
+  int maxNumConcurrentRequest{8};
+  int maxNumRetry{5};
+  long retryDelayMilliseconds{1000};
+  int candlestickIntervalSeconds{60};
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct Day {
+    TimePoint dateTp{std::chrono::seconds{0}};
+    std::vector<std::pair<TimePoint, std::string> > rowList;
+    int numWindowPending{};
+    bool isFailed{};
+  };
+  // rows are kept if their time is in [startTp, endTp); the part of the window that hasn't been paged through yet is [cursorStartTp, cursorEndTp]
+  struct Window {
+    int dayIndex{};
+    TimePoint startTp{std::chrono::seconds{0}}, endTp{std::chrono::seconds{0}}, cursorStartTp{std::chrono::seconds{0}}, cursorEndTp{std::chrono::seconds{0}};
+    std::set<std::string> keySet;  // the rows seen, because consecutive pages overlap at their boundary time
+    int numRetry{};
+    TimePoint retryTp{std::chrono::seconds{0}};
+    int numRowOfShortPage{};  // the number of rows of the latest page if it had fewer than limit rows
+    bool isDone{};
+  };
+  bool isCandlestick() const { return this->operation == Request::Operation::GET_HISTORICAL_CANDLESTICKS; }
+  // the range starts one millisecond early for exchanges that treat its start as exclusive; the extra rows are dropped
+  Request createRequest(const Window& window, const std::string& correlationId) const {
+    Request request(this->operation, this->exchange, this->instrument, correlationId);
+    std::map<std::string, std::string> requestParam(this->param);
+    requestParam[CCAPI_START_TIME_SECONDS] = convertTimePointToMillisecondsString(window.cursorStartTp - std::chrono::milliseconds(1));
+    requestParam[CCAPI_END_TIME_SECONDS] = convertTimePointToMillisecondsString(window.cursorEndTp);
+    requestParam[CCAPI_LIMIT] = std::to_string(this->limit);
+    if (this->isCandlestick()) {
+      requestParam[CCAPI_CANDLESTICK_INTERVAL_SECONDS] = std::to_string(this->candlestickIntervalSeconds);
+    }
+    request.appendParam(requestParam);
+    return request;
+  }
+  template <class SessionType>
+  void sendRequest(SessionType& session, std::map<std::string, Window>& activeWindowByCorrelationIdMap, Window window, int& requestIndex) {
+    auto correlationId = std::to_string(requestIndex++);
+    auto request = this->createRequest(window, correlationId);
+    activeWindowByCorrelationIdMap.emplace(correlationId, std::move(window));
+    session.sendRequest(request);
+  }
+  static std::string convertTimePointToMillisecondsString(const TimePoint& tp) {
+    long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+    std::string fraction = std::to_string(milliseconds % 1000);
+    return std::to_string(milliseconds / 1000) + "." + std::string(3 - fraction.length(), '0') + fraction;
+  }
+  // returns false if the response is missing or an error. A window is paged through until a page brings no new rows in it or the cursor reaches its edge:
+  // a page shorter than limit doesn't mean that the window is exhausted, because exchanges may cap their page size below limit.
+  bool processPage(Window& window, const std::vector<Message>& messageList) {
+    if (messageList.empty()) {
+      APP_LOGGER_WARN("No response for " + this->exchange + " " + this->instrument + " from " + UtilTime::getISOTimestamp(window.cursorStartTp) + ".");
+      return false;
+    }
+    Day& day = this->dayList.at(window.dayIndex);
+    int numRow = 0, numNewRow = 0;
+    TimePoint firstTp{std::chrono::seconds{0}}, lastTp{std::chrono::seconds{0}}, minTp{TimePoint::max()}, maxTp{TimePoint::min()};
+    for (const auto& message : messageList) {
+      if (message.getType() == Message::Type::RESPONSE_ERROR || message.getType() == Message::Type::REQUEST_FAILURE) {
+        APP_LOGGER_WARN("Request failed for " + this->exchange + " " + this->instrument + ": " + message.toString());
+        return false;
+      }
+      const auto& tp = message.getTime();
+      for (const auto& element : message.getElementList()) {
+        if (numRow == 0) {
+          firstTp = tp;
+        }
+        lastTp = tp;
+        minTp = std::min(minTp, tp);
+        maxTp = std::max(maxTp, tp);
+        ++numRow;
+        if (tp < window.startTp || tp >= window.endTp) {
+          continue;
+        }
+        auto row = this->createRow(tp, element);
+        const auto& tradeId = element.getValue(CCAPI_TRADE_ID, element.getValue(CCAPI_AGG_TRADE_ID));
+        if (window.keySet.insert(tradeId.empty() ? row : tradeId).second) {
+          day.rowList.emplace_back(tp, std::move(row));
+          ++numNewRow;
+        }
+      }
+    }
+    if (numNewRow == 0) {
+      window.isDone = true;
+      return true;
+    }
+    if (window.numRowOfShortPage > 0 && !this->hasWarnedShortPage) {
+      APP_LOGGER_WARN("A page of " + std::to_string(window.numRowOfShortPage) + " rows, fewer than LIMIT = " + std::to_string(this->limit) +
+                      ", didn't reach the end of its window: the exchange seems to cap its page size, which costs a request per window to detect.");
+      this->hasWarnedShortPage = true;
+    }
+    window.numRowOfShortPage = numRow < this->limit ? numRow : 0;
+    if (firstTp != lastTp) {
+      this->isNewestFirst = firstTp > lastTp;
+    }
+    // continue from the far end of the page, which is requested again so that no row sharing its time is lost
+    if (this->isNewestFirst) {
+      if (minTp >= window.cursorEndTp) {
+        if (numRow >= this->limit) {
+          APP_LOGGER_WARN("More than " + std::to_string(this->limit) + " rows at " + UtilTime::getISOTimestamp(minTp) + ", some may be missing.");
+        }
+        minTp = window.cursorEndTp - std::chrono::milliseconds(1);
+      }
+      window.cursorEndTp = minTp;
+    } else {
+      if (maxTp <= window.cursorStartTp) {
+        if (numRow >= this->limit) {
+          APP_LOGGER_WARN("More than " + std::to_string(this->limit) + " rows at " + UtilTime::getISOTimestamp(maxTp) + ", some may be missing.");
+        }
+        maxTp = window.cursorStartTp + std::chrono::milliseconds(1);
+      }
+      window.cursorStartTp = maxTp;
+    }
+    window.isDone = window.cursorStartTp >= window.endTp || window.cursorEndTp < window.startTp;
+    return true;
+  }
+  std::string createRow(const TimePoint& tp, const Element& element) const {
+    std::string row = convertTimePointToSecondsString(tp);
+    if (this->isCandlestick()) {
+      for (const auto& name : {CCAPI_OPEN_PRICE, CCAPI_HIGH_PRICE, CCAPI_LOW_PRICE, CCAPI_CLOSE_PRICE, CCAPI_VOLUME}) {
+        row += ",";
+        row += element.getValue(name);
+      }
+    } else {
+      row += ",";
+      row += element.getValue(CCAPI_LAST_PRICE);
+      row += ",";
+      row += element.getValue(CCAPI_LAST_SIZE);
+      row += ",";
+      row += element.getValue(CCAPI_IS_BUYER_MAKER);
+    }
+    return row;
+  }
+  void writeFile(Day& day) {
+    const auto& filePath = this->getFilePath(day.dateTp);
+    std::stable_sort(day.rowList.begin(), day.rowList.end(),
+                     [](const std::pair<TimePoint, std::string>& a, const std::pair<TimePoint, std::string>& b) { return a.first < b.first; });
+    std::string tmpFilePath = filePath + ".tmp";
+    {
+      std::ofstream f(tmpFilePath);
+      f << (this->isCandlestick() ? "time_seconds,open,high,low,close,volume" : "time_seconds,price,size,is_buyer_maker") << "\n";
+      for (const auto& x : day.rowList) {
+        f << x.second << "\n";
+      }
+      if (!f) {
+        APP_LOGGER_ERROR("Failed to write " + tmpFilePath + ".");
+        day.rowList.clear();
+        return;
+      }
+    }
+    if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+      APP_LOGGER_ERROR("Failed to rename " + tmpFilePath + " to " + filePath + ".");
+    } else {
+      APP_LOGGER_INFO("Wrote " + std::to_string(day.rowList.size()) + " rows to " + filePath + ".");
+      ++this->numFileWritten;
+    }
+    day.rowList.clear();
+    day.rowList.shrink_to_fit();
+  }
+  std::vector<Day> dayList;
+  bool isNewestFirst{};
+  bool hasWarnedShortPage{};
+  int numFileWritten{};
+};
+} /* namespace ccapi */
+#endif  // APP_INCLUDE_APP_HISTORICAL_MARKET_DATA_DOWNLOADER_H_
@@ -0,0 +1,159 @@
+#ifndef APP_INCLUDE_APP_ROLLING_PRICE_SERIES_H_
+#define APP_INCLUDE_APP_ROLLING_PRICE_SERIES_H_
+#include <algorithm>
+#include <cmath>
+#include <vector>
+namespace ccapi {
+/**
+ * The last prices of a sequence of time intervals, kept in a fixed-capacity ring buffer together with the statistics of the relative changes (returns)
+ * between consecutive prices: their sum, sum of squares, sum of lag-1 products and gain/loss accumulators. The statistics are maintained incrementally as
+ * prices enter and leave, so every operation is constant-time. To bound floating point drift they are recomputed from the buffer once every capacity
+ * updates, which keeps the amortized cost constant too.
+ */
+class RollingPriceSeries {
+ public:
+  RollingPriceSeries() {}
+  explicit RollingPriceSeries(size_t capacity) : keyList(std::max<size_t>(capacity, 2)), priceList(std::max<size_t>(capacity, 2)) {}
+  size_t getCapacity() const { return this->priceList.size(); }
+  size_t size() const { return this->count; }
+  bool empty() const { return this->count == 0; }
+  // appends the price of a new interval or, if key is the one of the last interval, replaces its price; the oldest interval is dropped when the buffer is full
+  void update(int key, double price) {
+    if (this->priceList.empty()) {
+      return;
+    }
+    if (this->count > 0 && key == this->keyList[this->index(this->count - 1)]) {
+      this->removeLastReturn();
+      this->priceList[this->index(this->count - 1)] = price;
+      this->addLastReturn();
+    } else {
+      if (this->count == this->priceList.size()) {
+        this->popFront();
+      }
+      this->keyList[this->index(this->count)] = key;
+      this->priceList[this->index(this->count)] = price;
+      ++this->count;
+      this->addLastReturn();
+    }
+    // replacements drift the sums as much as appends do
+    if (++this->numUpdateSinceRecompute >= this->priceList.size()) {
+      this->recompute();
+    }
+  }
+  // drops the intervals whose key is less than or equal to key
+  void eraseUpTo(int key) {
+    while (this->count > 0 && this->keyList[this->head] <= key) {
+      this->popFront();
+    }
+  }
+  // i = 0 is the oldest price
+  double getPrice(size_t i) const { return this->priceList[this->index(i)]; }
+  // the return from price i to price i + 1
+  double getReturn(size_t i) const {
+    double previousPrice = this->getPrice(i);
+    return (this->getPrice(i + 1) - previousPrice) / previousPrice;
+  }
+  size_t getNumReturn() const { return this->count > 1 ? this->count - 1 : 0; }
+  double getSumReturn() const { return this->sumReturn; }
+  double getSumSquaredReturn() const { return this->sumSquaredReturn; }
+  double getSumLagOneProduct() const { return this->sumLagOneProduct; }
+  double getSumGain() const { return this->sumGain; }
+  double getSumLoss() const { return this->sumLoss; }
+  int getNumGain() const { return this->numGain; }
+  int getNumLoss() const { return this->numLoss; }
+  // the Pearson correlation coefficient between each return and the next one; returns false if there are fewer than two such pairs or either side has no
+  // variance
+  bool getLagOneCorrelationCoefficient(double& output) const {
+    if (this->count < 4) {
+      return false;
+    }
+    double n = this->count - 2;
+    double firstReturn = this->getReturn(0), lastReturn = this->getReturn(this->count - 2);
+    double sumX = this->sumReturn - lastReturn, sumY = this->sumReturn - firstReturn;
+    double sumXX = this->sumSquaredReturn - lastReturn * lastReturn, sumYY = this->sumSquaredReturn - firstReturn * firstReturn;
+    double varianceX = sumXX - sumX * sumX / n, varianceY = sumYY - sumY * sumY / n;
+    // what is left after the cancellation of nearly equal sums is rounding error, and so is a variance that is negligible next to the squared returns that
+    // have passed through the sums since they were last recomputed
+    double threshold = std::max(this->maxSquaredReturn, std::max(sumXX, sumYY)) * 1e-12;
+    if (varianceX <= threshold || varianceY <= threshold) {
+      return false;
+    }
+    output = (this->sumLagOneProduct - sumX * sumY / n) / std::sqrt(varianceX * varianceY);
+    return true;
+  }
+
+ private:
+  size_t index(size_t i) const { return (this->head + i) % this->priceList.size(); }
+  void popFront() {
+    if (this->count > 1) {
+      double r = this->getReturn(0);
+      this->accumulateReturn(r, -1);
+      if (this->count > 2) {
+        this->sumLagOneProduct -= r * this->getReturn(1);
+      }
+    }
+    this->head = this->index(1);
+    --this->count;
+    if (this->count == 0) {
+      this->resetStatistics();
+    }
+  }
+  void addLastReturn() {
+    if (this->count > 1) {
+      double r = this->getReturn(this->count - 2);
+      this->accumulateReturn(r, 1);
+      if (this->count > 2) {
+        this->sumLagOneProduct += this->getReturn(this->count - 3) * r;
+      }
+    }
+  }
+  void removeLastReturn() {
+    if (this->count > 1) {
+      double r = this->getReturn(this->count - 2);
+      this->accumulateReturn(r, -1);
+      if (this->count > 2) {
+        this->sumLagOneProduct -= this->getReturn(this->count - 3) * r;
+      }
+    }
+  }
+  void accumulateReturn(double r, int sign) {
+    this->maxSquaredReturn = std::max(this->maxSquaredReturn, r * r);
+    this->sumReturn += sign * r;
+    this->sumSquaredReturn += sign * r * r;
+    if (r > 0) {
+      this->sumGain += sign * r;
+      this->numGain += sign;
+    } else if (r < 0) {
+      this->sumLoss -= sign * r;
+      this->numLoss += sign;
+    }
+  }
+  void resetStatistics() {
+    this->sumReturn = 0;
+    this->sumSquaredReturn = 0;
+    this->sumLagOneProduct = 0;
+    this->sumGain = 0;
+    this->sumLoss = 0;
+    this->numGain = 0;
+    this->numLoss = 0;
+    this->maxSquaredReturn = 0;
+  }
+  void recompute() {
+    this->resetStatistics();
+    for (size_t i = 0; i + 1 < this->count; ++i) {
+      double r = this->getReturn(i);
+      this->accumulateReturn(r, 1);
+      if (i > 0) {
+        this->sumLagOneProduct += this->getReturn(i - 1) * r;
+      }
+    }
+    this->numUpdateSinceRecompute = 0;
+  }
+  std::vector<int> keyList;
+  std::vector<double> priceList;
+  size_t head{}, count{}, numUpdateSinceRecompute{};
+  double sumReturn{}, sumSquaredReturn{}, sumLagOneProduct{}, sumGain{}, sumLoss{}, maxSquaredReturn{};
+  int numGain{}, numLoss{};
+};
+} /* namespace ccapi */
+#endif  // APP_INCLUDE_APP_ROLLING_PRICE_SERIES_H_
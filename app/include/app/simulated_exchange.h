@@ -0,0 +1,524 @@
+#ifndef APP_INCLUDE_APP_SIMULATED_EXCHANGE_H_
+#define APP_INCLUDE_APP_SIMULATED_EXCHANGE_H_
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "app/common.h"
+#include "ccapi_cpp/ccapi_bar_aggregator.h"
+#include "ccapi_cpp/ccapi_decimal.h"
+#include "ccapi_cpp/ccapi_element.h"
+#include "ccapi_cpp/ccapi_event.h"
+#include "ccapi_cpp/ccapi_message.h"
+#include "ccapi_cpp/ccapi_request.h"
+#ifndef APP_EVENT_HANDLER_BASE_ORDER_STATUS_NEW
+#define APP_EVENT_HANDLER_BASE_ORDER_STATUS_NEW "NEW"
+#endif
+#ifndef APP_EVENT_HANDLER_BASE_ORDER_STATUS_CANCELED
+#define APP_EVENT_HANDLER_BASE_ORDER_STATUS_CANCELED "CANCELED"
+#endif
+#ifndef APP_EVENT_HANDLER_BASE_ORDER_STATUS_PARTIALLY_FILLED
+#define APP_EVENT_HANDLER_BASE_ORDER_STATUS_PARTIALLY_FILLED "PARTIALLY_FILLED"
+#endif
+#ifndef APP_EVENT_HANDLER_BASE_ORDER_STATUS_FILLED
+#define APP_EVENT_HANDLER_BASE_ORDER_STATUS_FILLED "FILLED"
+#endif
+namespace ccapi {
+/**
+ * A matching simulator for paper trading and backtests. Like a Service it accepts requests and answers with events (responses, order updates and private
+ * trades), but instead of talking to an exchange it matches the orders against the market data that it is fed.
+ *
+ * Any number of orders may rest on either side. They are kept in price-time priority and each one carries an estimate of the displayed quantity queued ahead
+ * of it: the size of its price level when it arrived, reduced by the volume of the public trades at that price and capped by the size that the order book
+ * later shows at that price (cancellations are assumed to come from behind). A resting order is filled by a public trade once the trade has eaten through the
+ * queue ahead of it, completely by a trade at a worse price and completely when the opposite side of the order book crosses its price. An incoming order that
+ * crosses the book takes liquidity level by level.
+ *
+ * Requests don't take effect before they reach the simulated exchange: a request sent at time t arrives at t + market data latency + order entry latency (plus
+ * a uniformly distributed jitter), and it is matched against the market data from that moment on. Prices are kept in integer ticks of the price increment
+ * and quantities in integer units of the quantity increment's last decimal, so matching is exact; a price or quantity with more decimals is rounded to the
+ * nearest tick or unit.
+ */
+class SimulatedExchange {
+ public:
+  struct LatencyModel {
+    std::chrono::microseconds marketDataLatency{}, marketDataLatencyJitter{}, orderEntryLatency{}, orderEntryLatencyJitter{};
+  };
+  SimulatedExchange(const std::string& priceIncrement, const std::string& quantityIncrement, const std::string& baseAsset, const std::string& quoteAsset)
+      : baseAsset(baseAsset),
+        quoteAsset(quoteAsset),
+        priceIncrement(FixedPoint::parse(priceIncrement)),
+        quantityScale(FixedPoint::parse(quantityIncrement).scale) {
+    if (this->priceIncrement.mantissa <= 0) {
+      throw std::invalid_argument("price increment must be positive: " + priceIncrement);
+    }
+  }
+  // CREATE_ORDER, CANCEL_ORDER and CANCEL_OPEN_ORDERS are supported; the resulting events are appended to eventList once the request reaches the exchange
+  void sendRequest(const Request& request, std::vector<Event>& eventList) {
+    auto arrivalTp = request.getTimeSent() + this->sampleLatency(this->latencyModel.marketDataLatency, this->latencyModel.marketDataLatencyJitter) +
+                     this->sampleLatency(this->latencyModel.orderEntryLatency, this->latencyModel.orderEntryLatencyJitter);
+    // requests travel over one connection, so they can't overtake each other
+    if (arrivalTp < this->lastArrivalTp) {
+      arrivalTp = this->lastArrivalTp;
+    }
+    this->lastArrivalTp = arrivalTp;
+    this->pendingRequestQueue.push_back({arrivalTp, request});
+    this->advance(this->now, eventList);
+  }
+  // a snapshot of the top of the order book as pairs of price tick and quantity, best levels first
+  void onMarketDepth(const TimePoint& tp, const std::vector<std::pair<int64_t, int64_t> >& bidList, const std::vector<std::pair<int64_t, int64_t> >& askList,
+                     std::vector<Event>& eventList) {
+    this->advance(tp, eventList);
+    this->bidLevelList = bidList;
+    this->askLevelList = askList;
+    this->updateQueueAhead(true);
+    this->updateQueueAhead(false);
+    if (!this->askLevelList.empty()) {
+      this->fillCrossedOrders(true, this->askLevelList.front().first, eventList);
+    }
+    if (!this->bidLevelList.empty()) {
+      this->fillCrossedOrders(false, this->bidLevelList.front().first, eventList);
+    }
+  }
+  void onTrade(const TimePoint& tp, int64_t priceTick, int64_t size, bool isBuyerMaker, std::vector<Event>& eventList) {
+    this->advance(tp, eventList);
+    // a buyer maker means that a seller took liquidity from the bids
+    bool isBuy = isBuyerMaker;
+    auto& orderListByPriceTickMap = isBuy ? this->bidOrderListByPriceTickMap : this->askOrderListByPriceTickMap;
+    std::vector<std::pair<int64_t, std::list<SimulatedOrder>*> > levelList;
+    if (isBuy) {
+      for (auto it = orderListByPriceTickMap.rbegin(); it != orderListByPriceTickMap.rend() && it->first >= priceTick; ++it) {
+        levelList.emplace_back(it->first, &it->second);
+      }
+    } else {
+      for (auto it = orderListByPriceTickMap.begin(); it != orderListByPriceTickMap.end() && it->first <= priceTick; ++it) {
+        levelList.emplace_back(it->first, &it->second);
+      }
+    }
+    for (const auto& level : levelList) {
+      auto& orderList = *level.second;
+      if (level.first != priceTick) {
+        // the trade went through this price, so everything resting here must have been executed
+        for (auto& order : orderList) {
+          this->fill(order, level.first, order.quantity - order.filledQuantity, true, tp, eventList);
+        }
+      } else {
+        int64_t volume = size, displayedVolumeConsumed = 0;
+        for (auto& order : orderList) {
+          order.queueAhead = std::max<int64_t>(order.queueAhead - displayedVolumeConsumed, 0);
+          int64_t queueAheadConsumed = std::min(volume, order.queueAhead);
+          order.queueAhead -= queueAheadConsumed;
+          volume -= queueAheadConsumed;
+          displayedVolumeConsumed += queueAheadConsumed;
+          if (volume > 0) {
+            int64_t filledQuantity = std::min(volume, order.quantity - order.filledQuantity);
+            this->fill(order, level.first, filledQuantity, true, tp, eventList);
+            volume -= filledQuantity;
+          }
+        }
+      }
+      this->removeFilledOrders(isBuy, level.first);
+    }
+  }
+  // accepts the MARKET_DEPTH, TRADE and AGG_TRADE messages of a subscription
+  void processMarketDataMessage(const Message& message, std::vector<Event>& eventList) {
+    if (message.getRecapType() != Message::RecapType::NONE) {
+      return;
+    }
+    const auto& messageType = message.getType();
+    if (messageType == Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH) {
+      std::vector<std::pair<int64_t, int64_t> > bidList, askList;
+      for (const auto& element : message.getElementList()) {
+        const auto& elementNameValueMap = element.getNameValueMap();
+        this->appendLevel(elementNameValueMap, CCAPI_BEST_BID_N_PRICE, CCAPI_BEST_BID_N_PRICE_EMPTY, CCAPI_BEST_BID_N_SIZE, bidList);
+        this->appendLevel(elementNameValueMap, CCAPI_BEST_ASK_N_PRICE, CCAPI_BEST_ASK_N_PRICE_EMPTY, CCAPI_BEST_ASK_N_SIZE, askList);
+      }
+      std::sort(bidList.begin(), bidList.end(), [](const std::pair<int64_t, int64_t>& l, const std::pair<int64_t, int64_t>& r) { return l.first > r.first; });
+      std::sort(askList.begin(), askList.end());
+      this->onMarketDepth(message.getTime(), bidList, askList, eventList);
+    } else if (messageType == Message::Type::MARKET_DATA_EVENTS_TRADE || messageType == Message::Type::MARKET_DATA_EVENTS_AGG_TRADE) {
+      for (const auto& element : message.getElementList()) {
+        int64_t priceTick, size;
+        const auto& price = element.getValue(CCAPI_LAST_PRICE);
+        const auto& quantity = element.getValue(CCAPI_LAST_SIZE);
+        if (!this->toTick(price, priceTick) || !this->toQuantity(quantity, size)) {
+          APP_LOGGER_WARN("Skipped a trade that can't be simulated: price = " + price + ", size = " + quantity);
+          continue;
+        }
+        this->onTrade(message.getTime(), priceTick, size, element.getValue(CCAPI_IS_BUYER_MAKER) == "1", eventList);
+      }
+    }
+  }
+  // the price in ticks of the price increment, rounded to the nearest tick
+  bool toTick(const std::string& price, int64_t& output) const {
+    int64_t units;
+    if (!toUnits(price, this->priceIncrement.scale, units)) {
+      return false;
+    }
+    output = units / this->priceIncrement.mantissa + (units % this->priceIncrement.mantissa * 2 >= this->priceIncrement.mantissa ? 1 : 0);
+    return true;
+  }
+  // the quantity in units of the quantity increment's last decimal, rounded to the nearest unit
+  bool toQuantity(const std::string& quantity, int64_t& output) const { return toUnits(quantity, this->quantityScale, output); }
+  size_t getNumOpenOrder() const { return locationByOrderIdMap.size(); }
+  LatencyModel latencyModel;
+  double makerFee{}, takerFee{};
+  std::string makerBuyerFeeAsset, makerSellerFeeAsset, takerBuyerFeeAsset, takerSellerFeeAsset;
+  unsigned int randomSeed{};
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct SimulatedOrder {
+    std::string orderId, clientOrderId;
+    bool isBuy{};
+    int64_t priceTick{};
+    int64_t quantity{}, filledQuantity{}, queueAhead{};
+    std::string status;
+  };
+  struct Location {
+    bool isBuy{};
+    int64_t priceTick{};
+    std::list<SimulatedOrder>::iterator it;
+  };
+  // the value in units of 10^-scale, rounded to the nearest unit
+  static bool toUnits(const std::string& value, int scale, int64_t& output) {
+    FixedPoint x;
+    if (!FixedPoint::parse(value, x)) {
+      return false;
+    }
+    if (x.scale <= scale) {
+      return FixedPoint::rescale(x.mantissa, x.scale, scale, output);
+    }
+    int64_t divisor = FixedPoint::powerOfTen(x.scale - scale);
+    output = x.mantissa / divisor + (x.mantissa % divisor * 2 >= divisor ? 1 : 0);
+    return true;
+  }
+  void appendLevel(const std::map<std::string, std::string>& elementNameValueMap, const std::string& priceName, const std::string& emptyPrice,
+                   const std::string& sizeName, std::vector<std::pair<int64_t, int64_t> >& levelList) const {
+    auto it = elementNameValueMap.find(priceName);
+    if (it == elementNameValueMap.end() || it->second == emptyPrice) {
+      return;
+    }
+    int64_t priceTick, size;
+    auto it2 = elementNameValueMap.find(sizeName);
+    if (it2 == elementNameValueMap.end() || !this->toTick(it->second, priceTick) || !this->toQuantity(it2->second, size)) {
+      APP_LOGGER_WARN("Skipped an order book level that can't be simulated: price = " + it->second);
+      return;
+    }
+    levelList.emplace_back(priceTick, size);
+  }
+  struct PendingRequest {
+    TimePoint arrivalTp;
+    Request request;
+  };
+  std::chrono::microseconds sampleLatency(const std::chrono::microseconds& latency, const std::chrono::microseconds& jitter) {
+    if (jitter.count() <= 0) {
+      return latency;
+    }
+    if (!this->randomEnginePtr) {
+      this->randomEnginePtr.reset(new std::mt19937(this->randomSeed));
+    }
+    std::uniform_int_distribution<int64_t> distribution(0, jitter.count());
+    return latency + std::chrono::microseconds(distribution(*this->randomEnginePtr));
+  }
+  void advance(const TimePoint& tp, std::vector<Event>& eventList) {
+    if (tp > this->now) {
+      this->now = tp;
+    }
+    while (!this->pendingRequestQueue.empty() && this->pendingRequestQueue.front().arrivalTp <= this->now) {
+      auto pendingRequest = std::move(this->pendingRequestQueue.front());
+      this->pendingRequestQueue.pop_front();
+      this->onRequestArrival(pendingRequest.request, pendingRequest.arrivalTp, eventList);
+    }
+  }
+  void onRequestArrival(const Request& request, const TimePoint& tp, std::vector<Event>& eventList) {
+    const auto& operation = request.getOperation();
+    if (operation == Request::Operation::CREATE_ORDER) {
+      const auto& param = request.getParamList().at(0);
+      SimulatedOrder order;
+      order.orderId = std::to_string(++this->virtualOrderId);
+      auto it = param.find(CCAPI_EM_CLIENT_ORDER_ID);
+      if (it != param.end()) {
+        order.clientOrderId = it->second;
+      }
+      order.isBuy = param.at(CCAPI_EM_ORDER_SIDE) == CCAPI_EM_ORDER_SIDE_BUY;
+      if (!this->toTick(param.at(CCAPI_EM_ORDER_LIMIT_PRICE), order.priceTick) || !this->toQuantity(param.at(CCAPI_EM_ORDER_QUANTITY), order.quantity) ||
+          order.quantity <= 0) {
+        Element element;
+        element.insert(CCAPI_ERROR_MESSAGE, "invalid price or quantity");
+        this->appendResponseEvent(request, Message::Type::RESPONSE_ERROR, {element}, tp, eventList);
+        return;
+      }
+      order.status = APP_EVENT_HANDLER_BASE_ORDER_STATUS_NEW;
+      this->appendOrderUpdateEvent(order, tp, eventList);
+      this->appendResponseEvent(request, Message::Type::CREATE_ORDER, {this->toElement(order)}, tp, eventList);
+      this->take(order, tp, eventList);
+      if (order.filledQuantity < order.quantity) {
+        order.queueAhead = this->getDisplayedSize(order.isBuy, order.priceTick);
+        auto& orderList = (order.isBuy ? this->bidOrderListByPriceTickMap : this->askOrderListByPriceTickMap)[order.priceTick];
+        orderList.push_back(order);
+        this->locationByOrderIdMap[order.orderId] = {order.isBuy, order.priceTick, std::prev(orderList.end())};
+        if (!order.clientOrderId.empty()) {
+          this->orderIdByClientOrderIdMap[order.clientOrderId] = order.orderId;
+        }
+      }
+    } else if (operation == Request::Operation::CANCEL_ORDER) {
+      const auto& param = request.getParamList().empty() ? std::map<std::string, std::string>() : request.getParamList().at(0);
+      auto it = param.find(CCAPI_EM_ORDER_ID);
+      auto it2 = param.find(CCAPI_EM_CLIENT_ORDER_ID);
+      std::vector<Element> elementList;
+      if (it != param.end()) {
+        this->cancel(it->second, "", tp, eventList, elementList);
+      } else if (it2 != param.end()) {
+        this->cancel("", it2->second, tp, eventList, elementList);
+      }
+      if (elementList.empty()) {
+        Element element;
+        element.insert(CCAPI_ERROR_MESSAGE, "order not found");
+        this->appendResponseEvent(request, Message::Type::RESPONSE_ERROR, {element}, tp, eventList);
+      } else {
+        this->appendResponseEvent(request, Message::Type::CANCEL_ORDER, elementList, tp, eventList);
+      }
+    } else if (operation == Request::Operation::CANCEL_OPEN_ORDERS) {
+      std::vector<std::string> orderIdList;
+      for (const auto& x : this->locationByOrderIdMap) {
+        orderIdList.push_back(x.first);
+      }
+      std::sort(orderIdList.begin(), orderIdList.end(), [](const std::string& l, const std::string& r) { return std::stoll(l) < std::stoll(r); });
+      std::vector<Element> elementList;
+      for (const auto& orderId : orderIdList) {
+        this->cancel(orderId, "", tp, eventList, elementList);
+      }
+      this->appendResponseEvent(request, Message::Type::CANCEL_OPEN_ORDERS, elementList, tp, eventList);
+    } else {
+      Element element;
+      element.insert(CCAPI_ERROR_MESSAGE, "unsupported operation " + Request::operationToString(operation));
+      this->appendResponseEvent(request, Message::Type::RESPONSE_ERROR, {element}, tp, eventList);
+    }
+  }
+  void cancel(const std::string& orderId, const std::string& clientOrderId, const TimePoint& tp, std::vector<Event>& eventList,
+              std::vector<Element>& elementList) {
+    auto it = this->locationByOrderIdMap.end();
+    if (!orderId.empty()) {
+      it = this->locationByOrderIdMap.find(orderId);
+    } else {
+      auto it2 = this->orderIdByClientOrderIdMap.find(clientOrderId);
+      if (it2 != this->orderIdByClientOrderIdMap.end()) {
+        it = this->locationByOrderIdMap.find(it2->second);
+      }
+    }
+    if (it == this->locationByOrderIdMap.end()) {
+      return;
+    }
+    auto& order = *it->second.it;
+    order.status = APP_EVENT_HANDLER_BASE_ORDER_STATUS_CANCELED;
+    this->appendOrderUpdateEvent(order, tp, eventList);
+    elementList.push_back(this->toElement(order));
+    auto& orderListByPriceTickMap = it->second.isBuy ? this->bidOrderListByPriceTickMap : this->askOrderListByPriceTickMap;
+    auto it3 = orderListByPriceTickMap.find(it->second.priceTick);
+    this->eraseOrder(it3->second, it->second.it);
+    if (it3->second.empty()) {
+      orderListByPriceTickMap.erase(it3);
+    }
+  }
+  std::list<SimulatedOrder>::iterator eraseOrder(std::list<SimulatedOrder>& orderList, std::list<SimulatedOrder>::iterator it) {
+    auto it2 = this->orderIdByClientOrderIdMap.find(it->clientOrderId);
+    if (it2 != this->orderIdByClientOrderIdMap.end() && it2->second == it->orderId) {
+      this->orderIdByClientOrderIdMap.erase(it2);
+    }
+    this->locationByOrderIdMap.erase(it->orderId);
+    return orderList.erase(it);
+  }
+  // takes liquidity from the opposite side of the order book
+  void take(SimulatedOrder& order, const TimePoint& tp, std::vector<Event>& eventList) {
+    auto& levelList = order.isBuy ? this->askLevelList : this->bidLevelList;
+    for (auto& level : levelList) {
+      if (order.filledQuantity >= order.quantity || (order.isBuy ? level.first > order.priceTick : level.first < order.priceTick)) {
+        break;
+      }
+      int64_t filledQuantity = std::min(level.second, order.quantity - order.filledQuantity);
+      if (filledQuantity > 0) {
+        this->fill(order, level.first, filledQuantity, false, tp, eventList);
+        // the liquidity that was taken stays gone until the next order book snapshot
+        level.second -= filledQuantity;
+      }
+    }
+  }
+  // the opposite side of the order book has reached these prices, so the orders resting there must have been executed
+  void fillCrossedOrders(bool isBuy, int64_t oppositeBestPriceTick, std::vector<Event>& eventList) {
+    auto& orderListByPriceTickMap = isBuy ? this->bidOrderListByPriceTickMap : this->askOrderListByPriceTickMap;
+    std::vector<int64_t> priceTickList;
+    if (isBuy) {
+      for (auto it = orderListByPriceTickMap.rbegin(); it != orderListByPriceTickMap.rend() && it->first >= oppositeBestPriceTick; ++it) {
+        priceTickList.push_back(it->first);
+      }
+    } else {
+      for (auto it = orderListByPriceTickMap.begin(); it != orderListByPriceTickMap.end() && it->first <= oppositeBestPriceTick; ++it) {
+        priceTickList.push_back(it->first);
+      }
+    }
+    for (auto priceTick : priceTickList) {
+      for (auto& order : orderListByPriceTickMap.at(priceTick)) {
+        this->fill(order, priceTick, order.quantity - order.filledQuantity, true, this->now, eventList);
+      }
+      this->removeFilledOrders(isBuy, priceTick);
+    }
+  }
+  void updateQueueAhead(bool isBuy) {
+    const auto& levelList = isBuy ? this->bidLevelList : this->askLevelList;
+    if (levelList.empty()) {
+      return;
+    }
+    int64_t worstVisiblePriceTick = levelList.back().first;
+    for (auto& x : isBuy ? this->bidOrderListByPriceTickMap : this->askOrderListByPriceTickMap) {
+      // a level beyond the visible depth keeps its estimate
+      if (isBuy ? x.first < worstVisiblePriceTick : x.first > worstVisiblePriceTick) {
+        continue;
+      }
+      int64_t displayedSize = this->getDisplayedSize(isBuy, x.first);
+      for (auto& order : x.second) {
+        order.queueAhead = std::min(order.queueAhead, displayedSize);
+      }
+    }
+  }
+  int64_t getDisplayedSize(bool isBuy, int64_t priceTick) const {
+    for (const auto& level : isBuy ? this->bidLevelList : this->askLevelList) {
+      if (level.first == priceTick) {
+        return level.second;
+      }
+    }
+    return 0;
+  }
+  void removeFilledOrders(bool isBuy, int64_t priceTick) {
+    auto& orderListByPriceTickMap = isBuy ? this->bidOrderListByPriceTickMap : this->askOrderListByPriceTickMap;
+    auto it = orderListByPriceTickMap.find(priceTick);
+    if (it == orderListByPriceTickMap.end()) {
+      return;
+    }
+    auto& orderList = it->second;
+    for (auto it2 = orderList.begin(); it2 != orderList.end();) {
+      if (it2->filledQuantity >= it2->quantity) {
+        it2 = this->eraseOrder(orderList, it2);
+      } else {
+        ++it2;
+      }
+    }
+    if (orderList.empty()) {
+      orderListByPriceTickMap.erase(it);
+    }
+  }
+  void fill(SimulatedOrder& order, int64_t priceTick, int64_t quantity, bool isMaker, const TimePoint& tp, std::vector<Event>& eventList) {
+    if (quantity <= 0) {
+      return;
+    }
+    order.filledQuantity += quantity;
+    order.status = order.filledQuantity >= order.quantity ? APP_EVENT_HANDLER_BASE_ORDER_STATUS_FILLED : APP_EVENT_HANDLER_BASE_ORDER_STATUS_PARTIALLY_FILLED;
+    // the fee is the only inexact quantity
+    double price = static_cast<double>(priceTick * this->priceIncrement.mantissa) / FixedPoint::powerOfTen(this->priceIncrement.scale);
+    double filledQuantity = static_cast<double>(quantity) / FixedPoint::powerOfTen(this->quantityScale);
+    const auto& feeAsset = isMaker ? (order.isBuy ? this->makerBuyerFeeAsset : this->makerSellerFeeAsset)
+                                   : (order.isBuy ? this->takerBuyerFeeAsset : this->takerSellerFeeAsset);
+    double feeRate = isMaker ? this->makerFee : this->takerFee;
+    double feeQuantity = 0;
+    if (UtilString::toLower(feeAsset) == UtilString::toLower(this->baseAsset)) {
+      feeQuantity = filledQuantity * feeRate;
+    } else if (UtilString::toLower(feeAsset) == UtilString::toLower(this->quoteAsset)) {
+      feeQuantity = price * filledQuantity * feeRate;
+    }
+    Event event;
+    event.setType(Event::Type::SUBSCRIPTION_DATA);
+    std::vector<Message> messageList;
+    {
+      Message message;
+      message.setType(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE);
+      message.setTime(tp);
+      message.setTimeReceived(tp);
+      message.setCorrelationIdList({PRIVATE_SUBSCRIPTION_DATA_CORRELATION_ID});
+      Element element;
+      element.insert(CCAPI_TRADE_ID, std::to_string(++this->virtualTradeId));
+      element.insert(CCAPI_EM_ORDER_LAST_EXECUTED_PRICE, this->tickToString(priceTick));
+      element.insert(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE, this->quantityToString(quantity));
+      element.insert(CCAPI_EM_ORDER_SIDE, order.isBuy ? CCAPI_EM_ORDER_SIDE_BUY : CCAPI_EM_ORDER_SIDE_SELL);
+      element.insert(CCAPI_IS_MAKER, isMaker ? "1" : "0");
+      element.insert(CCAPI_EM_ORDER_ID, order.orderId);
+      element.insert(CCAPI_EM_CLIENT_ORDER_ID, order.clientOrderId);
+      element.insert(CCAPI_EM_ORDER_FEE_QUANTITY, Decimal(UtilString::printDoubleScientific(feeQuantity)).toString());
+      element.insert(CCAPI_EM_ORDER_FEE_ASSET, feeAsset);
+      std::vector<Element> elementList;
+      elementList.emplace_back(std::move(element));
+      message.setElementList(elementList);
+      messageList.emplace_back(std::move(message));
+    }
+    messageList.emplace_back(this->toOrderUpdateMessage(order, tp));
+    event.setMessageList(messageList);
+    eventList.emplace_back(std::move(event));
+  }
+  Message toOrderUpdateMessage(const SimulatedOrder& order, const TimePoint& tp) const {
+    Message message;
+    message.setType(Message::Type::EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE);
+    message.setTime(tp);
+    message.setTimeReceived(tp);
+    message.setCorrelationIdList({PRIVATE_SUBSCRIPTION_DATA_CORRELATION_ID});
+    std::vector<Element> elementList;
+    elementList.emplace_back(this->toElement(order));
+    message.setElementList(elementList);
+    return message;
+  }
+  void appendOrderUpdateEvent(const SimulatedOrder& order, const TimePoint& tp, std::vector<Event>& eventList) const {
+    Event event;
+    event.setType(Event::Type::SUBSCRIPTION_DATA);
+    event.setMessageList({this->toOrderUpdateMessage(order, tp)});
+    eventList.emplace_back(std::move(event));
+  }
+  void appendResponseEvent(const Request& request, Message::Type messageType, const std::vector<Element>& elementList, const TimePoint& tp,
+                           std::vector<Event>& eventList) const {
+    Event event;
+    event.setType(Event::Type::RESPONSE);
+    Message message;
+    message.setType(messageType);
+    message.setTime(tp);
+    message.setTimeReceived(tp);
+    message.setCorrelationIdList({request.getCorrelationId()});
+    message.setElementList(elementList);
+    event.setMessageList({message});
+    eventList.emplace_back(std::move(event));
+  }
+  Element toElement(const SimulatedOrder& order) const {
+    Element element;
+    element.insert(CCAPI_EM_ORDER_ID, order.orderId);
+    element.insert(CCAPI_EM_CLIENT_ORDER_ID, order.clientOrderId);
+    element.insert(CCAPI_EM_ORDER_SIDE, order.isBuy ? CCAPI_EM_ORDER_SIDE_BUY : CCAPI_EM_ORDER_SIDE_SELL);
+    element.insert(CCAPI_EM_ORDER_LIMIT_PRICE, this->tickToString(order.priceTick));
+    element.insert(CCAPI_EM_ORDER_QUANTITY, this->quantityToString(order.quantity));
+    element.insert(CCAPI_EM_ORDER_CUMULATIVE_FILLED_QUANTITY, this->quantityToString(order.filledQuantity));
+    element.insert(CCAPI_EM_ORDER_REMAINING_QUANTITY, this->quantityToString(order.quantity - order.filledQuantity));
+    element.insert(CCAPI_EM_ORDER_STATUS, order.status);
+    return element;
+  }
+  std::string tickToString(int64_t priceTick) const { return FixedPoint::toString(priceTick * this->priceIncrement.mantissa, this->priceIncrement.scale); }
+  std::string quantityToString(int64_t quantity) const { return FixedPoint::toString(quantity, this->quantityScale); }
+  std::string baseAsset, quoteAsset;
+  FixedPoint priceIncrement;
+  int quantityScale{};
+  TimePoint now{std::chrono::seconds{0}}, lastArrivalTp{std::chrono::seconds{0}};
+  std::deque<PendingRequest> pendingRequestQueue;
+  // pairs of price tick and quantity, best levels first
+  std::vector<std::pair<int64_t, int64_t> > bidLevelList, askLevelList;
+  std::map<int64_t, std::list<SimulatedOrder> > bidOrderListByPriceTickMap, askOrderListByPriceTickMap;
+  std::unordered_map<std::string, Location> locationByOrderIdMap;
+  std::unordered_map<std::string, std::string> orderIdByClientOrderIdMap;
+  std::unique_ptr<std::mt19937> randomEnginePtr;
+  int64_t virtualOrderId{}, virtualTradeId{};
+};
+} /* namespace ccapi */
+#endif  // APP_INCLUDE_APP_SIMULATED_EXCHANGE_H_
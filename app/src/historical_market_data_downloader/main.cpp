@@ -0,0 +1,89 @@
+#include "app/historical_market_data_downloader.h"
+
+#include "ccapi_cpp/ccapi_session.h"
+namespace ccapi {
+AppLogger appLogger;
+AppLogger* AppLogger::logger = &appLogger;
+CcapiLogger ccapiLogger;
+Logger* Logger::logger = &ccapiLogger;
+} /* namespace ccapi */
+using ::ccapi::AppLogger;
+using ::ccapi::CcapiLogger;
+using ::ccapi::Event;
+using ::ccapi::HistoricalMarketDataDownloader;
+using ::ccapi::Logger;
+using ::ccapi::Message;
+using ::ccapi::Queue;
+using ::ccapi::Request;
+using ::ccapi::Session;
+using ::ccapi::SessionConfigs;
+using ::ccapi::SessionOptions;
+using ::ccapi::UtilString;
+using ::ccapi::UtilSystem;
+using ::ccapi::UtilTime;
+int main(int argc, char** argv) {
+  HistoricalMarketDataDownloader downloader;
+  downloader.exchange = UtilSystem::getEnvAsString("EXCHANGE");
+  downloader.instrument = UtilSystem::getEnvAsString("INSTRUMENT");
+  downloader.baseAsset = UtilSystem::getEnvAsString("BASE_ASSET_OVERRIDE");
+  downloader.quoteAsset = UtilSystem::getEnvAsString("QUOTE_ASSET_OVERRIDE");
+  downloader.historicalMarketDataStartDateTp = UtilTime::parse(UtilSystem::getEnvAsString("HISTORICAL_MARKET_DATA_START_DATE"));
+  downloader.historicalMarketDataEndDateTp = UtilTime::parse(UtilSystem::getEnvAsString("HISTORICAL_MARKET_DATA_END_DATE"));
+  downloader.historicalMarketDataDirectory = UtilSystem::getEnvAsString("HISTORICAL_MARKET_DATA_DIRECTORY");
+  downloader.historicalMarketDataFilePrefix = UtilSystem::getEnvAsString("HISTORICAL_MARKET_DATA_FILE_PREFIX");
+  downloader.historicalMarketDataFileSuffix = UtilSystem::getEnvAsString("HISTORICAL_MARKET_DATA_FILE_SUFFIX");
+  downloader.windowSeconds = UtilSystem::getEnvAsInt("WINDOW_SECONDS", 1800);
+  downloader.limit = UtilSystem::getEnvAsInt("LIMIT", 1000);
+  downloader.maxNumConcurrentRequest = UtilSystem::getEnvAsInt("MAX_NUM_CONCURRENT_REQUEST", 8);
+  downloader.maxNumRetry = UtilSystem::getEnvAsInt("MAX_NUM_RETRY", 5);
+  downloader.retryDelayMilliseconds = UtilSystem::getEnvAsInt("RETRY_DELAY_MILLISECONDS", 1000);
+  downloader.candlestickIntervalSeconds = UtilSystem::getEnvAsInt("CANDLESTICK_INTERVAL_SECONDS", 60);
+  if (UtilString::toLower(UtilSystem::getEnvAsString("DATA_TYPE", "trade")) == "candlestick") {
+    downloader.operation = Request::Operation::GET_HISTORICAL_CANDLESTICKS;
+  } else if (downloader.exchange.rfind("binance", 0) == 0) {
+    downloader.operation = Request::Operation::GET_HISTORICAL_AGG_TRADES;
+  } else {
+    downloader.operation = Request::Operation::GET_HISTORICAL_TRADES;
+    if (downloader.exchange == "okx") {
+      downloader.param = {
+          {"type", "2"},
+      };
+    }
+  }
+  SessionOptions sessionOptions;
+  sessionOptions.enableRateLimiter = true;
+  sessionOptions.httpConnectionPoolMaxSize = downloader.maxNumConcurrentRequest;
+  SessionConfigs sessionConfigs;
+  Session session(sessionOptions, sessionConfigs);
+  if (downloader.baseAsset.empty() || downloader.quoteAsset.empty()) {
+    Request request(Request::Operation::GET_INSTRUMENT, downloader.exchange, downloader.instrument, "GET_INSTRUMENT");
+    if (downloader.exchange == "okx") {
+      request.appendParam({
+          {"instType", "SPOT"},
+      });
+    }
+    Queue<Event> eventQueue;
+    session.sendRequest(request, &eventQueue);
+    for (const auto& event : eventQueue.purge()) {
+      for (const auto& message : event.getMessageList()) {
+        if (message.getType() == Message::Type::GET_INSTRUMENT && !message.getElementList().empty()) {
+          const auto& element = message.getElementList().at(0);
+          downloader.baseAsset = element.getValue(CCAPI_BASE_ASSET);
+          downloader.quoteAsset = element.getValue(CCAPI_QUOTE_ASSET);
+        }
+      }
+    }
+    if (downloader.baseAsset.empty() || downloader.quoteAsset.empty()) {
+      APP_LOGGER_ERROR("Unable to get the base asset and the quote asset of " + downloader.instrument +
+                       ". Please set BASE_ASSET_OVERRIDE and QUOTE_ASSET_OVERRIDE.");
+      session.stop();
+      return EXIT_FAILURE;
+    }
+  }
+  auto startTp = UtilTime::now();
+  int numFileWritten = downloader.download(session);
+  APP_LOGGER_INFO("Wrote " + std::to_string(numFileWritten) + " files in " +
+                  std::to_string(std::chrono::duration_cast<std::chrono::seconds>(UtilTime::now() - startTp).count()) + " seconds.");
+  session.stop();
+  return EXIT_SUCCESS;
+}
@@ -48,6 +48,8 @@ int main(int argc, char** argv) {
   eventHandler.privateDataFilePrefix = UtilSystem::getEnvAsString("PRIVATE_DATA_FILE_PREFIX");
   eventHandler.privateDataFileSuffix = UtilSystem::getEnvAsString("PRIVATE_DATA_FILE_SUFFIX");
   eventHandler.privateDataOnlySaveFinalSummary = UtilString::toLower(UtilSystem::getEnvAsString("PRIVATE_DATA_ONLY_SAVE_FINAL_SUMMARY")) == "true";
+  eventHandler.privateDataSaveBinary = UtilString::toLower(UtilSystem::getEnvAsString("PRIVATE_DATA_SAVE_BINARY")) == "true";
+  eventHandler.privateDataFsyncIntervalMilliseconds = UtilSystem::getEnvAsInt("PRIVATE_DATA_FSYNC_INTERVAL_MILLISECONDS", -1);
   eventHandler.clockStepMilliseconds = UtilSystem::getEnvAsInt("CLOCK_STEP_MILLISECONDS", 1000);
   eventHandler.baseAsset = UtilSystem::getEnvAsString("BASE_ASSET_OVERRIDE");
   eventHandler.quoteAsset = UtilSystem::getEnvAsString("QUOTE_ASSET_OVERRIDE");
@@ -98,6 +100,11 @@ int main(int argc, char** argv) {
     eventHandler.baseBalance = eventHandler.totalTargetQuantity;
     eventHandler.quoteBalance = eventHandler.quoteTotalTargetQuantity;
     eventHandler.marketImpfactFactor = UtilSystem::getEnvAsDouble("MARKET_IMPACT_FACTOR");
+    eventHandler.enableSimulatedExchange = UtilString::toLower(UtilSystem::getEnvAsString("ENABLE_SIMULATED_EXCHANGE")) == "true";
+    eventHandler.simulatedOrderEntryLatencyMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_ORDER_ENTRY_LATENCY_MICROSECONDS");
+    eventHandler.simulatedOrderEntryLatencyJitterMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_ORDER_ENTRY_LATENCY_JITTER_MICROSECONDS");
+    eventHandler.simulatedMarketDataLatencyMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_MARKET_DATA_LATENCY_MICROSECONDS");
+    eventHandler.simulatedMarketDataLatencyJitterMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_MARKET_DATA_LATENCY_JITTER_MICROSECONDS");
   }
   if (eventHandler.tradingMode == EventHandlerBase::TradingMode::BACKTEST) {
     eventHandler.historicalMarketDataStartDateTp = UtilTime::parse(UtilSystem::getEnvAsString("HISTORICAL_MARKET_DATA_START_DATE"));
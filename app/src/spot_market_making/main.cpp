@@ -62,6 +62,8 @@ int main(int argc, char** argv) {
   eventHandler.privateDataFilePrefix = UtilSystem::getEnvAsString("PRIVATE_DATA_FILE_PREFIX");
   eventHandler.privateDataFileSuffix = UtilSystem::getEnvAsString("PRIVATE_DATA_FILE_SUFFIX");
   eventHandler.privateDataOnlySaveFinalSummary = UtilString::toLower(UtilSystem::getEnvAsString("PRIVATE_DATA_ONLY_SAVE_FINAL_SUMMARY")) == "true";
+  eventHandler.privateDataSaveBinary = UtilString::toLower(UtilSystem::getEnvAsString("PRIVATE_DATA_SAVE_BINARY")) == "true";
+  eventHandler.privateDataFsyncIntervalMilliseconds = UtilSystem::getEnvAsInt("PRIVATE_DATA_FSYNC_INTERVAL_MILLISECONDS", -1);
   eventHandler.killSwitchMaximumDrawdown = UtilSystem::getEnvAsDouble("KILL_SWITCH_MAXIMUM_DRAWDOWN");
   eventHandler.clockStepMilliseconds = UtilSystem::getEnvAsInt("CLOCK_STEP_MILLISECONDS", 1000);
   eventHandler.enableAdverseSelectionGuard = UtilString::toLower(UtilSystem::getEnvAsString("ENABLE_ADVERSE_SELECTION_GUARD")) == "true";
@@ -145,6 +147,11 @@ int main(int argc, char** argv) {
     eventHandler.baseBalance = UtilSystem::getEnvAsDouble("INITIAL_BASE_BALANCE") * eventHandler.baseAvailableBalanceProportion;
     eventHandler.quoteBalance = UtilSystem::getEnvAsDouble("INITIAL_QUOTE_BALANCE") * eventHandler.quoteAvailableBalanceProportion;
     eventHandler.marketImpfactFactor = UtilSystem::getEnvAsDouble("MARKET_IMPACT_FACTOR");
+    eventHandler.enableSimulatedExchange = UtilString::toLower(UtilSystem::getEnvAsString("ENABLE_SIMULATED_EXCHANGE")) == "true";
+    eventHandler.simulatedOrderEntryLatencyMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_ORDER_ENTRY_LATENCY_MICROSECONDS");
+    eventHandler.simulatedOrderEntryLatencyJitterMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_ORDER_ENTRY_LATENCY_JITTER_MICROSECONDS");
+    eventHandler.simulatedMarketDataLatencyMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_MARKET_DATA_LATENCY_MICROSECONDS");
+    eventHandler.simulatedMarketDataLatencyJitterMicroseconds = UtilSystem::getEnvAsInt("SIMULATED_MARKET_DATA_LATENCY_JITTER_MICROSECONDS");
   }
   if (eventHandler.tradingMode == EventHandlerBase::TradingMode::BACKTEST) {
     eventHandler.historicalMarketDataStartDateTp = UtilTime::parse(UtilSystem::getEnvAsString("HISTORICAL_MARKET_DATA_START_DATE"));
@@ -0,0 +1,24 @@
+import time
+from ccapi import SessionOptions, SessionConfigs, Session, Subscription, EventBatch
+
+if __name__ == "__main__":
+    option = SessionOptions()
+    config = SessionConfigs()
+    session = Session(option, config)
+    subscriptionList = [Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=10"), Subscription("okx", "BTC-USDT", "TRADE")]
+    for subscription in subscriptionList:
+        session.subscribe(subscription)
+    batch = EventBatch()
+    startTime = time.time()
+    while time.time() - startTime < 10:
+        # The GIL is released while the batch is filled.
+        numEvent = batch.drain(session.getEventQueue(), 1000)
+        # The columns are memoryviews of the batch's own memory, e.g. numpy.asarray(batch.depthPrice()). They have to be released before the next drain.
+        with batch.depthPrice() as depthPrice, batch.tradePrice() as tradePrice, batch.tradeCorrelationIdIndex() as tradeCorrelationIdIndex:
+            print(f"Drained {numEvent} events: {len(depthPrice)} market depth levels, {len(tradePrice)} trades")
+            if len(tradePrice) > 0:
+                print(f"  last trade of {batch.getCorrelationIdList()[tradeCorrelationIdIndex[-1]]} at price {tradePrice[-1]}")
+        for event in batch.getOtherEventList():
+            print(f"Received an event:\n{event.toStringPretty(2, 2)}")
+    session.stop()
+    print("Bye")
@@ -0,0 +1,171 @@
+// The columns of an EventBatch as typed, read-only memoryviews of the batch's own memory (e.g. numpy.asarray(batch.depthPrice())), instead of element by
+// element copies. A memoryview is exported by a small object that keeps the batch alive and holds its columns, so drain raises instead of overwriting them
+// until every view of them (and every array made from one) has been released; copy them to keep them across drains. These functions build Python objects and
+// so have to hold the GIL, whereas drain releases it like every other wrapped call.
+%{
+struct CcapiEventBatchColumn {
+  PyObject_HEAD
+  PyObject* owner;
+  ccapi::EventBatch* batchPtr;
+  const void* columnPtr;
+  void (*getData)(const void* columnPtr, void*& data, Py_ssize_t& numItem);
+  Py_ssize_t itemSize;
+  const char* format;
+  Py_ssize_t shape;
+};
+template <class T>
+static void ccapiEventBatchColumnGetData(const void* columnPtr, void*& data, Py_ssize_t& numItem) {
+  const auto& column = *static_cast<const std::vector<T>*>(columnPtr);
+  data = const_cast<T*>(column.data());
+  numItem = column.size();
+}
+static int ccapiEventBatchColumnGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  auto self = reinterpret_cast<CcapiEventBatchColumn*>(exporter);
+  view->obj = nullptr;
+  if (flags & PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "the columns of an EventBatch are read-only");
+    return -1;
+  }
+  if (!self->batchPtr->holdColumns()) {
+    PyErr_SetString(PyExc_BufferError, "the EventBatch is being drained");
+    return -1;
+  }
+  static char empty;
+  void* data;
+  self->getData(self->columnPtr, data, self->shape);
+  view->buf = self->shape > 0 ? data : &empty;
+  view->obj = exporter;
+  Py_INCREF(exporter);
+  view->len = self->shape * self->itemSize;
+  view->readonly = 1;
+  view->itemsize = self->itemSize;
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(self->format) : nullptr;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) ? &self->shape : nullptr;
+  view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &self->itemSize : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+static void ccapiEventBatchColumnReleaseBuffer(PyObject* exporter, Py_buffer* view) {
+  reinterpret_cast<CcapiEventBatchColumn*>(exporter)->batchPtr->releaseColumns();
+}
+static void ccapiEventBatchColumnDealloc(PyObject* exporter) {
+  Py_XDECREF(reinterpret_cast<CcapiEventBatchColumn*>(exporter)->owner);
+  PyObject_Del(exporter);
+}
+static PyTypeObject* ccapiEventBatchColumnType() {
+  static PyBufferProcs bufferProcs{ccapiEventBatchColumnGetBuffer, ccapiEventBatchColumnReleaseBuffer};
+  static PyTypeObject type{PyVarObject_HEAD_INIT(nullptr, 0)};
+  if (!type.tp_name) {
+    type.tp_name = "ccapi.EventBatchColumn";
+    type.tp_basicsize = sizeof(CcapiEventBatchColumn);
+    type.tp_dealloc = ccapiEventBatchColumnDealloc;
+    type.tp_as_buffer = &bufferProcs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    if (PyType_Ready(&type) < 0) {
+      type.tp_name = nullptr;
+      return nullptr;
+    }
+  }
+  return &type;
+}
+// owner is the Python object of the batch
+template <class T>
+static PyObject* ccapiMemoryView(PyObject* owner, ccapi::EventBatch* batchPtr, const std::vector<T>& column, const char* format) {
+  PyTypeObject* type = ccapiEventBatchColumnType();
+  if (!type) {
+    return nullptr;
+  }
+  auto exporter = PyObject_New(CcapiEventBatchColumn, type);
+  if (!exporter) {
+    return nullptr;
+  }
+  Py_INCREF(owner);
+  exporter->owner = owner;
+  exporter->batchPtr = batchPtr;
+  exporter->columnPtr = &column;
+  exporter->getData = ccapiEventBatchColumnGetData<T>;
+  exporter->itemSize = sizeof(T);
+  exporter->format = format;
+  exporter->shape = 0;
+  PyObject* memoryView = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(exporter));
+  Py_DECREF(exporter);
+  return memoryView;
+}
+%}
+%feature("nothread") ccapi::EventBatch::_depthMessageIndex;
+%feature("nothread") ccapi::EventBatch::_depthCorrelationIdIndex;
+%feature("nothread") ccapi::EventBatch::_depthTime;
+%feature("nothread") ccapi::EventBatch::_depthTimeReceived;
+%feature("nothread") ccapi::EventBatch::_depthSide;
+%feature("nothread") ccapi::EventBatch::_depthLevel;
+%feature("nothread") ccapi::EventBatch::_depthPrice;
+%feature("nothread") ccapi::EventBatch::_depthSize;
+%feature("nothread") ccapi::EventBatch::_tradeCorrelationIdIndex;
+%feature("nothread") ccapi::EventBatch::_tradeTime;
+%feature("nothread") ccapi::EventBatch::_tradeTimeReceived;
+%feature("nothread") ccapi::EventBatch::_tradePrice;
+%feature("nothread") ccapi::EventBatch::_tradeSize;
+%feature("nothread") ccapi::EventBatch::_tradeIsBuyerMaker;
+%ignore ccapi::EventBatch::holdColumns;
+%ignore ccapi::EventBatch::releaseColumns;
+%extend ccapi::EventBatch {
+  PyObject* _depthMessageIndex(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthMessageIndex(), "i"); }
+  PyObject* _depthCorrelationIdIndex(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthCorrelationIdIndex(), "i"); }
+  PyObject* _depthTime(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthTime(), "q"); }
+  PyObject* _depthTimeReceived(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthTimeReceived(), "q"); }
+  PyObject* _depthSide(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthSide(), "i"); }
+  PyObject* _depthLevel(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthLevel(), "i"); }
+  PyObject* _depthPrice(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthPrice(), "d"); }
+  PyObject* _depthSize(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getDepthSize(), "d"); }
+  PyObject* _tradeCorrelationIdIndex(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getTradeCorrelationIdIndex(), "i"); }
+  PyObject* _tradeTime(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getTradeTime(), "q"); }
+  PyObject* _tradeTimeReceived(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getTradeTimeReceived(), "q"); }
+  PyObject* _tradePrice(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getTradePrice(), "d"); }
+  PyObject* _tradeSize(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getTradeSize(), "d"); }
+  PyObject* _tradeIsBuyerMaker(PyObject* owner) { return ccapiMemoryView(owner, $self, $self->getTradeIsBuyerMaker(), "i"); }
+  %pythoncode %{
+    def depthMessageIndex(self):
+        return self._depthMessageIndex(self)
+
+    def depthCorrelationIdIndex(self):
+        return self._depthCorrelationIdIndex(self)
+
+    def depthTime(self):
+        return self._depthTime(self)
+
+    def depthTimeReceived(self):
+        return self._depthTimeReceived(self)
+
+    def depthSide(self):
+        return self._depthSide(self)
+
+    def depthLevel(self):
+        return self._depthLevel(self)
+
+    def depthPrice(self):
+        return self._depthPrice(self)
+
+    def depthSize(self):
+        return self._depthSize(self)
+
+    def tradeCorrelationIdIndex(self):
+        return self._tradeCorrelationIdIndex(self)
+
+    def tradeTime(self):
+        return self._tradeTime(self)
+
+    def tradeTimeReceived(self):
+        return self._tradeTimeReceived(self)
+
+    def tradePrice(self):
+        return self._tradePrice(self)
+
+    def tradeSize(self):
+        return self._tradeSize(self)
+
+    def tradeIsBuyerMaker(self):
+        return self._tradeIsBuyerMaker(self)
+  %}
+}
@@ -0,0 +1,459 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_BAR_AGGREGATOR_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_BAR_AGGREGATOR_H_
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_decimal.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * A non-negative decimal number held as an integer mantissa and a number of fractional digits, e.g. "12.34" is {1234, 2}. Exchanges quote prices and sizes
+ * with a fixed number of decimals, so arithmetic on this type is exact and cheap as long as the result fits into 64 bits. Every operation that could exceed
+ * 64 bits is checked and reports the overflow instead of wrapping around.
+ */
+struct FixedPoint {
+  int64_t mantissa{};
+  int scale{};
+  // returns false, leaving output untouched, if the value is negative, isn't a decimal number or has more significant digits (or decimals) than an int64_t
+  // always holds
+  static bool parse(const std::string& value, FixedPoint& output) {
+    if (value.find_first_of("eE") != std::string::npos) {
+      try {
+        return parse(Decimal(value).toString(), output);
+      } catch (const std::exception&) {
+        return false;
+      }
+    }
+    size_t end = value.length();
+    auto foundDot = value.find('.');
+    if (foundDot != std::string::npos) {
+      while (end > foundDot + 1 && value[end - 1] == '0') {
+        --end;
+      }
+    }
+    FixedPoint x;
+    int numDigit = 0;
+    int numSignificantDigit = 0;
+    for (size_t i = 0; i < end; ++i) {
+      char c = value[i];
+      if (c >= '0' && c <= '9') {
+        ++numDigit;
+        if (numSignificantDigit > 0 || c != '0') {
+          if (++numSignificantDigit > std::numeric_limits<int64_t>::digits10) {
+            return false;
+          }
+        }
+        x.mantissa = x.mantissa * 10 + (c - '0');
+        if (foundDot != std::string::npos && i > foundDot) {
+          ++x.scale;
+        }
+      } else if (!(c == '+' && i == 0) && i != foundDot) {
+        return false;
+      }
+    }
+    if (numDigit == 0 || x.scale > std::numeric_limits<int64_t>::digits10) {
+      return false;
+    }
+    output = x;
+    return true;
+  }
+  static FixedPoint parse(const std::string& value) {
+    FixedPoint output;
+    if (!parse(value, output)) {
+      throw std::invalid_argument("not a non-negative decimal of at most " + std::to_string(std::numeric_limits<int64_t>::digits10) +
+                                  " significant digits: " + value);
+    }
+    return output;
+  }
+  // exponent must be between 0 and 18
+  static int64_t powerOfTen(int exponent) {
+    int64_t output = 1;
+    for (int i = 0; i < exponent; ++i) {
+      output *= 10;
+    }
+    return output;
+  }
+  // the checked arithmetic on non-negative operands: returns false, leaving output untouched, on overflow
+  static bool multiply(int64_t a, int64_t b, int64_t& output) {
+#if defined(__GNUC__) || defined(__clang__)
+    int64_t x;
+    if (__builtin_mul_overflow(a, b, &x)) {
+      return false;
+    }
+    output = x;
+    return true;
+#else
+    if (b != 0 && a > std::numeric_limits<int64_t>::max() / b) {
+      return false;
+    }
+    output = a * b;
+    return true;
+#endif
+  }
+  static bool add(int64_t a, int64_t b, int64_t& output) {
+#if defined(__GNUC__) || defined(__clang__)
+    int64_t x;
+    if (__builtin_add_overflow(a, b, &x)) {
+      return false;
+    }
+    output = x;
+    return true;
+#else
+    if (a > std::numeric_limits<int64_t>::max() - b) {
+      return false;
+    }
+    output = a + b;
+    return true;
+#endif
+  }
+  // the mantissa at newScale: exact when scaling up (or false on overflow), truncated when scaling down
+  static bool rescale(int64_t mantissa, int scale, int newScale, int64_t& output) {
+    if (newScale >= scale) {
+      return newScale - scale <= std::numeric_limits<int64_t>::digits10 && multiply(mantissa, powerOfTen(newScale - scale), output);
+    }
+    output = scale - newScale <= std::numeric_limits<int64_t>::digits10 ? mantissa / powerOfTen(scale - newScale) : 0;
+    return true;
+  }
+  bool rescale(int newScale, FixedPoint& output) const {
+    int64_t x;
+    if (!rescale(this->mantissa, this->scale, std::max(newScale, this->scale), x)) {
+      return false;
+    }
+    output = {x, std::max(newScale, this->scale)};
+    return true;
+  }
+  // compares by value regardless of scale; a side that overflows at the common scale is the larger one
+  int compare(const FixedPoint& x) const {
+    int scale = std::max(this->scale, x.scale);
+    FixedPoint l, r;
+    if (!this->rescale(scale, l)) {
+      return 1;
+    }
+    if (!x.rescale(scale, r)) {
+      return -1;
+    }
+    return l.mantissa < r.mantissa ? -1 : l.mantissa > r.mantissa ? 1 : 0;
+  }
+  std::string toString() const { return toString(this->mantissa, this->scale); }
+  static std::string toString(int64_t mantissa, int scale) {
+    std::string output = std::to_string(mantissa);
+    if (scale > 0) {
+      if (output.length() <= static_cast<size_t>(scale)) {
+        output.insert(0, scale + 1 - output.length(), '0');
+      }
+      output.insert(output.length() - scale, 1, '.');
+      output.erase(output.find_last_not_of('0') + 1);
+      if (output.back() == '.') {
+        output.pop_back();
+      }
+    } else if (scale < 0 && mantissa != 0) {
+      output.append(-scale, '0');
+    }
+    return output;
+  }
+};
+/**
+ * Open, high, low, close, volume, quote volume, VWAP and trade count of a series of trades. Prices and sizes are accumulated in fixed point: each bar adopts
+ * the largest number of decimals that it has seen so far, so an update costs a few integer operations and never loses precision. The quote volume is the one
+ * exception: once it would no longer fit into 64 bits at the price decimals plus the size decimals, it drops its least significant decimals instead.
+ */
+class Bar CCAPI_FINAL {
+ public:
+  // returns false, leaving the bar untouched, if the trade's price or size can't be represented at the decimals of the bar or its volume would overflow
+  bool update(const TimePoint& tp, const FixedPoint& price, const FixedPoint& size) { return this->update(tp, price, size, nullptr); }
+  // also keeps the price as the exchange formatted it (e.g. with trailing zeros), so that getOpen, getHigh, getLow and getClose return the exchange's strings
+  bool update(const TimePoint& tp, const FixedPoint& price, const FixedPoint& size, const std::string& priceString) {
+    return this->update(tp, price, size, &priceString);
+  }
+  void reset() { *this = Bar(); }
+  bool empty() const { return this->tradeCount == 0; }
+  std::string getOpen() const { return this->openString.empty() ? FixedPoint::toString(this->open, this->priceScale) : this->openString; }
+  std::string getHigh() const { return this->highString.empty() ? FixedPoint::toString(this->high, this->priceScale) : this->highString; }
+  std::string getLow() const { return this->lowString.empty() ? FixedPoint::toString(this->low, this->priceScale) : this->lowString; }
+  std::string getClose() const { return this->closeString.empty() ? FixedPoint::toString(this->close, this->priceScale) : this->closeString; }
+  std::string getVolume() const { return FixedPoint::toString(this->volume, this->sizeScale); }
+  std::string getQuoteVolume() const { return FixedPoint::toString(this->quoteVolume, this->quoteVolumeScale); }
+  // quote volume divided by volume, truncated to numExtraDigit more decimals than the quote volume has over the sizes (normally the prices' decimals)
+  std::string getVwap(int numExtraDigit = 4) const {
+    if (this->volume == 0) {
+      return CCAPI_CANDLESTICK_EMPTY;
+    }
+    int64_t quotient = this->quoteVolume / this->volume;
+    int64_t remainder = this->quoteVolume % this->volume;
+    int scale = this->quoteVolumeScale - this->sizeScale;
+    for (int i = 0; i < numExtraDigit && remainder != 0 && remainder <= INT64_MAX / 10 && quotient <= INT64_MAX / 10; ++i) {
+      remainder *= 10;
+      quotient = quotient * 10 + remainder / this->volume;
+      remainder %= this->volume;
+      ++scale;
+    }
+    return FixedPoint::toString(quotient, scale);
+  }
+  FixedPoint getVolumeFixedPoint() const { return {this->volume, this->sizeScale}; }
+  FixedPoint getQuoteVolumeFixedPoint() const { return {this->quoteVolume, this->quoteVolumeScale}; }
+  int64_t getTradeCount() const { return tradeCount; }
+  const TimePoint& getOpenTime() const { return openTime; }
+  const TimePoint& getCloseTime() const { return closeTime; }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  // priceStringPtr is null if the exchange's string of the price isn't kept
+  bool update(const TimePoint& tp, const FixedPoint& price, const FixedPoint& size, const std::string* priceStringPtr) {
+    int priceScale = std::max(this->priceScale, price.scale);
+    int sizeScale = std::max(this->sizeScale, size.scale);
+    int64_t p, s, high, volume;
+    // the other prices are non-negative and at most the high, so they fit whenever the high does
+    if (!FixedPoint::rescale(price.mantissa, price.scale, priceScale, p) || !FixedPoint::rescale(size.mantissa, size.scale, sizeScale, s) ||
+        !FixedPoint::rescale(this->high, this->priceScale, priceScale, high) || !FixedPoint::rescale(this->volume, this->sizeScale, sizeScale, volume) ||
+        !FixedPoint::add(volume, s, volume)) {
+      return false;
+    }
+    int64_t quoteVolume;
+    int quoteVolumeScale;
+    if (!this->addQuoteVolume(p, s, priceScale + sizeScale, quoteVolume, quoteVolumeScale)) {
+      return false;
+    }
+    if (priceScale > this->priceScale) {
+      int64_t factor = FixedPoint::powerOfTen(priceScale - this->priceScale);
+      this->open *= factor;
+      this->low *= factor;
+      this->close *= factor;
+      this->priceScale = priceScale;
+    }
+    this->high = high;
+    if (this->tradeCount == 0) {
+      this->open = p;
+      this->high = p;
+      this->low = p;
+      this->openTime = tp;
+      if (priceStringPtr) {
+        this->openString = *priceStringPtr;
+        this->highString = *priceStringPtr;
+        this->lowString = *priceStringPtr;
+      }
+    } else {
+      if (p > this->high) {
+        this->high = p;
+        if (priceStringPtr) {
+          this->highString = *priceStringPtr;
+        }
+      }
+      if (p < this->low) {
+        this->low = p;
+        if (priceStringPtr) {
+          this->lowString = *priceStringPtr;
+        }
+      }
+    }
+    this->close = p;
+    if (priceStringPtr) {
+      this->closeString = *priceStringPtr;
+    }
+    this->closeTime = tp;
+    this->volume = volume;
+    this->sizeScale = sizeScale;
+    this->quoteVolume = quoteVolume;
+    this->quoteVolumeScale = quoteVolumeScale;
+    ++this->tradeCount;
+    return true;
+  }
+  // the quote volume plus p * s, where p * s has productScale decimals, at as many decimals as fit into 64 bits; false if not even an integer fits
+  bool addQuoteVolume(int64_t p, int64_t s, int productScale, int64_t& output, int& outputScale) const {
+    int64_t product;
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 wideProduct = static_cast<unsigned __int128>(p) * static_cast<unsigned __int128>(s);
+    while (wideProduct > static_cast<unsigned __int128>(std::numeric_limits<int64_t>::max())) {
+      wideProduct /= 10;
+      --productScale;
+    }
+    product = static_cast<int64_t>(wideProduct);
+#else
+    while (!FixedPoint::multiply(p, s, product)) {
+      if (p > s) {
+        p /= 10;
+      } else {
+        s /= 10;
+      }
+      --productScale;
+    }
+#endif
+    for (int scale = std::max(this->quoteVolumeScale, productScale); scale >= 0; --scale) {
+      int64_t x, y;
+      if (FixedPoint::rescale(this->quoteVolume, this->quoteVolumeScale, scale, x) && FixedPoint::rescale(product, productScale, scale, y) &&
+          FixedPoint::add(x, y, output)) {
+        outputScale = scale;
+        return true;
+      }
+    }
+    return false;
+  }
+  int64_t open{};
+  int64_t high{};
+  int64_t low{};
+  int64_t close{};
+  int priceScale{};
+  int64_t volume{};
+  int sizeScale{};
+  int64_t quoteVolume{};
+  int quoteVolumeScale{};
+  int64_t tradeCount{};
+  TimePoint openTime{std::chrono::seconds{0}};
+  TimePoint closeTime{std::chrono::seconds{0}};
+  std::string openString;
+  std::string highString;
+  std::string lowString;
+  std::string closeString;
+};
+/**
+ * Maintains several bars of one instrument at once. A time bar closes when a trade falls into a later interval (or when flushed past its end), a volume bar
+ * once its volume reaches the threshold and a dollar bar once its quote volume reaches the threshold. Bars are specified as a comma separated list, e.g.
+ * "1s,1m,5m,volume:100,dollar:1000000", where a time interval is a number followed by one of "ms", "s", "m", "h" or "d".
+ */
+class BarAggregator CCAPI_FINAL {
+ public:
+  enum class Type {
+    TIME,
+    VOLUME,
+    DOLLAR,
+  };
+  struct Spec {
+    std::string name;
+    Type type{Type::TIME};
+    int64_t intervalMilliseconds{};
+    FixedPoint threshold;
+  };
+  struct ClosedBar {
+    std::string specName;
+    // the start of the interval for a time bar, the time of the first trade otherwise
+    TimePoint startTime{std::chrono::seconds{0}};
+    Bar bar;
+  };
+  static std::vector<Spec> parseSpecList(const std::string& input) {
+    std::vector<Spec> specList;
+    for (const auto& x : UtilString::split(input, ",")) {
+      if (x.empty()) {
+        continue;
+      }
+      Spec spec;
+      spec.name = x;
+      auto foundColon = x.find(':');
+      if (foundColon != std::string::npos) {
+        auto type = x.substr(0, foundColon);
+        if (type == "volume") {
+          spec.type = Type::VOLUME;
+        } else if (type == "dollar") {
+          spec.type = Type::DOLLAR;
+        } else {
+          CCAPI_LOGGER_FATAL("unsupported bar type " + type);
+        }
+        if (!FixedPoint::parse(x.substr(foundColon + 1), spec.threshold) || spec.threshold.mantissa <= 0) {
+          CCAPI_LOGGER_FATAL("bar threshold must be positive: " + x);
+        }
+      } else {
+        auto foundUnit = x.find_first_not_of("0123456789");
+        if (foundUnit == 0 || foundUnit == std::string::npos) {
+          CCAPI_LOGGER_FATAL("bar interval must have a unit: " + x);
+        }
+        auto unit = x.substr(foundUnit);
+        int64_t multiplier = unit == "ms" ? 1 : unit == "s" ? 1000 : unit == "m" ? 60000 : unit == "h" ? 3600000 : unit == "d" ? 86400000 : 0;
+        if (multiplier == 0) {
+          CCAPI_LOGGER_FATAL("unsupported bar interval unit " + unit);
+        }
+        spec.intervalMilliseconds = std::stoll(x.substr(0, foundUnit)) * multiplier;
+        if (spec.intervalMilliseconds <= 0) {
+          CCAPI_LOGGER_FATAL("bar interval must be positive: " + x);
+        }
+      }
+      specList.push_back(spec);
+    }
+    return specList;
+  }
+  explicit BarAggregator(const std::vector<Spec>& specList = {}) : specList(specList), barList(specList.size()), intervalIndexList(specList.size()) {}
+  // closed bars are appended to closedBarList in the order in which they closed
+  void update(const TimePoint& tp, const std::string& price, const std::string& size, std::vector<ClosedBar>& closedBarList) {
+    FixedPoint x, y;
+    if (!FixedPoint::parse(price, x) || !FixedPoint::parse(size, y)) {
+      CCAPI_LOGGER_WARN("skipped a trade that can't be aggregated: price = " + price + ", size = " + size);
+      return;
+    }
+    this->update(tp, x, y, closedBarList);
+  }
+  void update(const TimePoint& tp, const FixedPoint& price, const FixedPoint& size, std::vector<ClosedBar>& closedBarList) {
+    for (size_t i = 0; i < this->specList.size(); ++i) {
+      const auto& spec = this->specList[i];
+      auto& bar = this->barList[i];
+      if (spec.type == Type::TIME) {
+        int64_t intervalIndex = this->getIntervalIndex(tp, spec.intervalMilliseconds);
+        if (!bar.empty() && intervalIndex != this->intervalIndexList[i]) {
+          this->close(i, closedBarList);
+        }
+        this->intervalIndexList[i] = intervalIndex;
+        if (!bar.update(tp, price, size)) {
+          CCAPI_LOGGER_WARN("skipped a trade that overflows bar " + spec.name + ": price = " + price.toString() + ", size = " + size.toString());
+        }
+      } else {
+        if (!bar.update(tp, price, size)) {
+          CCAPI_LOGGER_WARN("skipped a trade that overflows bar " + spec.name + ": price = " + price.toString() + ", size = " + size.toString());
+        }
+        const FixedPoint& accumulated = spec.type == Type::VOLUME ? bar.getVolumeFixedPoint() : bar.getQuoteVolumeFixedPoint();
+        if (accumulated.compare(spec.threshold) >= 0) {
+          this->close(i, closedBarList);
+        }
+      }
+    }
+  }
+  // closes the time bars whose interval ended at or before now
+  void flush(const TimePoint& now, std::vector<ClosedBar>& closedBarList) {
+    for (size_t i = 0; i < this->specList.size(); ++i) {
+      const auto& spec = this->specList[i];
+      if (spec.type == Type::TIME && !this->barList[i].empty() && this->getIntervalIndex(now, spec.intervalMilliseconds) > this->intervalIndexList[i]) {
+        this->close(i, closedBarList);
+      }
+    }
+  }
+  // the earliest end of the interval of an open time bar, i.e. when flush has something to close, or TimePoint::max() if there is none
+  TimePoint getNextFlushTp() const {
+    TimePoint output = TimePoint::max();
+    for (size_t i = 0; i < this->specList.size(); ++i) {
+      const auto& spec = this->specList[i];
+      if (spec.type == Type::TIME && !this->barList[i].empty()) {
+        output = std::min(output, TimePoint(std::chrono::milliseconds((this->intervalIndexList[i] + 1) * spec.intervalMilliseconds)));
+      }
+    }
+    return output;
+  }
+  const std::vector<Spec>& getSpecList() const { return specList; }
+  const std::vector<Bar>& getBarList() const { return barList; }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  int64_t getIntervalIndex(const TimePoint& tp, int64_t intervalMilliseconds) const {
+    int64_t milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+    return milliseconds >= 0 ? milliseconds / intervalMilliseconds : -((-milliseconds + intervalMilliseconds - 1) / intervalMilliseconds);
+  }
+  void close(size_t i, std::vector<ClosedBar>& closedBarList) {
+    const auto& spec = this->specList[i];
+    auto& bar = this->barList[i];
+    ClosedBar closedBar;
+    closedBar.specName = spec.name;
+    closedBar.startTime =
+        spec.type == Type::TIME ? TimePoint(std::chrono::milliseconds(this->intervalIndexList[i] * spec.intervalMilliseconds)) : bar.getOpenTime();
+    closedBar.bar = bar;
+    closedBarList.push_back(std::move(closedBar));
+    bar.reset();
+  }
+  std::vector<Spec> specList;
+  std::vector<Bar> barList;
+  std::vector<int64_t> intervalIndexList;
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_BAR_AGGREGATOR_H_
@@ -5,6 +5,7 @@
 #include "ccapi_cpp/ccapi_logger.h"
 #include "ccapi_cpp/ccapi_message.h"
 namespace ccapi {
+class LatencyStats;
 /**
 ** A single event resulting from a subscription or a request. Event objects are created by the API and passed to the application either through a registered
 *EventHandler or EventQueue. Event objects contain Message objects which can be accessed using the getMessageList() function. The Event object is a handle to an
@@ -82,18 +83,37 @@ class Event CCAPI_FINAL {
       std::move(std::begin(newMessageList), std::end(newMessageList), std::back_inserter(this->messageList));
     }
   }
+  // moves the messages of other to the end of this event's messages
+  void addMessages(Event& other) { this->addMessages(other.messageList); }
   void addMessage(const Message& newMessage) { this->messageList.push_back(newMessage); }
   void addMessage(Message& newMessage) { this->messageList.emplace_back(std::move(newMessage)); }
   void setMessageList(const std::vector<Message>& messageList) { this->messageList = messageList; }
   void setMessageList(std::vector<Message>& messageList) { this->messageList = std::move(messageList); }
   Type getType() const { return type; }
   void setType(Type type) { this->type = type; }
+#ifndef SWIG
+  // Only set when SessionOptions::enableLatencyStats is true: the tick count at which the bytes that produced this event were read from the socket, and the
+  // statistics that the remaining stages should be recorded to.
+  uint64_t getReadTsc() const { return readTsc; }
+  LatencyStats* getLatencyStatsPtr() const { return latencyStatsPtr; }
+  void setLatencyTrace(uint64_t readTsc, LatencyStats* latencyStatsPtr) {
+    this->readTsc = readTsc;
+    this->latencyStatsPtr = latencyStatsPtr;
+  }
+  void setTimeReceivedKernel(TimePoint timeReceivedKernel) {
+    for (auto& message : this->messageList) {
+      message.setTimeReceivedKernel(timeReceivedKernel);
+    }
+  }
+#endif
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  private:
 #endif
   Type type{Type::UNKNOWN};
   std::vector<Message> messageList;
+  uint64_t readTsc{};
+  LatencyStats* latencyStatsPtr{};
 };
 } /* namespace ccapi */
 #endif  // INCLUDE_CCAPI_CPP_CCAPI_EVENT_H_
@@ -0,0 +1,210 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_EVENT_BATCH_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_EVENT_BATCH_H_
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_event.h"
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_queue.h"
+namespace ccapi {
+/**
+ * Many events at once in columnar form, for consumers that can't afford to visit every Event, Message and Element one by one (e.g. from Python). drain moves
+ * the events that have accumulated in a Session's event queue (batching mode) into the batch. Market depth levels and trades become rows of contiguous numeric
+ * columns: one row per price level or per trade, with times in nanoseconds since the epoch and the subscription as an index into getCorrelationIdList(), which
+ * keeps its indices for the lifetime of the batch. Everything else is kept as is: events that aren't subscription data in getOtherEventList() and subscription
+ * data messages of other types in getOtherMessageList(). The columns are reused from one drain to the next, so references to them are only valid until then.
+ */
+class EventBatch CCAPI_FINAL {
+ public:
+  std::string EXCEPTION_COLUMNS_HELD = "the columns of the batch are held";
+  // waits up to timeoutMilliseconds for the queue to become non-empty, then replaces the contents of the batch with everything in the queue; returns the
+  // number of events drained. Throws while the columns are held.
+  size_t drain(Queue<Event>& eventQueue, long timeoutMilliseconds = 0) {
+    int numHold = 0;
+    if (!this->numColumnHold.compare_exchange_strong(numHold, -1)) {
+      throw std::runtime_error(EXCEPTION_COLUMNS_HELD);
+    }
+    try {
+      this->clear();
+      if (timeoutMilliseconds > 0) {
+        eventQueue.waitUntilNonEmpty(timeoutMilliseconds);
+      }
+      this->eventList.clear();
+      eventQueue.removeAll(this->eventList);
+      for (const auto& event : this->eventList) {
+        this->add(event);
+      }
+    } catch (...) {
+      this->numColumnHold.store(0);
+      throw;
+    }
+    this->numColumnHold.store(0);
+    return this->eventList.size();
+  }
+  // views of the columns that can outlive a call into the batch, such as the buffers exported to Python, hold the columns while they exist so that drain
+  // doesn't overwrite them; returns false while a drain is in progress
+  bool holdColumns() {
+    int numHold = this->numColumnHold.load();
+    while (numHold >= 0) {
+      if (this->numColumnHold.compare_exchange_weak(numHold, numHold + 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  void releaseColumns() { --this->numColumnHold; }
+  void add(const Event& event) {
+    if (event.getType() != Event::Type::SUBSCRIPTION_DATA) {
+      this->otherEventList.push_back(event);
+      return;
+    }
+    for (const auto& message : event.getMessageList()) {
+      switch (message.getType()) {
+        case Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH:
+          this->addMarketDepth(message);
+          break;
+        case Message::Type::MARKET_DATA_EVENTS_TRADE:
+        case Message::Type::MARKET_DATA_EVENTS_AGG_TRADE:
+          this->addTrade(message);
+          break;
+        default:
+          this->otherMessageList.push_back(message);
+      }
+    }
+  }
+  void clear() {
+    this->depthMessageIndex.clear();
+    this->depthCorrelationIdIndex.clear();
+    this->depthTime.clear();
+    this->depthTimeReceived.clear();
+    this->depthSide.clear();
+    this->depthLevel.clear();
+    this->depthPrice.clear();
+    this->depthSize.clear();
+    this->tradeCorrelationIdIndex.clear();
+    this->tradeTime.clear();
+    this->tradeTimeReceived.clear();
+    this->tradePrice.clear();
+    this->tradeSize.clear();
+    this->tradeIsBuyerMaker.clear();
+    this->otherEventList.clear();
+    this->otherMessageList.clear();
+    this->numDepthMessage = 0;
+  }
+  size_t getNumDepthRow() const { return this->depthPrice.size(); }
+  size_t getNumTradeRow() const { return this->tradePrice.size(); }
+  // the rows of one market depth message share their depth message index, which counts the market depth messages of the batch
+  const std::vector<int>& getDepthMessageIndex() const { return depthMessageIndex; }
+  const std::vector<int>& getDepthCorrelationIdIndex() const { return depthCorrelationIdIndex; }
+  const std::vector<long long>& getDepthTime() const { return depthTime; }
+  const std::vector<long long>& getDepthTimeReceived() const { return depthTimeReceived; }
+  // 0 for bid, 1 for ask
+  const std::vector<int>& getDepthSide() const { return depthSide; }
+  // 0 for the best level of a side
+  const std::vector<int>& getDepthLevel() const { return depthLevel; }
+  const std::vector<double>& getDepthPrice() const { return depthPrice; }
+  const std::vector<double>& getDepthSize() const { return depthSize; }
+  const std::vector<int>& getTradeCorrelationIdIndex() const { return tradeCorrelationIdIndex; }
+  const std::vector<long long>& getTradeTime() const { return tradeTime; }
+  const std::vector<long long>& getTradeTimeReceived() const { return tradeTimeReceived; }
+  const std::vector<double>& getTradePrice() const { return tradePrice; }
+  const std::vector<double>& getTradeSize() const { return tradeSize; }
+  // 1 if the buyer was the maker, 0 if not
+  const std::vector<int>& getTradeIsBuyerMaker() const { return tradeIsBuyerMaker; }
+  const std::vector<std::string>& getCorrelationIdList() const { return correlationIdList; }
+  const std::vector<Event>& getOtherEventList() const { return otherEventList; }
+  const std::vector<Message>& getOtherMessageList() const { return otherMessageList; }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  // a message that belongs to several subscriptions is attributed to the first of them
+  int getCorrelationIdIndex(const Message& message) {
+    const auto& messageCorrelationIdList = message.getCorrelationIdList();
+    const std::string& correlationId = messageCorrelationIdList.empty() ? "" : messageCorrelationIdList.front();
+    auto it = this->correlationIdIndexMap.find(correlationId);
+    if (it != this->correlationIdIndexMap.end()) {
+      return it->second;
+    }
+    int index = this->correlationIdList.size();
+    this->correlationIdIndexMap.emplace(correlationId, index);
+    this->correlationIdList.push_back(correlationId);
+    return index;
+  }
+  // NaN if the value is missing
+  static double toDouble(const std::map<std::string, std::string>& nameValueMap, const std::string& name) {
+    auto it = nameValueMap.find(name);
+    return it == nameValueMap.end() ? std::numeric_limits<double>::quiet_NaN() : std::strtod(it->second.c_str(), nullptr);
+  }
+  static long long toNanoseconds(const TimePoint& tp) { return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count(); }
+  void addMarketDepth(const Message& message) {
+    int correlationIdIndex = this->getCorrelationIdIndex(message);
+    long long time = toNanoseconds(message.getTime()), timeReceived = toNanoseconds(message.getTimeReceived());
+    int numBid = 0, numAsk = 0;
+    for (const auto& element : message.getElementList()) {
+      const auto& nameValueMap = element.getNameValueMap();
+      auto it = nameValueMap.find(CCAPI_BEST_BID_N_PRICE);
+      bool isBid = it != nameValueMap.end();
+      if (!isBid) {
+        it = nameValueMap.find(CCAPI_BEST_ASK_N_PRICE);
+      }
+      // skips the placeholder of an empty side
+      if (it == nameValueMap.end() || it->second == (isBid ? CCAPI_BEST_BID_N_PRICE_EMPTY : CCAPI_BEST_ASK_N_PRICE_EMPTY)) {
+        continue;
+      }
+      this->depthMessageIndex.push_back(this->numDepthMessage);
+      this->depthCorrelationIdIndex.push_back(correlationIdIndex);
+      this->depthTime.push_back(time);
+      this->depthTimeReceived.push_back(timeReceived);
+      this->depthSide.push_back(isBid ? 0 : 1);
+      this->depthLevel.push_back(isBid ? numBid++ : numAsk++);
+      this->depthPrice.push_back(std::strtod(it->second.c_str(), nullptr));
+      this->depthSize.push_back(toDouble(nameValueMap, isBid ? CCAPI_BEST_BID_N_SIZE : CCAPI_BEST_ASK_N_SIZE));
+    }
+    ++this->numDepthMessage;
+  }
+  void addTrade(const Message& message) {
+    int correlationIdIndex = this->getCorrelationIdIndex(message);
+    long long time = toNanoseconds(message.getTime()), timeReceived = toNanoseconds(message.getTimeReceived());
+    for (const auto& element : message.getElementList()) {
+      this->tradeCorrelationIdIndex.push_back(correlationIdIndex);
+      this->tradeTime.push_back(time);
+      this->tradeTimeReceived.push_back(timeReceived);
+      const auto& nameValueMap = element.getNameValueMap();
+      this->tradePrice.push_back(toDouble(nameValueMap, CCAPI_LAST_PRICE));
+      this->tradeSize.push_back(toDouble(nameValueMap, CCAPI_LAST_SIZE));
+      auto it = nameValueMap.find(CCAPI_IS_BUYER_MAKER);
+      this->tradeIsBuyerMaker.push_back(it != nameValueMap.end() && it->second == "1" ? 1 : 0);
+    }
+  }
+  std::vector<Event> eventList;
+  // the number of holds on the columns, or -1 during a drain
+  std::atomic<int> numColumnHold{};
+  int numDepthMessage{};
+  std::vector<int> depthMessageIndex;
+  std::vector<int> depthCorrelationIdIndex;
+  std::vector<long long> depthTime;
+  std::vector<long long> depthTimeReceived;
+  std::vector<int> depthSide;
+  std::vector<int> depthLevel;
+  std::vector<double> depthPrice;
+  std::vector<double> depthSize;
+  std::vector<int> tradeCorrelationIdIndex;
+  std::vector<long long> tradeTime;
+  std::vector<long long> tradeTimeReceived;
+  std::vector<double> tradePrice;
+  std::vector<double> tradeSize;
+  std::vector<int> tradeIsBuyerMaker;
+  std::vector<std::string> correlationIdList;
+  std::map<std::string, int> correlationIdIndexMap;
+  std::vector<Event> otherEventList;
+  std::vector<Message> otherMessageList;
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_EVENT_BATCH_H_
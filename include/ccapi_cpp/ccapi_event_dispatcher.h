@@ -37,6 +37,7 @@ class EventDispatcher CCAPI_FINAL {
       CCAPI_LOGGER_TRACE("start to dispatch an operation");
       std::unique_lock<std::mutex> lock(this->lock);
       this->queue.push(op);
+      this->numPendingOperation.fetch_add(1, std::memory_order_relaxed);
       // Manual unlocking is done before notifying, to avoid waking up
       // the waiting thread only to block again (see notify_one for details)
       lock.unlock();
@@ -53,6 +54,10 @@ class EventDispatcher CCAPI_FINAL {
     }
   }
   void resume() { this->shouldContinue = true; }
+  // number of operations that have been dispatched but have not yet started to execute
+  size_t getNumPendingOperation() const { return this->numPendingOperation.load(std::memory_order_relaxed); }
+  // number of operations that have been executed since construction
+  size_t getNumExecutedOperation() const { return this->numExecutedOperation.load(std::memory_order_relaxed); }
   void pause() { this->shouldContinue = false; }
   void stop() {
     std::unique_lock<std::mutex> lock(this->lock);
@@ -78,8 +83,10 @@ class EventDispatcher CCAPI_FINAL {
       if (!this->quit && this->queue.size()) {
         auto op = std::move(this->queue.front());
         this->queue.pop();
+        this->numPendingOperation.fetch_sub(1, std::memory_order_relaxed);
         lock.unlock();
         op();
+        this->numExecutedOperation.fetch_add(1, std::memory_order_relaxed);
         lock.lock();
       }
     } while (!this->quit);
@@ -92,6 +99,8 @@ class EventDispatcher CCAPI_FINAL {
   std::queue<std::function<void()> > queue;
   std::condition_variable cv;
   bool quit{};
+  std::atomic<size_t> numPendingOperation{};
+  std::atomic<size_t> numExecutedOperation{};
 };
 } /* namespace ccapi */
 #endif  // INCLUDE_CCAPI_CPP_CCAPI_EVENT_DISPATCHER_H_
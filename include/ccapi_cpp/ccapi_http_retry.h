@@ -1,8 +1,19 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_HTTP_RETRY_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_HTTP_RETRY_H_
 #include <future>
+#include <memory>
 #include <string>
 namespace ccapi {
+/**
+ * The state shared by the duplicates of a hedged http request: whether one of them has already produced the outcome that is delivered to the application, how
+ * many are still outstanding, and the timer that fires the next duplicate.
+ */
+class HttpHedge CCAPI_FINAL {
+ public:
+  bool settled{};
+  int numInFlight{1};
+  std::shared_ptr<boost::asio::steady_timer> timerPtr;
+};
 /**
  * This class is used for retrying http requests for the REST API.
  */
@@ -21,6 +32,7 @@ class HttpRetry CCAPI_FINAL {
   int numRetry;
   int numRedirect;
   std::shared_ptr<std::promise<void> > promisePtr;
+  std::shared_ptr<HttpHedge> hedgePtr;
 };
 
 } /* namespace ccapi */
@@ -3,6 +3,15 @@
 #ifndef CCAPI_DECOMPRESS_BUFFER_SIZE
 #define CCAPI_DECOMPRESS_BUFFER_SIZE 1 << 20
 #endif
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "boost/beast/core/string.hpp"
+#include "boost/system/error_code.hpp"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_macro.h"
 #include "zlib.h"
 namespace ccapi {
 /**
@@ -34,6 +43,7 @@ class InflateStream CCAPI_FINAL {
     }
   }
   void setWindowBitsOverride(int windowBitsOverride) { this->windowBitsOverride = windowBitsOverride; }
+  int getWindowBitsOverride() const { return this->windowBitsOverride; }
   boost::system::error_code init() {
     int ret;
     if (this->windowBitsOverride == 0) {
@@ -47,30 +57,44 @@ class InflateStream CCAPI_FINAL {
       CCAPI_LOGGER_ERROR("decompress error");
       return boost::system::error_code();
     }
-    this->buffer.reset(new unsigned char[this->decompressBufferSize]);
     this->initialized = true;
     return boost::system::error_code();
   }
-  boost::system::error_code decompress(uint8_t const *buf, size_t len, std::string &out) {
+  // inflates into a buffer owned by the stream that only ever grows, so that a message costs neither an allocation nor zero-filling the output; out views the
+  // result, which is followed by CCAPI_WEBSOCKET_READ_BUFFER_PADDING zero bytes like a message read from the socket, and stays valid until the next call
+  boost::system::error_code decompress(uint8_t const *buf, size_t len, boost::beast::string_view &out) {
+    out = boost::beast::string_view();
     if (!this->initialized) {
       CCAPI_LOGGER_ERROR("decompress error");
       return boost::system::error_code();
     }
-    int ret;
     this->istate.avail_in = len;
     this->istate.next_in = const_cast<unsigned char *>(buf);
+    size_t outSize = 0;
     do {
-      this->istate.avail_out = this->decompressBufferSize;
-      this->istate.next_out = this->buffer.get();
+      if (outSize == this->outputCapacity) {
+        this->reserveOutput(outSize + std::min(std::max(outSize, 4 * len + 1024), this->decompressBufferSize), outSize);
+      }
+      this->istate.avail_out = this->outputCapacity - outSize;
+      this->istate.next_out = reinterpret_cast<unsigned char *>(this->outputBuffer.get() + outSize);
       int ret = inflate(&this->istate, Z_SYNC_FLUSH);
+      outSize = this->outputCapacity - this->istate.avail_out;
       if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR) {
         CCAPI_LOGGER_ERROR("decompress error");
         return boost::system::error_code();
       }
-      out.append(reinterpret_cast<char *>(this->buffer.get()), this->decompressBufferSize - this->istate.avail_out);
     } while (this->istate.avail_out == 0);
+    std::memset(this->outputBuffer.get() + outSize, 0, CCAPI_WEBSOCKET_READ_BUFFER_PADDING);
+    out = boost::beast::string_view(this->outputBuffer.get(), outSize);
     return boost::system::error_code();
   }
+  // appends the result to out
+  boost::system::error_code decompress(uint8_t const *buf, size_t len, std::string &out) {
+    boost::beast::string_view decompressed;
+    auto ec = this->decompress(buf, len, decompressed);
+    out.append(decompressed.data(), decompressed.size());
+    return ec;
+  }
   boost::system::error_code inflate_reset() {
     int ret = inflateReset(&this->istate);
     if (ret != Z_OK) {
@@ -83,12 +107,22 @@ class InflateStream CCAPI_FINAL {
 
  private:
 #endif
+  // keeps the first size bytes and room for the padding behind the capacity
+  void reserveOutput(size_t capacity, size_t size) {
+    std::unique_ptr<char[]> outputBuffer(new char[capacity + CCAPI_WEBSOCKET_READ_BUFFER_PADDING]);
+    if (size > 0) {
+      std::memcpy(outputBuffer.get(), this->outputBuffer.get(), size);
+    }
+    this->outputBuffer = std::move(outputBuffer);
+    this->outputCapacity = capacity;
+  }
   int windowBits;
   int windowBitsOverride;
-  bool initialized;
-  std::unique_ptr<unsigned char[]> buffer;
+  bool initialized{};
   z_stream istate;
   size_t decompressBufferSize;
+  std::unique_ptr<char[]> outputBuffer;
+  size_t outputCapacity{};
 };
 
 } /* namespace ccapi */
@@ -0,0 +1,347 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_INSTRUMENT_REGISTRY_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_INSTRUMENT_REGISTRY_H_
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_bar_aggregator.h"
+#include "ccapi_cpp/ccapi_event.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_queue.h"
+#include "ccapi_cpp/ccapi_request.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * The metadata of one instrument as returned by GET_INSTRUMENT(S), together with the fixed-point scales derived from its price and quantity increments. A
+ * price is represented as an integer in units of 10^-priceScale and a quantity as an integer in units of 10^-quantityScale, so that prices and quantities on
+ * the exchange's grid convert to integers exactly and can be added, compared and checked against the increments with integer arithmetic. Values are
+ * non-negative decimals. An instrument whose increment is unknown can't convert the corresponding values.
+ */
+struct InstrumentInfo {
+  std::string exchange;
+  std::string instrument;
+  std::string baseAsset;
+  std::string quoteAsset;
+  std::string settleAsset;
+  std::string priceIncrement;
+  std::string quantityIncrement;
+  std::string quantityMin;
+  std::string quantityMax;
+  std::string priceTimesQuantityMin;
+  std::string contractSize;
+  std::string contractMultiplier;
+  int priceScale{};                  // the number of decimals of the price increment
+  int quantityScale{};               // the number of decimals of the quantity increment
+  int64_t priceIncrementUnits{};     // the price increment in units of 10^-priceScale, 0 if unknown
+  int64_t quantityIncrementUnits{};  // the quantity increment in units of 10^-quantityScale, 0 if unknown
+  // the names are those of the elements of GET_INSTRUMENT(S) responses
+  static InstrumentInfo create(const std::string& exchange, const std::map<std::string, std::string>& nameValueMap) {
+    auto getValue = [&nameValueMap](const std::string& name) {
+      auto it = nameValueMap.find(name);
+      return it == nameValueMap.end() ? std::string() : it->second;
+    };
+    InstrumentInfo output;
+    output.exchange = exchange;
+    output.instrument = getValue(CCAPI_INSTRUMENT);
+    output.baseAsset = getValue(CCAPI_BASE_ASSET);
+    output.quoteAsset = getValue(CCAPI_QUOTE_ASSET);
+    output.settleAsset = getValue(CCAPI_SETTLE_ASSET);
+    output.priceIncrement = getValue(CCAPI_ORDER_PRICE_INCREMENT);
+    output.quantityIncrement = getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
+    output.quantityMin = getValue(CCAPI_ORDER_QUANTITY_MIN);
+    output.quantityMax = getValue(CCAPI_ORDER_QUANTITY_MAX);
+    output.priceTimesQuantityMin = getValue(CCAPI_ORDER_PRICE_TIMES_QUANTITY_MIN);
+    output.contractSize = getValue(CCAPI_CONTRACT_SIZE);
+    output.contractMultiplier = getValue(CCAPI_CONTRACT_MULTIPLIER);
+    setScale(output.priceIncrement, output.priceScale, output.priceIncrementUnits);
+    setScale(output.quantityIncrement, output.quantityScale, output.quantityIncrementUnits);
+    return output;
+  }
+  std::map<std::string, std::string> getNameValueMap() const {
+    return {
+        {CCAPI_INSTRUMENT, instrument},
+        {CCAPI_BASE_ASSET, baseAsset},
+        {CCAPI_QUOTE_ASSET, quoteAsset},
+        {CCAPI_SETTLE_ASSET, settleAsset},
+        {CCAPI_ORDER_PRICE_INCREMENT, priceIncrement},
+        {CCAPI_ORDER_QUANTITY_INCREMENT, quantityIncrement},
+        {CCAPI_ORDER_QUANTITY_MIN, quantityMin},
+        {CCAPI_ORDER_QUANTITY_MAX, quantityMax},
+        {CCAPI_ORDER_PRICE_TIMES_QUANTITY_MIN, priceTimesQuantityMin},
+        {CCAPI_CONTRACT_SIZE, contractSize},
+        {CCAPI_CONTRACT_MULTIPLIER, contractMultiplier},
+    };
+  }
+  int64_t getPriceScaleFactor() const { return FixedPoint::powerOfTen(this->priceScale); }
+  int64_t getQuantityScaleFactor() const { return FixedPoint::powerOfTen(this->quantityScale); }
+  // returns false if the price has more decimals than the price increment, doesn't fit into 64 bits or the price increment is unknown
+  bool convertPriceToInteger(const std::string& price, int64_t& output) const {
+    return this->priceIncrementUnits > 0 && convertToInteger(price, this->priceScale, output);
+  }
+  bool convertQuantityToInteger(const std::string& quantity, int64_t& output) const {
+    return this->quantityIncrementUnits > 0 && convertToInteger(quantity, this->quantityScale, output);
+  }
+  std::string convertIntegerToPrice(int64_t price) const { return FixedPoint::toString(price, this->priceScale); }
+  std::string convertIntegerToQuantity(int64_t quantity) const { return FixedPoint::toString(quantity, this->quantityScale); }
+  // whether an integer price or quantity lies on the exchange's grid
+  bool isPriceOnGrid(int64_t price) const { return this->priceIncrementUnits > 0 && price % this->priceIncrementUnits == 0; }
+  bool isQuantityOnGrid(int64_t quantity) const { return this->quantityIncrementUnits > 0 && quantity % this->quantityIncrementUnits == 0; }
+  // for order entry: the price rounded down (or up) to a multiple of the price increment, or the input if the price increment is unknown
+  std::string roundPrice(const std::string& price, bool roundUp = false) const { return round(price, this->priceScale, this->priceIncrementUnits, roundUp); }
+  // for order entry: the quantity rounded down to a multiple of the quantity increment, or the input if the quantity increment is unknown
+  std::string roundQuantity(const std::string& quantity) const { return round(quantity, this->quantityScale, this->quantityIncrementUnits, false); }
+  std::string toString() const {
+    std::string output = "InstrumentInfo [exchange = " + exchange + ", instrument = " + instrument + ", baseAsset = " + baseAsset +
+                         ", quoteAsset = " + quoteAsset + ", settleAsset = " + settleAsset + ", priceIncrement = " + priceIncrement +
+                         ", quantityIncrement = " + quantityIncrement + ", quantityMin = " + quantityMin + ", quantityMax = " + quantityMax +
+                         ", priceTimesQuantityMin = " + priceTimesQuantityMin + ", contractSize = " + contractSize +
+                         ", contractMultiplier = " + contractMultiplier + ", priceScale = " + ccapi::toString(priceScale) +
+                         ", quantityScale = " + ccapi::toString(quantityScale) + "]";
+    return output;
+  }
+  static void setScale(const std::string& increment, int& scale, int64_t& incrementUnits) {
+    scale = 0;
+    incrementUnits = 0;
+    FixedPoint x;
+    if (FixedPoint::parse(increment, x) && x.mantissa > 0) {
+      scale = x.scale;
+      incrementUnits = x.mantissa;
+    }
+  }
+  // the value in units of 10^-scale
+  static bool convertToInteger(const std::string& value, int scale, int64_t& output) {
+    FixedPoint x;
+    return FixedPoint::parse(value, x) && x.scale <= scale && FixedPoint::rescale(x.mantissa, x.scale, scale, output);
+  }
+  static std::string round(const std::string& value, int scale, int64_t incrementUnits, bool roundUp) {
+    FixedPoint x;
+    if (incrementUnits <= 0 || !FixedPoint::parse(value, x)) {
+      return value;
+    }
+    // the value has more decimals than the grid: truncate it to the grid's decimals first
+    bool hasRemainder = x.scale > scale && x.mantissa % FixedPoint::powerOfTen(x.scale - scale) != 0;
+    int64_t units;
+    if (!FixedPoint::rescale(x.mantissa, x.scale, scale, units)) {
+      return value;
+    }
+    int64_t quotient = units / incrementUnits;
+    hasRemainder = hasRemainder || units % incrementUnits != 0;
+    if (roundUp && hasRemainder) {
+      ++quotient;
+    }
+    return FixedPoint::toString(quotient * incrementUnits, scale);
+  }
+};
+/**
+ * A thread safe registry of instrument metadata per exchange, populated from GET_INSTRUMENT(S) responses. It can be saved to and loaded from a local file so
+ * that a process starts with the metadata of its previous run instead of waiting for the exchanges, and it can refresh itself in the background. Lookups
+ * return shared pointers to immutable InstrumentInfo objects, so a hot path can look an instrument up once and keep the pointer: a refresh replaces the
+ * registry's entries but never modifies an InstrumentInfo that has been handed out.
+ */
+class InstrumentRegistry CCAPI_FINAL {
+ public:
+  InstrumentRegistry() {}
+  InstrumentRegistry(const InstrumentRegistry&) = delete;
+  InstrumentRegistry& operator=(const InstrumentRegistry&) = delete;
+  ~InstrumentRegistry() { this->stopRefresh(); }
+  // adds or replaces the instruments carried by the elements of a GET_INSTRUMENT or GET_INSTRUMENTS message; returns the number of instruments
+  int update(const std::string& exchange, const Message& message) {
+    if (message.getType() != Message::Type::GET_INSTRUMENT && message.getType() != Message::Type::GET_INSTRUMENTS) {
+      return 0;
+    }
+    int numInstrument = 0;
+    std::lock_guard<std::mutex> lock(this->m);
+    for (const auto& element : message.getElementList()) {
+      auto instrumentInfo = InstrumentInfo::create(exchange, element.getNameValueMap());
+      if (!instrumentInfo.instrument.empty()) {
+        auto& instrumentInfoPtr = this->instrumentInfoByInstrumentByExchangeMap[exchange][instrumentInfo.instrument];
+        instrumentInfoPtr = std::make_shared<const InstrumentInfo>(std::move(instrumentInfo));
+        ++numInstrument;
+      }
+    }
+    return numInstrument;
+  }
+  void update(const InstrumentInfo& instrumentInfo) {
+    std::lock_guard<std::mutex> lock(this->m);
+    this->instrumentInfoByInstrumentByExchangeMap[instrumentInfo.exchange][instrumentInfo.instrument] = std::make_shared<const InstrumentInfo>(instrumentInfo);
+  }
+  // nullptr if the instrument is unknown
+  std::shared_ptr<const InstrumentInfo> get(const std::string& exchange, const std::string& instrument) const {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto it = this->instrumentInfoByInstrumentByExchangeMap.find(exchange);
+    if (it == this->instrumentInfoByInstrumentByExchangeMap.end()) {
+      return nullptr;
+    }
+    auto it2 = it->second.find(instrument);
+    return it2 == it->second.end() ? nullptr : it2->second;
+  }
+  std::vector<std::shared_ptr<const InstrumentInfo> > getList(const std::string& exchange = "") const {
+    std::vector<std::shared_ptr<const InstrumentInfo> > output;
+    std::lock_guard<std::mutex> lock(this->m);
+    for (const auto& x : this->instrumentInfoByInstrumentByExchangeMap) {
+      if (exchange.empty() || exchange == x.first) {
+        for (const auto& y : x.second) {
+          output.push_back(y.second);
+        }
+      }
+    }
+    return output;
+  }
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(this->m);
+    size_t output = 0;
+    for (const auto& x : this->instrumentInfoByInstrumentByExchangeMap) {
+      output += x.second.size();
+    }
+    return output;
+  }
+  // writes one tab separated line per instrument under a header line of element names; the file is replaced atomically
+  bool save(const std::string& filePath) const {
+    auto instrumentInfoList = this->getList();
+    std::string tmpFilePath = filePath + ".tmp";
+    {
+      std::ofstream f(tmpFilePath, std::ios::trunc);
+      if (!f) {
+        CCAPI_LOGGER_WARN("cannot open " + tmpFilePath);
+        return false;
+      }
+      f << "EXCHANGE";
+      for (const auto& x : InstrumentInfo().getNameValueMap()) {
+        f << '\t' << x.first;
+      }
+      f << '\n';
+      for (const auto& instrumentInfo : instrumentInfoList) {
+        f << instrumentInfo->exchange;
+        for (const auto& x : instrumentInfo->getNameValueMap()) {
+          f << '\t' << x.second;
+        }
+        f << '\n';
+      }
+      if (!f.flush()) {
+        CCAPI_LOGGER_WARN("cannot write " + tmpFilePath);
+        return false;
+      }
+    }
+    if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+      CCAPI_LOGGER_WARN("cannot rename " + tmpFilePath + " to " + filePath);
+      return false;
+    }
+    return true;
+  }
+  // adds the instruments of a file written by save; returns the number of instruments loaded, -1 if the file can't be opened
+  int load(const std::string& filePath) {
+    std::ifstream f(filePath);
+    if (!f) {
+      return -1;
+    }
+    std::string line;
+    if (!std::getline(f, line)) {
+      return 0;
+    }
+    auto nameList = UtilString::split(line, '\t');
+    int numInstrument = 0;
+    while (std::getline(f, line)) {
+      auto valueList = UtilString::split(line, '\t');
+      if (valueList.size() != nameList.size()) {
+        continue;
+      }
+      std::map<std::string, std::string> nameValueMap;
+      for (size_t i = 1; i < nameList.size(); ++i) {
+        nameValueMap[nameList.at(i)] = valueList.at(i);
+      }
+      auto instrumentInfo = InstrumentInfo::create(valueList.at(0), nameValueMap);
+      if (!instrumentInfo.instrument.empty()) {
+        this->update(instrumentInfo);
+        ++numInstrument;
+      }
+    }
+    return numInstrument;
+  }
+  // sends the requests (typically one GET_INSTRUMENTS per exchange) and blocks until their responses have updated the registry; returns the number of
+  // instruments updated. SessionType is Session or anything with the same sendRequest.
+  template <class SessionType>
+  int refresh(SessionType& session, std::vector<Request> requestList) {
+    std::map<std::string, std::string> exchangeByCorrelationIdMap;
+    for (const auto& request : requestList) {
+      exchangeByCorrelationIdMap[request.getCorrelationId()] = request.getExchange();
+    }
+    Queue<Event> eventQueue;
+    session.sendRequest(requestList, &eventQueue);
+    int numInstrument = 0;
+    for (const auto& event : eventQueue.purge()) {
+      for (const auto& message : event.getMessageList()) {
+        for (const auto& correlationId : message.getCorrelationIdList()) {
+          auto it = exchangeByCorrelationIdMap.find(correlationId);
+          if (it == exchangeByCorrelationIdMap.end()) {
+            continue;
+          }
+          if (message.getType() == Message::Type::RESPONSE_ERROR || message.getType() == Message::Type::REQUEST_FAILURE) {
+            CCAPI_LOGGER_WARN("cannot refresh instruments of " + it->second + ": " + message.toString());
+          } else {
+            numInstrument += this->update(it->second, message);
+          }
+        }
+      }
+    }
+    // a refresh whose responses all failed leaves the registry as old as it was
+    if (numInstrument > 0) {
+      this->lastRefreshTp = std::chrono::system_clock::now();
+    }
+    return numInstrument;
+  }
+  // refreshes the registry right away and then every intervalMilliseconds on a background thread, saving it to filePath after each refresh that updated it
+  // if filePath isn't empty; the session must outlive the refresh
+  template <class SessionType>
+  void startRefresh(SessionType& session, const std::vector<Request>& requestList, long intervalMilliseconds, const std::string& filePath = "") {
+    this->stopRefresh();
+    this->shouldStopRefresh = false;
+    this->refreshThread = std::thread([this, &session, requestList, intervalMilliseconds, filePath]() {
+      while (true) {
+        if (this->refresh(session, requestList) > 0 && !filePath.empty()) {
+          this->save(filePath);
+        }
+        std::unique_lock<std::mutex> lock(this->refreshMutex);
+        if (this->refreshCv.wait_for(lock, std::chrono::milliseconds(intervalMilliseconds), [this]() { return this->shouldStopRefresh; })) {
+          return;
+        }
+      }
+    });
+  }
+  // waits for a refresh in progress to finish
+  void stopRefresh() {
+    {
+      std::lock_guard<std::mutex> lock(this->refreshMutex);
+      this->shouldStopRefresh = true;
+    }
+    this->refreshCv.notify_all();
+    if (this->refreshThread.joinable()) {
+      this->refreshThread.join();
+    }
+  }
+  // the time at which the latest refresh that updated the registry completed, or the epoch if there hasn't been any
+  TimePoint getLastRefreshTp() const { return this->lastRefreshTp; }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  mutable std::mutex m;
+  std::map<std::string, std::map<std::string, std::shared_ptr<const InstrumentInfo> > > instrumentInfoByInstrumentByExchangeMap;
+  std::atomic<TimePoint> lastRefreshTp{TimePoint(std::chrono::seconds(0))};
+  std::thread refreshThread;
+  std::mutex refreshMutex;
+  std::condition_variable refreshCv;
+  bool shouldStopRefresh{};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_INSTRUMENT_REGISTRY_H_
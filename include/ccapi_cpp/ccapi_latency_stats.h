@@ -0,0 +1,255 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_LATENCY_STATS_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_LATENCY_STATS_H_
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * A cheap monotonic tick counter. It reads the time stamp counter where available and falls back to std::chrono::steady_clock (in nanoseconds) otherwise.
+ * Ticks are only meaningful as differences and are converted to nanoseconds by LatencyStats.
+ */
+class TscClock CCAPI_FINAL {
+ public:
+  static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+};
+/**
+ * A fixed-size log-linear histogram in the spirit of HdrHistogram. Each power-of-two range is split into 16 linear sub-buckets, so any recorded value is
+ * reported with a relative error below 1/16. Recording is lock-free and may happen concurrently with reading.
+ */
+class LatencyHistogram CCAPI_FINAL {
+ public:
+  static constexpr int numSubBucketBit = 4;
+  static constexpr int numSubBucket = 1 << numSubBucketBit;
+  static constexpr int numBucket = (64 - numSubBucketBit + 1) * numSubBucket;
+  LatencyHistogram() {
+    for (auto& x : this->countByBucket) {
+      x.store(0, std::memory_order_relaxed);
+    }
+  }
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+  void record(uint64_t value) {
+    this->countByBucket[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    this->count.fetch_add(1, std::memory_order_relaxed);
+    this->sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t currentMax = this->max.load(std::memory_order_relaxed);
+    while (value > currentMax && !this->max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+    uint64_t currentMin = this->min.load(std::memory_order_relaxed);
+    while (value < currentMin && !this->min.compare_exchange_weak(currentMin, value, std::memory_order_relaxed)) {
+    }
+  }
+  uint64_t getCount() const { return this->count.load(std::memory_order_relaxed); }
+  uint64_t getSum() const { return this->sum.load(std::memory_order_relaxed); }
+  uint64_t getMax() const { return this->max.load(std::memory_order_relaxed); }
+  uint64_t getMin() const {
+    uint64_t value = this->min.load(std::memory_order_relaxed);
+    return value == UINT64_MAX ? 0 : value;
+  }
+  // returns the midpoint of the bucket that contains the given percentile (0 to 100), or the exact maximum if that bucket is the highest non-empty one
+  uint64_t getValueAtPercentile(double percentile) const {
+    uint64_t totalCount = this->getCount();
+    if (totalCount == 0) {
+      return 0;
+    }
+    uint64_t targetCount = static_cast<uint64_t>(percentile / 100 * totalCount + 0.5);
+    if (targetCount == 0) {
+      targetCount = 1;
+    }
+    uint64_t cumulativeCount = 0;
+    for (int i = 0; i < numBucket; ++i) {
+      cumulativeCount += this->countByBucket[i].load(std::memory_order_relaxed);
+      if (cumulativeCount >= totalCount) {
+        return this->getMax();
+      }
+      if (cumulativeCount >= targetCount) {
+        return std::min(bucketLowerBound(i) + bucketWidth(i) / 2, this->getMax());
+      }
+    }
+    return this->getMax();
+  }
+  void reset() {
+    for (auto& x : this->countByBucket) {
+      x.store(0, std::memory_order_relaxed);
+    }
+    this->count.store(0, std::memory_order_relaxed);
+    this->sum.store(0, std::memory_order_relaxed);
+    this->max.store(0, std::memory_order_relaxed);
+    this->min.store(UINT64_MAX, std::memory_order_relaxed);
+  }
+  static int bucketIndex(uint64_t value) {
+    if (value < numSubBucket) {
+      return static_cast<int>(value);
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - numSubBucketBit;
+    return (shift + 1) * numSubBucket + static_cast<int>((value >> shift) & (numSubBucket - 1));
+  }
+  static uint64_t bucketLowerBound(int index) {
+    int group = index / numSubBucket;
+    uint64_t subBucket = index % numSubBucket;
+    return group == 0 ? subBucket : (numSubBucket + subBucket) << (group - 1);
+  }
+  static uint64_t bucketWidth(int index) {
+    int group = index / numSubBucket;
+    return group == 0 ? 1 : uint64_t(1) << (group - 1);
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  std::array<std::atomic<uint64_t>, numBucket> countByBucket;
+  std::atomic<uint64_t> count{};
+  std::atomic<uint64_t> sum{};
+  std::atomic<uint64_t> max{};
+  std::atomic<uint64_t> min{UINT64_MAX};
+};
+/**
+ * Per-exchange latency histograms of the websocket hot path. Every stage is measured from the moment the socket read completed, so the difference between two
+ * consecutive stages is the time spent in between.
+ */
+class LatencyStats CCAPI_FINAL {
+ public:
+  enum class Stage {
+    DECOMPRESS,
+    PARSE,
+    ORDER_BOOK_UPDATE,
+    DISPATCHER_ENQUEUE,
+    HANDLER_INVOCATION,
+  };
+  static constexpr int numStage = 5;
+  static std::string stageToString(Stage stage) {
+    std::string output;
+    switch (stage) {
+      case Stage::DECOMPRESS:
+        output = "DECOMPRESS";
+        break;
+      case Stage::PARSE:
+        output = "PARSE";
+        break;
+      case Stage::ORDER_BOOK_UPDATE:
+        output = "ORDER_BOOK_UPDATE";
+        break;
+      case Stage::DISPATCHER_ENQUEUE:
+        output = "DISPATCHER_ENQUEUE";
+        break;
+      case Stage::HANDLER_INVOCATION:
+        output = "HANDLER_INVOCATION";
+        break;
+      default:
+        CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
+    }
+    return output;
+  }
+  struct Summary {
+    std::string exchange;
+    std::string stage;
+    uint64_t count{};
+    double minNanoseconds{};
+    double meanNanoseconds{};
+    double p50Nanoseconds{};
+    double p90Nanoseconds{};
+    double p99Nanoseconds{};
+    double p999Nanoseconds{};
+    double maxNanoseconds{};
+    std::string toString() const {
+      std::string output = "Summary [exchange = " + exchange + ", stage = " + stage + ", count = " + ccapi::toString(count) +
+                           ", minNanoseconds = " + ccapi::toString(minNanoseconds) + ", meanNanoseconds = " + ccapi::toString(meanNanoseconds) +
+                           ", p50Nanoseconds = " + ccapi::toString(p50Nanoseconds) + ", p90Nanoseconds = " + ccapi::toString(p90Nanoseconds) +
+                           ", p99Nanoseconds = " + ccapi::toString(p99Nanoseconds) + ", p999Nanoseconds = " + ccapi::toString(p999Nanoseconds) +
+                           ", maxNanoseconds = " + ccapi::toString(maxNanoseconds) + "]";
+      return output;
+    }
+  };
+  explicit LatencyStats(const std::string& exchange) : exchange(exchange) { getCalibration(); }
+  LatencyStats(const LatencyStats&) = delete;
+  LatencyStats& operator=(const LatencyStats&) = delete;
+  void record(Stage stage, uint64_t startTsc, uint64_t endTsc) {
+    if (startTsc != 0 && endTsc >= startTsc) {
+      this->histogramByStage[static_cast<int>(stage)].record(endTsc - startTsc);
+    }
+  }
+  const LatencyHistogram& getHistogram(Stage stage) const { return this->histogramByStage[static_cast<int>(stage)]; }
+  std::vector<Summary> getSummaryList() const {
+    double nanosecondsPerTick = this->getNanosecondsPerTick();
+    std::vector<Summary> summaryList;
+    for (int i = 0; i < numStage; ++i) {
+      const auto& histogram = this->histogramByStage[i];
+      Summary summary;
+      summary.exchange = this->exchange;
+      summary.stage = stageToString(static_cast<Stage>(i));
+      summary.count = histogram.getCount();
+      if (summary.count > 0) {
+        summary.minNanoseconds = histogram.getMin() * nanosecondsPerTick;
+        summary.meanNanoseconds = static_cast<double>(histogram.getSum()) / summary.count * nanosecondsPerTick;
+        summary.p50Nanoseconds = histogram.getValueAtPercentile(50) * nanosecondsPerTick;
+        summary.p90Nanoseconds = histogram.getValueAtPercentile(90) * nanosecondsPerTick;
+        summary.p99Nanoseconds = histogram.getValueAtPercentile(99) * nanosecondsPerTick;
+        summary.p999Nanoseconds = histogram.getValueAtPercentile(99.9) * nanosecondsPerTick;
+        summary.maxNanoseconds = histogram.getMax() * nanosecondsPerTick;
+      }
+      summaryList.push_back(summary);
+    }
+    return summaryList;
+  }
+  void reset() {
+    for (auto& x : this->histogramByStage) {
+      x.reset();
+    }
+  }
+  // the tick rate is calibrated against std::chrono::steady_clock since the first LatencyStats of the process was constructed, growing more precise over time
+  double getNanosecondsPerTick() const {
+#if defined(__x86_64__) || defined(__i386__)
+    const auto& calibration = getCalibration();
+    uint64_t elapsedTick = TscClock::now() - calibration.tscAnchor;
+    auto elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - calibration.steadyClockAnchor).count();
+    if (elapsedTick == 0) {
+      return 1;
+    }
+    return static_cast<double>(elapsedNanoseconds) / elapsedTick;
+#else
+    return 1;
+#endif
+  }
+  const std::string& getExchange() const { return exchange; }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct Calibration {
+    uint64_t tscAnchor;
+    std::chrono::steady_clock::time_point steadyClockAnchor;
+  };
+  // the first call spins for a millisecond, so that no summary is ever scaled by a tick rate measured over a shorter time
+  static const Calibration& getCalibration() {
+    static const Calibration calibration = [] {
+      Calibration output{TscClock::now(), std::chrono::steady_clock::now()};
+#if defined(__x86_64__) || defined(__i386__)
+      while (std::chrono::steady_clock::now() - output.steadyClockAnchor < std::chrono::milliseconds(1)) {
+      }
+#endif
+      return output;
+    }();
+    return calibration;
+  }
+  std::string exchange;
+  std::array<LatencyHistogram, numStage> histogramByStage;
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_LATENCY_STATS_H_
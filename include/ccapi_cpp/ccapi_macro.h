@@ -9,6 +9,15 @@
 #define CCAPI_FINAL final
 #endif
 #endif
+// io_uring has to be chosen before the first boost asio header is included, see ServiceContext
+#ifdef CCAPI_USE_IO_URING
+#ifndef BOOST_ASIO_HAS_IO_URING
+#define BOOST_ASIO_HAS_IO_URING
+#endif
+#ifndef BOOST_ASIO_DISABLE_EPOLL
+#define BOOST_ASIO_DISABLE_EPOLL
+#endif
+#endif
 #ifndef CCAPI_PRINT_DOUBLE_PRECISION_DEFAULT
 #define CCAPI_PRINT_DOUBLE_PRECISION_DEFAULT 10
 #endif
@@ -58,6 +67,9 @@
 #ifndef CCAPI_CANDLESTICK_INTERVAL_SECONDS_DEFAULT
 #define CCAPI_CANDLESTICK_INTERVAL_SECONDS_DEFAULT "60"
 #endif
+#ifndef CCAPI_CALCULATED_BAR_LIST
+#define CCAPI_CALCULATED_BAR_LIST "CALCULATED_BAR_LIST"
+#endif
 #ifndef CCAPI_EXCHANGE_NAME_COINBASE
 #define CCAPI_EXCHANGE_NAME_COINBASE "coinbase"
 #endif
@@ -226,6 +238,15 @@
 #ifndef CCAPI_QUOTE_VOLUME
 #define CCAPI_QUOTE_VOLUME "QUOTE_VOLUME"
 #endif
+#ifndef CCAPI_VWAP
+#define CCAPI_VWAP "VWAP"
+#endif
+#ifndef CCAPI_TRADE_COUNT
+#define CCAPI_TRADE_COUNT "TRADE_COUNT"
+#endif
+#ifndef CCAPI_CALCULATED_BAR
+#define CCAPI_CALCULATED_BAR "CALCULATED_BAR"
+#endif
 #ifndef CCAPI_LIMIT
 #define CCAPI_LIMIT "LIMIT"
 #endif
@@ -526,6 +547,24 @@
 #ifndef CCAPI_EM_CLIENT_ORDER_ID
 #define CCAPI_EM_CLIENT_ORDER_ID "CLIENT_ORDER_ID"
 #endif
+#ifndef CCAPI_RATE_LIMIT_REQUEST_WEIGHT
+#define CCAPI_RATE_LIMIT_REQUEST_WEIGHT "REQUEST_WEIGHT"
+#endif
+#ifndef CCAPI_RATE_LIMIT_ORDER_COUNT_10S
+#define CCAPI_RATE_LIMIT_ORDER_COUNT_10S "ORDER_COUNT_10S"
+#endif
+#ifndef CCAPI_RATE_LIMIT_ORDER_COUNT_1M
+#define CCAPI_RATE_LIMIT_ORDER_COUNT_1M "ORDER_COUNT_1M"
+#endif
+#ifndef CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MIN
+#define CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MIN 20
+#endif
+#ifndef CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MAX
+#define CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MAX 200
+#endif
+#ifndef CCAPI_EM_ORDER_CORRELATION_ID
+#define CCAPI_EM_ORDER_CORRELATION_ID "ORDER_CORRELATION_ID"
+#endif
 #ifndef CCAPI_EM_ORIGINAL_CLIENT_ORDER_ID
 #define CCAPI_EM_ORIGINAL_CLIENT_ORDER_ID "ORIGINAL_CLIENT_ORDER_ID"
 #endif
@@ -605,6 +644,14 @@
 #ifndef CCAPI_CREDENTIAL_DISPLAY_LENGTH
 #define CCAPI_CREDENTIAL_DISPLAY_LENGTH 4
 #endif
+#ifndef CCAPI_WEBSOCKET_READ_BUFFER_INITIAL_SIZE
+#define CCAPI_WEBSOCKET_READ_BUFFER_INITIAL_SIZE 65536
+#endif
+// zero bytes kept after every websocket message that is read: a terminator for parsers that need one and room for parsers that read past the end (e.g. 64 for
+// simdjson)
+#ifndef CCAPI_WEBSOCKET_READ_BUFFER_PADDING
+#define CCAPI_WEBSOCKET_READ_BUFFER_PADDING 64
+#endif
 
 // start: exchange REST urls
 #ifndef CCAPI_COINBASE_URL_REST_BASE
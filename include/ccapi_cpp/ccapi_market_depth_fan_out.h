@@ -0,0 +1,282 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_MARKET_DEPTH_FAN_OUT_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_MARKET_DEPTH_FAN_OUT_H_
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_event.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_subscription.h"
+namespace ccapi {
+/**
+ * Lets market depth subscriptions to the same instrument that differ only in MARKET_DEPTH_MAX and CONFLATE_INTERVAL_MILLISECONDS share one upstream
+ * subscription. merge replaces each such group with a single subscription at the largest requested depth and without conflation, so that the service opens one
+ * channel and maintains one book. fanOut then turns every message of that upstream subscription into one message per original subscription ("view"): the book
+ * is cut to the view's depth and a message is delivered only if the view's top levels changed. A conflated view is delivered at the end of each interval in
+ * which its book changed, stamped with the end of the interval, like the service's conflation: by fanOut when the next upstream message arrives after the
+ * interval, or by flush, which the owner calls from a timer at the time point that flush returns so that a quiet upstream doesn't hold the view back.
+ * Subscriptions with a conflation grace period or with MARKET_DEPTH_RETURN_UPDATE aren't merged because their output depends on more than the top levels.
+ */
+class MarketDepthFanOut CCAPI_FINAL {
+ public:
+  // returns the subscriptions to actually send: every group of at least two mergeable subscriptions is replaced by its upstream subscription
+  std::vector<Subscription> merge(const std::vector<Subscription>& subscriptionList) {
+    std::vector<Subscription> output;
+    std::map<std::string, std::vector<size_t> > indexListByKeyMap;
+    std::vector<std::string> keyList;
+    for (size_t i = 0; i < subscriptionList.size(); ++i) {
+      const auto& subscription = subscriptionList.at(i);
+      if (!isMergeable(subscription)) {
+        output.push_back(subscription);
+        continue;
+      }
+      auto key = getKey(subscription);
+      auto& indexList = indexListByKeyMap[key];
+      if (indexList.empty()) {
+        keyList.push_back(key);
+      }
+      indexList.push_back(i);
+    }
+    std::lock_guard<std::mutex> lock(this->m);
+    for (const auto& key : keyList) {
+      const auto& indexList = indexListByKeyMap.at(key);
+      if (indexList.size() < 2) {
+        output.push_back(subscriptionList.at(indexList.front()));
+        continue;
+      }
+      std::vector<View> viewList;
+      int maxMarketDepth = 1;
+      for (auto i : indexList) {
+        const auto& subscription = subscriptionList.at(i);
+        View view;
+        view.correlationId = subscription.getCorrelationId();
+        view.maxMarketDepth = std::stoi(subscription.getOptionMap().at(CCAPI_MARKET_DEPTH_MAX));
+        view.conflateIntervalMilliseconds = std::stoi(subscription.getOptionMap().at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
+        maxMarketDepth = std::max(maxMarketDepth, view.maxMarketDepth);
+        if (view.conflateIntervalMilliseconds > 0) {
+          this->hasConflatedView = true;
+        }
+        viewList.push_back(view);
+      }
+      const auto& first = subscriptionList.at(indexList.front());
+      auto optionMap = first.getOptionMap();
+      optionMap[CCAPI_MARKET_DEPTH_MAX] = std::to_string(maxMarketDepth);
+      optionMap[CCAPI_CONFLATE_INTERVAL_MILLISECONDS] = CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT;
+      std::string options;
+      for (const auto& x : optionMap) {
+        if (!options.empty()) {
+          options += "&";
+        }
+        options += x.first + "=" + x.second;
+      }
+      Subscription upstream(first.getExchange(), first.getInstrument(), first.getField(), options, "", first.getCredential());
+      upstream.setInstrumentType(first.getInstrumentType());
+      upstream.setMarginType(first.getMarginType());
+      CCAPI_LOGGER_INFO("market depth subscriptions " + toString(indexList.size()) + " share upstream subscription " + upstream.toString());
+      this->viewListByUpstreamCorrelationIdMap[upstream.getCorrelationId()] = std::move(viewList);
+      this->hasView = true;
+      output.push_back(upstream);
+    }
+    return output;
+  }
+  // rewrites the messages of upstream subscriptions into the messages of their views in place; returns false if nothing is left to deliver
+  bool fanOut(Event& event) {
+    if (!this->hasView) {
+      return true;
+    }
+    const auto& messageList = event.getMessageList();
+    if (messageList.empty()) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(this->m);
+    bool isAffected = false;
+    for (const auto& message : messageList) {
+      for (const auto& correlationId : message.getCorrelationIdList()) {
+        if (this->viewListByUpstreamCorrelationIdMap.find(correlationId) != this->viewListByUpstreamCorrelationIdMap.end()) {
+          isAffected = true;
+        }
+      }
+    }
+    if (!isAffected) {
+      return true;
+    }
+    std::vector<Message> newMessageList;
+    for (const auto& message : messageList) {
+      std::vector<std::string> otherCorrelationIdList;
+      std::vector<std::vector<View>*> viewListList;
+      for (const auto& correlationId : message.getCorrelationIdList()) {
+        auto it = this->viewListByUpstreamCorrelationIdMap.find(correlationId);
+        if (it == this->viewListByUpstreamCorrelationIdMap.end()) {
+          otherCorrelationIdList.push_back(correlationId);
+        } else {
+          viewListList.push_back(&it->second);
+        }
+      }
+      if (viewListList.empty()) {
+        newMessageList.push_back(message);
+        continue;
+      }
+      if (!otherCorrelationIdList.empty()) {
+        Message otherMessage = message;
+        otherMessage.setCorrelationIdList(otherCorrelationIdList);
+        newMessageList.push_back(otherMessage);
+      }
+      if (message.getType() == Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH) {
+        for (auto viewListPtr : viewListList) {
+          for (auto& view : *viewListPtr) {
+            this->updateView(view, message, newMessageList);
+          }
+        }
+      } else {
+        std::vector<std::string> correlationIdList;
+        for (auto viewListPtr : viewListList) {
+          for (const auto& view : *viewListPtr) {
+            correlationIdList.push_back(view.correlationId);
+          }
+        }
+        Message viewMessage = message;
+        viewMessage.setCorrelationIdList(correlationIdList);
+        newMessageList.push_back(viewMessage);
+      }
+    }
+    event.setMessageList(newMessageList);
+    return !event.getMessageList().empty();
+  }
+  bool isFlushNeeded() const { return this->hasConflatedView; }
+  // sets event to the messages of the conflated views whose interval ended by now with a changed book; returns the time point at which flush should be called
+  // next, which is TimePoint::max() if there is no conflated view
+  TimePoint flush(Event& event, const TimePoint& now) {
+    TimePoint nextFlushTp = TimePoint::max();
+    std::vector<Message> messageList;
+    std::lock_guard<std::mutex> lock(this->m);
+    for (auto& x : this->viewListByUpstreamCorrelationIdMap) {
+      for (auto& view : x.second) {
+        if (view.conflateIntervalMilliseconds <= 0) {
+          continue;
+        }
+        auto interval = std::chrono::milliseconds(view.conflateIntervalMilliseconds);
+        if (now >= view.previousConflateTp + interval) {
+          if (!isEqual(view.elementList, view.deliveredElementList)) {
+            Message message;
+            message.setType(Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+            message.setRecapType(Message::RecapType::NONE);
+            message.setTime(view.previousConflateTp + interval);
+            message.setTimeReceived(now);
+            message.setElementList(view.elementList);
+            message.setCorrelationIdList({view.correlationId});
+            messageList.push_back(std::move(message));
+            view.deliveredElementList = view.elementList;
+          }
+          view.previousConflateTp = getConflateTp(now, view.conflateIntervalMilliseconds);
+        }
+        nextFlushTp = std::min(nextFlushTp, view.previousConflateTp + interval);
+      }
+    }
+    event.setType(Event::Type::SUBSCRIPTION_DATA);
+    event.setMessageList(messageList);
+    return nextFlushTp;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct View {
+    std::string correlationId;
+    int maxMarketDepth{};
+    int conflateIntervalMilliseconds{};
+    // the view's book as of the latest upstream message and as of the latest delivered message
+    std::vector<Element> elementList;
+    std::vector<Element> deliveredElementList;
+    TimePoint previousConflateTp{std::chrono::seconds(0)};
+  };
+  static bool isMergeable(const Subscription& subscription) {
+    if (subscription.getField() != CCAPI_MARKET_DEPTH || subscription.getInstrumentSet().size() != 1) {
+      return false;
+    }
+    const auto& optionMap = subscription.getOptionMap();
+    return optionMap.at(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS) == CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS_DEFAULT &&
+           optionMap.at(CCAPI_MARKET_DEPTH_RETURN_UPDATE) == CCAPI_MARKET_DEPTH_RETURN_UPDATE_DEFAULT;
+  }
+  static std::string getKey(const Subscription& subscription) {
+    auto optionMap = subscription.getOptionMap();
+    optionMap.erase(CCAPI_MARKET_DEPTH_MAX);
+    optionMap.erase(CCAPI_CONFLATE_INTERVAL_MILLISECONDS);
+    return subscription.getExchange() + "|" + subscription.getInstrumentType() + "|" + subscription.getMarginType() + "|" + subscription.getInstrument() + "|" +
+           toString(optionMap) + "|" + subscription.getSerializedCredential();
+  }
+  // the first maxMarketDepth bid elements followed by the first maxMarketDepth ask elements, including the placeholder of an empty side
+  static std::vector<Element> truncate(const std::vector<Element>& elementList, int maxMarketDepth) {
+    std::vector<Element> output;
+    int numBid = 0, numAsk = 0;
+    for (const auto& element : elementList) {
+      if (element.has(CCAPI_BEST_BID_N_PRICE)) {
+        if (numBid++ < maxMarketDepth) {
+          output.push_back(element);
+        }
+      } else if (numAsk++ < maxMarketDepth) {
+        output.push_back(element);
+      }
+    }
+    return output;
+  }
+  static bool isEqual(const std::vector<Element>& a, const std::vector<Element>& b) {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (a.at(i).getNameValueMap() != b.at(i).getNameValueMap()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  static Message makeMessage(const Message& message, const View& view, const std::vector<Element>& elementList) {
+    Message output;
+    output.setType(message.getType());
+    output.setRecapType(message.getRecapType());
+    output.setTime(message.getTime());
+    output.setTimeReceived(message.getTimeReceived());
+    output.setElementList(elementList);
+    output.setCorrelationIdList({view.correlationId});
+    return output;
+  }
+  // the start of the conflation interval that tp falls in
+  static TimePoint getConflateTp(const TimePoint& tp, int conflateIntervalMilliseconds) {
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+    return UtilTime::makeTimePointFromMilliseconds(milliseconds / conflateIntervalMilliseconds * conflateIntervalMilliseconds);
+  }
+  void updateView(View& view, const Message& message, std::vector<Message>& newMessageList) {
+    auto elementList = truncate(message.getElementList(), view.maxMarketDepth);
+    const auto& tp = message.getTime();
+    bool shouldConflate = view.conflateIntervalMilliseconds > 0;
+    TimePoint conflateTp = shouldConflate ? getConflateTp(tp, view.conflateIntervalMilliseconds) : tp;
+    if (message.getRecapType() == Message::RecapType::SOLICITED) {
+      newMessageList.push_back(makeMessage(message, view, elementList));
+      view.deliveredElementList = elementList;
+      view.previousConflateTp = conflateTp;
+    } else if (!shouldConflate) {
+      if (!isEqual(elementList, view.elementList)) {
+        newMessageList.push_back(makeMessage(message, view, elementList));
+      }
+    } else if (conflateTp > view.previousConflateTp) {
+      if (!isEqual(view.elementList, view.deliveredElementList)) {
+        Message viewMessage = makeMessage(message, view, view.elementList);
+        viewMessage.setTime(view.previousConflateTp + std::chrono::milliseconds(view.conflateIntervalMilliseconds));
+        newMessageList.push_back(viewMessage);
+        view.deliveredElementList = view.elementList;
+      }
+      view.previousConflateTp = conflateTp;
+    }
+    view.elementList = std::move(elementList);
+  }
+  std::map<std::string, std::vector<View> > viewListByUpstreamCorrelationIdMap;
+  std::atomic<bool> hasView{};
+  std::atomic<bool> hasConflatedView{};
+  std::mutex m;
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_MARKET_DEPTH_FAN_OUT_H_
@@ -10,7 +10,8 @@ namespace ccapi {
  * A handle to a single message. Message objects are obtained from the getMessageList() function of the Event object. Each Message is associated with one or
  * more correlation id values. The Message contents are represented as Elements and can be accessed via the getElementList() function. Each Message object
  * consists of an Type attribute and a RecapType attribute. The exchange timestamp (if any) associated with the Messsage object can be retrieved via the
- * getTime() function. The library timestamp can be retrieved via the getTimeReceived() function.
+ * getTime() function. The library timestamp can be retrieved via the getTimeReceived() function. If SessionOptions::enableKernelReceiveTimestamp is true, the
+ * time at which the kernel received the underlying bytes can be retrieved via the getTimeReceivedKernel() function.
  */
 class Message CCAPI_FINAL {
  public:
@@ -219,7 +220,7 @@ class Message CCAPI_FINAL {
   std::string toString() const {
     std::string output = "Message [type = " + typeToString(type) + ", recapType = " + recapTypeToString(recapType) +
                          ", time = " + UtilTime::getISOTimestamp(time) + ", timeReceived = " + UtilTime::getISOTimestamp(timeReceived) +
-                         ", elementList = " + ccapi::firstNToString(elementList, 10) + ", correlationIdList = " + ccapi::toString(correlationIdList) +
+                         ", timeReceivedKernel = " + UtilTime::getISOTimestamp(timeReceivedKernel) + ", elementList = " + ccapi::firstNToString(elementList, 10) + ", correlationIdList = " + ccapi::toString(correlationIdList) +
                          ", secondaryCorrelationIdMap = " + ccapi::toString(secondaryCorrelationIdMap) + "]";
     return output;
   }
@@ -229,6 +230,7 @@ class Message CCAPI_FINAL {
     std::string output = (indentFirstLine ? sl : "") + "Message [\n" + ss + "type = " + typeToString(type) + ",\n" + ss +
                          "recapType = " + recapTypeToString(recapType) + ",\n" + ss + "time = " + UtilTime::getISOTimestamp(time) + ",\n" + ss +
                          "timeReceived = " + UtilTime::getISOTimestamp(timeReceived) + ",\n" + ss +
+                         "timeReceivedKernel = " + UtilTime::getISOTimestamp(timeReceivedKernel) + ",\n" + ss +
                          "elementList = " + ccapi::firstNToStringPretty(elementList, 10, space, space + leftToIndent, false) + ",\n" + ss +
                          "correlationIdList = " + ccapi::toString(correlationIdList) + ",\n" + ss +
                          "secondaryCorrelationIdMap = " + ccapi::toString(secondaryCorrelationIdMap) + "\n" + sl + "]";
@@ -259,12 +261,20 @@ class Message CCAPI_FINAL {
   std::pair<long long, long long> getTimeReceivedUnix() const { return UtilTime::divide(timeReceived); }
   std::pair<long long, long long> getTimeReceivedPair() const { return UtilTime::divide(timeReceived); }
   void setTimeReceived(TimePoint timeReceived) { this->timeReceived = timeReceived; }
+  // The epoch unless kernel receive timestamps are enabled and the message originates from a websocket read. 'getTimeReceivedKernel' only works in C++. For
+  // other languages, please use 'getTimeReceivedKernelISO'.
+  TimePoint getTimeReceivedKernel() const { return timeReceivedKernel; }
+  std::string getTimeReceivedKernelISO() const { return UtilTime::getISOTimestamp(timeReceivedKernel); }
+  std::pair<long long, long long> getTimeReceivedKernelUnix() const { return UtilTime::divide(timeReceivedKernel); }
+  std::pair<long long, long long> getTimeReceivedKernelPair() const { return UtilTime::divide(timeReceivedKernel); }
+  void setTimeReceivedKernel(TimePoint timeReceivedKernel) { this->timeReceivedKernel = timeReceivedKernel; }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  private:
 #endif
   TimePoint time{std::chrono::seconds{0}};
   TimePoint timeReceived{std::chrono::seconds{0}};
+  TimePoint timeReceivedKernel{std::chrono::seconds{0}};
   std::vector<Element> elementList;
   std::vector<std::string> correlationIdList;
   std::map<std::string, std::string> secondaryCorrelationIdMap;
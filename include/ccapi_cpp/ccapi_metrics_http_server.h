@@ -0,0 +1,129 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_METRICS_HTTP_SERVER_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_METRICS_HTTP_SERVER_H_
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "boost/asio/ip/tcp.hpp"
+#include "boost/asio/steady_timer.hpp"
+#include "boost/beast/core.hpp"
+#include "boost/beast/http.hpp"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_metrics_registry.h"
+namespace ccapi {
+/**
+ * Serves the metrics of a MetricsRegistry in the Prometheus text format over plain HTTP. It runs on the io_context that it is given and answers every GET
+ * request, regardless of its target, with the current metrics. A client that doesn't complete its request and read the response within
+ * timeoutMilliseconds is disconnected, and accepting is paused for acceptRetryDelayMilliseconds after an accept error (e.g. running out of file descriptors)
+ * instead of being retried at once.
+ */
+class MetricsHttpServer CCAPI_FINAL : public std::enable_shared_from_this<MetricsHttpServer> {
+ public:
+  MetricsHttpServer(boost::asio::io_context& ioContext, std::shared_ptr<MetricsRegistry> metricsRegistryPtr, long timeoutMilliseconds = 10000,
+                    long acceptRetryDelayMilliseconds = 1000)
+      : ioContext(ioContext),
+        acceptor(ioContext),
+        acceptRetryTimer(ioContext),
+        metricsRegistryPtr(metricsRegistryPtr),
+        timeoutMilliseconds(timeoutMilliseconds),
+        acceptRetryDelayMilliseconds(acceptRetryDelayMilliseconds) {}
+  MetricsHttpServer(const MetricsHttpServer&) = delete;
+  MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+  void start(const std::string& address, unsigned short port) {
+    boost::system::error_code ec;
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::make_address(address, ec), port);
+    if (ec) {
+      CCAPI_LOGGER_ERROR("metrics http server address " + address + " is invalid: " + ec.message());
+      return;
+    }
+    this->acceptor.open(endpoint.protocol(), ec);
+    if (!ec) {
+      this->acceptor.set_option(boost::asio::socket_base::reuse_address(true), ec);
+    }
+    if (!ec) {
+      this->acceptor.bind(endpoint, ec);
+    }
+    if (!ec) {
+      this->acceptor.listen(boost::asio::socket_base::max_listen_connections, ec);
+    }
+    if (ec) {
+      CCAPI_LOGGER_ERROR("metrics http server failed to listen on " + address + ":" + ccapi::toString(port) + ": " + ec.message());
+      return;
+    }
+    CCAPI_LOGGER_INFO("metrics http server listening on " + address + ":" + ccapi::toString(port));
+    this->startAccept();
+  }
+  void stop() {
+    boost::system::error_code ec;
+    this->acceptor.close(ec);
+    this->acceptRetryTimer.cancel();
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct Connection {
+    explicit Connection(boost::asio::io_context& ioContext) : stream(ioContext) {}
+    boost::beast::tcp_stream stream;
+    boost::beast::flat_buffer buffer;
+    boost::beast::http::request<boost::beast::http::empty_body> req;
+    boost::beast::http::response<boost::beast::http::string_body> res;
+  };
+  void startAccept() {
+    auto connectionPtr = std::make_shared<Connection>(this->ioContext);
+    this->acceptor.async_accept(connectionPtr->stream.socket(), [that = shared_from_this(), connectionPtr](const boost::system::error_code& ec) {
+      if (!that->acceptor.is_open()) {
+        return;
+      }
+      if (ec) {
+        CCAPI_LOGGER_WARN("metrics http server accept error: " + ec.message());
+        that->acceptRetryTimer.expires_after(std::chrono::milliseconds(that->acceptRetryDelayMilliseconds));
+        that->acceptRetryTimer.async_wait([that](const boost::system::error_code& ec) {
+          if (!ec && that->acceptor.is_open()) {
+            that->startAccept();
+          }
+        });
+        return;
+      }
+      that->startRead(connectionPtr);
+      that->startAccept();
+    });
+  }
+  void startRead(std::shared_ptr<Connection> connectionPtr) {
+    connectionPtr->stream.expires_after(std::chrono::milliseconds(this->timeoutMilliseconds));
+    boost::beast::http::async_read(connectionPtr->stream, connectionPtr->buffer, connectionPtr->req,
+                                   [that = shared_from_this(), connectionPtr](const boost::system::error_code& ec, std::size_t) {
+                                     if (ec) {
+                                       boost::system::error_code ignored;
+                                       connectionPtr->stream.socket().close(ignored);
+                                       return;
+                                     }
+                                     that->startWrite(connectionPtr);
+                                   });
+  }
+  void startWrite(std::shared_ptr<Connection> connectionPtr) {
+    auto& res = connectionPtr->res;
+    res.version(connectionPtr->req.version());
+    res.keep_alive(false);
+    if (connectionPtr->req.method() == boost::beast::http::verb::get) {
+      res.result(boost::beast::http::status::ok);
+      res.set(boost::beast::http::field::content_type, "text/plain; version=0.0.4");
+      res.body() = this->metricsRegistryPtr->toPrometheusText();
+    } else {
+      res.result(boost::beast::http::status::method_not_allowed);
+    }
+    res.prepare_payload();
+    boost::beast::http::async_write(connectionPtr->stream, res, [connectionPtr](const boost::system::error_code& ec, std::size_t) {
+      boost::system::error_code ignored;
+      connectionPtr->stream.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ignored);
+    });
+  }
+  boost::asio::io_context& ioContext;
+  boost::asio::ip::tcp::acceptor acceptor;
+  boost::asio::steady_timer acceptRetryTimer;
+  std::shared_ptr<MetricsRegistry> metricsRegistryPtr;
+  long timeoutMilliseconds;
+  long acceptRetryDelayMilliseconds;
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_METRICS_HTTP_SERVER_H_
@@ -0,0 +1,290 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_METRICS_REGISTRY_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_METRICS_REGISTRY_H_
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_latency_stats.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_macro.h"
+namespace ccapi {
+/**
+ * A monotonically increasing counter. Updates are lock-free.
+ */
+class MetricCounter CCAPI_FINAL {
+ public:
+  void increment(uint64_t value = 1) { this->value.fetch_add(value, std::memory_order_relaxed); }
+  uint64_t getValue() const { return this->value.load(std::memory_order_relaxed); }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  std::atomic<uint64_t> value{};
+};
+/**
+ * A value that can go up and down. Updates are lock-free.
+ */
+class MetricGauge CCAPI_FINAL {
+ public:
+  void set(double value) { this->value.store(value, std::memory_order_relaxed); }
+  void increment(double value = 1) {
+    double current = this->value.load(std::memory_order_relaxed);
+    while (!this->value.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+  }
+  void decrement(double value = 1) { this->increment(-value); }
+  double getValue() const { return this->value.load(std::memory_order_relaxed); }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  std::atomic<double> value{};
+};
+/**
+ * Holds named counters, gauges and histograms, each of which is identified by its name and a set of labels. Looking up a metric takes a lock, so hot paths
+ * should look a metric up once and keep the returned reference, which stays valid for the lifetime of the registry unless the metric is removed. Updating a
+ * metric is lock-free. Gauges and counters whose value is owned by somebody else can be registered as callbacks that are evaluated at collection time.
+ */
+class MetricsRegistry CCAPI_FINAL {
+ public:
+  enum class Type {
+    COUNTER,
+    GAUGE,
+    HISTOGRAM,
+  };
+  static std::string typeToString(Type type) {
+    std::string output;
+    switch (type) {
+      case Type::COUNTER:
+        output = "COUNTER";
+        break;
+      case Type::GAUGE:
+        output = "GAUGE";
+        break;
+      case Type::HISTOGRAM:
+        output = "HISTOGRAM";
+        break;
+      default:
+        CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
+    }
+    return output;
+  }
+  // a histogram is collected as one sample per quantile plus the "_sum" and "_count" samples, the same way as a Prometheus summary
+  struct Sample {
+    std::string name;
+    std::map<std::string, std::string> labelMap;
+    Type type{Type::COUNTER};
+    double value{};
+    std::string toString() const {
+      std::string output = "Sample [name = " + name + ", labelMap = " + ccapi::toString(labelMap) + ", type = " + typeToString(type) +
+                           ", value = " + ccapi::toString(value) + "]";
+      return output;
+    }
+  };
+  MetricsRegistry() {}
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+  MetricCounter& getCounter(const std::string& name, const std::map<std::string, std::string>& labelMap = {}, const std::string& help = "") {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto& series = this->getSeries(Type::COUNTER, name, labelMap, help);
+    if (!series.counterPtr) {
+      series.counterPtr.reset(new MetricCounter());
+    }
+    return *series.counterPtr;
+  }
+  MetricGauge& getGauge(const std::string& name, const std::map<std::string, std::string>& labelMap = {}, const std::string& help = "") {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto& series = this->getSeries(Type::GAUGE, name, labelMap, help);
+    if (!series.gaugePtr) {
+      series.gaugePtr.reset(new MetricGauge());
+    }
+    return *series.gaugePtr;
+  }
+  LatencyHistogram& getHistogram(const std::string& name, const std::map<std::string, std::string>& labelMap = {}, const std::string& help = "") {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto& series = this->getSeries(Type::HISTOGRAM, name, labelMap, help);
+    if (!series.histogramPtr) {
+      series.histogramPtr.reset(new LatencyHistogram());
+    }
+    return *series.histogramPtr;
+  }
+  // the callback is invoked from the thread that collects the metrics, so it must be thread safe
+  void setCallback(Type type, const std::string& name, const std::map<std::string, std::string>& labelMap, const std::string& help,
+                   std::function<double()> callback) {
+    if (type == Type::HISTOGRAM) {
+      CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
+    }
+    std::lock_guard<std::mutex> lock(this->m);
+    this->getSeries(type, name, labelMap, help).callback = callback;
+  }
+  void removeCallback(const std::string& name, const std::map<std::string, std::string>& labelMap = {}) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto it = this->familyByNameMap.find(name);
+    if (it != this->familyByNameMap.end()) {
+      auto it2 = it->second.seriesByLabelTextMap.find(labelMapToText(labelMap));
+      if (it2 != it->second.seriesByLabelTextMap.end() && it2->second.callback) {
+        it->second.seriesByLabelTextMap.erase(it2);
+      }
+    }
+  }
+  // removes a series of any type; a reference that getCounter, getGauge or getHistogram has returned for it must not be used afterwards
+  void remove(const std::string& name, const std::map<std::string, std::string>& labelMap = {}) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto it = this->familyByNameMap.find(name);
+    if (it != this->familyByNameMap.end()) {
+      it->second.seriesByLabelTextMap.erase(labelMapToText(labelMap));
+    }
+  }
+  std::vector<Sample> getSampleList() const {
+    std::vector<Sample> sampleList;
+    this->collect([&sampleList](const std::string& name, const Family& family, const Series& series) {
+      for (const auto& x : collectSeries(name, family, series)) {
+        sampleList.push_back(x);
+      }
+    });
+    return sampleList;
+  }
+  // see https://prometheus.io/docs/instrumenting/exposition_formats/#text-based-format
+  std::string toPrometheusText() const {
+    std::string output;
+    const Family* previousFamilyPtr = nullptr;
+    this->collect([&output, &previousFamilyPtr](const std::string& name, const Family& family, const Series& series) {
+      if (previousFamilyPtr != &family) {
+        if (!family.help.empty()) {
+          output += "# HELP " + name + " " + family.help + "\n";
+        }
+        output += "# TYPE " + name + " " + (family.type == Type::COUNTER ? "counter" : family.type == Type::GAUGE ? "gauge" : "summary") + "\n";
+        previousFamilyPtr = &family;
+      }
+      for (const auto& x : collectSeries(name, family, series)) {
+        output += x.name;
+        auto labelText = labelMapToText(x.labelMap);
+        if (!labelText.empty()) {
+          output += "{" + labelText + "}";
+        }
+        output += " " + valueToText(x.value) + "\n";
+      }
+    });
+    return output;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct Series {
+    std::map<std::string, std::string> labelMap;
+    std::unique_ptr<MetricCounter> counterPtr;
+    std::unique_ptr<MetricGauge> gaugePtr;
+    std::unique_ptr<LatencyHistogram> histogramPtr;
+    std::function<double()> callback;
+  };
+  struct Family {
+    Type type{Type::COUNTER};
+    std::string help;
+    std::map<std::string, Series> seriesByLabelTextMap;
+  };
+  static std::string labelMapToText(const std::map<std::string, std::string>& labelMap) {
+    std::string output;
+    for (const auto& x : labelMap) {
+      if (!output.empty()) {
+        output += ",";
+      }
+      output += x.first;
+      output += "=\"";
+      for (char c : x.second) {
+        if (c == '\\' || c == '"') {
+          output += '\\';
+          output += c;
+        } else if (c == '\n') {
+          output += "\\n";
+        } else {
+          output += c;
+        }
+      }
+      output += "\"";
+    }
+    return output;
+  }
+  // the Prometheus text format spells non-finite values +Inf, -Inf and NaN; only values within the range of long long may be cast to it
+  static std::string valueToText(double value) {
+    if (std::isnan(value)) {
+      return "NaN";
+    }
+    if (std::isinf(value)) {
+      return value > 0 ? "+Inf" : "-Inf";
+    }
+    char buffer[32];
+    if (std::fabs(value) < 9e18 && value == static_cast<long long>(value)) {
+      std::snprintf(buffer, sizeof buffer, "%lld", static_cast<long long>(value));
+    } else {
+      std::snprintf(buffer, sizeof buffer, "%.17g", value);
+    }
+    return buffer;
+  }
+  static std::vector<Sample> collectSeries(const std::string& name, const Family& family, const Series& series) {
+    std::vector<Sample> sampleList;
+    Sample sample;
+    sample.name = name;
+    sample.labelMap = series.labelMap;
+    sample.type = family.type;
+    if (series.callback) {
+      sample.value = series.callback();
+      sampleList.push_back(sample);
+    } else if (series.counterPtr) {
+      sample.value = series.counterPtr->getValue();
+      sampleList.push_back(sample);
+    } else if (series.gaugePtr) {
+      sample.value = series.gaugePtr->getValue();
+      sampleList.push_back(sample);
+    } else if (series.histogramPtr) {
+      const auto& histogram = *series.histogramPtr;
+      for (const auto& quantile : std::vector<std::pair<std::string, double> >{{"0.5", 50}, {"0.9", 90}, {"0.99", 99}, {"0.999", 99.9}}) {
+        Sample quantileSample = sample;
+        quantileSample.labelMap["quantile"] = quantile.first;
+        quantileSample.value = histogram.getValueAtPercentile(quantile.second);
+        sampleList.push_back(quantileSample);
+      }
+      Sample sumSample = sample;
+      sumSample.name += "_sum";
+      sumSample.value = histogram.getSum();
+      sampleList.push_back(sumSample);
+      Sample countSample = sample;
+      countSample.name += "_count";
+      countSample.value = histogram.getCount();
+      sampleList.push_back(countSample);
+    }
+    return sampleList;
+  }
+  Series& getSeries(Type type, const std::string& name, const std::map<std::string, std::string>& labelMap, const std::string& help) {
+    auto it = this->familyByNameMap.find(name);
+    if (it == this->familyByNameMap.end()) {
+      Family family;
+      family.type = type;
+      family.help = help;
+      it = this->familyByNameMap.insert(std::make_pair(name, std::move(family))).first;
+    } else if (it->second.type != type) {
+      CCAPI_LOGGER_FATAL("metric " + name + " was already registered as a " + typeToString(it->second.type));
+    }
+    auto& series = it->second.seriesByLabelTextMap[labelMapToText(labelMap)];
+    series.labelMap = labelMap;
+    return series;
+  }
+  void collect(std::function<void(const std::string&, const Family&, const Series&)> visitor) const {
+    std::lock_guard<std::mutex> lock(this->m);
+    for (const auto& x : this->familyByNameMap) {
+      for (const auto& y : x.second.seriesByLabelTextMap) {
+        visitor(x.first, x.second, y.second);
+      }
+    }
+  }
+  std::map<std::string, Family> familyByNameMap;
+  mutable std::mutex m;
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_METRICS_REGISTRY_H_
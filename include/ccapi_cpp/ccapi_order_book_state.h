@@ -0,0 +1,27 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_ORDER_BOOK_STATE_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_ORDER_BOOK_STATE_H_
+#include <map>
+#include <string>
+
+#include "ccapi_cpp/ccapi_decimal.h"
+namespace ccapi {
+/**
+ * This class holds the order book of a channel and symbol of a websocket connection together with the flags that describe how its messages are applied. It is
+ * owned by the connection, so that the market data services reach it from a message without looking anything up by connection id.
+ */
+class OrderBookState CCAPI_FINAL {
+ public:
+  std::map<Decimal, std::string> snapshotBid;
+  std::map<Decimal, std::string> snapshotAsk;
+  std::map<Decimal, std::string> previousConflateSnapshotBid;
+  std::map<Decimal, std::string> previousConflateSnapshotAsk;
+  bool processedInitialSnapshot{};
+  bool l2UpdateIsReplace{};
+  // with SessionOptions::enableOrderBookRetention, whether a side has been truncated and the worst price that it kept, beyond which its levels are unknown
+  bool isBidTruncated{};
+  bool isAskTruncated{};
+  Decimal bidBoundary;
+  Decimal askBoundary;
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_ORDER_BOOK_STATE_H_
@@ -1,5 +1,7 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_QUEUE_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_QUEUE_H_
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <queue>
 #include <vector>
@@ -25,6 +27,9 @@ class Queue {
     } else {
       throw std::runtime_error(EXCEPTION_QUEUE_FULL);
     }
+#ifndef CCAPI_USE_SINGLE_THREAD
+    this->cv.notify_all();
+#endif
   }
   void pushBack(T&& t) {
 #ifndef CCAPI_USE_SINGLE_THREAD
@@ -36,6 +41,9 @@ class Queue {
     } else {
       throw std::runtime_error(EXCEPTION_QUEUE_FULL);
     }
+#ifndef CCAPI_USE_SINGLE_THREAD
+    this->cv.notify_all();
+#endif
   }
   T popBack() {
 #ifndef CCAPI_USE_SINGLE_THREAD
@@ -69,6 +77,15 @@ class Queue {
     }
     this->queue.clear();
   }
+  // waits up to timeoutMilliseconds for the queue to become non-empty; returns whether it is
+  bool waitUntilNonEmpty(long timeoutMilliseconds) {
+#ifndef CCAPI_USE_SINGLE_THREAD
+    std::unique_lock<std::mutex> lock(this->m);
+    return this->cv.wait_for(lock, std::chrono::milliseconds(timeoutMilliseconds), [this] { return !this->queue.empty(); });
+#else
+    return !this->queue.empty();
+#endif
+  }
   size_t size() const {
 #ifndef CCAPI_USE_SINGLE_THREAD
     std::lock_guard<std::mutex> lock(this->m);
@@ -88,6 +105,7 @@ class Queue {
   std::vector<T> queue;
 #ifndef CCAPI_USE_SINGLE_THREAD
   mutable std::mutex m;
+  std::condition_variable cv;
 #endif
   size_t maxSize{};
 };
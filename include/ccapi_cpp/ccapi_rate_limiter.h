@@ -0,0 +1,170 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_RATE_LIMITER_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_RATE_LIMITER_H_
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * A client-side rate limiter made of named token buckets, e.g. one for the request weight per IP and one for the number of orders per account. A bucket holds
+ * at most its limit and refills continuously at limit per interval. Each queued value costs some amount of one or more buckets and is released once all of them
+ * can pay. Values are released strictly by priority and in FIFO order within a priority, so a queued cancel is never overtaken by a new order, and low priority
+ * values additionally have to leave a fraction of every bucket untouched so that they can't starve the others. The limiter doesn't own a clock: the caller pops
+ * the released values at the current time and rearms its timer to getNextReleaseTp.
+ */
+template <typename T>
+class RateLimiter CCAPI_FINAL {
+ public:
+  enum class Priority {
+    HIGH = 0,
+    NORMAL = 1,
+    LOW = 2,
+  };
+  typedef std::vector<std::pair<std::string, double> > CostList;
+  explicit RateLimiter(double lowPriorityReserveRatio = 0.2) : lowPriorityReserveRatio(lowPriorityReserveRatio) {}
+  void setLimit(const std::string& bucketName, double limit, std::chrono::milliseconds interval) {
+    Bucket& bucket = this->bucketByNameMap[bucketName];
+    bucket.limit = limit;
+    bucket.refillPerMillisecond = limit / std::max<long long>(interval.count(), 1);
+    bucket.numToken = limit;
+    bucket.lastRefillTp = TimePoint(std::chrono::seconds(0));
+  }
+  // adds the buckets of other that this limiter doesn't have yet, e.g. when services that share an exchange's limits each know only some of them
+  void mergeLimit(const RateLimiter& other) {
+    for (const auto& x : other.bucketByNameMap) {
+      this->bucketByNameMap.insert(x);
+    }
+  }
+  bool empty() const { return this->bucketByNameMap.empty(); }
+  size_t getNumPending() const {
+    size_t output = 0;
+    for (const auto& x : this->pendingListByPriority) {
+      output += x.size();
+    }
+    return output;
+  }
+  void push(Priority priority, const CostList& costList, const T& value) { this->pendingListByPriority[static_cast<int>(priority)].push_back({costList, value}); }
+  // returns the values that can be released now, highest priority first
+  std::vector<T> pop(const TimePoint& now) {
+    std::vector<T> output;
+    if (now < this->blockedUntilTp) {
+      return output;
+    }
+    this->refill(now);
+    for (size_t i = 0; i < this->pendingListByPriority.size(); ++i) {
+      auto& pendingList = this->pendingListByPriority[i];
+      while (!pendingList.empty() && this->canPay(pendingList.front().costList, static_cast<Priority>(i))) {
+        this->pay(pendingList.front().costList);
+        output.push_back(std::move(pendingList.front().value));
+        pendingList.pop_front();
+      }
+      if (!pendingList.empty()) {
+        break;
+      }
+    }
+    return output;
+  }
+  // the earliest time at which pop may release something; only meaningful if there is something pending
+  TimePoint getNextReleaseTp(const TimePoint& now) {
+    this->refill(now);
+    TimePoint output = std::max(now, this->blockedUntilTp);
+    for (size_t i = 0; i < this->pendingListByPriority.size(); ++i) {
+      const auto& pendingList = this->pendingListByPriority[i];
+      if (!pendingList.empty()) {
+        double waitMilliseconds = 0;
+        for (const auto& x : pendingList.front().costList) {
+          auto it = this->bucketByNameMap.find(x.first);
+          if (it != this->bucketByNameMap.end() && it->second.refillPerMillisecond > 0) {
+            double deficit = this->getRequired(it->second, x.second, static_cast<Priority>(i)) - it->second.numToken;
+            waitMilliseconds = std::max(waitMilliseconds, deficit / it->second.refillPerMillisecond);
+          }
+        }
+        output = std::max(output, now + std::chrono::milliseconds(static_cast<long long>(std::ceil(waitMilliseconds))));
+        break;
+      }
+    }
+    return output;
+  }
+  // aligns a bucket with the usage that the exchange reports, e.g. Binance's X-MBX-USED-WEIGHT-1M; the report is trusted only if it is stricter than our count
+  void setUsed(const std::string& bucketName, double used, const TimePoint& now) {
+    auto it = this->bucketByNameMap.find(bucketName);
+    if (it != this->bucketByNameMap.end()) {
+      this->refill(it->second, now);
+      it->second.numToken = std::min(it->second.numToken, it->second.limit - used);
+    }
+  }
+  // stops releasing anything until tp, e.g. after a 429 or 418 response with Retry-After
+  void block(const TimePoint& tp) { this->blockedUntilTp = std::max(this->blockedUntilTp, tp); }
+  double getNumToken(const std::string& bucketName, const TimePoint& now) {
+    auto it = this->bucketByNameMap.find(bucketName);
+    if (it == this->bucketByNameMap.end()) {
+      return 0;
+    }
+    this->refill(it->second, now);
+    return it->second.numToken;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct Bucket {
+    double limit{};
+    double refillPerMillisecond{};
+    double numToken{};
+    TimePoint lastRefillTp{std::chrono::seconds(0)};
+  };
+  struct Pending {
+    CostList costList;
+    T value;
+  };
+  void refill(Bucket& bucket, const TimePoint& now) {
+    if (bucket.lastRefillTp.time_since_epoch().count() == 0) {
+      bucket.lastRefillTp = now;
+      return;
+    }
+    if (now > bucket.lastRefillTp) {
+      double elapsedMilliseconds = std::chrono::duration<double, std::milli>(now - bucket.lastRefillTp).count();
+      bucket.numToken = std::min(bucket.limit, bucket.numToken + elapsedMilliseconds * bucket.refillPerMillisecond);
+      bucket.lastRefillTp = now;
+    }
+  }
+  void refill(const TimePoint& now) {
+    for (auto& x : this->bucketByNameMap) {
+      this->refill(x.second, now);
+    }
+  }
+  // the number of tokens that a bucket must hold to pay cost at priority; capped at the limit so that nothing waits forever
+  double getRequired(const Bucket& bucket, double cost, Priority priority) const {
+    return std::min(cost + (priority == Priority::LOW ? bucket.limit * this->lowPriorityReserveRatio : 0), bucket.limit);
+  }
+  bool canPay(const CostList& costList, Priority priority) const {
+    for (const auto& x : costList) {
+      auto it = this->bucketByNameMap.find(x.first);
+      if (it != this->bucketByNameMap.end() && it->second.numToken < this->getRequired(it->second, x.second, priority)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  void pay(const CostList& costList) {
+    for (const auto& x : costList) {
+      auto it = this->bucketByNameMap.find(x.first);
+      if (it != this->bucketByNameMap.end()) {
+        it->second.numToken -= std::min(x.second, it->second.limit);
+      }
+    }
+  }
+  double lowPriorityReserveRatio;
+  std::map<std::string, Bucket> bucketByNameMap;
+  std::vector<std::deque<Pending> > pendingListByPriority{3};
+  TimePoint blockedUntilTp{std::chrono::seconds(0)};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_RATE_LIMITER_H_
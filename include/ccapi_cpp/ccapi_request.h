@@ -1,9 +1,11 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_REQUEST_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_REQUEST_H_
+#include <algorithm>
 #include <condition_variable>
 #include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "ccapi_cpp/ccapi_macro.h"
 #include "ccapi_cpp/ccapi_util_private.h"
@@ -44,6 +46,8 @@ class Request CCAPI_FINAL {
     GET_ORDER,
     GET_OPEN_ORDERS,
     CANCEL_OPEN_ORDERS,
+    CREATE_ORDERS_BATCH,
+    CANCEL_ORDERS_BATCH,
     GET_ACCOUNTS = CCAPI_REQUEST_OPERATION_TYPE_EXECUTION_MANAGEMENT_ACCOUNT,
     GET_ACCOUNT_BALANCES,
     GET_ACCOUNT_POSITIONS,
@@ -105,6 +109,12 @@ class Request CCAPI_FINAL {
       case Operation::CANCEL_OPEN_ORDERS:
         output = "CANCEL_OPEN_ORDERS";
         break;
+      case Operation::CREATE_ORDERS_BATCH:
+        output = "CREATE_ORDERS_BATCH";
+        break;
+      case Operation::CANCEL_ORDERS_BATCH:
+        output = "CANCEL_ORDERS_BATCH";
+        break;
       case Operation::GET_ACCOUNTS:
         output = "GET_ACCOUNTS";
         break;
@@ -119,6 +129,11 @@ class Request CCAPI_FINAL {
     }
     return output;
   }
+  static bool isBatchOperation(Operation operation) { return operation == Operation::CREATE_ORDERS_BATCH || operation == Operation::CANCEL_ORDERS_BATCH; }
+  // the operation that each order of a batch request performs
+  static Operation getBatchElementOperation(Operation operation) {
+    return operation == Operation::CREATE_ORDERS_BATCH ? Operation::CREATE_ORDER : operation == Operation::CANCEL_ORDERS_BATCH ? Operation::CANCEL_ORDER : operation;
+  }
   Request() {}
   Request(Operation operation, std::string exchange, std::string instrument = "", std::string correlationId = "",
           std::map<std::string, std::string> credential = {})
@@ -176,6 +191,40 @@ class Request CCAPI_FINAL {
       return this->paramList.front();
     }
   }
+  // In a batch request each param is one order and may carry CCAPI_EM_ORDER_CORRELATION_ID to tag the message of that order. Without it the order's message is
+  // tagged with the correlation id of the batch request.
+  std::string getBatchElementCorrelationId(size_t i) const {
+    const auto& param = this->paramList.at(i);
+    auto it = param.find(CCAPI_EM_ORDER_CORRELATION_ID);
+    return it != param.end() && !it->second.empty() ? it->second : this->correlationId;
+  }
+  std::map<std::string, std::string> getBatchElementParam(size_t i) const {
+    auto param = this->paramList.at(i);
+    param.erase(CCAPI_EM_ORDER_CORRELATION_ID);
+    return param;
+  }
+  // Splits a batch request into batch requests of at most batchSizeMax orders each. If batchSizeMax is 1 the result is one CREATE_ORDER or CANCEL_ORDER request
+  // per order instead, tagged with the order's correlation id and carrying the batch's correlation id as its secondary correlation id.
+  std::vector<Request> splitBatch(size_t batchSizeMax) const {
+    std::vector<Request> output;
+    if (batchSizeMax <= 1) {
+      for (size_t i = 0; i < this->paramList.size(); ++i) {
+        Request request = *this;
+        request.operation = getBatchElementOperation(this->operation);
+        request.correlationId = this->getBatchElementCorrelationId(i);
+        request.secondaryCorrelationId = this->correlationId;
+        request.paramList = {this->getBatchElementParam(i)};
+        output.emplace_back(std::move(request));
+      }
+    } else {
+      for (size_t i = 0; i < this->paramList.size(); i += batchSizeMax) {
+        Request request = *this;
+        request.paramList.assign(this->paramList.begin() + i, this->paramList.begin() + std::min(i + batchSizeMax, this->paramList.size()));
+        output.emplace_back(std::move(request));
+      }
+    }
+    return output;
+  }
   // 'getTimeSent' only works in C++. For other languages, please use 'getTimeSentISO'.
   TimePoint getTimeSent() const { return timeSent; }
   std::string getTimeSentISO() const { return UtilTime::getISOTimestamp(timeSent); }
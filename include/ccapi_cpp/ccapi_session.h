@@ -233,7 +233,10 @@
 #endif
 // end: enable exchanges for FIX
 
+#include <chrono>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -241,9 +244,14 @@
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_event_dispatcher.h"
 #include "ccapi_cpp/ccapi_event_handler.h"
+#include "ccapi_cpp/ccapi_latency_stats.h"
+#include "ccapi_cpp/ccapi_market_depth_fan_out.h"
+#include "ccapi_cpp/ccapi_metrics_http_server.h"
+#include "ccapi_cpp/ccapi_metrics_registry.h"
 #include "ccapi_cpp/ccapi_queue.h"
 #include "ccapi_cpp/ccapi_session_configs.h"
 #include "ccapi_cpp/ccapi_session_options.h"
+#include "ccapi_cpp/ccapi_shared_memory_event.h"
 #include "ccapi_cpp/service/ccapi_service.h"
 #include "ccapi_cpp/service/ccapi_service_context.h"
 using steady_timer = boost::asio::steady_timer;
@@ -303,316 +311,428 @@ class Session {
       delete this->eventDispatcher;
     }
 #endif
+    this->latencyStatsLogTimerPtr.reset();
+    this->marketDepthFanOutTimerPtr.reset();
+    this->coalescedEventTimerPtr.reset();
+    this->metricsHttpServerPtr.reset();
     delete this->serviceContextPtr;
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
   virtual void start() {
     CCAPI_LOGGER_FUNCTION_ENTER;
+    auto startTp = std::chrono::steady_clock::now();
+#ifndef _WIN32
+    if (!this->sessionOptions.sharedMemoryPublishName.empty()) {
+      this->sharedMemoryPublisherPtr = std::make_shared<SharedMemoryPublisher>(this->sessionOptions.sharedMemoryPublishName,
+                                                                               this->sessionOptions.sharedMemorySlotSize, this->sessionOptions.sharedMemoryNumSlot);
+    }
+#endif
+#ifndef CCAPI_LEGACY_USE_WEBSOCKETPP
+    if (this->sessionOptions.enableTlsSessionResumption) {
+      this->serviceContextPtr->enableTlsSessionResumption();
+    }
+#endif
     std::thread t([this]() { this->serviceContextPtr->start(); });
     this->t = std::move(t);
     this->internalEventHandler = std::bind(&Session::onEvent, this, std::placeholders::_1, std::placeholders::_2);
+    if (this->sessionOptions.enableMetrics) {
+      this->startMetrics();
+    }
 #ifdef CCAPI_ENABLE_SERVICE_MARKET_DATA
 #ifdef CCAPI_ENABLE_EXCHANGE_COINBASE
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_COINBASE] =
-        std::make_shared<MarketDataServiceCoinbase>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_COINBASE] = [this]() {
+      return std::make_shared<MarketDataServiceCoinbase>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_GEMINI
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_GEMINI] =
-        std::make_shared<MarketDataServiceGemini>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_GEMINI] = [this]() {
+      return std::make_shared<MarketDataServiceGemini>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KRAKEN
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KRAKEN] =
-        std::make_shared<MarketDataServiceKraken>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KRAKEN] = [this]() {
+      return std::make_shared<MarketDataServiceKraken>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KRAKEN_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KRAKEN_FUTURES] =
-        std::make_shared<MarketDataServiceKrakenFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KRAKEN_FUTURES] = [this]() {
+      return std::make_shared<MarketDataServiceKrakenFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITSTAMP
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITSTAMP] =
-        std::make_shared<MarketDataServiceBitstamp>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITSTAMP] = [this]() {
+      return std::make_shared<MarketDataServiceBitstamp>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITFINEX
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITFINEX] =
-        std::make_shared<MarketDataServiceBitfinex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITFINEX] = [this]() {
+      return std::make_shared<MarketDataServiceBitfinex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITMEX
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITMEX] =
-        std::make_shared<MarketDataServiceBitmex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITMEX] = [this]() {
+      return std::make_shared<MarketDataServiceBitmex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE_US
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE_US] =
-        std::make_shared<MarketDataServiceBinanceUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE_US] = [this]() {
+      return std::make_shared<MarketDataServiceBinanceUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE] =
-        std::make_shared<MarketDataServiceBinance>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE] = [this]() {
+      return std::make_shared<MarketDataServiceBinance>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE_USDS_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES] =
-        std::make_shared<MarketDataServiceBinanceUsdsFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES] = [this]() {
+      return std::make_shared<MarketDataServiceBinanceUsdsFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE_COIN_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE_COIN_FUTURES] =
-        std::make_shared<MarketDataServiceBinanceCoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BINANCE_COIN_FUTURES] = [this]() {
+      return std::make_shared<MarketDataServiceBinanceCoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_HUOBI
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_HUOBI] =
-        std::make_shared<MarketDataServiceHuobi>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_HUOBI] = [this]() {
+      return std::make_shared<MarketDataServiceHuobi>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_HUOBI_USDT_SWAP
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_HUOBI_USDT_SWAP] =
-        std::make_shared<MarketDataServiceHuobiUsdtSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_HUOBI_USDT_SWAP] = [this]() {
+      return std::make_shared<MarketDataServiceHuobiUsdtSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_HUOBI_COIN_SWAP
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_HUOBI_COIN_SWAP] =
-        std::make_shared<MarketDataServiceHuobiCoinSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_HUOBI_COIN_SWAP] = [this]() {
+      return std::make_shared<MarketDataServiceHuobiCoinSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_OKX
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_OKX] =
-        std::make_shared<MarketDataServiceOkx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_OKX] = [this]() {
+      return std::make_shared<MarketDataServiceOkx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_ERISX
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_ERISX] =
-        std::make_shared<MarketDataServiceErisx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_ERISX] = [this]() {
+      return std::make_shared<MarketDataServiceErisx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KUCOIN
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KUCOIN] =
-        std::make_shared<MarketDataServiceKucoin>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KUCOIN] = [this]() {
+      return std::make_shared<MarketDataServiceKucoin>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KUCOIN_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KUCOIN_FUTURES] =
-        std::make_shared<MarketDataServiceKucoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_KUCOIN_FUTURES] = [this]() {
+      return std::make_shared<MarketDataServiceKucoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_FTX
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_FTX] =
-        std::make_shared<MarketDataServiceFtx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_FTX] = [this]() {
+      return std::make_shared<MarketDataServiceFtx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_FTX_US
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_FTX_US] =
-        std::make_shared<MarketDataServiceFtxUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_FTX_US] = [this]() {
+      return std::make_shared<MarketDataServiceFtxUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_DERIBIT
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_DERIBIT] =
-        std::make_shared<MarketDataServiceDeribit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_DERIBIT] = [this]() {
+      return std::make_shared<MarketDataServiceDeribit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_GATEIO
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_GATEIO] =
-        std::make_shared<MarketDataServiceGateio>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_GATEIO] = [this]() {
+      return std::make_shared<MarketDataServiceGateio>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_GATEIO_PERPETUAL_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_GATEIO_PERPETUAL_FUTURES] =
-        std::make_shared<MarketDataServiceGateioPerpetualFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_GATEIO_PERPETUAL_FUTURES] = [this]() {
+      return std::make_shared<MarketDataServiceGateioPerpetualFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_CRYPTOCOM
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_CRYPTOCOM] =
-        std::make_shared<MarketDataServiceCryptocom>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_CRYPTOCOM] = [this]() {
+      return std::make_shared<MarketDataServiceCryptocom>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BYBIT
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BYBIT] =
-        std::make_shared<MarketDataServiceBybit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BYBIT] = [this]() {
+      return std::make_shared<MarketDataServiceBybit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BYBIT_DERIVATIVES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BYBIT_DERIVATIVES] =
-        std::make_shared<MarketDataServiceBybitDerivatives>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BYBIT_DERIVATIVES] = [this]() {
+      return std::make_shared<MarketDataServiceBybitDerivatives>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_ASCENDEX
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_ASCENDEX] =
-        std::make_shared<MarketDataServiceAscendex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_ASCENDEX] = [this]() {
+      return std::make_shared<MarketDataServiceAscendex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITGET
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITGET] =
-        std::make_shared<MarketDataServiceBitget>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITGET] = [this]() {
+      return std::make_shared<MarketDataServiceBitget>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITGET_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITGET_FUTURES] =
-        std::make_shared<MarketDataServiceBitgetFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITGET_FUTURES] = [this]() {
+      return std::make_shared<MarketDataServiceBitgetFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITMART
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITMART] =
-        std::make_shared<MarketDataServiceBitmart>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_BITMART] = [this]() {
+      return std::make_shared<MarketDataServiceBitmart>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_MEXC
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_MEXC] =
-        std::make_shared<MarketDataServiceMexc>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_MEXC] = [this]() {
+      return std::make_shared<MarketDataServiceMexc>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_MEXC_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_MEXC_FUTURES] =
-        std::make_shared<MarketDataServiceMexcFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_MEXC_FUTURES] = [this]() {
+      return std::make_shared<MarketDataServiceMexcFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_WHITEBIT
-    this->serviceByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_WHITEBIT] =
-        std::make_shared<MarketDataServiceWhitebit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_MARKET_DATA][CCAPI_EXCHANGE_NAME_WHITEBIT] = [this]() {
+      return std::make_shared<MarketDataServiceWhitebit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #endif
 #ifdef CCAPI_ENABLE_SERVICE_EXECUTION_MANAGEMENT
 #ifdef CCAPI_ENABLE_EXCHANGE_COINBASE
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_COINBASE] =
-        std::make_shared<ExecutionManagementServiceCoinbase>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_COINBASE] = [this]() {
+      return std::make_shared<ExecutionManagementServiceCoinbase>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_GEMINI
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_GEMINI] =
-        std::make_shared<ExecutionManagementServiceGemini>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_GEMINI] = [this]() {
+      return std::make_shared<ExecutionManagementServiceGemini>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KRAKEN
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KRAKEN] =
-        std::make_shared<ExecutionManagementServiceKraken>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KRAKEN] = [this]() {
+      return std::make_shared<ExecutionManagementServiceKraken>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KRAKEN_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KRAKEN_FUTURES] =
-        std::make_shared<ExecutionManagementServiceKrakenFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KRAKEN_FUTURES] = [this]() {
+      return std::make_shared<ExecutionManagementServiceKrakenFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITSTAMP
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITSTAMP] =
-        std::make_shared<ExecutionManagementServiceBitstamp>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITSTAMP] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBitstamp>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITFINEX
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITFINEX] =
-        std::make_shared<ExecutionManagementServiceBitfinex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITFINEX] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBitfinex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITMEX
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITMEX] =
-        std::make_shared<ExecutionManagementServiceBitmex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITMEX] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBitmex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE_US
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_US] =
-        std::make_shared<ExecutionManagementServiceBinanceUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_US] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBinanceUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE] =
-        std::make_shared<ExecutionManagementServiceBinance>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBinance>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 // #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE_MARGIN
-//     this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_MARGIN] =
-//         std::make_shared<ExecutionManagementServiceBinanceMargin>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_MARGIN] = [this]() {
+//       return std::make_shared<ExecutionManagementServiceBinanceMargin>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     };
 // #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE_USDS_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES] =
-        std::make_shared<ExecutionManagementServiceBinanceUsdsFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBinanceUsdsFutures>(this->internalEventHandler, sessionOptions, sessionConfigs,
+                                                                            this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BINANCE_COIN_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_COIN_FUTURES] =
-        std::make_shared<ExecutionManagementServiceBinanceCoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BINANCE_COIN_FUTURES] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBinanceCoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs,
+                                                                            this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_HUOBI
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_HUOBI] =
-        std::make_shared<ExecutionManagementServiceHuobi>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_HUOBI] = [this]() {
+      return std::make_shared<ExecutionManagementServiceHuobi>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_HUOBI_USDT_SWAP
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_HUOBI_USDT_SWAP] =
-        std::make_shared<ExecutionManagementServiceHuobiUsdtSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_HUOBI_USDT_SWAP] = [this]() {
+      return std::make_shared<ExecutionManagementServiceHuobiUsdtSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_HUOBI_COIN_SWAP
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_HUOBI_COIN_SWAP] =
-        std::make_shared<ExecutionManagementServiceHuobiCoinSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_HUOBI_COIN_SWAP] = [this]() {
+      return std::make_shared<ExecutionManagementServiceHuobiCoinSwap>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_OKX
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_OKX] =
-        std::make_shared<ExecutionManagementServiceOkx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_OKX] = [this]() {
+      return std::make_shared<ExecutionManagementServiceOkx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_ERISX
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_ERISX] =
-        std::make_shared<ExecutionManagementServiceErisx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_ERISX] = [this]() {
+      return std::make_shared<ExecutionManagementServiceErisx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KUCOIN
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KUCOIN] =
-        std::make_shared<ExecutionManagementServiceKucoin>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KUCOIN] = [this]() {
+      return std::make_shared<ExecutionManagementServiceKucoin>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_KUCOIN_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KUCOIN_FUTURES] =
-        std::make_shared<ExecutionManagementServiceKucoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_KUCOIN_FUTURES] = [this]() {
+      return std::make_shared<ExecutionManagementServiceKucoinFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_FTX
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_FTX] =
-        std::make_shared<ExecutionManagementServiceFtx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_FTX] = [this]() {
+      return std::make_shared<ExecutionManagementServiceFtx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_FTX_US
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_FTX_US] =
-        std::make_shared<ExecutionManagementServiceFtxUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_FTX_US] = [this]() {
+      return std::make_shared<ExecutionManagementServiceFtxUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_DERIBIT
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_DERIBIT] =
-        std::make_shared<ExecutionManagementServiceDeribit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_DERIBIT] = [this]() {
+      return std::make_shared<ExecutionManagementServiceDeribit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_GATEIO
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_GATEIO] =
-        std::make_shared<ExecutionManagementServiceGateio>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_GATEIO] = [this]() {
+      return std::make_shared<ExecutionManagementServiceGateio>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_GATEIO_PERPETUAL_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_GATEIO_PERPETUAL_FUTURES] =
-        std::make_shared<ExecutionManagementServiceGateioPerpetualFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_GATEIO_PERPETUAL_FUTURES] = [this]() {
+      return std::make_shared<ExecutionManagementServiceGateioPerpetualFutures>(this->internalEventHandler, sessionOptions, sessionConfigs,
+                                                                                this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_CRYPTOCOM
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_CRYPTOCOM] =
-        std::make_shared<ExecutionManagementServiceCryptocom>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_CRYPTOCOM] = [this]() {
+      return std::make_shared<ExecutionManagementServiceCryptocom>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BYBIT
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BYBIT] =
-        std::make_shared<ExecutionManagementServiceBybit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BYBIT] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBybit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BYBIT_DERIVATIVES
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BYBIT_DERIVATIVES] =
-        std::make_shared<ExecutionManagementServiceBybitDerivatives>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BYBIT_DERIVATIVES] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBybitDerivatives>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_ASCENDEX
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_ASCENDEX] =
-        std::make_shared<ExecutionManagementServiceAscendex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_ASCENDEX] = [this]() {
+      return std::make_shared<ExecutionManagementServiceAscendex>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITGET
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITGET] =
-        std::make_shared<ExecutionManagementServiceBitget>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITGET] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBitget>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITGET_FUTURES
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITGET_FUTURES] =
-        std::make_shared<ExecutionManagementServiceBitgetFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITGET_FUTURES] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBitgetFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_BITMART
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITMART] =
-        std::make_shared<ExecutionManagementServiceBitmart>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_BITMART] = [this]() {
+      return std::make_shared<ExecutionManagementServiceBitmart>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_MEXC
-    this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_MEXC] =
-        std::make_shared<ExecutionManagementServiceMexc>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_MEXC] = [this]() {
+      return std::make_shared<ExecutionManagementServiceMexc>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 // #ifdef CCAPI_ENABLE_EXCHANGE_MEXC_FUTURES
-//     this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_MEXC_FUTURES] =
-//         std::make_shared<ExecutionManagementServiceMexcFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_MEXC_FUTURES] = [this]() {
+//       return std::make_shared<ExecutionManagementServiceMexcFutures>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     };
 // #endif
 // #ifdef CCAPI_ENABLE_EXCHANGE_WHITEBIT
-//     this->serviceByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_WHITEBIT] =
-//         std::make_shared<ExecutionManagementServiceWhitebit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     this->serviceFactoryByServiceNameExchangeMap[CCAPI_EXECUTION_MANAGEMENT][CCAPI_EXCHANGE_NAME_WHITEBIT] = [this]() {
+//       return std::make_shared<ExecutionManagementServiceWhitebit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     };
 // #endif
 #endif
 
 #ifdef CCAPI_ENABLE_SERVICE_FIX
 #ifdef CCAPI_ENABLE_EXCHANGE_COINBASE
-    this->serviceByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_COINBASE] =
-        std::make_shared<FixServiceCoinbase>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_COINBASE] = [this]() {
+      return std::make_shared<FixServiceCoinbase>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 // #ifdef CCAPI_ENABLE_EXCHANGE_GEMINI
-//     this->serviceByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_GEMINI] =
-//         std::make_shared<FixServiceGemini>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     this->serviceFactoryByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_GEMINI] = [this]() {
+//       return std::make_shared<FixServiceGemini>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     };
 // #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_FTX
-    this->serviceByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_FTX] =
-        std::make_shared<FixServiceFtx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_FTX] = [this]() {
+      return std::make_shared<FixServiceFtx>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 #ifdef CCAPI_ENABLE_EXCHANGE_FTX_US
-    this->serviceByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_FTX_US] =
-        std::make_shared<FixServiceFtxUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    this->serviceFactoryByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_FTX_US] = [this]() {
+      return std::make_shared<FixServiceFtxUs>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+    };
 #endif
 // #ifdef CCAPI_ENABLE_EXCHANGE_DERIBIT
-//     this->serviceByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_DERIBIT] =
-//         std::make_shared<FixServiceDeribit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     this->serviceFactoryByServiceNameExchangeMap[CCAPI_FIX][CCAPI_EXCHANGE_NAME_DERIBIT] = [this]() {
+//       return std::make_shared<FixServiceDeribit>(this->internalEventHandler, sessionOptions, sessionConfigs, this->serviceContextPtr);
+//     };
 // #endif
 #endif
-    for (const auto& x : this->serviceByServiceNameExchangeMap) {
+    int numService = 0;
+    for (const auto& x : this->serviceFactoryByServiceNameExchangeMap) {
       auto serviceName = x.first;
       for (const auto& y : x.second) {
         auto exchange = y.first;
         CCAPI_LOGGER_INFO("enabled service: " + serviceName + ", exchange: " + exchange);
+        if (!this->sessionOptions.enableLazyServiceConstruction) {
+          this->getService(serviceName, exchange);
+        }
+        ++numService;
       }
     }
+    if (this->sessionOptions.enableLatencyStats && this->sessionOptions.latencyStatsLogIntervalMilliseconds > 0) {
+      boost::asio::post(*this->serviceContextPtr->ioContextPtr, [this]() {
+        this->latencyStatsLogTimerPtr = std::make_shared<steady_timer>(*this->serviceContextPtr->ioContextPtr);
+        this->setLatencyStatsLogTimer();
+      });
+    }
+    double startSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTp).count();
+    if (this->metricsRegistryPtr) {
+      this->metricsRegistryPtr->getGauge("ccapi_session_start_seconds", {}, "Time taken by Session::start, including the services constructed in it.")
+          .set(startSeconds);
+    }
+    CCAPI_LOGGER_INFO("session started in " + toString(startSeconds) + " seconds with " + toString(this->getServiceList().size()) + " of " +
+                      toString(numService) + " enabled services constructed");
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
   virtual void stop() {
@@ -621,13 +741,18 @@ class Session {
       this->eventDispatcher->stop();
     }
 #endif
-    for (const auto& x : this->serviceByServiceNameExchangeMap) {
-      for (const auto& y : x.second) {
-        y.second->stop();
-      }
+    for (const auto& servicePtr : this->getServiceList()) {
+      servicePtr->stop();
     }
     this->serviceContextPtr->stop();
     this->t.join();
+    this->latencyStatsLogTimerPtr.reset();
+    this->marketDepthFanOutTimerPtr.reset();
+    this->coalescedEventTimerPtr.reset();
+    if (this->metricsHttpServerPtr) {
+      this->metricsHttpServerPtr->stop();
+      this->metricsHttpServerPtr.reset();
+    }
   }
   virtual void subscribe(Subscription& subscription) {
     std::vector<Subscription> subscriptionList;
@@ -636,15 +761,28 @@ class Session {
   }
   virtual void subscribe(std::vector<Subscription>& subscriptionList) {
     CCAPI_LOGGER_FUNCTION_ENTER;
+    std::vector<Subscription> mergedSubscriptionList;
+    if (this->sessionOptions.enableMarketDepthFanOut) {
+      mergedSubscriptionList = this->marketDepthFanOut.merge(subscriptionList);
+      if (this->marketDepthFanOut.isFlushNeeded()) {
+        boost::asio::post(*this->serviceContextPtr->ioContextPtr, [this]() {
+          if (!this->marketDepthFanOutTimerPtr) {
+            this->marketDepthFanOutTimerPtr = std::make_shared<steady_timer>(*this->serviceContextPtr->ioContextPtr);
+            this->setMarketDepthFanOutTimer(UtilTime::now());
+          }
+        });
+      }
+    }
+    const auto& subscriptionListToSend = this->sessionOptions.enableMarketDepthFanOut ? mergedSubscriptionList : subscriptionList;
     std::map<std::string, std::vector<Subscription> > subscriptionListByServiceNameMap;
-    for (const auto& subscription : subscriptionList) {
+    for (const auto& subscription : subscriptionListToSend) {
       auto serviceName = subscription.getServiceName();
       subscriptionListByServiceNameMap[serviceName].push_back(subscription);
     }
     for (const auto& x : subscriptionListByServiceNameMap) {
       auto serviceName = x.first;
       auto subscriptionList = x.second;
-      if (this->serviceByServiceNameExchangeMap.find(serviceName) == this->serviceByServiceNameExchangeMap.end()) {
+      if (!this->isServiceEnabled(serviceName)) {
         this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE,
                       "please enable service: " + serviceName + ", and the exchanges that you want");
         return;
@@ -702,12 +840,12 @@ class Session {
         for (auto& subscriptionListByExchange : subscriptionListByExchangeMap) {
           auto exchange = subscriptionListByExchange.first;
           auto subscriptionList = subscriptionListByExchange.second;
-          std::map<std::string, std::shared_ptr<Service> >& serviceByExchangeMap = this->serviceByServiceNameExchangeMap.at(serviceName);
-          if (serviceByExchangeMap.find(exchange) == serviceByExchangeMap.end()) {
+          auto servicePtr = this->getService(serviceName, exchange);
+          if (!servicePtr) {
             this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, "please enable exchange: " + exchange);
             return;
           }
-          serviceByExchangeMap.at(exchange)->subscribe(subscriptionList);
+          servicePtr->subscribe(subscriptionList);
         }
       } else if (serviceName == CCAPI_EXECUTION_MANAGEMENT) {
         std::map<std::string, std::vector<Subscription> > subscriptionListByExchangeMap;
@@ -719,12 +857,12 @@ class Session {
         for (auto& subscriptionListByExchange : subscriptionListByExchangeMap) {
           auto exchange = subscriptionListByExchange.first;
           auto subscriptionList = subscriptionListByExchange.second;
-          std::map<std::string, std::shared_ptr<Service> >& serviceByExchangeMap = this->serviceByServiceNameExchangeMap.at(serviceName);
-          if (serviceByExchangeMap.find(exchange) == serviceByExchangeMap.end()) {
+          auto servicePtr = this->getService(serviceName, exchange);
+          if (!servicePtr) {
             this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, "please enable exchange: " + exchange);
             return;
           }
-          serviceByExchangeMap.at(exchange)->subscribe(subscriptionList);
+          servicePtr->subscribe(subscriptionList);
         }
       }
     }
@@ -733,17 +871,17 @@ class Session {
   virtual void subscribeByFix(Subscription& subscription) {
     auto serviceName = subscription.getServiceName();
     CCAPI_LOGGER_DEBUG("serviceName = " + serviceName);
-    if (this->serviceByServiceNameExchangeMap.find(serviceName) == this->serviceByServiceNameExchangeMap.end()) {
+    if (!this->isServiceEnabled(serviceName)) {
       this->onError(Event::Type::FIX_STATUS, Message::Type::FIX_FAILURE, "please enable service: " + serviceName + ", and the exchanges that you want");
       return;
     }
     auto exchange = subscription.getExchange();
-    std::map<std::string, std::shared_ptr<Service> >& serviceByExchangeMap = this->serviceByServiceNameExchangeMap.at(serviceName);
-    if (serviceByExchangeMap.find(exchange) == serviceByExchangeMap.end()) {
+    auto servicePtr = this->getService(serviceName, exchange);
+    if (!servicePtr) {
       this->onError(Event::Type::FIX_STATUS, Message::Type::FIX_FAILURE, "please enable exchange: " + exchange);
       return;
     }
-    serviceByExchangeMap.at(exchange)->subscribeByFix(subscription);
+    servicePtr->subscribeByFix(subscription);
   }
   virtual void subscribeByFix(std::vector<Subscription>& subscriptionList) {
     for (auto& x : subscriptionList) {
@@ -753,14 +891,75 @@ class Session {
   virtual void onEvent(Event& event, Queue<Event>* eventQueue) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     CCAPI_LOGGER_TRACE("event = " + toString(event));
+    if (this->sessionOptions.enableMarketDepthFanOut && !this->marketDepthFanOut.fanOut(event)) {
+      return;
+    }
+    if (this->sessionOptions.enableEventCoalescing && !eventQueue && this->serviceContextPtr->ioContextPtr->get_executor().running_in_this_thread()) {
+      if (event.getType() == Event::Type::SUBSCRIPTION_DATA) {
+        this->coalesceEvent(event);
+        return;
+      }
+      this->flushCoalescedEvent();
+    }
+    this->deliverEvent(event, eventQueue);
+    CCAPI_LOGGER_FUNCTION_EXIT;
+  }
+  // the subscription data events that arrive while the io_context works through the completions that are already ready are merged into one, which is delivered
+  // by an already expired timer that completes behind them or as soon as it is older than sessionOptions.eventCoalescingMaxDelayMicroseconds. Unlike a posted
+  // handler, the timer's handler is cancelled when the session stops.
+  void coalesceEvent(Event& event) {
+    if (!this->hasCoalescedEvent) {
+      this->coalescedEvent = std::move(event);
+      this->coalescedEventTp = UtilTime::now();
+      this->hasCoalescedEvent = true;
+      if (!this->coalescedEventTimerPtr) {
+        this->coalescedEventTimerPtr = std::make_shared<steady_timer>(*this->serviceContextPtr->ioContextPtr);
+      }
+      this->coalescedEventTimerPtr->expires_after(std::chrono::seconds(0));
+      this->coalescedEventTimerPtr->async_wait([this](const boost::system::error_code& ec) {
+        if (ec) {
+          return;
+        }
+        this->flushCoalescedEvent();
+      });
+      return;
+    }
+    this->coalescedEvent.addMessages(event);
+    if (this->sessionOptions.eventCoalescingMaxDelayMicroseconds > 0 &&
+        UtilTime::now() - this->coalescedEventTp >= std::chrono::microseconds(this->sessionOptions.eventCoalescingMaxDelayMicroseconds)) {
+      this->flushCoalescedEvent();
+    }
+  }
+  void flushCoalescedEvent() {
+    if (this->hasCoalescedEvent) {
+      this->hasCoalescedEvent = false;
+      Event event = std::move(this->coalescedEvent);
+      this->coalescedEvent = Event();
+      this->deliverEvent(event, nullptr);
+    }
+  }
+  void deliverEvent(Event& event, Queue<Event>* eventQueue) {
+    auto readTsc = event.getReadTsc();
+    auto latencyStatsPtr = event.getLatencyStatsPtr();
+#ifndef _WIN32
+    if (this->sharedMemoryPublisherPtr) {
+      this->sharedMemoryPublisherPtr->publish(event);
+    }
+#endif
     if (eventQueue) {
       eventQueue->pushBack(std::move(event));
+      if (latencyStatsPtr) {
+        latencyStatsPtr->record(LatencyStats::Stage::DISPATCHER_ENQUEUE, readTsc, TscClock::now());
+      }
     } else {
       if (this->eventHandler) {
         CCAPI_LOGGER_TRACE("handle event in immediate mode");
 #ifdef CCAPI_USE_SINGLE_THREAD
         bool shouldContinue = true;
         try {
+          if (latencyStatsPtr) {
+            latencyStatsPtr->record(LatencyStats::Stage::HANDLER_INVOCATION, readTsc, TscClock::now());
+          }
           this->eventHandler->processEvent(event, this);
         } catch (const std::runtime_error& e) {
           CCAPI_LOGGER_ERROR(e.what());
@@ -769,6 +968,10 @@ class Session {
         this->eventDispatcher->dispatch([that = this, event = std::move(event)] {
           bool shouldContinue = true;
           try {
+            auto latencyStatsPtr = event.getLatencyStatsPtr();
+            if (latencyStatsPtr) {
+              latencyStatsPtr->record(LatencyStats::Stage::HANDLER_INVOCATION, event.getReadTsc(), TscClock::now());
+            }
             shouldContinue = that->eventHandler->processEvent(event, that);
           } catch (const std::runtime_error& e) {
             CCAPI_LOGGER_ERROR(e.what());
@@ -778,29 +981,33 @@ class Session {
             that->eventDispatcher->pause();
           }
         });
+        if (latencyStatsPtr) {
+          latencyStatsPtr->record(LatencyStats::Stage::DISPATCHER_ENQUEUE, readTsc, TscClock::now());
+        }
 #endif
       } else {
         CCAPI_LOGGER_TRACE("handle event in batching mode");
         this->eventQueue.pushBack(std::move(event));
+        if (latencyStatsPtr) {
+          latencyStatsPtr->record(LatencyStats::Stage::DISPATCHER_ENQUEUE, readTsc, TscClock::now());
+        }
       }
     }
-    CCAPI_LOGGER_FUNCTION_EXIT;
   }
   virtual void sendRequestByFix(Request& request) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     auto serviceName = request.getServiceName();
     CCAPI_LOGGER_DEBUG("serviceName = " + serviceName);
-    if (this->serviceByServiceNameExchangeMap.find(serviceName) == this->serviceByServiceNameExchangeMap.end()) {
+    if (!this->isServiceEnabled(serviceName)) {
       this->onError(Event::Type::FIX_STATUS, Message::Type::FIX_FAILURE, "please enable service: " + serviceName + ", and the exchanges that you want");
       return;
     }
-    std::map<std::string, std::shared_ptr<Service> >& serviceByExchangeMap = this->serviceByServiceNameExchangeMap.at(serviceName);
     auto exchange = request.getExchange();
-    if (serviceByExchangeMap.find(exchange) == serviceByExchangeMap.end()) {
+    auto servicePtr = this->getService(serviceName, exchange);
+    if (!servicePtr) {
       this->onError(Event::Type::FIX_STATUS, Message::Type::FIX_FAILURE, "please enable exchange: " + exchange);
       return;
     }
-    std::shared_ptr<Service>& servicePtr = serviceByExchangeMap.at(exchange);
     auto now = UtilTime::now();
     servicePtr->sendRequestByFix(request, now);
     CCAPI_LOGGER_FUNCTION_EXIT;
@@ -814,17 +1021,16 @@ class Session {
     CCAPI_LOGGER_FUNCTION_ENTER;
     auto serviceName = request.getServiceName();
     CCAPI_LOGGER_DEBUG("serviceName = " + serviceName);
-    if (this->serviceByServiceNameExchangeMap.find(serviceName) == this->serviceByServiceNameExchangeMap.end()) {
+    if (!this->isServiceEnabled(serviceName)) {
       this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, "please enable service: " + serviceName + ", and the exchanges that you want");
       return;
     }
-    std::map<std::string, std::shared_ptr<Service> >& serviceByExchangeMap = this->serviceByServiceNameExchangeMap.at(serviceName);
     auto exchange = request.getExchange();
-    if (serviceByExchangeMap.find(exchange) == serviceByExchangeMap.end()) {
+    auto servicePtr = this->getService(serviceName, exchange);
+    if (!servicePtr) {
       this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, "please enable exchange: " + exchange);
       return;
     }
-    std::shared_ptr<Service>& servicePtr = serviceByExchangeMap.at(exchange);
     auto now = UtilTime::now();
     servicePtr->sendRequestByWebsocket(request, now);
     CCAPI_LOGGER_FUNCTION_EXIT;
@@ -849,27 +1055,37 @@ class Session {
       request.setIndex(i);
       auto serviceName = request.getServiceName();
       CCAPI_LOGGER_DEBUG("serviceName = " + serviceName);
-      if (this->serviceByServiceNameExchangeMap.find(serviceName) == this->serviceByServiceNameExchangeMap.end()) {
+      if (!this->isServiceEnabled(serviceName)) {
         this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE,
                       "please enable service: " + serviceName + ", and the exchanges that you want", eventQueuePtr);
         return;
       }
-      std::map<std::string, std::shared_ptr<Service> >& serviceByExchangeMap = this->serviceByServiceNameExchangeMap.at(serviceName);
       auto exchange = request.getExchange();
-      if (serviceByExchangeMap.find(exchange) == serviceByExchangeMap.end()) {
+      auto servicePtr = this->getService(serviceName, exchange);
+      if (!servicePtr) {
         this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, "please enable exchange: " + exchange, eventQueuePtr);
         return;
       }
-      std::shared_ptr<Service>& servicePtr = serviceByExchangeMap.at(exchange);
       std::string key = serviceName + exchange;
       // if (eventQueuePtr && serviceNameExchangeSet.find(key) == serviceNameExchangeSet.end()) {
       //   // servicePtr->setEventHandler(std::bind(&Session::onEvent, this, std::placeholders::_1, eventQueuePtr));
       //   serviceNameExchangeSet.insert(key);
       // }
       auto now = UtilTime::now();
-      auto futurePtr = servicePtr->sendRequest(request, !!eventQueuePtr, now, delayMilliseconds, eventQueuePtr);
-      if (eventQueuePtr) {
-        futurePtrList.push_back(futurePtr);
+      if (Request::isBatchOperation(request.getOperation())) {
+        // the parts of a batch are sent concurrently over the pooled http connections, their responses are demultiplexed into one message per order
+        for (auto& x : request.splitBatch(servicePtr->getBatchSizeMax(request.getOperation()))) {
+          x.setIndex(i);
+          auto futurePtr = servicePtr->sendRequest(x, !!eventQueuePtr, now, delayMilliseconds, eventQueuePtr);
+          if (eventQueuePtr) {
+            futurePtrList.push_back(futurePtr);
+          }
+        }
+      } else {
+        auto futurePtr = servicePtr->sendRequest(request, !!eventQueuePtr, now, delayMilliseconds, eventQueuePtr);
+        if (eventQueuePtr) {
+          futurePtrList.push_back(futurePtr);
+        }
       }
       ++i;
     }
@@ -948,27 +1164,181 @@ class Session {
       }
     });
   }
-  void purgeHttpConnectionPool(const std::string& serviceName = "", const std::string& exchangeName = "") {
+  // the service of the exchange, constructed here on first use if SessionOptions::enableLazyServiceConstruction is set; nullptr if the service or the
+  // exchange isn't enabled
+  std::shared_ptr<Service> getService(const std::string& serviceName, const std::string& exchange) {
+    std::lock_guard<std::mutex> lock(this->serviceMutex);
+    auto it = this->serviceByServiceNameExchangeMap.find(serviceName);
+    if (it != this->serviceByServiceNameExchangeMap.end() && it->second.find(exchange) != it->second.end()) {
+      return it->second.at(exchange);
+    }
+    auto factoryIt = this->serviceFactoryByServiceNameExchangeMap.find(serviceName);
+    if (factoryIt == this->serviceFactoryByServiceNameExchangeMap.end() || factoryIt->second.find(exchange) == factoryIt->second.end()) {
+      return nullptr;
+    }
+    auto constructionStartTp = std::chrono::steady_clock::now();
+    auto servicePtr = factoryIt->second.at(exchange)();
+    double constructionSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - constructionStartTp).count();
+    CCAPI_LOGGER_INFO("constructed service: " + serviceName + ", exchange: " + exchange + " in " + toString(constructionSeconds) + " seconds");
+    if (this->sessionOptions.enableLatencyStats) {
+      auto& latencyStatsPtr = this->latencyStatsByExchangeMap[exchange];
+      if (!latencyStatsPtr) {
+        latencyStatsPtr = std::make_shared<LatencyStats>(exchange);
+      }
+      servicePtr->setLatencyStatsPtr(latencyStatsPtr);
+    }
+    if (this->sessionOptions.enableRateLimiter) {
+      auto& rateLimiterPtr = this->rateLimiterPtrByExchangeHostMap[exchange][servicePtr->getHostRest()];
+      if (!rateLimiterPtr) {
+        rateLimiterPtr = servicePtr->getRateLimiterPtr();
+      } else {
+        servicePtr->setRateLimiterPtr(rateLimiterPtr);
+      }
+    }
+    if (this->metricsRegistryPtr) {
+      servicePtr->setMetricsRegistryPtr(this->metricsRegistryPtr);
+      this->metricsRegistryPtr
+          ->getGauge("ccapi_service_construction_seconds", {{"service", serviceName}, {"exchange", exchange}}, "Time taken to construct the service.")
+          .set(constructionSeconds);
+    }
+    this->serviceByServiceNameExchangeMap[serviceName][exchange] = servicePtr;
+    return servicePtr;
+  }
+  bool isServiceEnabled(const std::string& serviceName) const {
+    std::lock_guard<std::mutex> lock(this->serviceMutex);
+    return this->serviceFactoryByServiceNameExchangeMap.find(serviceName) != this->serviceFactoryByServiceNameExchangeMap.end() ||
+           this->serviceByServiceNameExchangeMap.find(serviceName) != this->serviceByServiceNameExchangeMap.end();
+  }
+  // the services constructed so far, optionally only those of one service name or exchange
+  std::vector<std::shared_ptr<Service> > getServiceList(const std::string& serviceName = "", const std::string& exchangeName = "") const {
+    std::lock_guard<std::mutex> lock(this->serviceMutex);
+    std::vector<std::shared_ptr<Service> > serviceList;
     for (const auto& x : this->serviceByServiceNameExchangeMap) {
       if (serviceName.empty() || serviceName == x.first) {
         for (const auto& y : x.second) {
           if (exchangeName.empty() || exchangeName == y.first) {
-            y.second->purgeHttpConnectionPool();
+            serviceList.push_back(y.second);
           }
         }
       }
     }
+    return serviceList;
+  }
+  void purgeHttpConnectionPool(const std::string& serviceName = "", const std::string& exchangeName = "") {
+    for (const auto& servicePtr : this->getServiceList(serviceName, exchangeName)) {
+      servicePtr->purgeHttpConnectionPool();
+    }
+  }
+  // requires SessionOptions::enableLatencyStats, returns one summary per exchange and stage
+  std::vector<LatencyStats::Summary> getLatencyStats(const std::string& exchangeName = "") const {
+    std::vector<LatencyStats::Summary> summaryList;
+    std::lock_guard<std::mutex> lock(this->serviceMutex);
+    for (const auto& x : this->latencyStatsByExchangeMap) {
+      if (exchangeName.empty() || exchangeName == x.first) {
+        auto exchangeSummaryList = x.second->getSummaryList();
+        summaryList.insert(summaryList.end(), exchangeSummaryList.begin(), exchangeSummaryList.end());
+      }
+    }
+    return summaryList;
+  }
+  void resetLatencyStats() {
+    std::lock_guard<std::mutex> lock(this->serviceMutex);
+    for (const auto& x : this->latencyStatsByExchangeMap) {
+      x.second->reset();
+    }
+  }
+  // requires SessionOptions::enableMetrics
+  std::vector<MetricsRegistry::Sample> getMetrics() const {
+    if (!this->metricsRegistryPtr) {
+      return {};
+    }
+    return this->metricsRegistryPtr->getSampleList();
+  }
+  // requires SessionOptions::enableMetrics
+  std::string getMetricsPrometheusText() const {
+    if (!this->metricsRegistryPtr) {
+      return "";
+    }
+    return this->metricsRegistryPtr->toPrometheusText();
   }
   void forceCloseWebsocketConnections(const std::string& serviceName = "", const std::string& exchangeName = "") {
-    for (const auto& x : this->serviceByServiceNameExchangeMap) {
-      if (serviceName.empty() || serviceName == x.first) {
-        for (const auto& y : x.second) {
-          if (exchangeName.empty() || exchangeName == y.first) {
-            y.second->forceCloseWebsocketConnections();
-          }
+    for (const auto& servicePtr : this->getServiceList(serviceName, exchangeName)) {
+      servicePtr->forceCloseWebsocketConnections();
+    }
+  }
+  void startMetrics() {
+    this->metricsRegistryPtr = std::make_shared<MetricsRegistry>();
+    this->metricsRegistryPtr->setCallback(MetricsRegistry::Type::GAUGE, "ccapi_event_queue_size", {}, "Number of events waiting in the batching mode queue.",
+                                          [this]() { return static_cast<double>(this->eventQueue.size()); });
+#ifndef CCAPI_USE_SINGLE_THREAD
+    if (this->eventDispatcher) {
+      auto eventDispatcher = this->eventDispatcher;
+      this->metricsRegistryPtr->setCallback(MetricsRegistry::Type::GAUGE, "ccapi_event_dispatcher_backlog", {},
+                                            "Number of events waiting to be handed to the event handler.",
+                                            [eventDispatcher]() { return static_cast<double>(eventDispatcher->getNumPendingOperation()); });
+      this->metricsRegistryPtr->setCallback(MetricsRegistry::Type::COUNTER, "ccapi_event_dispatcher_operations_total", {},
+                                            "Number of operations executed by the event dispatcher.",
+                                            [eventDispatcher]() { return static_cast<double>(eventDispatcher->getNumExecutedOperation()); });
+    }
+#endif
+#ifndef CCAPI_LEGACY_USE_WEBSOCKETPP
+    if (this->serviceContextPtr->tlsSessionCache.isEnabled()) {
+      auto tlsSessionCachePtr = &this->serviceContextPtr->tlsSessionCache;
+      this->metricsRegistryPtr->setCallback(MetricsRegistry::Type::COUNTER, "ccapi_tls_handshakes_total", {{"resumed", "false"}},
+                                            "Number of completed TLS handshakes.",
+                                            [tlsSessionCachePtr]() { return static_cast<double>(tlsSessionCachePtr->getNumFullHandshake()); });
+      this->metricsRegistryPtr->setCallback(MetricsRegistry::Type::COUNTER, "ccapi_tls_handshakes_total", {{"resumed", "true"}},
+                                            "Number of completed TLS handshakes.",
+                                            [tlsSessionCachePtr]() { return static_cast<double>(tlsSessionCachePtr->getNumResumedHandshake()); });
+      this->metricsRegistryPtr->setCallback(MetricsRegistry::Type::GAUGE, "ccapi_tls_session_resumption_hit_ratio", {},
+                                            "Fraction of completed TLS handshakes that resumed a cached session.",
+                                            [tlsSessionCachePtr]() { return tlsSessionCachePtr->getResumptionHitRate(); });
+      this->metricsRegistryPtr->setCallback(MetricsRegistry::Type::GAUGE, "ccapi_tls_handshake_seconds_saved", {},
+                                            "Estimated handshake time saved by session resumption.",
+                                            [tlsSessionCachePtr]() { return tlsSessionCachePtr->getHandshakeSecondsSaved(); });
+    }
+#endif
+    if (this->sessionOptions.metricsHttpPort > 0) {
+      this->metricsHttpServerPtr = std::make_shared<MetricsHttpServer>(*this->serviceContextPtr->ioContextPtr, this->metricsRegistryPtr);
+      boost::asio::post(*this->serviceContextPtr->ioContextPtr, [metricsHttpServerPtr = this->metricsHttpServerPtr, this]() {
+        metricsHttpServerPtr->start(this->sessionOptions.metricsHttpAddress, this->sessionOptions.metricsHttpPort);
+      });
+    }
+  }
+  // delivers the conflated market depth views whose interval has ended even if no upstream message has arrived since
+  void setMarketDepthFanOutTimer(const TimePoint& tp) {
+    this->marketDepthFanOutTimerPtr->expires_after(tp - UtilTime::now());
+    this->marketDepthFanOutTimerPtr->async_wait([this](const boost::system::error_code& ec) {
+      if (ec) {
+        return;
+      }
+      Event event;
+      auto nextFlushTp = this->marketDepthFanOut.flush(event, UtilTime::now());
+      if (!event.getMessageList().empty()) {
+        if (this->sessionOptions.enableEventCoalescing) {
+          this->coalesceEvent(event);
+        } else {
+          this->deliverEvent(event, nullptr);
         }
       }
-    }
+      if (nextFlushTp != TimePoint::max()) {
+        this->setMarketDepthFanOutTimer(nextFlushTp);
+      }
+    });
+  }
+  void setLatencyStatsLogTimer() {
+    this->latencyStatsLogTimerPtr->expires_after(std::chrono::milliseconds(this->sessionOptions.latencyStatsLogIntervalMilliseconds));
+    this->latencyStatsLogTimerPtr->async_wait([this](const boost::system::error_code& ec) {
+      if (ec) {
+        return;
+      }
+      for (const auto& summary : this->getLatencyStats()) {
+        if (summary.count > 0) {
+          CCAPI_LOGGER_INFO(summary.toString());
+        }
+      }
+      this->setLatencyStatsLogTimer();
+    });
   }
 #endif
 #ifndef CCAPI_EXPOSE_INTERNAL
@@ -984,10 +1354,26 @@ class Session {
 #endif
   ServiceContext* serviceContextPtr{nullptr};
   std::map<std::string, std::map<std::string, std::shared_ptr<Service> > > serviceByServiceNameExchangeMap;
+  std::map<std::string, std::map<std::string, std::function<std::shared_ptr<Service>()> > > serviceFactoryByServiceNameExchangeMap;
+  mutable std::mutex serviceMutex;
   std::thread t;
   Queue<Event> eventQueue;
   std::function<void(Event& event, Queue<Event>* eventQueue)> internalEventHandler;
   std::map<std::string, std::shared_ptr<steady_timer> > delayTimerByIdMap;
+  std::map<std::string, std::shared_ptr<LatencyStats> > latencyStatsByExchangeMap;
+  std::map<std::string, std::map<std::string, std::shared_ptr<Service::RequestRateLimiter> > > rateLimiterPtrByExchangeHostMap;
+  std::shared_ptr<steady_timer> latencyStatsLogTimerPtr;
+  std::shared_ptr<MetricsRegistry> metricsRegistryPtr;
+  std::shared_ptr<MetricsHttpServer> metricsHttpServerPtr;
+  MarketDepthFanOut marketDepthFanOut;
+  std::shared_ptr<steady_timer> marketDepthFanOutTimerPtr;
+  Event coalescedEvent;
+  TimePoint coalescedEventTp{std::chrono::seconds(0)};
+  bool hasCoalescedEvent{};
+  std::shared_ptr<steady_timer> coalescedEventTimerPtr;
+#ifndef _WIN32
+  std::shared_ptr<SharedMemoryPublisher> sharedMemoryPublisherPtr;
+#endif
 };
 } /* namespace ccapi */
 #endif  // INCLUDE_CCAPI_CPP_CCAPI_SESSION_H_
@@ -29,7 +29,31 @@ class SessionOptions CCAPI_FINAL {
                          ", httpRequestTimeoutMilliseconds = " + ccapi::toString(httpRequestTimeoutMilliseconds) +
                          ", httpConnectionPoolMaxSize = " + ccapi::toString(httpConnectionPoolMaxSize) +
                          ", httpConnectionKeepAliveTimeoutSeconds = " + ccapi::toString(httpConnectionKeepAliveTimeoutSeconds) +
-                         ", enableOneHttpConnectionPerRequest = " + ccapi::toString(enableOneHttpConnectionPerRequest) + "]";
+                         ", enableOneHttpConnectionPerRequest = " + ccapi::toString(enableOneHttpConnectionPerRequest) +
+                         ", enableLatencyStats = " + ccapi::toString(enableLatencyStats) +
+                         ", latencyStatsLogIntervalMilliseconds = " + ccapi::toString(latencyStatsLogIntervalMilliseconds) +
+                         ", enableMetrics = " + ccapi::toString(enableMetrics) + ", metricsHttpAddress = " + metricsHttpAddress +
+                         ", metricsHttpPort = " + ccapi::toString(metricsHttpPort) + ", enableRateLimiter = " + ccapi::toString(enableRateLimiter) +
+                         ", enableHedgedRequest = " + ccapi::toString(enableHedgedRequest) +
+                         ", hedgedRequestDelayPercentile = " + ccapi::toString(hedgedRequestDelayPercentile) +
+                         ", hedgedRequestDelayMillisecondsDefault = " + ccapi::toString(hedgedRequestDelayMillisecondsDefault) +
+                         ", hedgedRequestLocalIpAddress = " + hedgedRequestLocalIpAddress + ", sharedMemoryPublishName = " + sharedMemoryPublishName +
+                         ", sharedMemorySlotSize = " + ccapi::toString(sharedMemorySlotSize) +
+                         ", sharedMemoryNumSlot = " + ccapi::toString(sharedMemoryNumSlot) +
+                         ", enableMarketDepthFanOut = " + ccapi::toString(enableMarketDepthFanOut) +
+                         ", enableOrderBookRetention = " + ccapi::toString(enableOrderBookRetention) +
+                         ", orderBookRetentionBufferLevels = " + ccapi::toString(orderBookRetentionBufferLevels) +
+                         ", enableEventCoalescing = " + ccapi::toString(enableEventCoalescing) +
+                         ", eventCoalescingMaxDelayMicroseconds = " + ccapi::toString(eventCoalescingMaxDelayMicroseconds) +
+                         ", enableWebsocketPermessageDeflate = " + ccapi::toString(enableWebsocketPermessageDeflate) +
+                         ", enableTlsSessionResumption = " + ccapi::toString(enableTlsSessionResumption) +
+                         ", socketReceiveBufferSize = " + ccapi::toString(socketReceiveBufferSize) +
+                         ", socketSendBufferSize = " + ccapi::toString(socketSendBufferSize) +
+                         ", socketBusyPollMicroseconds = " + ccapi::toString(socketBusyPollMicroseconds) +
+                         ", enableTcpQuickAck = " + ccapi::toString(enableTcpQuickAck) +
+                         ", tcpQuickAckRearmIntervalMilliseconds = " + ccapi::toString(tcpQuickAckRearmIntervalMilliseconds) +
+                         ", enableKernelReceiveTimestamp = " + ccapi::toString(enableKernelReceiveTimestamp) +
+                         ", enableLazyServiceConstruction = " + ccapi::toString(enableLazyServiceConstruction) + "]";
     return output;
   }
   // long warnLateEventMaxMilliseconds{};                      // used to print a warning log message if en event arrives late
@@ -53,6 +77,44 @@ class SessionOptions CCAPI_FINAL {
   long httpConnectionKeepAliveTimeoutSeconds{
       10};  // used to remove a http connection from the http connection pool if it has stayed idle for at least this amount of time
   bool enableOneHttpConnectionPerRequest{};  // create a new http connection for each request
+  bool enableLatencyStats{};  // record per-exchange latency histograms of the websocket hot path, see Session::getLatencyStats
+  long latencyStatsLogIntervalMilliseconds{};  // if set to a positive integer and enableLatencyStats is true, the latency histograms are logged periodically
+  bool enableMetrics{};  // collect runtime metrics (message rates, reconnects, queue depths, http connection pool usage, request latencies), see Session::getMetrics
+  std::string metricsHttpAddress{"127.0.0.1"};  // the address that the metrics http endpoint listens on
+  int metricsHttpPort{};  // if set to a positive integer and enableMetrics is true, the metrics are served in the Prometheus text format on this port
+  bool enableRateLimiter{};  // queue http requests on the client side according to the exchange's documented request weight and order count limits, releasing
+                             // cancels before new orders and new orders before informational requests
+  bool enableHedgedRequest{};  // for CANCEL_ORDER and CANCEL_OPEN_ORDERS, send a duplicate over another http connection if no response has arrived within
+                               // the hedge delay; the first response wins and the later ones are dropped
+  double hedgedRequestDelayPercentile{0.95};  // the hedge delay is this percentile of the operation's recent response latencies
+  long hedgedRequestDelayMillisecondsDefault{100};  // the hedge delay until enough response latencies of the operation have been observed
+  std::string hedgedRequestLocalIpAddress;  // if not empty, the duplicate is sent from this local ip address instead of the request's
+  std::string sharedMemoryPublishName;  // if not empty, public market data events are also written to the POSIX shared memory ring of this name (e.g.
+                                       // "/ccapi_market_data") for SharedMemorySubscriber in co-located processes; not supported on Windows
+  size_t sharedMemorySlotSize{4096};  // the size in bytes of one slot of the shared memory ring, larger events span several slots
+  size_t sharedMemoryNumSlot{65536};  // the number of slots of the shared memory ring, i.e. how far behind a subscriber can fall before it loses data
+  bool enableMarketDepthFanOut{};  // market depth subscriptions of one subscribe call to the same instrument that differ only in MARKET_DEPTH_MAX and
+                                   // CONFLATE_INTERVAL_MILLISECONDS share one upstream subscription at the largest depth, see MarketDepthFanOut
+  bool enableOrderBookRetention{};  // for exchanges that push full-depth books (Kraken, Coinbase, Bitfinex), keep only the best MARKET_DEPTH_MAX +
+                                    // orderBookRetentionBufferLevels levels of each side; a side that runs out of levels is fetched anew
+  int orderBookRetentionBufferLevels{50};  // the levels kept beyond MARKET_DEPTH_MAX, should cover the exchange's checksum depth if checksums are checked
+  bool enableEventCoalescing{};  // merge the subscription data events produced while draining one batch of socket reads into one event before it is
+                                 // dispatched or queued, preserving the order of their messages
+  long eventCoalescingMaxDelayMicroseconds{};  // if set to a positive integer, a merged event is delivered once it is this old even if reads keep arriving
+  bool enableWebsocketPermessageDeflate{};  // offer the permessage-deflate websocket extension; exchanges that don't support it simply decline it
+  bool enableTlsSessionResumption{};  // cache the TLS session of each host in the ServiceContext and resume it on the next connection to that host
+  // The socket tuning profile of websocket connections. Options left at their defaults aren't set. SO_BUSY_POLL, TCP_QUICKACK and kernel receive timestamps
+  // are Linux only; SO_BUSY_POLL may require CAP_NET_ADMIN and only pays off with NIC drivers that support busy polling.
+  int socketReceiveBufferSize{};     // if set to a positive integer, SO_RCVBUF in bytes
+  int socketSendBufferSize{};        // if set to a positive integer, SO_SNDBUF in bytes
+  int socketBusyPollMicroseconds{};  // if set to a positive integer, SO_BUSY_POLL: spin on the device queue for up to this long when a read finds no data
+  bool enableTcpQuickAck{};          // acknowledge received data immediately instead of delaying acks, entered once when a connection opens
+  long tcpQuickAckRearmIntervalMilliseconds{};  // if set to a positive integer, quick ack mode is re-entered on every open connection at this interval, since
+                                                // the kernel may leave it at any time
+  bool enableKernelReceiveTimestamp{};  // stamp market data messages with the time at which the kernel received their bytes, see
+                                        // Message::getTimeReceivedKernel and TimestampingTcpStream
+  bool enableLazyServiceConstruction{};  // construct the service of an exchange on its first subscribe or request instead of when the session starts, which
+                                         // shortens the startup of sessions that use few of the enabled exchanges at the cost of a slower first call
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
   long websocketConnectTimeoutMilliseconds{10000};
@@ -0,0 +1,264 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_SHARED_MEMORY_EVENT_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_SHARED_MEMORY_EVENT_H_
+#ifndef _WIN32
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_event.h"
+#include "ccapi_cpp/ccapi_event_handler.h"
+#include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_shared_memory_ring.h"
+namespace ccapi {
+/**
+ * The binary encoding of the events that travel through a SharedMemoryRing. Both ends run the same library build on the same host, so integers are written in
+ * native byte order and strings are length-prefixed.
+ */
+class SharedMemoryEventCodec CCAPI_FINAL {
+ public:
+  static void encode(const Event& event, std::string& output) {
+    output.clear();
+    appendInteger<uint8_t>(output, static_cast<uint8_t>(event.getType()));
+    const auto& messageList = event.getMessageList();
+    appendInteger<uint32_t>(output, messageList.size());
+    for (const auto& message : messageList) {
+      appendInteger<uint8_t>(output, static_cast<uint8_t>(message.getType()));
+      appendInteger<uint8_t>(output, static_cast<uint8_t>(message.getRecapType()));
+      appendInteger<int64_t>(output, message.getTime().time_since_epoch().count());
+      appendInteger<int64_t>(output, message.getTimeReceived().time_since_epoch().count());
+      appendInteger<int64_t>(output, message.getTimeReceivedKernel().time_since_epoch().count());
+      const auto& correlationIdList = message.getCorrelationIdList();
+      appendInteger<uint32_t>(output, correlationIdList.size());
+      for (const auto& x : correlationIdList) {
+        appendString(output, x);
+      }
+      const auto& elementList = message.getElementList();
+      appendInteger<uint32_t>(output, elementList.size());
+      for (const auto& element : elementList) {
+        const auto& nameValueMap = element.getNameValueMap();
+        appendInteger<uint32_t>(output, nameValueMap.size());
+        for (const auto& x : nameValueMap) {
+          appendString(output, x.first);
+          appendString(output, x.second);
+        }
+      }
+    }
+  }
+  // returns false if input isn't a complete encoding
+  static bool decode(const std::string& input, Event& event) {
+    const char* p = input.data();
+    const char* end = p + input.size();
+    uint8_t eventType{};
+    uint32_t numMessage{};
+    if (!readInteger(p, end, eventType) || !readInteger(p, end, numMessage)) {
+      return false;
+    }
+    event.setType(static_cast<Event::Type>(eventType));
+    std::vector<Message> messageList;
+    for (uint32_t i = 0; i < numMessage; ++i) {
+      Message message;
+      uint8_t messageType{}, recapType{};
+      int64_t time{}, timeReceived{}, timeReceivedKernel{};
+      uint32_t numCorrelationId{};
+      if (!readInteger(p, end, messageType) || !readInteger(p, end, recapType) || !readInteger(p, end, time) || !readInteger(p, end, timeReceived) ||
+          !readInteger(p, end, timeReceivedKernel) || !readInteger(p, end, numCorrelationId)) {
+        return false;
+      }
+      message.setType(static_cast<Message::Type>(messageType));
+      message.setRecapType(static_cast<Message::RecapType>(recapType));
+      message.setTime(TimePoint(std::chrono::nanoseconds(time)));
+      message.setTimeReceived(TimePoint(std::chrono::nanoseconds(timeReceived)));
+      message.setTimeReceivedKernel(TimePoint(std::chrono::nanoseconds(timeReceivedKernel)));
+      std::vector<std::string> correlationIdList(numCorrelationId);
+      for (auto& x : correlationIdList) {
+        if (!readString(p, end, x)) {
+          return false;
+        }
+      }
+      message.setCorrelationIdList(correlationIdList);
+      uint32_t numElement{};
+      if (!readInteger(p, end, numElement)) {
+        return false;
+      }
+      std::vector<Element> elementList(numElement);
+      for (auto& element : elementList) {
+        uint32_t numNameValue{};
+        if (!readInteger(p, end, numNameValue)) {
+          return false;
+        }
+        for (uint32_t j = 0; j < numNameValue; ++j) {
+          std::string name, value;
+          if (!readString(p, end, name) || !readString(p, end, value)) {
+            return false;
+          }
+          element.emplace(name, value);
+        }
+      }
+      message.setElementList(elementList);
+      messageList.emplace_back(std::move(message));
+    }
+    event.setMessageList(messageList);
+    return p == end;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  template <typename T>
+  static void appendInteger(std::string& output, T value) {
+    output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  static void appendString(std::string& output, const std::string& value) {
+    appendInteger<uint32_t>(output, value.size());
+    output.append(value);
+  }
+  template <typename T>
+  static bool readInteger(const char*& p, const char* end, T& value) {
+    if (static_cast<size_t>(end - p) < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+  }
+  static bool readString(const char*& p, const char* end, std::string& value) {
+    uint32_t size{};
+    if (!readInteger(p, end, size) || static_cast<size_t>(end - p) < size) {
+      return false;
+    }
+    value.assign(p, size);
+    p += size;
+    return true;
+  }
+};
+/**
+ * The publishing end of a market data fan-out: one Session that has SessionOptions::sharedMemoryPublishName set writes every public market data event
+ * (market depth, trades, aggregated trades and candlesticks) into a SharedMemoryRing, and any number of co-located processes read them with
+ * SharedMemorySubscriber. Private execution management data is never published. Only the thread that runs the Session's io_context publishes.
+ */
+class SharedMemoryPublisher CCAPI_FINAL {
+ public:
+  SharedMemoryPublisher(const std::string& name, size_t slotSize, size_t numSlot) { this->ring.create(name, slotSize, numSlot); }
+  static bool isPublishable(const Event& event) {
+    if (event.getType() != Event::Type::SUBSCRIPTION_DATA || event.getMessageList().empty()) {
+      return false;
+    }
+    for (const auto& message : event.getMessageList()) {
+      switch (message.getType()) {
+        case Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH:
+        case Message::Type::MARKET_DATA_EVENTS_TRADE:
+        case Message::Type::MARKET_DATA_EVENTS_AGG_TRADE:
+        case Message::Type::MARKET_DATA_EVENTS_CANDLESTICK:
+          break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+  void publish(const Event& event) {
+    if (!isPublishable(event)) {
+      return;
+    }
+    SharedMemoryEventCodec::encode(event, this->buffer);
+    if (!this->ring.write(this->buffer.data(), this->buffer.size())) {
+      CCAPI_LOGGER_ERROR("shared memory ring refused an event of size " + std::to_string(this->buffer.size()) + " larger than its capacity of " +
+                         std::to_string(this->ring.getMaxRecordSize()));
+    }
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  SharedMemoryRing ring;
+  std::string buffer;
+};
+/**
+ * The subscribing end of a market data fan-out: attaches to the SharedMemoryRing of a SharedMemoryPublisher and delivers the events it reads to an EventHandler
+ * on its own thread, exactly like a Session in immediate mode but with a null Session pointer and without any connection, parsing or rate limit cost of its own.
+ * If it falls so far behind that the publisher overwrites unread data, it delivers a SUBSCRIPTION_STATUS event with a GENERIC_ERROR message that says how many
+ * events were lost. If the publisher isn't running yet, it keeps retrying to attach. A publisher restart creates a new ring, so subscribers have to be
+ * restarted too.
+ */
+class SharedMemorySubscriber CCAPI_FINAL {
+ public:
+  SharedMemorySubscriber(const std::string& name, EventHandler* eventHandler, long idleSleepMicroseconds = 0)
+      : name(name), eventHandler(eventHandler), idleSleepMicroseconds(idleSleepMicroseconds) {}
+  SharedMemorySubscriber(const SharedMemorySubscriber&) = delete;
+  SharedMemorySubscriber& operator=(const SharedMemorySubscriber&) = delete;
+  ~SharedMemorySubscriber() { this->stop(); }
+  void start() {
+    this->shouldContinue = true;
+    this->t = std::thread([this]() { this->run(); });
+  }
+  void stop() {
+    this->shouldContinue = false;
+    if (this->t.joinable()) {
+      this->t.join();
+    }
+  }
+  // reads and delivers what is available without blocking; returns the number of events delivered. Use it instead of start() to poll from a thread of your own.
+  size_t poll() {
+    if (!this->ring.isOpen() && !this->ring.open(this->name)) {
+      return 0;
+    }
+    size_t numEvent = 0;
+    uint64_t numLost = 0;
+    while (true) {
+      auto status = this->ring.read(this->buffer, numLost);
+      if (status == SharedMemoryRing::ReadStatus::EMPTY) {
+        break;
+      }
+      Event event;
+      if (status == SharedMemoryRing::ReadStatus::OVERRUN) {
+        CCAPI_LOGGER_WARN("shared memory ring " + this->name + " overrun, " + std::to_string(numLost) + " events lost");
+        event.setType(Event::Type::SUBSCRIPTION_STATUS);
+        Message message;
+        message.setTimeReceived(UtilTime::now());
+        message.setType(Message::Type::GENERIC_ERROR);
+        Element element;
+        element.insert(CCAPI_ERROR_MESSAGE, "shared memory ring " + this->name + " overrun, " + std::to_string(numLost) + " events lost");
+        message.setElementList({element});
+        event.setMessageList({message});
+      } else if (!SharedMemoryEventCodec::decode(this->buffer, event)) {
+        CCAPI_LOGGER_ERROR("shared memory ring " + this->name + " contains an undecodable record of size " + std::to_string(this->buffer.size()));
+        continue;
+      }
+      ++numEvent;
+      if (!this->eventHandler->processEvent(event, nullptr)) {
+        this->shouldContinue = false;
+        break;
+      }
+    }
+    return numEvent;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  void run() {
+    while (this->shouldContinue) {
+      if (this->poll() == 0) {
+        if (this->idleSleepMicroseconds > 0 || !this->ring.isOpen()) {
+          std::this_thread::sleep_for(std::chrono::microseconds(this->ring.isOpen() ? this->idleSleepMicroseconds : 100000));
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+  std::string name;
+  EventHandler* eventHandler;
+  long idleSleepMicroseconds;
+  SharedMemoryRing ring;
+  std::string buffer;
+  std::atomic<bool> shouldContinue{};
+  std::thread t;
+};
+} /* namespace ccapi */
+#endif
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_SHARED_MEMORY_EVENT_H_
@@ -0,0 +1,229 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_SHARED_MEMORY_RING_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_SHARED_MEMORY_RING_H_
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+namespace ccapi {
+/**
+ * A single-producer, multi-consumer broadcast ring buffer in POSIX shared memory. The ring is made of fixed-size slots, each guarded by its own sequence number
+ * in the manner of a seqlock: the producer marks the slot as being written, copies the record and then publishes it, so it never waits for anyone. Every consumer
+ * keeps its own read index in its own process and validates the sequence number before and after copying a record out; a consumer that falls more than the ring
+ * size behind loses the overwritten records and is told how many. Records larger than a slot are split into consecutive chunks flagged as first and last, and a
+ * record that doesn't fit into the whole ring is refused.
+ */
+class SharedMemoryRing CCAPI_FINAL {
+ public:
+  enum class ReadStatus {
+    OK,
+    EMPTY,
+    OVERRUN,
+  };
+  SharedMemoryRing() {}
+  SharedMemoryRing(const SharedMemoryRing&) = delete;
+  SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+  ~SharedMemoryRing() { this->close(); }
+  // creates the ring as the producer, replacing whatever a previous producer of the same name has left behind
+  void create(const std::string& name, size_t slotSize, size_t numSlot) {
+    this->close();
+    this->slotSize = std::max<size_t>((slotSize + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize, 2 * kCacheLineSize);
+    this->numSlot = std::max<size_t>(numSlot, 2);
+    this->mappingSize = sizeof(Header) + this->slotSize * this->numSlot;
+    ::shm_unlink(name.c_str());
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      throw std::runtime_error("shm_open " + name + " failed: " + std::strerror(errno));
+    }
+    if (::ftruncate(fd, this->mappingSize) != 0) {
+      int e = errno;
+      ::close(fd);
+      throw std::runtime_error("ftruncate " + name + " failed: " + std::strerror(e));
+    }
+    this->map(fd, name, PROT_READ | PROT_WRITE);
+    this->header->slotSize = this->slotSize;
+    this->header->numSlot = this->numSlot;
+    this->header->writeIndex.store(0, std::memory_order_relaxed);
+    this->header->numRecord.store(0, std::memory_order_relaxed);
+    this->header->magic.store(kMagic, std::memory_order_release);
+    this->name = name;
+    this->isOwner = true;
+  }
+  // attaches to the ring of a producer as a consumer; returns false if the producer hasn't created it yet
+  bool open(const std::string& name) {
+    this->close();
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+      ::close(fd);
+      return false;
+    }
+    this->mappingSize = st.st_size;
+    this->map(fd, name, PROT_READ);
+    if (this->header->magic.load(std::memory_order_acquire) != kMagic ||
+        sizeof(Header) + this->header->slotSize * this->header->numSlot > this->mappingSize) {
+      this->close();
+      return false;
+    }
+    this->slotSize = this->header->slotSize;
+    this->numSlot = this->header->numSlot;
+    this->nextRecordIndex = this->header->numRecord.load(std::memory_order_acquire);
+    this->readIndex = this->header->writeIndex.load(std::memory_order_acquire);
+    this->name = name;
+    return true;
+  }
+  void close() {
+    if (this->header) {
+      ::munmap(this->header, this->mappingSize);
+      this->header = nullptr;
+    }
+    if (this->isOwner) {
+      ::shm_unlink(this->name.c_str());
+      this->isOwner = false;
+    }
+  }
+  bool isOpen() const { return this->header != nullptr; }
+  size_t getMaxChunkSize() const { return this->slotSize - sizeof(SlotHeader); }
+  // a larger record would overwrite its own beginning before a consumer could read it
+  size_t getMaxRecordSize() const { return this->getMaxChunkSize() * this->numSlot; }
+  // producer only: returns false without writing anything if the record is larger than getMaxRecordSize
+  bool write(const char* data, size_t size) {
+    if (size > this->getMaxRecordSize()) {
+      return false;
+    }
+    size_t maxChunkSize = this->getMaxChunkSize();
+    uint64_t recordIndex = this->header->numRecord.load(std::memory_order_relaxed);
+    this->header->numRecord.store(recordIndex + 1, std::memory_order_release);
+    bool isFirst = true;
+    do {
+      size_t chunkSize = std::min(size, maxChunkSize);
+      uint64_t index = this->header->writeIndex.load(std::memory_order_relaxed);
+      SlotHeader* slotHeader = this->getSlotHeader(index);
+      slotHeader->sequence.store(2 * index + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      slotHeader->recordIndex = recordIndex;
+      slotHeader->size = static_cast<uint32_t>(chunkSize);
+      slotHeader->isFirst = isFirst;
+      slotHeader->isLast = chunkSize == size;
+      std::memcpy(reinterpret_cast<char*>(slotHeader) + sizeof(SlotHeader), data, chunkSize);
+      slotHeader->sequence.store(2 * index + 2, std::memory_order_release);
+      this->header->writeIndex.store(index + 1, std::memory_order_release);
+      data += chunkSize;
+      size -= chunkSize;
+      isFirst = false;
+    } while (size > 0);
+    return true;
+  }
+  // consumer only: on OK, output holds a complete record; on OVERRUN, numLost is the number of records that were overwritten, entirely or partly, before they
+  // could be read. The chunks of a record whose beginning has been lost, whether by an overrun or by attaching while it was being written, are skipped.
+  ReadStatus read(std::string& output, uint64_t& numLost) {
+    while (true) {
+      SlotHeader* slotHeader = this->getSlotHeader(this->readIndex);
+      uint64_t sequence = slotHeader->sequence.load(std::memory_order_acquire);
+      if (sequence < 2 * this->readIndex + 2) {
+        return ReadStatus::EMPTY;
+      }
+      if (sequence == 2 * this->readIndex + 2) {
+        uint64_t recordIndex = slotHeader->recordIndex;
+        uint32_t size = slotHeader->size;
+        uint16_t isFirst = slotHeader->isFirst;
+        uint16_t isLast = slotHeader->isLast;
+        bool isValid = size <= this->getMaxChunkSize() && (isFirst || !this->pending.empty());
+        if (isValid) {
+          if (isFirst) {
+            this->pending.clear();
+          }
+          this->pending.append(reinterpret_cast<const char*>(slotHeader) + sizeof(SlotHeader), size);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slotHeader->sequence.load(std::memory_order_relaxed) == sequence) {
+          ++this->readIndex;
+          if (isValid && isLast) {
+            output.swap(this->pending);
+            this->pending.clear();
+            this->nextRecordIndex = recordIndex + 1;
+            return ReadStatus::OK;
+          }
+          continue;
+        }
+      }
+      uint64_t writeIndex = this->header->writeIndex.load(std::memory_order_acquire);
+      uint64_t newReadIndex = writeIndex > this->numSlot / 2 ? writeIndex - this->numSlot / 2 : 0;
+      newReadIndex = std::max(newReadIndex, this->readIndex + 1);
+      this->readIndex = newReadIndex;
+      this->pending.clear();
+      // the first record that can still be read completely is the one that begins at or after the new read index; if even that slot has been overwritten in
+      // the meantime, everything begun so far counts as lost and the next read overruns again
+      uint64_t resumeRecordIndex = this->header->numRecord.load(std::memory_order_acquire);
+      SlotHeader* resumeSlotHeader = this->getSlotHeader(newReadIndex);
+      uint64_t resumeSequence = resumeSlotHeader->sequence.load(std::memory_order_acquire);
+      if (resumeSequence == 2 * newReadIndex + 2) {
+        uint64_t recordIndex = resumeSlotHeader->recordIndex;
+        uint16_t isFirst = resumeSlotHeader->isFirst;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (resumeSlotHeader->sequence.load(std::memory_order_relaxed) == resumeSequence) {
+          resumeRecordIndex = isFirst ? recordIndex : recordIndex + 1;
+        }
+      }
+      numLost = resumeRecordIndex > this->nextRecordIndex ? resumeRecordIndex - this->nextRecordIndex : 0;
+      this->nextRecordIndex = std::max(this->nextRecordIndex, resumeRecordIndex);
+      return ReadStatus::OVERRUN;
+    }
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  static constexpr uint64_t kMagic = 0x43434150495349ULL;
+  static constexpr size_t kCacheLineSize = 64;
+  struct alignas(64) Header {
+    std::atomic<uint64_t> magic;
+    uint64_t slotSize;
+    uint64_t numSlot;
+    alignas(64) std::atomic<uint64_t> writeIndex;
+    // the number of records begun, i.e. the index of the next record
+    std::atomic<uint64_t> numRecord;
+  };
+  struct SlotHeader {
+    std::atomic<uint64_t> sequence;
+    uint64_t recordIndex;
+    uint32_t size;
+    uint16_t isFirst;
+    uint16_t isLast;
+  };
+  void map(int fd, const std::string& name, int prot) {
+    void* address = ::mmap(nullptr, this->mappingSize, prot, MAP_SHARED, fd, 0);
+    int e = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      throw std::runtime_error("mmap " + name + " failed: " + std::strerror(e));
+    }
+    this->header = static_cast<Header*>(address);
+  }
+  SlotHeader* getSlotHeader(uint64_t index) const {
+    return reinterpret_cast<SlotHeader*>(reinterpret_cast<char*>(this->header) + sizeof(Header) + (index % this->numSlot) * this->slotSize);
+  }
+  std::string name;
+  Header* header{};
+  size_t mappingSize{};
+  size_t slotSize{};
+  size_t numSlot{};
+  bool isOwner{};
+  uint64_t readIndex{};
+  uint64_t nextRecordIndex{};
+  std::string pending;
+};
+} /* namespace ccapi */
+#endif
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_SHARED_MEMORY_RING_H_
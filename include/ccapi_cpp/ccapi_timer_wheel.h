@@ -0,0 +1,102 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_TIMER_WHEEL_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_TIMER_WHEEL_H_
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * A hashed timer wheel. Deadlines are rounded up to whole ticks and hashed into a fixed number of slots; a deadline that is more than one revolution away
+ * stays in its slot until the wheel has turned far enough. The wheel doesn't own a clock: the caller advances it to the current time and receives every value
+ * that has become due, so a single io timer can serve any number of deadlines.
+ */
+template <typename T>
+class TimerWheel CCAPI_FINAL {
+ public:
+  explicit TimerWheel(std::chrono::milliseconds tickDuration = std::chrono::milliseconds(1), size_t numSlot = 1024)
+      : tickMilliseconds(std::max<long long>(tickDuration.count(), 1)), slotList(numSlot > 0 ? numSlot : 1) {}
+  void schedule(const TimePoint& dueTp, const T& value) {
+    long long dueTick = this->ceilTick(dueTp);
+    if (this->size == 0 || dueTick <= this->currentTick) {
+      this->currentTick = dueTick - 1;
+    }
+    this->slotList[this->slotIndex(dueTick)].push_back({dueTick, value});
+    ++this->size;
+  }
+  // returns all values whose deadline is at or before now, in the order of their deadlines' ticks
+  std::vector<T> advance(const TimePoint& now) {
+    std::vector<T> output;
+    long long nowTick = this->floorTick(now);
+    if (this->size == 0 || nowTick <= this->currentTick) {
+      return output;
+    }
+    long long numTick = std::min<long long>(nowTick - this->currentTick, this->slotList.size());
+    for (long long tick = this->currentTick + 1; tick <= this->currentTick + numTick; ++tick) {
+      auto& slot = this->slotList[this->slotIndex(tick)];
+      size_t numKept = 0;
+      for (size_t i = 0; i < slot.size(); ++i) {
+        if (slot[i].dueTick <= nowTick) {
+          output.push_back(std::move(slot[i].value));
+        } else {
+          if (numKept != i) {
+            slot[numKept] = std::move(slot[i]);
+          }
+          ++numKept;
+        }
+      }
+      slot.resize(numKept);
+    }
+    this->size -= output.size();
+    this->currentTick = nowTick;
+    return output;
+  }
+  // the earliest time at which advance may return something; only meaningful if the wheel isn't empty
+  TimePoint getNextDueTp() const {
+    long long nextTick = this->currentTick + static_cast<long long>(this->slotList.size());
+    for (long long tick = this->currentTick + 1; tick <= this->currentTick + static_cast<long long>(this->slotList.size()); ++tick) {
+      if (!this->slotList[this->slotIndex(tick)].empty()) {
+        nextTick = tick;
+        break;
+      }
+    }
+    return TimePoint(std::chrono::milliseconds(nextTick * this->tickMilliseconds));
+  }
+  bool empty() const { return this->size == 0; }
+  size_t getSize() const { return this->size; }
+  void clear() {
+    for (auto& slot : this->slotList) {
+      slot.clear();
+    }
+    this->size = 0;
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  struct Entry {
+    long long dueTick;
+    T value;
+  };
+  long long toMilliseconds(const TimePoint& tp) const { return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count(); }
+  long long floorTick(const TimePoint& tp) const {
+    long long milliseconds = this->toMilliseconds(tp);
+    return milliseconds >= 0 ? milliseconds / this->tickMilliseconds : -((-milliseconds + this->tickMilliseconds - 1) / this->tickMilliseconds);
+  }
+  long long ceilTick(const TimePoint& tp) const {
+    long long tick = this->floorTick(tp);
+    return TimePoint(std::chrono::milliseconds(tick * this->tickMilliseconds)) < tp ? tick + 1 : tick;
+  }
+  size_t slotIndex(long long tick) const {
+    long long numSlot = this->slotList.size();
+    return static_cast<size_t>(((tick % numSlot) + numSlot) % numSlot);
+  }
+  long long tickMilliseconds;
+  std::vector<std::vector<Entry> > slotList;
+  long long currentTick{};
+  size_t size{};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_TIMER_WHEEL_H_
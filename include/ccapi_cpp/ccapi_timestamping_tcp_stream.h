@@ -0,0 +1,131 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_TIMESTAMPING_TCP_STREAM_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_TIMESTAMPING_TCP_STREAM_H_
+#ifdef __linux__
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <sys/socket.h>
+#endif
+#include <chrono>
+#include <utility>
+
+#include "boost/asio/dispatch.hpp"
+#include "boost/asio/post.hpp"
+#include "boost/beast/core.hpp"
+#include "boost/beast/websocket/teardown.hpp"
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+/**
+ * A beast::tcp_stream that can report the time at which the kernel received the data of its latest read (SO_TIMESTAMPING software receive timestamps). That
+ * time excludes the queueing delay of the io loop, so it is the closest this process gets to the time on the wire. The kernel hands the timestamps out only as
+ * ancillary data of recvmsg, so once enabled, reads are performed here with recvmsg instead of by asio: one speculative non-blocking recvmsg and, if nothing is
+ * there yet, a wait for readability followed by another. Enable it only after the TLS and websocket handshakes, because those reads rely on beast's timeouts,
+ * which these reads bypass. Elsewhere than on Linux, enabling it fails and the stream reads as usual.
+ */
+class TimestampingTcpStream : public boost::beast::tcp_stream {
+ public:
+  using boost::beast::tcp_stream::tcp_stream;
+  // returns whether the kernel accepted the option
+  bool enableReceiveTimestamp() {
+#ifdef __linux__
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    this->receiveTimestampEnabled = ::setsockopt(this->socket().native_handle(), SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0;
+#endif
+    return this->receiveTimestampEnabled;
+  }
+  bool isReceiveTimestampEnabled() const { return this->receiveTimestampEnabled; }
+  // the kernel receive time of the data returned by the latest read, or the epoch if it isn't known
+  const TimePoint& getReceiveTp() const { return this->receiveTp; }
+  template <class MutableBufferSequence, class ReadHandler>
+  BOOST_BEAST_ASYNC_RESULT2(ReadHandler)
+  async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler) {
+    if (!this->receiveTimestampEnabled) {
+      return boost::beast::tcp_stream::async_read_some(buffers, std::forward<ReadHandler>(handler));
+    }
+    return boost::asio::async_initiate<ReadHandler, void(boost::beast::error_code, std::size_t)>(
+        [this, buffers](auto&& handler) { this->readSome(buffers, std::move(handler), false); }, handler);
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  template <class MutableBufferSequence, class ReadHandler>
+  void readSome(const MutableBufferSequence& buffers, ReadHandler&& handler, bool hasWaited) {
+    boost::beast::error_code ec;
+    std::size_t n = this->receive(buffers, ec);
+    auto executor = boost::asio::get_associated_executor(handler, this->get_executor());
+    if (ec == boost::asio::error::would_block) {
+      this->socket().async_wait(boost::asio::socket_base::wait_read,
+                                boost::asio::bind_executor(executor, [this, buffers, handler = std::move(handler)](boost::beast::error_code ec) mutable {
+                                  if (ec) {
+                                    handler(ec, 0);
+                                    return;
+                                  }
+                                  this->readSome(buffers, std::move(handler), true);
+                                }));
+      return;
+    }
+    // a handler must not be invoked from within the initiating function
+    if (hasWaited) {
+      boost::asio::dispatch(executor, boost::beast::bind_front_handler(std::move(handler), ec, n));
+    } else {
+      boost::asio::post(executor, boost::beast::bind_front_handler(std::move(handler), ec, n));
+    }
+  }
+  template <class MutableBufferSequence>
+  std::size_t receive(const MutableBufferSequence& buffers, boost::beast::error_code& ec) {
+#ifdef __linux__
+    iovec iov[16];
+    std::size_t numIov = 0;
+    for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers) && numIov < 16; ++it) {
+      boost::asio::mutable_buffer buffer(*it);
+      if (buffer.size() > 0) {
+        iov[numIov].iov_base = buffer.data();
+        iov[numIov].iov_len = buffer.size();
+        ++numIov;
+      }
+    }
+    if (numIov == 0) {
+      return 0;
+    }
+    char control[CMSG_SPACE(sizeof(scm_timestamping))];
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = numIov;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    ssize_t n = ::recvmsg(this->socket().native_handle(), &msg, MSG_DONTWAIT);
+    if (n < 0) {
+      ec = (errno == EAGAIN || errno == EWOULDBLOCK) ? boost::beast::error_code(boost::asio::error::would_block)
+                                                     : boost::beast::error_code(errno, boost::system::system_category());
+      return 0;
+    }
+    if (n == 0) {
+      ec = boost::asio::error::eof;
+      return 0;
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPING) {
+        const auto* timestamping = reinterpret_cast<const scm_timestamping*>(CMSG_DATA(cmsg));
+        this->receiveTp = TimePoint(std::chrono::seconds(timestamping->ts[0].tv_sec) + std::chrono::nanoseconds(timestamping->ts[0].tv_nsec));
+      }
+    }
+    return n;
+#else
+    ec = boost::asio::error::operation_not_supported;
+    return 0;
+#endif
+  }
+  bool receiveTimestampEnabled{};
+  TimePoint receiveTp{std::chrono::seconds{0}};
+};
+// without these, the generic websocket teardown would be a better match than the ones of beast::tcp_stream
+inline void teardown(boost::beast::role_type role, TimestampingTcpStream& stream, boost::beast::error_code& ec) {
+  boost::beast::teardown(role, static_cast<boost::beast::tcp_stream&>(stream), ec);
+}
+template <class TeardownHandler>
+void async_teardown(boost::beast::role_type role, TimestampingTcpStream& stream, TeardownHandler&& handler) {
+  boost::beast::async_teardown(role, static_cast<boost::beast::tcp_stream&>(stream), std::forward<TeardownHandler>(handler));
+}
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_TIMESTAMPING_TCP_STREAM_H_
@@ -0,0 +1,148 @@
+#ifndef INCLUDE_CCAPI_CPP_CCAPI_TLS_SESSION_CACHE_H_
+#define INCLUDE_CCAPI_CPP_CCAPI_TLS_SESSION_CACHE_H_
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "ccapi_cpp/ccapi_macro.h"
+#include "ccapi_cpp/ccapi_util_private.h"
+#include "openssl/ssl.h"
+namespace ccapi {
+/**
+ * A client side TLS session cache keyed by server name, so that a reconnect or a new http connection to a host that has been connected to before can resume
+ * the previous session instead of performing a full handshake. OpenSSL hands every new session to the cache, including the TLS 1.3 tickets that arrive after
+ * the handshake has completed, and the latest resumable session of a host is offered on its next handshake. The server may always decline it, in which case a
+ * full handshake takes place as before. The cache also counts full and resumed handshakes and their durations.
+ */
+class TlsSessionCache CCAPI_FINAL {
+ public:
+  TlsSessionCache() {}
+  TlsSessionCache(const TlsSessionCache&) = delete;
+  TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+  ~TlsSessionCache() { this->clear(); }
+  // starts caching the sessions of every connection made with ctx; ctx must not be shared with another cache
+  void attach(SSL_CTX* ctx) {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_set_ex_data(ctx, getExDataIndex(), this);
+    SSL_CTX_sess_set_new_cb(ctx, &TlsSessionCache::onNewSession);
+    this->enabled = true;
+  }
+  bool isEnabled() const { return this->enabled; }
+  // call right before the handshake, after the server name has been set
+  void beforeHandshake(SSL* ssl) {
+    if (!this->enabled) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(this->m);
+    this->handshakeStartTpBySslMap[ssl] = std::chrono::steady_clock::now();
+    auto it = this->sessionByServerNameMap.find(getServerName(ssl));
+    if (it != this->sessionByServerNameMap.end() && SSL_SESSION_is_resumable(it->second)) {
+      SSL_SESSION* copy = SSL_SESSION_dup(it->second);
+      if (copy) {
+        SSL_set_session(ssl, copy);
+        SSL_SESSION_free(copy);
+      }
+    }
+  }
+  // call as soon as the handshake has completed, whether or not it succeeded
+  void afterHandshake(SSL* ssl, bool succeeded) {
+    if (!this->enabled) {
+      return;
+    }
+    std::chrono::steady_clock::time_point startTp;
+    {
+      std::lock_guard<std::mutex> lock(this->m);
+      auto it = this->handshakeStartTpBySslMap.find(ssl);
+      if (it == this->handshakeStartTpBySslMap.end()) {
+        return;
+      }
+      startTp = it->second;
+      this->handshakeStartTpBySslMap.erase(it);
+    }
+    if (!succeeded) {
+      return;
+    }
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTp).count();
+    if (SSL_session_reused(ssl)) {
+      ++this->numResumedHandshake;
+      this->resumedHandshakeNanoseconds += nanoseconds;
+    } else {
+      ++this->numFullHandshake;
+      this->fullHandshakeNanoseconds += nanoseconds;
+    }
+  }
+  uint64_t getNumFullHandshake() const { return this->numFullHandshake; }
+  uint64_t getNumResumedHandshake() const { return this->numResumedHandshake; }
+  double getResumptionHitRate() const {
+    uint64_t numResumed = this->numResumedHandshake, numTotal = numResumed + this->numFullHandshake;
+    return numTotal > 0 ? static_cast<double>(numResumed) / numTotal : 0;
+  }
+  // the resumed handshakes times the difference between the mean durations of a full and of a resumed handshake
+  double getHandshakeSecondsSaved() const {
+    uint64_t numFull = this->numFullHandshake, numResumed = this->numResumedHandshake;
+    if (numFull == 0 || numResumed == 0) {
+      return 0;
+    }
+    double meanFull = static_cast<double>(this->fullHandshakeNanoseconds) / numFull;
+    double meanResumed = static_cast<double>(this->resumedHandshakeNanoseconds) / numResumed;
+    return std::max(meanFull - meanResumed, 0.0) * numResumed / 1e9;
+  }
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(this->m);
+    return this->sessionByServerNameMap.size();
+  }
+  void clear() {
+    std::lock_guard<std::mutex> lock(this->m);
+    for (const auto& x : this->sessionByServerNameMap) {
+      SSL_SESSION_free(x.second);
+    }
+    this->sessionByServerNameMap.clear();
+    this->handshakeStartTpBySslMap.clear();
+  }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  static int getExDataIndex() {
+    static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+  }
+  static std::string getServerName(const SSL* ssl) {
+    const char* serverName = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+    return serverName ? serverName : "";
+  }
+  // sessions are copied in and out of the cache because OpenSSL marks the session of a connection that is freed without a TLS shutdown as not resumable,
+  // which is how most connections end
+  static int onNewSession(SSL* ssl, SSL_SESSION* session) {
+    auto that = static_cast<TlsSessionCache*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), getExDataIndex()));
+    auto serverName = getServerName(ssl);
+    if (that && !serverName.empty()) {
+      SSL_SESSION* copy = SSL_SESSION_dup(session);
+      if (copy) {
+        that->put(serverName, copy);
+      }
+    }
+    return 0;
+  }
+  void put(const std::string& serverName, SSL_SESSION* session) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto& x = this->sessionByServerNameMap[serverName];
+    if (x) {
+      SSL_SESSION_free(x);
+    }
+    x = session;
+  }
+  std::atomic<bool> enabled{};
+  mutable std::mutex m;
+  std::map<std::string, SSL_SESSION*> sessionByServerNameMap;
+  std::map<const SSL*, std::chrono::steady_clock::time_point> handshakeStartTpBySslMap;
+  std::atomic<uint64_t> numFullHandshake{};
+  std::atomic<uint64_t> numResumedHandshake{};
+  std::atomic<uint64_t> fullHandshakeNanoseconds{};
+  std::atomic<uint64_t> resumedHandshakeNanoseconds{};
+};
+} /* namespace ccapi */
+#endif  // INCLUDE_CCAPI_CPP_CCAPI_TLS_SESSION_CACHE_H_
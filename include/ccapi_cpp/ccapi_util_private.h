@@ -13,6 +13,7 @@
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <numeric>
 #include <random>
@@ -277,33 +278,24 @@ class UtilTime CCAPI_FINAL {
     return output;
   }
   static std::string convertTimePointToFIXTime(const TimePoint& tp) {
-    int year, month, day, hour, minute, second, millisecond;
-    timePointToParts(tp, year, month, day, hour, minute, second, millisecond);
-    std::string output;
-    output += std::to_string(year);
-    auto monthStr = std::to_string(month);
-    output += std::string(2 - monthStr.length(), '0');
-    output += monthStr;
-    auto dayStr = std::to_string(day);
-    output += std::string(2 - dayStr.length(), '0');
-    output += dayStr;
-    output += "-";
-    auto hourStr = std::to_string(hour);
-    output += std::string(2 - hourStr.length(), '0');
-    output += hourStr;
-    output += ":";
-    auto minuteStr = std::to_string(minute);
-    output += std::string(2 - minuteStr.length(), '0');
-    output += minuteStr;
-    output += ":";
-    auto secondStr = std::to_string(second);
-    output += std::string(2 - secondStr.length(), '0');
-    output += secondStr;
-    output += ".";
-    auto millisecondStr = std::to_string(millisecond);
-    output += std::string(3 - millisecondStr.length(), '0');
-    output += millisecondStr;
-    return output;
+    char buffer[21];
+    return std::string(buffer, writeFIXTime(tp, buffer));
+  }
+  // writes 20200925-15:55:28.093 into output, which must hold at least 21 characters, and returns the number of characters written
+  static size_t writeFIXTime(const TimePoint& tp, char* output) {
+    long long daysSinceEpoch, nanosecond;
+    int secondOfDay;
+    splitTimePoint(tp, daysSinceEpoch, secondOfDay, nanosecond);
+    int year, month, day;
+    civilFromDaysCached(daysSinceEpoch, year, month, day);
+    writeFixedWidthDigits(output, 4, year);
+    writeFixedWidthDigits(output + 4, 2, month);
+    writeFixedWidthDigits(output + 6, 2, day);
+    output[8] = '-';
+    writeTimeOfDay(output + 9, secondOfDay);
+    output[17] = '.';
+    writeFixedWidthDigits(output + 18, 3, nanosecond / 1000000);
+    return 21;
   }
   template <typename T = std::chrono::milliseconds>
   static void timePointToParts(TimePoint tp, int& year, int& month, int& day, int& hour, int& minute, int& second, int& fractionalSecond) {
@@ -336,32 +328,32 @@ class UtilTime CCAPI_FINAL {
     auto now = std::chrono::system_clock::now();
     return TimePoint(now);
   }
-  static TimePoint parse(const std::string& input) {
-    std::tm time{};
-    time.tm_year = std::strtol(&input[0], nullptr, 10) - 1900;
-    time.tm_mon = std::strtol(&input[5], nullptr, 10) - 1;
-    time.tm_mday = std::strtol(&input[8], nullptr, 10);
-    if (input.length() > 10) {
-      time.tm_hour = std::strtol(&input[11], nullptr, 10);
-      time.tm_min = std::strtol(&input[14], nullptr, 10);
-      time.tm_sec = std::strtol(&input[17], nullptr, 10);
-    }
-    time.tm_isdst = 0;
-    long nanoseconds = 0;
-    if (input.length() > 20) {
-      std::string trail = input.substr(20);
-      if (trail.back() == 'Z') {
-        trail.pop_back();
-      }
-      if (!trail.empty()) {
-        if (trail.length() > 9) {
-          throw std::invalid_argument("input too long");
-        }
-        nanoseconds = std::stoll(UtilString::rightPadTo(trail, 9, '0'));
-      }
+  static TimePoint parse(const std::string& input) { return parse(input.data(), input.length()); }
+  // parses fixed width 2019-11-21, 2019-11-21T01:38:23 and 2019-11-21T01:38:23.123456789Z (any number of fractional digits up to 9)
+  static TimePoint parse(const char* data, size_t length) {
+    long long seconds = daysFromCivilCached(parseFixedWidthDigits(data, 4), parseFixedWidthDigits(data + 5, 2), parseFixedWidthDigits(data + 8, 2)) * 86400;
+    if (length > 10) {
+      seconds += parseTimeOfDay(data + 11);
+    }
+    long long nanoseconds = 0;
+    if (length > 20) {
+      nanoseconds = parseFractionalSecond(data + 20, data + length);
     }
-    return TimePoint(std::chrono::system_clock::from_time_t(timegm(&time))) + std::chrono::nanoseconds(nanoseconds);
+    return TimePoint(std::chrono::seconds(seconds)) + std::chrono::nanoseconds(nanoseconds);
   }
+  // parses fixed width 20200925-15:55:28 and 20200925-15:55:28.093490622 (any number of fractional digits up to 9)
+  static TimePoint parseFIXTime(const char* data, size_t length) {
+    long long seconds = daysFromCivilCached(parseFixedWidthDigits(data, 4), parseFixedWidthDigits(data + 4, 2), parseFixedWidthDigits(data + 6, 2)) * 86400;
+    if (length > 8) {
+      seconds += parseTimeOfDay(data + 9);
+    }
+    long long nanoseconds = 0;
+    if (length > 18) {
+      nanoseconds = parseFractionalSecond(data + 18, data + length);
+    }
+    return TimePoint(std::chrono::seconds(seconds)) + std::chrono::nanoseconds(nanoseconds);
+  }
+  static TimePoint parseFIXTime(const std::string& input) { return parseFIXTime(input.data(), input.length()); }
   static TimePoint makeTimePoint(const std::pair<long long, long long>& timePair) {
     auto tp = TimePoint(std::chrono::duration<int64_t>(timePair.first));
     tp += std::chrono::nanoseconds(timePair.second);
@@ -379,29 +371,46 @@ class UtilTime CCAPI_FINAL {
     auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(then);
     return std::make_pair(s.count(), ns.count());
   }
-  static std::pair<long long, long long> divide(const std::string& seconds) {
-    if (seconds.find('.') != std::string::npos) {
-      std::string secondsCopy = seconds;
-      UtilString::rtrimInPlace(secondsCopy, '0');
-      UtilString::rtrimInPlace(secondsCopy, '.');
-      auto found = secondsCopy.find('.');
-      return std::make_pair(std::stoll(secondsCopy.substr(0, found)),
-                            found != std::string::npos ? std::stoll(UtilString::rightPadTo(secondsCopy.substr(found + 1), 9, '0')) : 0);
-    } else {
-      return std::make_pair(std::stoll(seconds), 0);
-    }
-  }
+  static std::pair<long long, long long> divide(const std::string& seconds) { return divideDecimalString(seconds.data(), seconds.length(), 9); }
   static std::pair<long long, long long> divideMilli(const std::string& milliseconds) {
-    if (milliseconds.find('.') != std::string::npos) {
-      std::string millisecondsCopy = milliseconds;
-      UtilString::rtrimInPlace(millisecondsCopy, '0');
-      UtilString::rtrimInPlace(millisecondsCopy, '.');
-      auto found = millisecondsCopy.find('.');
-      return std::make_pair(std::stoll(millisecondsCopy.substr(0, found)),
-                            found != std::string::npos ? std::stoll(UtilString::rightPadTo(millisecondsCopy.substr(found + 1), 6, '0')) : 0);
-    } else {
-      return std::make_pair(std::stoll(milliseconds), 0);
+    return divideDecimalString(milliseconds.data(), milliseconds.length(), 6);
+  }
+  // splits e.g. 1634929946.010 into its whole part and its fractional part scaled to fractionalWidth digits, without copying the input. Like std::stoll, it
+  // throws std::out_of_range if the whole part doesn't fit in a long long.
+  static std::pair<long long, long long> divideDecimalString(const char* data, size_t length, int fractionalWidth) {
+    const char* it = data;
+    const char* end = data + length;
+    bool isNegative = false;
+    if (it != end && (*it == '-' || *it == '+')) {
+      isNegative = *it == '-';
+      ++it;
     }
+    const char* wholeBegin = it;
+    long long whole = 0;
+    while (it != end && static_cast<unsigned>(*it - '0') < 10) {
+      if (whole > (std::numeric_limits<long long>::max() - (*it - '0')) / 10) {
+        throw std::out_of_range("out of range: " + std::string(data, length));
+      }
+      whole = whole * 10 + (*it - '0');
+      ++it;
+    }
+    if (it == wholeBegin) {
+      throw std::invalid_argument("no digits in " + std::string(data, length));
+    }
+    long long fractional = 0;
+    if (it != end && *it == '.') {
+      ++it;
+      int numDigit = 0;
+      while (it != end && numDigit < fractionalWidth && static_cast<unsigned>(*it - '0') < 10) {
+        fractional = fractional * 10 + (*it - '0');
+        ++numDigit;
+        ++it;
+      }
+      for (; numDigit < fractionalWidth; ++numDigit) {
+        fractional *= 10;
+      }
+    }
+    return std::make_pair(isNegative ? -whole : whole, fractional);
   }
   static std::string convertMillisecondsStrToSecondsStr(const std::string& milliseconds) {
     std::string output;
@@ -421,47 +430,37 @@ class UtilTime CCAPI_FINAL {
   }
   template <typename T = std::chrono::nanoseconds>
   static std::string getISOTimestamp(const TimePoint& tp) {
-    int year, month, day, hour, minute, second, fractionalSecond;
-    timePointToParts<T>(tp, year, month, day, hour, minute, second, fractionalSecond);
-    std::string output;
-    output += std::to_string(year);
-    output += "-";
-    auto monthStr = std::to_string(month);
-    output += std::string(2 - monthStr.length(), '0');
-    output += monthStr;
-    output += "-";
-    auto dayStr = std::to_string(day);
-    output += std::string(2 - dayStr.length(), '0');
-    output += dayStr;
-    output += "T";
-    auto hourStr = std::to_string(hour);
-    output += std::string(2 - hourStr.length(), '0');
-    output += hourStr;
-    output += ":";
-    auto minuteStr = std::to_string(minute);
-    output += std::string(2 - minuteStr.length(), '0');
-    output += minuteStr;
-    output += ":";
-    auto secondStr = std::to_string(second);
-    output += std::string(2 - secondStr.length(), '0');
-    output += secondStr;
-    if (!std::is_same<T, std::chrono::seconds>::value) {
-      output += ".";
-      auto fractionalSecondStr = std::to_string(fractionalSecond);
-      int padToLength;
-      if (std::is_same<T, std::chrono::nanoseconds>::value) {
-        padToLength = 9;
-      } else if (std::is_same<T, std::chrono::microseconds>::value) {
-        padToLength = 6;
-      } else if (std::is_same<T, std::chrono::milliseconds>::value) {
-        padToLength = 3;
-      }
-      output += std::string(padToLength - fractionalSecondStr.length(), '0');
-      // UtilString::rtrimInPlace(fractionalSecondStr, '0');
-      output += fractionalSecondStr;
+    char buffer[30];
+    return std::string(buffer, writeISOTimestamp<T>(tp, buffer));
+  }
+  // writes 2019-11-21T01:38:23.123456789Z (fractional digits according to T) into output, which must hold at least 30 characters, and returns the number of
+  // characters written
+  template <typename T = std::chrono::nanoseconds>
+  static size_t writeISOTimestamp(const TimePoint& tp, char* output) {
+    long long daysSinceEpoch, nanosecond;
+    int secondOfDay;
+    splitTimePoint(tp, daysSinceEpoch, secondOfDay, nanosecond);
+    int year, month, day;
+    civilFromDaysCached(daysSinceEpoch, year, month, day);
+    writeFixedWidthDigits(output, 4, year);
+    output[4] = '-';
+    writeFixedWidthDigits(output + 5, 2, month);
+    output[7] = '-';
+    writeFixedWidthDigits(output + 8, 2, day);
+    output[10] = 'T';
+    writeTimeOfDay(output + 11, secondOfDay);
+    size_t length = 19;
+    int fractionalWidth = std::is_same<T, std::chrono::milliseconds>::value   ? 3
+                          : std::is_same<T, std::chrono::microseconds>::value ? 6
+                          : std::is_same<T, std::chrono::nanoseconds>::value  ? 9
+                                                                              : 0;
+    if (fractionalWidth > 0) {
+      output[length++] = '.';
+      writeFixedWidthDigits(output + length, fractionalWidth, nanosecond / powerOfTen(9 - fractionalWidth));
+      length += fractionalWidth;
     }
-    output += "Z";
-    return output;
+    output[length++] = 'Z';
+    return length;
   }
   static int getUnixTimestamp(const TimePoint& tp) {
     auto then = tp.time_since_epoch();
@@ -470,6 +469,117 @@ class UtilTime CCAPI_FINAL {
   }
   static TimePoint makeTimePointFromMilliseconds(long long milliseconds) { return TimePoint(std::chrono::milliseconds(milliseconds)); }
   static TimePoint makeTimePointFromSeconds(long seconds) { return TimePoint(std::chrono::seconds(seconds)); }
+#ifndef CCAPI_EXPOSE_INTERNAL
+
+ private:
+#endif
+  static long long powerOfTen(int n) {
+    static const long long powers[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    return powers[n];
+  }
+  static int parseFixedWidthDigits(const char* data, int width) {
+    int value = 0;
+    for (int i = 0; i < width; ++i) {
+      value = value * 10 + (data[i] - '0');
+    }
+    return value;
+  }
+  static void writeFixedWidthDigits(char* output, int width, long long value) {
+    for (int i = width - 1; i >= 0; --i) {
+      output[i] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    }
+  }
+  // HH:MM:SS
+  static int parseTimeOfDay(const char* data) {
+    return parseFixedWidthDigits(data, 2) * 3600 + parseFixedWidthDigits(data + 3, 2) * 60 + parseFixedWidthDigits(data + 6, 2);
+  }
+  static void writeTimeOfDay(char* output, int secondOfDay) {
+    writeFixedWidthDigits(output, 2, secondOfDay / 3600);
+    output[2] = ':';
+    writeFixedWidthDigits(output + 3, 2, secondOfDay / 60 % 60);
+    output[5] = ':';
+    writeFixedWidthDigits(output + 6, 2, secondOfDay % 60);
+  }
+  // digits after the decimal point, optionally followed by a timezone designator, e.g. 123456Z
+  static long long parseFractionalSecond(const char* it, const char* end) {
+    long long nanoseconds = 0;
+    int numDigit = 0;
+    while (it != end && static_cast<unsigned>(*it - '0') < 10) {
+      if (numDigit == 9) {
+        throw std::invalid_argument("input too long");
+      }
+      nanoseconds = nanoseconds * 10 + (*it - '0');
+      ++numDigit;
+      ++it;
+    }
+    return nanoseconds * powerOfTen(9 - numDigit);
+  }
+  static void splitTimePoint(const TimePoint& tp, long long& daysSinceEpoch, int& secondOfDay, long long& nanosecond) {
+    long long nanosecondsSinceEpoch = tp.time_since_epoch().count();
+    long long secondsSinceEpoch = nanosecondsSinceEpoch / 1000000000;
+    nanosecond = nanosecondsSinceEpoch - secondsSinceEpoch * 1000000000;
+    if (nanosecond < 0) {
+      nanosecond += 1000000000;
+      --secondsSinceEpoch;
+    }
+    daysSinceEpoch = secondsSinceEpoch / 86400;
+    secondOfDay = static_cast<int>(secondsSinceEpoch - daysSinceEpoch * 86400);
+    if (secondOfDay < 0) {
+      secondOfDay += 86400;
+      --daysSinceEpoch;
+    }
+  }
+  // see http://howardhinnant.github.io/date_algorithms.html
+  static long long daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long long>(doe) - 719468;
+  }
+  static void civilFromDays(long long daysSinceEpoch, int& year, int& month, int& day) {
+    daysSinceEpoch += 719468;
+    const long long era = (daysSinceEpoch >= 0 ? daysSinceEpoch : daysSinceEpoch - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(daysSinceEpoch - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(yoe + era * 400) + (month <= 2);
+  }
+  // timestamps on the hot path almost always fall on the current day, so the calendar conversion is only redone when the day changes
+  struct DayCache {
+    bool valid{};
+    long long daysSinceEpoch{};
+    int year{};
+    int month{};
+    int day{};
+  };
+  static long long daysFromCivilCached(int year, int month, int day) {
+    thread_local DayCache dayCache;
+    if (!dayCache.valid || dayCache.day != day || dayCache.month != month || dayCache.year != year) {
+      dayCache.daysSinceEpoch = daysFromCivil(year, month, day);
+      dayCache.year = year;
+      dayCache.month = month;
+      dayCache.day = day;
+      dayCache.valid = true;
+    }
+    return dayCache.daysSinceEpoch;
+  }
+  static void civilFromDaysCached(long long daysSinceEpoch, int& year, int& month, int& day) {
+    thread_local DayCache dayCache;
+    if (!dayCache.valid || dayCache.daysSinceEpoch != daysSinceEpoch) {
+      civilFromDays(daysSinceEpoch, dayCache.year, dayCache.month, dayCache.day);
+      dayCache.daysSinceEpoch = daysSinceEpoch;
+      dayCache.valid = true;
+    }
+    year = dayCache.year;
+    month = dayCache.month;
+    day = dayCache.day;
+  }
 };
 class UtilAlgorithm CCAPI_FINAL {
  public:
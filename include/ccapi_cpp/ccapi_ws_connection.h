@@ -1,9 +1,11 @@
 #ifndef INCLUDE_CCAPI_CPP_CCAPI_WS_CONNECTION_H_
 #define INCLUDE_CCAPI_CPP_CCAPI_WS_CONNECTION_H_
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
+#include <atomic>
 #include <string>
 
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_order_book_state.h"
 #include "ccapi_cpp/ccapi_subscription.h"
 namespace wspp = websocketpp;
 namespace ccapi {
@@ -18,17 +20,22 @@ class WsConnection CCAPI_FINAL {
   }
   WsConnection() {}
   void assignDummyId() {
-    this->id = this->url + "||" + this->group + "||" + ccapi::toString(this->subscriptionList) + "||" + ccapi::toString(this->credential);
+    this->id = generateId();
     this->hdl.reset();
   }
+  // a process-wide unique id, an integer so that keying the per-connection state maps by it costs an integer comparison
+  static uint64_t generateId() {
+    static std::atomic<uint64_t> counter{};
+    return ++counter;
+  }
   std::string toString() const {
     std::map<std::string, std::string> shortCredential;
     for (const auto& x : credential) {
       shortCredential.insert(std::make_pair(x.first, UtilString::firstNCharacter(x.second, CCAPI_CREDENTIAL_DISPLAY_LENGTH)));
     }
-    std::string output = "WsConnection [id = " + id + ", url = " + url + ", group = " + group + ", subscriptionList = " + ccapi::toString(subscriptionList) +
-                         ", credential = " + ccapi::toString(shortCredential) + ", status = " + statusToString(status) +
-                         ", headers = " + ccapi::toString(headers) + "]";
+    std::string output = "WsConnection [id = " + std::to_string(id) + ", url = " + url + ", group = " + group +
+                         ", subscriptionList = " + ccapi::toString(subscriptionList) + ", credential = " + ccapi::toString(shortCredential) +
+                         ", status = " + statusToString(status) + ", headers = " + ccapi::toString(headers) + "]";
     return output;
   }
   enum class Status {
@@ -65,7 +72,7 @@ class WsConnection CCAPI_FINAL {
     }
     return output;
   }
-  std::string id;
+  uint64_t id{};
   std::string url;
   std::string group;
   std::vector<Subscription> subscriptionList;
@@ -73,29 +80,43 @@ class WsConnection CCAPI_FINAL {
   wspp::connection_hdl hdl = wspp::lib::weak_ptr<void>();
   std::map<std::string, std::string> headers;
   std::map<std::string, std::string> credential;
+  std::map<std::string, std::map<std::string, OrderBookState>> orderBookStateByChannelIdSymbolIdMap;
 };
 } /* namespace ccapi */
 #else
+#include <atomic>
+#include <cstring>
+#include <memory>
 #include <string>
 
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_order_book_state.h"
 #include "ccapi_cpp/ccapi_subscription.h"
+#include "ccapi_cpp/ccapi_timestamping_tcp_stream.h"
 namespace ccapi {
+class InflateStream;
 /**
  * This class represents a TCP socket connection for the websocket API.
  */
 class WsConnection CCAPI_FINAL {
  public:
   WsConnection(std::string url, std::string group, std::vector<Subscription> subscriptionList, std::map<std::string, std::string> credential,
-               std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream> > > streamPtr)
+               std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream> > > streamPtr)
       : url(url), group(group), subscriptionList(subscriptionList), credential(credential), streamPtr(streamPtr) {
-    this->id = this->url + "||" + this->group + "||" + ccapi::toString(this->subscriptionList) + "||" + ccapi::toString(this->credential);
+    this->id = generateId();
     this->correlationIdList.reserve(subscriptionList.size());
     std::transform(subscriptionList.cbegin(), subscriptionList.cend(), std::back_inserter(this->correlationIdList),
                    [](Subscription subscription) { return subscription.getCorrelationId(); });
     this->setUrlParts();
+    this->readMessageBuffer.reserve(CCAPI_WEBSOCKET_READ_BUFFER_INITIAL_SIZE + CCAPI_WEBSOCKET_READ_BUFFER_PADDING);
   }
   WsConnection() {}
+  // a process-wide unique id, an integer so that keying the per-connection state maps by it costs an integer comparison; it survives reconnects because the
+  // same object is reused with a new stream
+  static uint64_t generateId() {
+    static std::atomic<uint64_t> counter{};
+    return ++counter;
+  }
   std::string toString() const {
     std::map<std::string, std::string> shortCredential;
     for (const auto& x : credential) {
@@ -103,8 +124,9 @@ class WsConnection CCAPI_FINAL {
     }
     std::ostringstream oss;
     oss << streamPtr;
-    std::string output = "WsConnection [id = " + id + ", url = " + url + ", group = " + group + ", subscriptionList = " + ccapi::toString(subscriptionList) +
-                         ", credential = " + ccapi::toString(shortCredential) + ", status = " + statusToString(status) +
+    std::string output = "WsConnection [id = " + std::to_string(id) + ", url = " + url + ", group = " + group +
+                         ", subscriptionList = " + ccapi::toString(subscriptionList) + ", credential = " + ccapi::toString(shortCredential) +
+                         ", status = " + statusToString(status) +
                          ", headers = " + ccapi::toString(headers) + ", streamPtr = " + oss.str() + ", remoteCloseCode = " + std::to_string(remoteCloseCode) +
                          ", remoteCloseReason = " + std::string(remoteCloseReason.reason.c_str()) +
                          ", hostHttpHeaderValue = " + ccapi::toString(hostHttpHeaderValue) + ", path = " + ccapi::toString(path) +
@@ -177,18 +199,28 @@ class WsConnection CCAPI_FINAL {
       }
     }
   }
+  // the message that has just been read, in place and writable, followed by CCAPI_WEBSOCKET_READ_BUFFER_PADDING zero bytes; the buffer only reallocates if the
+  // message doesn't leave room for the padding
+  char* padReadMessage() {
+    auto padding = this->readMessageBuffer.prepare(CCAPI_WEBSOCKET_READ_BUFFER_PADDING);
+    std::memset(padding.data(), 0, padding.size());
+    return static_cast<char*>(this->readMessageBuffer.data().data());
+  }
   void appendUrlPart(const std::string& urlPart) {
     this->url += urlPart;
     this->setUrlParts();
   }
-  std::string id;
+  uint64_t id{};
   std::string group;
   std::vector<Subscription> subscriptionList;
   std::vector<std::string> correlationIdList;
   Status status{Status::UNKNOWN};
   std::map<std::string, std::string> headers;
   std::map<std::string, std::string> credential;
-  std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream> > > streamPtr;
+  std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream> > > streamPtr;
+  beast::flat_buffer readMessageBuffer;        // owned by the connection so that reading a frame doesn't need to look anything up
+  std::shared_ptr<InflateStream> inflaterPtr;  // created on the first compressed message: inflate state must never be shared between connections
+  std::map<std::string, std::map<std::string, OrderBookState>> orderBookStateByChannelIdSymbolIdMap;
   beast::websocket::close_code remoteCloseCode{};
   beast::websocket::close_reason remoteCloseReason{};
   std::string hostHttpHeaderValue;
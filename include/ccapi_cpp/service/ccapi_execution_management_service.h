@@ -30,12 +30,15 @@ class ExecutionManagementService : public Service {
   ExecutionManagementService(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
                              ServiceContextPtr serviceContextPtr)
       : Service(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->serviceName = CCAPI_EXECUTION_MANAGEMENT;
     this->requestOperationToMessageTypeMap = {
         {Request::Operation::CREATE_ORDER, Message::Type::CREATE_ORDER},
         {Request::Operation::CANCEL_ORDER, Message::Type::CANCEL_ORDER},
         {Request::Operation::GET_ORDER, Message::Type::GET_ORDER},
         {Request::Operation::GET_OPEN_ORDERS, Message::Type::GET_OPEN_ORDERS},
         {Request::Operation::CANCEL_OPEN_ORDERS, Message::Type::CANCEL_OPEN_ORDERS},
+        {Request::Operation::CREATE_ORDERS_BATCH, Message::Type::CREATE_ORDER},
+        {Request::Operation::CANCEL_ORDERS_BATCH, Message::Type::CANCEL_ORDER},
         {Request::Operation::GET_ACCOUNTS, Message::Type::GET_ACCOUNTS},
         {Request::Operation::GET_ACCOUNT_BALANCES, Message::Type::GET_ACCOUNT_BALANCES},
         {Request::Operation::GET_ACCOUNT_POSITIONS, Message::Type::GET_ACCOUNT_POSITIONS},
@@ -59,7 +62,7 @@ class ExecutionManagementService : public Service {
           WsConnection wsConnection(that->baseUrlWs, "", {subscription}, credential);
           that->prepareConnect(wsConnection);
 #else
-                                std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> streamPtr(nullptr);
+                                std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>> streamPtr(nullptr);
                                 try {
                                   streamPtr = that->createWsStream(that->serviceContextPtr->ioContextPtr, that->serviceContextPtr->sslContextPtr);
                                 } catch (const beast::error_code& ec) {
@@ -100,6 +103,22 @@ class ExecutionManagementService : public Service {
     }
     return output;
   }
+  size_t getBatchSizeMax(Request::Operation operation) const override {
+    if (operation == Request::Operation::CREATE_ORDERS_BATCH && !this->createOrdersBatchTarget.empty()) {
+      return this->createOrdersBatchSizeMax;
+    } else if (operation == Request::Operation::CANCEL_ORDERS_BATCH && !this->cancelOrdersBatchTarget.empty()) {
+      return this->cancelOrdersBatchSizeMax;
+    }
+    return 1;
+  }
+  void setMetricsRegistryPtr(std::shared_ptr<MetricsRegistry> metricsRegistryPtr) override {
+    Service::setMetricsRegistryPtr(metricsRegistryPtr);
+    auto labelMap = this->getMetricsLabelMap();
+    this->websocketRequestSentCounterPtr =
+        &metricsRegistryPtr->getCounter("ccapi_websocket_requests_sent_total", labelMap, "Number of requests sent over private websocket connections.");
+    this->websocketRequestFailureCounterPtr = &metricsRegistryPtr->getCounter(
+        "ccapi_websocket_request_failures_total", labelMap, "Number of requests that failed to be sent over private websocket connections.");
+  }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  protected:
@@ -114,6 +133,9 @@ class ExecutionManagementService : public Service {
     std::vector<Element> elementList;
     Request::Operation operation = request.getOperation();
     message.setType(this->requestOperationToMessageTypeMap.at(operation));
+    if (Request::isBatchOperation(operation)) {
+      return this->convertTextMessageToMessageRestBatch(message, request, document);
+    }
     auto castedOperation = static_cast<int>(operation);
     if (castedOperation >= CCAPI_REQUEST_OPERATION_TYPE_EXECUTION_MANAGEMENT_ORDER &&
         castedOperation < CCAPI_REQUEST_OPERATION_TYPE_EXECUTION_MANAGEMENT_ACCOUNT) {
@@ -127,10 +149,31 @@ class ExecutionManagementService : public Service {
     messageList.emplace_back(std::move(message));
     return messageList;
   }
+  // the extraction of a batch response yields one element per order of the request, in the same order; an order that was rejected gets an element with
+  // CCAPI_ERROR_MESSAGE. Each element becomes its own message tagged with the correlation id of its order.
+  std::vector<Message> convertTextMessageToMessageRestBatch(const Message& messageTemplate, const Request& request, const rj::Document& document) {
+    std::vector<Element> elementList;
+    this->extractOrderInfoFromRequest(elementList, request, request.getOperation(), document);
+    const auto& paramList = request.getParamList();
+    std::vector<Message> messageList;
+    for (size_t i = 0; i < elementList.size(); ++i) {
+      Message message = messageTemplate;
+      message.setCorrelationIdList({elementList.size() == paramList.size() ? request.getBatchElementCorrelationId(i) : request.getCorrelationId()});
+      if (elementList.at(i).has(CCAPI_ERROR_MESSAGE)) {
+        message.setType(Message::Type::RESPONSE_ERROR);
+        elementList.at(i).insert(CCAPI_HTTP_STATUS_CODE, "200");
+      }
+      message.setElementList({elementList.at(i)});
+      messageList.emplace_back(std::move(message));
+    }
+    return messageList;
+  }
+  // a batch response that reports per order failures as a whole isn't an error as long as it still carries the per order results
+  virtual bool doesHttpBodyContainErrorBatch(const std::string& body) { return this->doesHttpBodyContainError(body); }
   void processSuccessfulTextMessageRest(int statusCode, const Request& request, const std::string& textMessage, const TimePoint& timeReceived,
                                         Queue<Event>* eventQueuePtr) override {
     Event event;
-    if (this->doesHttpBodyContainError(textMessage)) {
+    if (Request::isBatchOperation(request.getOperation()) ? this->doesHttpBodyContainErrorBatch(textMessage) : this->doesHttpBodyContainError(textMessage)) {
       event.setType(Event::Type::RESPONSE);
       Message message;
       message.setType(Message::Type::RESPONSE_ERROR);
@@ -141,6 +184,9 @@ class ExecutionManagementService : public Service {
       element.insert(CCAPI_ERROR_MESSAGE, UtilString::trim(textMessage));
       message.setElementList({element});
       event.setMessageList({message});
+      this->eventHandler(event, eventQueuePtr);
+      this->onBatchElementError(request, "200", textMessage, eventQueuePtr);
+      return;
     } else {
       event.setType(Event::Type::RESPONSE);
       if (request.getOperation() == Request::Operation::GENERIC_PRIVATE_REQUEST) {
@@ -322,6 +368,10 @@ class ExecutionManagementService : public Service {
   void sendRequestByWebsocket(Request& request, const TimePoint& now) override {
     CCAPI_LOGGER_FUNCTION_ENTER;
     CCAPI_LOGGER_TRACE("now = " + toString(now));
+    if (Request::isBatchOperation(request.getOperation())) {
+      this->onRequestFailure(request, "batch operation " + Request::operationToString(request.getOperation()) + " can only be sent by rest", nullptr);
+      return;
+    }
     boost::asio::post(*this->serviceContextPtr->ioContextPtr, [that = shared_from_base<ExecutionManagementService>(), request]() mutable {
       auto now = UtilTime::now();
       CCAPI_LOGGER_DEBUG("request = " + toString(request));
@@ -365,6 +415,11 @@ class ExecutionManagementService : public Service {
 #endif
       if (ec) {
         that->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "request");
+        if (that->websocketRequestFailureCounterPtr) {
+          that->websocketRequestFailureCounterPtr->increment();
+        }
+      } else if (that->websocketRequestSentCounterPtr) {
+        that->websocketRequestSentCounterPtr->increment();
       }
     });
     CCAPI_LOGGER_FUNCTION_EXIT;
@@ -393,14 +448,20 @@ class ExecutionManagementService : public Service {
   std::string getAccountsTarget;
   std::string getAccountBalancesTarget;
   std::string getAccountPositionsTarget;
-  std::map<std::string, std::string> correlationIdByConnectionIdMap;
+  std::string createOrdersBatchTarget;
+  std::string cancelOrdersBatchTarget;
+  size_t createOrdersBatchSizeMax{};
+  size_t cancelOrdersBatchSizeMax{};
+  std::map<uint64_t, std::string> correlationIdByConnectionIdMap;
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
   std::map<std::string, WsConnection> wsConnectionByCorrelationIdMap;
 #else
   std::map<std::string, std::shared_ptr<WsConnection>>
       wsConnectionByCorrelationIdMap;  // TODO(cryptochassis): for consistency, to be renamed to wsConnectionPtrByCorrelationIdMap
 #endif
-  std::map<std::string, int> wsRequestIdByConnectionIdMap;
+  std::map<uint64_t, int> wsRequestIdByConnectionIdMap;
+  MetricCounter* websocketRequestSentCounterPtr{};
+  MetricCounter* websocketRequestFailureCounterPtr{};
 };
 } /* namespace ccapi */
 #endif
@@ -368,7 +368,7 @@ class ExecutionManagementServiceAscendex : public ExecutionManagementService {
           WsConnection wsConnection(that->baseUrlWs + "/" + accountGroup + "/api/pro/v1/stream", "", {subscription}, credential);
           that->prepareConnect(wsConnection);
 #else
-                              std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> streamPtr(nullptr);
+                              std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>> streamPtr(nullptr);
                                 try {
                                   streamPtr = that->createWsStream(that->serviceContextPtr->ioContextPtr, that->serviceContextPtr->sslContextPtr);
                                 } catch (const beast::error_code& ec) {
@@ -420,9 +420,9 @@ class ExecutionManagementServiceAscendex : public ExecutionManagementService {
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -435,7 +435,7 @@ class ExecutionManagementServiceAscendex : public ExecutionManagementService {
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     Event event;
     std::vector<Message> messageList;
@@ -454,7 +454,7 @@ class ExecutionManagementServiceAscendex : public ExecutionManagementService {
           if (status == "Err") {
             message.setType(Message::Type::RESPONSE_ERROR);
             Element element;
-            element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+            element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
             message.setElementList({element});
             messageList.emplace_back(std::move(message));
           } else {
@@ -509,7 +509,7 @@ class ExecutionManagementServiceAscendex : public ExecutionManagementService {
         event.setType(Event::Type::SUBSCRIPTION_STATUS);
         message.setType(Message::Type::SUBSCRIPTION_STARTED);
         Element element;
-        element.insert(CCAPI_INFO_MESSAGE, textMessage);
+        element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       } else if (m == "auth") {
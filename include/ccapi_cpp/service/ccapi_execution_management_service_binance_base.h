@@ -12,12 +12,51 @@ class ExecutionManagementServiceBinanceBase : public ExecutionManagementService
       : ExecutionManagementService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
     this->enableCheckPingPongWebsocketApplicationLevel = false;
     this->pingListenKeyIntervalSeconds = 600;
+    this->rateLimiterPtr->setLimit(CCAPI_RATE_LIMIT_REQUEST_WEIGHT, 6000, std::chrono::minutes(1));
+    this->rateLimiterPtr->setLimit(CCAPI_RATE_LIMIT_ORDER_COUNT_10S, 100, std::chrono::seconds(10));
+    this->rateLimitUsedHeaderNameByBucketNameMap = {
+        {CCAPI_RATE_LIMIT_REQUEST_WEIGHT, "X-MBX-USED-WEIGHT-1M"},
+        {CCAPI_RATE_LIMIT_ORDER_COUNT_10S, "X-MBX-ORDER-COUNT-10S"},
+    };
   }
   virtual ~ExecutionManagementServiceBinanceBase() {}
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  protected:
 #endif
+  // https://binance-docs.github.io/apidocs/spot/en/#limits and https://binance-docs.github.io/apidocs/futures/en/#limits
+  RateLimiter<RateLimitedRequest>::CostList getRateLimitCostList(const Request& request) override {
+    double weight = 1;
+    double numOrder = 0;
+    switch (request.getOperation()) {
+      case Request::Operation::CREATE_ORDER:
+        numOrder = 1;
+        break;
+      case Request::Operation::CREATE_ORDERS_BATCH:
+        weight = 5;
+        numOrder = request.getParamList().size();
+        break;
+      case Request::Operation::GET_ORDER:
+        weight = this->isDerivatives ? 1 : 4;
+        break;
+      case Request::Operation::GET_OPEN_ORDERS:
+        weight = !request.getInstrument().empty() ? (this->isDerivatives ? 1 : 6) : (this->isDerivatives ? 40 : 80);
+        break;
+      case Request::Operation::GET_ACCOUNT_BALANCES:
+        weight = this->isDerivatives ? 5 : 20;
+        break;
+      case Request::Operation::GET_ACCOUNT_POSITIONS:
+        weight = 5;
+        break;
+      default:
+        break;
+    }
+    return {
+        {CCAPI_RATE_LIMIT_REQUEST_WEIGHT, weight},
+        {CCAPI_RATE_LIMIT_ORDER_COUNT_10S, numOrder},
+        {CCAPI_RATE_LIMIT_ORDER_COUNT_1M, numOrder},
+    };
+  }
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
   void prepareConnect(WsConnection& wsConnection) override {
     auto hostPort = this->extractHostFromUrl(this->baseUrlRest);
@@ -316,6 +355,13 @@ class ExecutionManagementServiceBinanceBase : public ExecutionManagementService
       queryString += "&";
     }
   }
+  void appendParam(rj::Value& rjValue, rj::Document::AllocatorType& allocator, const std::map<std::string, std::string>& param,
+                   const std::map<std::string, std::string> standardizationMap) {
+    for (const auto& kv : param) {
+      auto key = standardizationMap.find(kv.first) != standardizationMap.end() ? standardizationMap.at(kv.first) : kv.first;
+      rjValue.AddMember(rj::Value(key.c_str(), allocator).Move(), rj::Value(kv.second.c_str(), allocator).Move(), allocator);
+    }
+  }
   void appendSymbolId(std::string& queryString, const std::string& symbolId) {
     queryString += "symbol=";
     queryString += Url::urlEncode(symbolId);
@@ -448,7 +494,8 @@ class ExecutionManagementServiceBinanceBase : public ExecutionManagementService
         {CCAPI_EM_ORDER_INSTRUMENT, std::make_pair("symbol", JsonDataType::STRING)},
         {CCAPI_LAST_UPDATED_TIME_SECONDS, std::make_pair("updateTime", JsonDataType::STRING)},
     };
-    if (operation == Request::Operation::CANCEL_ORDER || operation == Request::Operation::CANCEL_OPEN_ORDERS) {
+    if (operation == Request::Operation::CANCEL_ORDER || operation == Request::Operation::CANCEL_OPEN_ORDERS ||
+        operation == Request::Operation::CANCEL_ORDERS_BATCH) {
       extractionFieldNameMap.insert({CCAPI_EM_CLIENT_ORDER_ID, std::make_pair("origClientOrderId", JsonDataType::STRING)});
     } else {
       extractionFieldNameMap.insert({CCAPI_EM_CLIENT_ORDER_ID, std::make_pair("clientOrderId", JsonDataType::STRING)});
@@ -464,6 +511,12 @@ class ExecutionManagementServiceBinanceBase : public ExecutionManagementService
     } else {
       for (const auto& x : document.GetArray()) {
         Element element;
+        // a rejected order of a batch is reported in place as {"code":...,"msg":...}
+        if (Request::isBatchOperation(operation) && x.HasMember("code") && !x.HasMember("orderId")) {
+          element.insert(CCAPI_ERROR_MESSAGE, x["msg"].GetString());
+          elementList.emplace_back(std::move(element));
+          continue;
+        }
         this->extractOrderInfo(
             element, x, extractionFieldNameMap,
             {
@@ -552,9 +605,9 @@ class ExecutionManagementServiceBinanceBase : public ExecutionManagementService
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -567,7 +620,7 @@ class ExecutionManagementServiceBinanceBase : public ExecutionManagementService
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     Event event;
     std::vector<Message> messageList;
@@ -696,7 +749,7 @@ class ExecutionManagementServiceBinanceBase : public ExecutionManagementService
   bool isDerivatives{};
   std::string listenKeyTarget;
   int pingListenKeyIntervalSeconds;
-  std::map<std::string, TimerPtr> pingListenKeyTimerMapByConnectionIdMap;
+  std::map<uint64_t, TimerPtr> pingListenKeyTimerMapByConnectionIdMap;
   std::string createOrderMarginTarget;
   std::string cancelOrderMarginTarget;
   std::string getOrderMarginTarget;
@@ -35,6 +35,8 @@ class ExecutionManagementServiceBinanceCoinFutures : public ExecutionManagementS
     this->getOrderTarget = "/dapi/v1/order";
     this->getOpenOrdersTarget = "/dapi/v1/openOrders";
     this->cancelOpenOrdersTarget = "/dapi/v1/allOpenOrders";
+    this->createOrdersBatchTarget = "/dapi/v1/batchOrders";
+    this->cancelOrdersBatchTarget = "/dapi/v1/batchOrders";
     this->isDerivatives = true;
     this->listenKeyTarget = CCAPI_BINANCE_COIN_FUTURES_LISTEN_KEY_PATH;
     this->getAccountBalancesTarget = "/dapi/v1/account";
@@ -10,6 +10,12 @@ class ExecutionManagementServiceBinanceDerivativesBase : public ExecutionManagem
                                                    SessionConfigs sessionConfigs, ServiceContextPtr serviceContextPtr)
       : ExecutionManagementServiceBinanceBase(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
     this->isDerivatives = true;
+    this->createOrdersBatchSizeMax = 5;
+    this->cancelOrdersBatchSizeMax = 10;
+    this->rateLimiterPtr->setLimit(CCAPI_RATE_LIMIT_REQUEST_WEIGHT, 2400, std::chrono::minutes(1));
+    this->rateLimiterPtr->setLimit(CCAPI_RATE_LIMIT_ORDER_COUNT_10S, 300, std::chrono::seconds(10));
+    this->rateLimiterPtr->setLimit(CCAPI_RATE_LIMIT_ORDER_COUNT_1M, 1200, std::chrono::minutes(1));
+    this->rateLimitUsedHeaderNameByBucketNameMap[CCAPI_RATE_LIMIT_ORDER_COUNT_1M] = "X-MBX-ORDER-COUNT-1M";
   }
   virtual ~ExecutionManagementServiceBinanceDerivativesBase() {}
   void convertRequestForRest(http::request<http::string_body>& req, const Request& request, const TimePoint& now, const std::string& symbolId,
@@ -23,6 +29,63 @@ class ExecutionManagementServiceBinanceDerivativesBase : public ExecutionManagem
         this->signRequest(queryString, {}, now, credential);
         req.target(this->getAccountPositionsTarget + "?" + queryString);
       } break;
+      case Request::Operation::CREATE_ORDERS_BATCH: {
+        this->prepareReq(req, credential);
+        req.method(http::verb::post);
+        rj::Document document;
+        document.SetArray();
+        rj::Document::AllocatorType& allocator = document.GetAllocator();
+        for (size_t i = 0; i < request.getParamList().size(); ++i) {
+          const std::map<std::string, std::string> param = request.getBatchElementParam(i);
+          rj::Value order(rj::kObjectType);
+          this->appendParam(order, allocator, param,
+                            {
+                                {CCAPI_EM_ORDER_SIDE, "side"},
+                                {CCAPI_EM_ORDER_QUANTITY, "quantity"},
+                                {CCAPI_EM_ORDER_LIMIT_PRICE, "price"},
+                                {CCAPI_EM_CLIENT_ORDER_ID, "newClientOrderId"},
+                            });
+          order.AddMember("symbol", rj::Value(symbolId.c_str(), allocator).Move(), allocator);
+          if (param.find("type") == param.end()) {
+            order.AddMember("type", rj::Value("LIMIT").Move(), allocator);
+            if (param.find("timeInForce") == param.end()) {
+              order.AddMember("timeInForce", rj::Value("GTC").Move(), allocator);
+            }
+          }
+          document.PushBack(order, allocator);
+        }
+        rj::StringBuffer stringBuffer;
+        rj::Writer<rj::StringBuffer> writer(stringBuffer);
+        document.Accept(writer);
+        std::string queryString = "batchOrders=";
+        queryString += Url::urlEncode(stringBuffer.GetString());
+        queryString += "&";
+        this->signRequest(queryString, {}, now, credential);
+        req.target(this->createOrdersBatchTarget + "?" + queryString);
+      } break;
+      case Request::Operation::CANCEL_ORDERS_BATCH: {
+        this->prepareReq(req, credential);
+        req.method(http::verb::delete_);
+        // the orders are identified either all by order id or all by client order id
+        bool useOrderId = true;
+        for (const auto& param : request.getParamList()) {
+          useOrderId = useOrderId && param.find(CCAPI_EM_ORDER_ID) != param.end();
+        }
+        std::string idList = "[";
+        for (const auto& param : request.getParamList()) {
+          if (idList.size() > 1) {
+            idList += ",";
+          }
+          idList += useOrderId ? param.at(CCAPI_EM_ORDER_ID) : "\"" + mapGetWithDefault(param, std::string(CCAPI_EM_CLIENT_ORDER_ID)) + "\"";
+        }
+        idList += "]";
+        std::string queryString = useOrderId ? "orderIdList=" : "origClientOrderIdList=";
+        queryString += Url::urlEncode(idList);
+        queryString += "&";
+        this->appendSymbolId(queryString, symbolId);
+        this->signRequest(queryString, {}, now, credential);
+        req.target(this->cancelOrdersBatchTarget + "?" + queryString);
+      } break;
       default:
         ExecutionManagementServiceBinanceBase::convertRequestForRest(req, request, now, symbolId, credential);
     }
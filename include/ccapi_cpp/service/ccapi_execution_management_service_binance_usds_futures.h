@@ -35,6 +35,8 @@ class ExecutionManagementServiceBinanceUsdsFutures : public ExecutionManagementS
     this->getOrderTarget = "/fapi/v1/order";
     this->getOpenOrdersTarget = "/fapi/v1/openOrders";
     this->cancelOpenOrdersTarget = "/fapi/v1/allOpenOrders";
+    this->createOrdersBatchTarget = "/fapi/v1/batchOrders";
+    this->cancelOrdersBatchTarget = "/fapi/v1/batchOrders";
     this->isDerivatives = true;
     this->listenKeyTarget = CCAPI_BINANCE_USDS_FUTURES_LISTEN_KEY_PATH;
     this->getAccountBalancesTarget = "/fapi/v2/account";
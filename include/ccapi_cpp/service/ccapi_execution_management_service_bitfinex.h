@@ -374,9 +374,9 @@ class ExecutionManagementServiceBitfinex : public ExecutionManagementService {
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -389,7 +389,7 @@ class ExecutionManagementServiceBitfinex : public ExecutionManagementService {
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
       Event event;
   std::vector<Message> messageList;
@@ -461,7 +461,7 @@ class ExecutionManagementServiceBitfinex : public ExecutionManagementService {
       if (status != "SUCCESS") {
         message.setType(Message::Type::RESPONSE_ERROR);
         Element element;
-        element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+        element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       } else {
@@ -486,7 +486,7 @@ class ExecutionManagementServiceBitfinex : public ExecutionManagementService {
         event.setType(Event::Type::SUBSCRIPTION_STATUS);
         message.setType(status == "OK" ? Message::Type::SUBSCRIPTION_STARTED : Message::Type::SUBSCRIPTION_FAILURE);
         Element element;
-        element.insert(status == "OK" ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, textMessage);
+        element.insert(status == "OK" ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       }
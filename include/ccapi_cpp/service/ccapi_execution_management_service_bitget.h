@@ -262,11 +262,11 @@ class ExecutionManagementServiceBitget : public ExecutionManagementServiceBitget
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
       if (textMessage != "pong") {
         rj::Document document;
-  document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+  document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
   auto it = document.FindMember("event");
   std::string eventStr = it != document.MemberEnd() ? it->value.GetString() : "";
   if (eventStr == "login") {
@@ -312,7 +312,7 @@ class ExecutionManagementServiceBitget : public ExecutionManagementServiceBitget
   }
 }
 }  // namespace ccapi
-Event createEvent(const Subscription& subscription, const std::string& textMessage, const rj::Document& document, const std::string& eventStr,
+Event createEvent(const Subscription& subscription, boost::beast::string_view textMessage, const rj::Document& document, const std::string& eventStr,
                   const TimePoint& timeReceived) {
   Event event;
   std::vector<Message> messageList;
@@ -390,14 +390,14 @@ Event createEvent(const Subscription& subscription, const std::string& textMessa
     event.setType(Event::Type::SUBSCRIPTION_STATUS);
     message.setType(Message::Type::SUBSCRIPTION_STARTED);
     Element element;
-    element.insert(CCAPI_INFO_MESSAGE, textMessage);
+    element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
     message.setElementList({element});
     messageList.emplace_back(std::move(message));
   } else if (eventStr == "error") {
     event.setType(Event::Type::SUBSCRIPTION_STATUS);
     message.setType(Message::Type::SUBSCRIPTION_FAILURE);
     Element element;
-    element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+    element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
     message.setElementList({element});
     messageList.emplace_back(std::move(message));
   }
@@ -315,11 +315,11 @@ class ExecutionManagementServiceBitgetFutures : public ExecutionManagementServic
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     if (textMessage != "pong") {
       rj::Document document;
-      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
       auto it = document.FindMember("event");
       std::string eventStr = it != document.MemberEnd() ? it->value.GetString() : "";
       if (eventStr == "login") {
@@ -376,7 +376,7 @@ class ExecutionManagementServiceBitgetFutures : public ExecutionManagementServic
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const std::string& eventStr, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     Event event;
     std::vector<Message> messageList;
@@ -454,14 +454,14 @@ class ExecutionManagementServiceBitgetFutures : public ExecutionManagementServic
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     } else if (eventStr == "error") {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
@@ -308,11 +308,11 @@ class ExecutionManagementServiceBitmart : public ExecutionManagementService {
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     if (textMessage != "pong") {
       rj::Document document;
-      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
       auto it = document.FindMember("errorCode");
       std::string errorCode = it != document.MemberEnd() ? it->value.GetString() : "";
       Event event;
@@ -383,7 +383,7 @@ class ExecutionManagementServiceBitmart : public ExecutionManagementService {
           message.setTimeReceived(timeReceived);
           message.setType(Message::Type::SUBSCRIPTION_FAILURE);
           Element element;
-          element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+          element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           message.setCorrelationIdList({correlationId});
           messageList.emplace_back(std::move(message));
@@ -396,7 +396,7 @@ class ExecutionManagementServiceBitmart : public ExecutionManagementService {
       }
     }
   }
-  Event createEvent(const Subscription& subscription, const std::string& textMessage, const rj::Document& document, const std::string& eventStr,
+  Event createEvent(const Subscription& subscription, boost::beast::string_view textMessage, const rj::Document& document, const std::string& eventStr,
                     const TimePoint& timeReceived) {
     Event event;
     std::vector<Message> messageList;
@@ -410,7 +410,7 @@ class ExecutionManagementServiceBitmart : public ExecutionManagementService {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     } else {
@@ -327,9 +327,9 @@ class ExecutionManagementServiceBitmex : public ExecutionManagementService {
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -342,7 +342,7 @@ class ExecutionManagementServiceBitmex : public ExecutionManagementService {
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
       Event event;
   std::vector<Message> messageList;
@@ -358,7 +358,7 @@ class ExecutionManagementServiceBitmex : public ExecutionManagementService {
         event.setType(Event::Type::SUBSCRIPTION_STATUS);
         message.setType(Message::Type::SUBSCRIPTION_FAILURE);
         Element element;
-        element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+        element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       }
@@ -371,7 +371,7 @@ class ExecutionManagementServiceBitmex : public ExecutionManagementService {
           event.setType(Event::Type::SUBSCRIPTION_STATUS);
           message.setType(Message::Type::SUBSCRIPTION_STARTED);
           Element element;
-          element.insert(CCAPI_INFO_MESSAGE, textMessage);
+          element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           messageList.emplace_back(std::move(message));
           rj::Document document;
@@ -210,7 +210,7 @@ class ExecutionManagementServiceBybit : public ExecutionManagementServiceBybitBa
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
       Event event;
   std::vector<Message> messageList;
@@ -319,7 +319,7 @@ class ExecutionManagementServiceBybit : public ExecutionManagementServiceBybitBa
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(success ? Message::Type::SUBSCRIPTION_STARTED : Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
@@ -329,7 +329,7 @@ class ExecutionManagementServiceBybit : public ExecutionManagementServiceBybitBa
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
@@ -245,7 +245,7 @@ class ExecutionManagementServiceBybitDerivatives : public ExecutionManagementSer
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
       Event event;
   std::vector<Message> messageList;
@@ -365,7 +365,7 @@ class ExecutionManagementServiceBybitDerivatives : public ExecutionManagementSer
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(success ? Message::Type::SUBSCRIPTION_STARTED : Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
@@ -375,7 +375,7 @@ class ExecutionManagementServiceBybitDerivatives : public ExecutionManagementSer
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
@@ -372,9 +372,9 @@ class ExecutionManagementServiceDeribit : public ExecutionManagementService {
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -387,7 +387,7 @@ class ExecutionManagementServiceDeribit : public ExecutionManagementService {
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     const WsConnection& wsConnection = *wsConnectionPtr;
 #endif
     Event event;
@@ -407,7 +407,7 @@ class ExecutionManagementServiceDeribit : public ExecutionManagementService {
           event.setType(Event::Type::SUBSCRIPTION_STATUS);
           message.setType(Message::Type::SUBSCRIPTION_FAILURE);
           Element element;
-          element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+          element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           messageList.emplace_back(std::move(message));
           if (it != document.MemberEnd()) {
@@ -468,7 +468,7 @@ class ExecutionManagementServiceDeribit : public ExecutionManagementService {
             event.setType(Event::Type::SUBSCRIPTION_STATUS);
             message.setType(Message::Type::SUBSCRIPTION_STARTED);
             Element element;
-            element.insert(CCAPI_INFO_MESSAGE, textMessage);
+            element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
             message.setElementList({element});
             messageList.emplace_back(std::move(message));
             if (it != document.MemberEnd()) {
@@ -573,8 +573,8 @@ class ExecutionManagementServiceDeribit : public ExecutionManagementService {
     event.setMessageList(messageList);
     return event;
   }
-  std::map<std::string, std::set<int64_t>> subscriptionJsonrpcIdSetByConnectionIdMap;
-  std::map<std::string, std::set<int64_t>> authorizationJsonrpcIdSetByConnectionIdMap;
+  std::map<uint64_t, std::set<int64_t>> subscriptionJsonrpcIdSetByConnectionIdMap;
+  std::map<uint64_t, std::set<int64_t>> authorizationJsonrpcIdSetByConnectionIdMap;
   std::string restTarget;
   std::string clientIdName;
   std::string clientSecretName;
@@ -36,6 +36,10 @@ class ExecutionManagementServiceGateio : public ExecutionManagementServiceGateio
     this->getOrderTarget = prefix + "/spot/orders/{order_id}";
     this->getOpenOrdersTarget = prefix + "/spot/orders";
     this->cancelOpenOrdersTarget = prefix + "/spot/orders";
+    this->createOrdersBatchTarget = prefix + "/spot/batch_orders";
+    this->cancelOrdersBatchTarget = prefix + "/spot/cancel_batch_orders";
+    this->createOrdersBatchSizeMax = 10;
+    this->cancelOrdersBatchSizeMax = 20;
     this->getAccountsTarget = prefix + "/spot/accounts";
     this->symbolName = "currency_pair";
     this->websocketChannelUserTrades = "spot.usertrades";
@@ -81,7 +81,7 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
     queryString += Url::urlEncode(symbolId);
     queryString += "&";
   }
-  void appendParam(rj::Document& document, rj::Document::AllocatorType& allocator, const std::map<std::string, std::string>& param,
+  void appendParam(rj::Value& document, rj::Document::AllocatorType& allocator, const std::map<std::string, std::string>& param,
                    const std::map<std::string, std::string> standardizationMap) {
     for (const auto& kv : param) {
       auto key = standardizationMap.find(kv.first) != standardizationMap.end() ? standardizationMap.at(kv.first) : kv.first;
@@ -98,7 +98,7 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
       }
     }
   }
-  void appendParam(rj::Document& document, rj::Document::AllocatorType& allocator, const std::map<std::string, std::string>& param) {
+  void appendParam(rj::Value& document, rj::Document::AllocatorType& allocator, const std::map<std::string, std::string>& param) {
     this->appendParam(document, allocator, param,
                       {
                           {CCAPI_EM_ORDER_SIDE, "side"},
@@ -109,7 +109,7 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
                           {CCAPI_EM_ACCOUNT_TYPE, "account"},
                       });
   }
-  void appendSymbolId(rj::Document& document, rj::Document::AllocatorType& allocator, const std::string& symbolId) {
+  void appendSymbolId(rj::Value& document, rj::Document::AllocatorType& allocator, const std::string& symbolId) {
     document.AddMember(rj::Value(symbolName.c_str(), allocator).Move(), rj::Value(symbolId.c_str(), allocator).Move(), allocator);
   }
   void substituteParamSettle(std::string& target, const std::map<std::string, std::string>& param, const std::string& symbolId) {
@@ -186,6 +186,42 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
         }
         this->signRequest(req, path, queryString, "", credential);
       } break;
+      case Request::Operation::CREATE_ORDERS_BATCH:
+      case Request::Operation::CANCEL_ORDERS_BATCH: {
+        bool isCreate = request.getOperation() == Request::Operation::CREATE_ORDERS_BATCH;
+        if (isCreate) {
+          req.set("X-Gate-Channel-Id", CCAPI_GATEIO_API_CHANNEL_ID);
+        }
+        req.method(http::verb::post);
+        rj::Document document;
+        document.SetArray();
+        rj::Document::AllocatorType& allocator = document.GetAllocator();
+        for (size_t i = 0; i < request.getParamList().size(); ++i) {
+          std::map<std::string, std::string> param = request.getBatchElementParam(i);
+          rj::Value order(rj::kObjectType);
+          if (isCreate) {
+            this->appendParam(order, allocator, param);
+          } else {
+            std::string id = param.find(CCAPI_EM_ORDER_ID) != param.end()          ? param.at(CCAPI_EM_ORDER_ID)
+                             : param.find(CCAPI_EM_CLIENT_ORDER_ID) != param.end() ? param.at(CCAPI_EM_CLIENT_ORDER_ID)
+                                                                                   : "";
+            param.erase(CCAPI_EM_ORDER_ID);
+            param.erase(CCAPI_EM_CLIENT_ORDER_ID);
+            param["id"] = id;
+            this->appendParam(order, allocator, param,
+                              {
+                                  {CCAPI_EM_ACCOUNT_ID, "account"},
+                              });
+          }
+          this->appendSymbolId(order, allocator, symbolId);
+          document.PushBack(order, allocator);
+        }
+        rj::StringBuffer stringBuffer;
+        rj::Writer<rj::StringBuffer> writer(stringBuffer);
+        document.Accept(writer);
+        auto body = stringBuffer.GetString();
+        this->signRequest(req, isCreate ? this->createOrdersBatchTarget : this->cancelOrdersBatchTarget, "", body, credential);
+      } break;
       case Request::Operation::GET_ORDER: {
         req.method(http::verb::get);
         std::map<std::string, std::string> param = request.getFirstParamWithDefault();
@@ -295,7 +331,17 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
         {CCAPI_EM_ORDER_STATUS, std::make_pair("status", JsonDataType::STRING)},
         {CCAPI_EM_ORDER_INSTRUMENT, std::make_pair(this->symbolName, JsonDataType::STRING)},
     };
-    if (operation == Request::Operation::GET_OPEN_ORDERS || operation == Request::Operation::CANCEL_OPEN_ORDERS) {
+    if (Request::isBatchOperation(operation)) {
+      for (const auto& x : document.GetArray()) {
+        Element element;
+        auto it = x.FindMember("succeeded");
+        if (it != x.MemberEnd() && !it->value.GetBool()) {
+          element.insert(CCAPI_ERROR_MESSAGE, std::string(x["label"].GetString()) + ": " + x["message"].GetString());
+        }
+        this->extractOrderInfo(element, x, extractionFieldNameMap);
+        elementList.emplace_back(std::move(element));
+      }
+    } else if (operation == Request::Operation::GET_OPEN_ORDERS || operation == Request::Operation::CANCEL_OPEN_ORDERS) {
       for (const auto& x : document.GetArray()) {
         Element element;
         this->extractOrderInfo(element, x, extractionFieldNameMap);
@@ -366,9 +412,9 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -381,7 +427,7 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     Event event;
     std::vector<Message> messageList;
@@ -456,7 +502,7 @@ class ExecutionManagementServiceGateioBase : public ExecutionManagementService {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(hasError ? Message::Type::SUBSCRIPTION_FAILURE : Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(hasError ? CCAPI_ERROR_MESSAGE : CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(hasError ? CCAPI_ERROR_MESSAGE : CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
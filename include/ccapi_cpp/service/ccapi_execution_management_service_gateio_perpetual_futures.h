@@ -110,7 +110,7 @@ class ExecutionManagementServiceGateioPerpetualFutures : public ExecutionManagem
                               WsConnection wsConnection(that->baseUrlWs + settle, "", {subscription}, credential);
                               that->prepareConnect(wsConnection);
 #else
-                              std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> streamPtr(nullptr);
+                              std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>> streamPtr(nullptr);
                                 try {
                                   streamPtr = that->createWsStream(that->serviceContextPtr->ioContextPtr, that->serviceContextPtr->sslContextPtr);
                                 } catch (const beast::error_code& ec) {
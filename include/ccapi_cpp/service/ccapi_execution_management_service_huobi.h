@@ -273,10 +273,10 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     std::string actionStr = document["action"].GetString();
     const auto& fieldSet = subscription.getFieldSet();
     const auto& instrumentSet = subscription.getInstrumentSet();
@@ -320,7 +320,7 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
             }
           }
         } else {
-          this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, textMessage, {subscription.getCorrelationId()});
+          this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, std::string(textMessage), {subscription.getCorrelationId()});
         }
       }
     } else if (actionStr == "ping") {
@@ -346,7 +346,7 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
       }
     }
   }
-  Event createEvent(const Subscription& subscription, const std::string& textMessage, const rj::Document& document, const std::string& actionStr,
+  Event createEvent(const Subscription& subscription, boost::beast::string_view textMessage, const rj::Document& document, const std::string& actionStr,
                     const TimePoint& timeReceived) {
     Event event;
     std::vector<Message> messageList;
@@ -430,7 +430,7 @@ class ExecutionManagementServiceHuobi : public ExecutionManagementServiceHuobiBa
         event.setType(Event::Type::SUBSCRIPTION_STATUS);
         message.setType(Message::Type::SUBSCRIPTION_STARTED);
         Element element;
-        element.insert(CCAPI_INFO_MESSAGE, textMessage);
+        element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       }
@@ -254,10 +254,10 @@ class ExecutionManagementServiceHuobiDerivativesBase : public ExecutionManagemen
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     std::string op = document["op"].GetString();
     const auto& fieldSet = subscription.getFieldSet();
     const auto& instrumentSet = subscription.getInstrumentSet();
@@ -293,7 +293,7 @@ class ExecutionManagementServiceHuobiDerivativesBase : public ExecutionManagemen
           }
         }
       } else {
-        this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, textMessage, {subscription.getCorrelationId()});
+        this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, std::string(textMessage), {subscription.getCorrelationId()});
       }
     } else if (op == "ping") {
       rj::StringBuffer stringBufferSubscribe;
@@ -318,7 +318,7 @@ class ExecutionManagementServiceHuobiDerivativesBase : public ExecutionManagemen
       }
     }
   }
-  Event createEvent(const Subscription& subscription, const std::string& textMessage, const rj::Document& document, const std::string& op,
+  Event createEvent(const Subscription& subscription, boost::beast::string_view textMessage, const rj::Document& document, const std::string& op,
                     const TimePoint& timeReceived) {
     Event event;
     std::vector<Message> messageList;
@@ -411,14 +411,14 @@ class ExecutionManagementServiceHuobiDerivativesBase : public ExecutionManagemen
         event.setType(Event::Type::SUBSCRIPTION_STATUS);
         message.setType(Message::Type::SUBSCRIPTION_FAILURE);
         Element element;
-        element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+        element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       } else {
         event.setType(Event::Type::SUBSCRIPTION_STATUS);
         message.setType(Message::Type::SUBSCRIPTION_STARTED);
         Element element;
-        element.insert(CCAPI_INFO_MESSAGE, textMessage);
+        element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       }
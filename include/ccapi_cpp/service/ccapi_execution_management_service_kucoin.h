@@ -35,6 +35,8 @@ class ExecutionManagementServiceKucoin : public ExecutionManagementServiceKucoin
     this->getOrderByClientOrderIdTarget = "/api/v1/order/client-order/<id>";
     this->getOpenOrdersTarget = "/api/v1/orders";
     this->cancelOpenOrdersTarget = "/api/v1/orders";
+    this->createOrdersBatchTarget = "/api/v1/orders/multi";
+    this->createOrdersBatchSizeMax = 5;
     this->getAccountsTarget = "/api/v1/accounts";
     this->getAccountBalancesTarget = "/api/v1/accounts/<accountId>";
     this->topicTradeOrders = "/spotMarket/tradeOrders";
@@ -161,7 +161,7 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
   void signApiPassphrase(http::request<http::string_body>& req, const std::string& apiPassphrase, const std::string& apiSecret) {
     req.set("KC-API-PASSPHRASE", UtilAlgorithm::base64Encode(Hmac::hmac(Hmac::ShaVersion::SHA256, apiSecret, apiPassphrase)));
   }
-  void appendParam(rj::Document& document, rj::Document::AllocatorType& allocator, const std::map<std::string, std::string>& param,
+  void appendParam(rj::Value& document, rj::Document::AllocatorType& allocator, const std::map<std::string, std::string>& param,
                    const std::map<std::string, std::string> standardizationMap = {
                        {CCAPI_EM_ORDER_SIDE, "side"},
                        {CCAPI_EM_ORDER_QUANTITY, "size"},
@@ -232,6 +232,27 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
         this->signRequestPartner(req, body, credential);
         this->signRequest(req, body, credential);
       } break;
+      case Request::Operation::CREATE_ORDERS_BATCH: {
+        req.method(http::verb::post);
+        req.target(this->createOrdersBatchTarget);
+        rj::Document document;
+        document.SetObject();
+        rj::Document::AllocatorType& allocator = document.GetAllocator();
+        this->appendSymbolId(document, allocator, symbolId);
+        rj::Value orderList(rj::kArrayType);
+        for (size_t i = 0; i < request.getParamList().size(); ++i) {
+          rj::Value order(rj::kObjectType);
+          this->appendParam(order, allocator, request.getBatchElementParam(i));
+          orderList.PushBack(order, allocator);
+        }
+        document.AddMember("orderList", orderList, allocator);
+        rj::StringBuffer stringBuffer;
+        rj::Writer<rj::StringBuffer> writer(stringBuffer);
+        document.Accept(writer);
+        auto body = stringBuffer.GetString();
+        this->signRequestPartner(req, body, credential);
+        this->signRequest(req, body, credential);
+      } break;
       case Request::Operation::CANCEL_ORDER: {
         req.method(http::verb::delete_);
         const std::map<std::string, std::string> param = request.getFirstParamWithDefault();
@@ -359,6 +380,16 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
       Element element;
       element.insert(CCAPI_EM_ORDER_ID, data["orderId"].GetString());
       elementList.emplace_back(std::move(element));
+    } else if (operation == Request::Operation::CREATE_ORDERS_BATCH) {
+      for (const auto& x : data["data"].GetArray()) {
+        Element element;
+        if (std::string(x["status"].GetString()) != "success") {
+          auto it = x.FindMember("failMsg");
+          element.insert(CCAPI_ERROR_MESSAGE, it != x.MemberEnd() && it->value.IsString() ? it->value.GetString() : "");
+        }
+        this->extractOrderInfo(element, x, extractionFieldNameMap);
+        elementList.emplace_back(std::move(element));
+      }
     } else if (operation == Request::Operation::GET_OPEN_ORDERS) {
       for (const auto& x : data["items"].GetArray()) {
         Element element;
@@ -421,9 +452,9 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -436,7 +467,7 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     const WsConnection& wsConnection = *wsConnectionPtr;
 #endif
     Event event;
@@ -508,14 +539,14 @@ class ExecutionManagementServiceKucoinBase : public ExecutionManagementService {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     } else if (type == "error") {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     } else if (type == "welcome") {
@@ -468,9 +468,9 @@ class ExecutionManagementServiceMexc : public ExecutionManagementService {
 #else
   void onTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                      const TimePoint& timeReceived) override {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     Event event = this->createEvent(wsConnectionPtr, subscription, textMessageView, document, timeReceived);
     if (!event.getMessageList().empty()) {
       this->eventHandler(event, nullptr);
@@ -483,7 +483,7 @@ class ExecutionManagementServiceMexc : public ExecutionManagementService {
 #else
   Event createEvent(const std::shared_ptr<WsConnection> wsConnectionPtr, const Subscription& subscription, boost::beast::string_view textMessageView,
                     const rj::Document& document, const TimePoint& timeReceived) {
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     Event event;
     std::vector<Message> messageList;
@@ -497,7 +497,7 @@ class ExecutionManagementServiceMexc : public ExecutionManagementService {
         message.setCorrelationIdList({subscription.getCorrelationId()});
         message.setType(success ? Message::Type::SUBSCRIPTION_STARTED : Message::Type::SUBSCRIPTION_FAILURE);
         Element element;
-        element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, textMessage);
+        element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
       }
@@ -563,7 +563,7 @@ class ExecutionManagementServiceMexc : public ExecutionManagementService {
   }
   std::string listenKeyTarget;
   int pingListenKeyIntervalSeconds;
-  std::map<std::string, TimerPtr> pingListenKeyTimerMapByConnectionIdMap;
+  std::map<uint64_t, TimerPtr> pingListenKeyTimerMapByConnectionIdMap;
 };
 } /* namespace ccapi */
 #endif
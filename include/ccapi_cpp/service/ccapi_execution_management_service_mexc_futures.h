@@ -368,11 +368,11 @@ class ExecutionManagementServiceMexcFutures : public ExecutionManagementService
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     // if (textMessage != "pong") {
     //   rj::Document document;
-    //   document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    //   document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     //   auto it = document.FindMember("event");
     //   std::string eventStr = it != document.MemberEnd() ? it->value.GetString() : "";
     //   if (eventStr == "login") {
@@ -418,7 +418,7 @@ this->send(wsConnectionPtr, sendString, ec);
     //   }
     // }
   }
-  Event createEvent(const Subscription& subscription, const std::string& textMessage, const rj::Document& document, const std::string& eventStr,
+  Event createEvent(const Subscription& subscription, boost::beast::string_view textMessage, const rj::Document& document, const std::string& eventStr,
                     const TimePoint& timeReceived) {
     Event event;
     // std::vector<Message> messageList;
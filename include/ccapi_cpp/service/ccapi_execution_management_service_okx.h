@@ -36,8 +36,25 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
     this->cancelOrderTarget = "/api/v5/trade/cancel-order";
     this->getOrderTarget = "/api/v5/trade/order";
     this->getOpenOrdersTarget = "/api/v5/trade/orders-pending";
+    this->createOrdersBatchTarget = "/api/v5/trade/batch-orders";
+    this->cancelOrdersBatchTarget = "/api/v5/trade/cancel-batch-orders";
+    this->createOrdersBatchSizeMax = 20;
+    this->cancelOrdersBatchSizeMax = 20;
     this->getAccountBalancesTarget = "/api/v5/account/balance";
     this->getAccountPositionsTarget = "/api/v5/account/positions";
+    // okx limits each endpoint separately, batch endpoints count orders rather than requests
+    for (const auto& x : std::vector<std::pair<Request::Operation, double> >{
+             {Request::Operation::CREATE_ORDER, 60},
+             {Request::Operation::CANCEL_ORDER, 60},
+             {Request::Operation::CREATE_ORDERS_BATCH, 300},
+             {Request::Operation::CANCEL_ORDERS_BATCH, 300},
+             {Request::Operation::GET_ORDER, 60},
+             {Request::Operation::GET_OPEN_ORDERS, 60},
+             {Request::Operation::GET_ACCOUNT_BALANCES, 10},
+             {Request::Operation::GET_ACCOUNT_POSITIONS, 10},
+         }) {
+      this->rateLimiterPtr->setLimit(Request::operationToString(x.first), x.second, std::chrono::seconds(2));
+    }
   }
   virtual ~ExecutionManagementServiceOkx() {}
 #ifndef CCAPI_EXPOSE_INTERNAL
@@ -50,6 +67,11 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
   void pingOnApplicationLevel(std::shared_ptr<WsConnection> wsConnectionPtr, ErrorCode& ec) override { this->send(wsConnectionPtr, "ping", ec); }
 #endif
   bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"0\"")); }
+  RateLimiter<RateLimitedRequest>::CostList getRateLimitCostList(const Request& request) override {
+    return {{Request::operationToString(request.getOperation()), Request::isBatchOperation(request.getOperation()) ? request.getParamList().size() : 1.0}};
+  }
+  // code 1 and 2 mean that all or some of the orders were rejected, each order still has its own sCode and sMsg
+  bool doesHttpBodyContainErrorBatch(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"[012]\"")); }
   void signReqeustForRestGenericPrivateRequest(http::request<http::string_body>& req, const Request& request, std::string& methodString,
                                                std::string& headerString, std::string& path, std::string& queryString, std::string& body, const TimePoint& now,
                                                const std::map<std::string, std::string>& credential) override {
@@ -175,6 +197,37 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
         auto body = stringBuffer.GetString();
         this->signRequest(req, body, credential);
       } break;
+      case Request::Operation::CREATE_ORDERS_BATCH:
+      case Request::Operation::CANCEL_ORDERS_BATCH: {
+        req.method(http::verb::post);
+        req.target(operation == Request::Operation::CREATE_ORDERS_BATCH ? this->createOrdersBatchTarget : this->cancelOrdersBatchTarget);
+        auto elementOperation = Request::getBatchElementOperation(operation);
+        rj::Document document;
+        document.SetArray();
+        rj::Document::AllocatorType& allocator = document.GetAllocator();
+        for (size_t i = 0; i < request.getParamList().size(); ++i) {
+          const std::map<std::string, std::string> param = request.getBatchElementParam(i);
+          rj::Value order(rj::kObjectType);
+          this->appendParam(elementOperation, order, allocator, param);
+          if (elementOperation == Request::Operation::CREATE_ORDER) {
+            if (param.find("tdMode") == param.end()) {
+              order.AddMember("tdMode", rj::Value("cash").Move(), allocator);
+            }
+            if (param.find("ordType") == param.end()) {
+              order.AddMember("ordType", rj::Value("limit").Move(), allocator);
+            }
+          }
+          if (!symbolId.empty()) {
+            this->appendSymbolId(order, allocator, symbolId);
+          }
+          document.PushBack(order, allocator);
+        }
+        rj::StringBuffer stringBuffer;
+        rj::Writer<rj::StringBuffer> writer(stringBuffer);
+        document.Accept(writer);
+        auto body = stringBuffer.GetString();
+        this->signRequest(req, body, credential);
+      } break;
       case Request::Operation::GET_ORDER: {
         req.method(http::verb::get);
         std::string queryString;
@@ -271,6 +324,21 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
   }
   void extractOrderInfoFromRequest(std::vector<Element>& elementList, const Request& request, const Request::Operation operation,
                                    const rj::Document& document) override {
+    if (Request::isBatchOperation(operation)) {
+      for (const auto& x : document["data"].GetArray()) {
+        Element element;
+        if (std::string(x["sCode"].GetString()) != "0") {
+          element.insert(CCAPI_ERROR_MESSAGE, x["sMsg"].GetString());
+        }
+        this->extractOrderInfo(element, x,
+                               {
+                                   {CCAPI_EM_ORDER_ID, std::make_pair("ordId", JsonDataType::STRING)},
+                                   {CCAPI_EM_CLIENT_ORDER_ID, std::make_pair("clOrdId", JsonDataType::STRING)},
+                               });
+        elementList.emplace_back(std::move(element));
+      }
+      return;
+    }
     this->extractOrderInfoFromRequest(elementList, document);
   }
   void extractOrderInfoFromRequest(std::vector<Element>& elementList, const rj::Document& document) {
@@ -380,11 +448,11 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
       const TimePoint& timeReceived) override {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     if (textMessage != "pong") {
       rj::Document document;
-      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
       auto it = document.FindMember("event");
       std::string eventStr = it != document.MemberEnd() ? it->value.GetString() : "";
       if (eventStr == "login") {
@@ -432,7 +500,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
       }
     }
   }
-  Event createEvent(const Subscription& subscription, const std::string& textMessage, const rj::Document& document, const std::string& eventStr,
+  Event createEvent(const Subscription& subscription, boost::beast::string_view textMessage, const rj::Document& document, const std::string& eventStr,
                     const TimePoint& timeReceived) {
     Event event;
     std::vector<Message> messageList;
@@ -451,7 +519,7 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
         if (code != "0") {
           message.setType(Message::Type::RESPONSE_ERROR);
           Element element;
-          element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+          element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           message.setSecondaryCorrelationIdMap({
               {correlationId, document["id"].GetString()},
@@ -542,14 +610,14 @@ class ExecutionManagementServiceOkx : public ExecutionManagementService {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     } else if (eventStr == "error") {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       message.setType(Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
     }
@@ -20,8 +20,30 @@ class FixService : public Service {
  public:
   FixService(std::function<void(Event&, Queue<Event>*)> eventHandler, SessionOptions sessionOptions, SessionConfigs sessionConfigs,
              ServiceContextPtr serviceContextPtr)
-      : Service(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {}
-  virtual ~FixService() {}
+      : Service(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
+    this->serviceName = CCAPI_FIX;
+  }
+  virtual ~FixService() {
+    for (const auto& x : this->pingTimerByMethodByConnectionIdMap) {
+      for (const auto& y : x.second) {
+        y.second->cancel();
+      }
+    }
+    for (const auto& x : this->pongTimeOutTimerByMethodByConnectionIdMap) {
+      for (const auto& y : x.second) {
+        y.second->cancel();
+      }
+    }
+    for (const auto& x : this->connectRetryOnFailTimerByConnectionIdMap) {
+      x.second->cancel();
+    }
+  }
+  void setMetricsRegistryPtr(std::shared_ptr<MetricsRegistry> metricsRegistryPtr) override {
+    Service::setMetricsRegistryPtr(metricsRegistryPtr);
+    auto labelMap = this->getMetricsLabelMap();
+    this->fixMessageReceivedCounterPtr = &metricsRegistryPtr->getCounter("ccapi_fix_messages_received_total", labelMap, "Number of FIX messages received.");
+    this->fixByteReceivedCounterPtr = &metricsRegistryPtr->getCounter("ccapi_fix_bytes_received_total", labelMap, "Number of FIX bytes received.");
+  }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  protected:
@@ -243,10 +265,16 @@ class FixService : public Service {
     auto& readMessageBuffer = this->readMessageBufferByConnectionIdMap[connectionId];
     auto& readMessageBufferReadLength = this->readMessageBufferReadLengthByConnectionIdMap[connectionId];
     readMessageBufferReadLength += n;
+    if (this->fixByteReceivedCounterPtr) {
+      this->fixByteReceivedCounterPtr->increment(n);
+    }
     CCAPI_LOGGER_TRACE("readMessageBufferReadLength = " + toString(readMessageBufferReadLength));
     hff::message_reader reader(readMessageBuffer.data(), readMessageBuffer.data() + readMessageBufferReadLength);
     std::vector<std::string> correlationIdList{fixConnectionPtr->subscription.getCorrelationId()};
     for (; reader.is_complete(); reader = reader.next_message_reader()) {
+      if (this->fixMessageReceivedCounterPtr) {
+        this->fixMessageReceivedCounterPtr->increment();
+      }
       Event event;
       bool shouldEmitEvent = true;
       Message message;
@@ -285,6 +313,9 @@ class FixService : public Service {
               element.insert(it->tag(), it->value().as_string());
               ++it;
             }
+            if (reader.find_with_hint(hff::tag::SendingTime, it) && it->value().size() >= 17) {
+              message.setTime(UtilTime::parseFIXTime(it->value().begin(), it->value().size()));
+            }
             if (reader.find_with_hint(hff::tag::MsgSeqNum, it) && it->value().as_string() == "1") {
               if (messageType == "A") {
                 event.setType(Event::Type::AUTHORIZATION_STATUS);
@@ -539,6 +570,11 @@ class FixService : public Service {
   std::map<std::string, std::shared_ptr<FixConnection<T>>> fixConnectionPtrByIdMap;
   std::map<std::string, int> sequenceSentByConnectionIdMap;
   std::map<std::string, std::map<std::string, std::string>> credentialByConnectionIdMap;
+  // keyed by the fix connection id, which is the subscription's correlation id, so they hide the websocket ones that Service keys by integer id
+  std::map<std::string, TimerPtr> connectRetryOnFailTimerByConnectionIdMap;
+  std::map<std::string, std::map<PingPongMethod, TimePoint>> lastPongTpByMethodByConnectionIdMap;
+  std::map<std::string, std::map<PingPongMethod, TimerPtr>> pingTimerByMethodByConnectionIdMap;
+  std::map<std::string, std::map<PingPongMethod, TimerPtr>> pongTimeOutTimerByMethodByConnectionIdMap;
   std::string apiKeyName;
   std::string apiSecretName;
   std::string baseUrlFix;
@@ -556,6 +592,8 @@ class FixService : public Service {
   std::string protocolVersion;
   std::string senderCompID;
   std::string targetCompID;
+  MetricCounter* fixMessageReceivedCounterPtr{};
+  MetricCounter* fixByteReceivedCounterPtr{};
 };
 template <>
 inline std::shared_ptr<beast::ssl_stream<beast::tcp_stream>> FixService<beast::ssl_stream<beast::tcp_stream>>::createStreamFix(net::io_context* iocPtr,
@@ -590,7 +628,11 @@ inline void FixService<beast::ssl_stream<beast::tcp_stream>>::onConnect_3(std::s
   CCAPI_LOGGER_TRACE("connected");
   beast::ssl_stream<beast::tcp_stream>& stream = *fixConnectionPtr->streamPtr;
   CCAPI_LOGGER_TRACE("before async_handshake");
-  stream.async_handshake(ssl::stream_base::client, beast::bind_front_handler(&FixService::onHandshake_3, shared_from_base<FixService>(), fixConnectionPtr));
+  this->serviceContextPtr->tlsSessionCache.beforeHandshake(stream.native_handle());
+  stream.async_handshake(ssl::stream_base::client, [that = shared_from_base<FixService>(), fixConnectionPtr](beast::error_code ec) {
+    that->serviceContextPtr->tlsSessionCache.afterHandshake(fixConnectionPtr->streamPtr->native_handle(), !ec);
+    that->onHandshake_3(fixConnectionPtr, ec);
+  });
   CCAPI_LOGGER_TRACE("after async_handshake");
 }
 template <>
@@ -6,8 +6,10 @@
 #include <string>
 #include <vector>
 
+#include "ccapi_cpp/ccapi_bar_aggregator.h"
 #include "ccapi_cpp/ccapi_hmac.h"
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_timer_wheel.h"
 #include "ccapi_cpp/ccapi_util_private.h"
 #include "ccapi_cpp/service/ccapi_service.h"
 namespace ccapi {
@@ -20,6 +22,7 @@ class MarketDataService : public Service {
                     ServiceContext* serviceContextPtr)
       : Service(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
     CCAPI_LOGGER_FUNCTION_ENTER;
+    this->serviceName = CCAPI_MARKET_DATA;
     this->requestOperationToMessageTypeMap = {
         {Request::Operation::GET_RECENT_TRADES, Message::Type::GET_RECENT_TRADES},
         {Request::Operation::GET_HISTORICAL_TRADES, Message::Type::GET_HISTORICAL_TRADES},
@@ -34,12 +37,11 @@ class MarketDataService : public Service {
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
   virtual ~MarketDataService() {
-    for (const auto& x : this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap) {
-      for (const auto& y : x.second) {
-        for (const auto& z : y.second) {
-          z.second->cancel();
-        }
-      }
+    if (this->conflateTimerPtr) {
+      this->conflateTimerPtr->cancel();
+    }
+    if (this->calculatedBarTimerPtr) {
+      this->calculatedBarTimerPtr->cancel();
     }
     for (const auto& x : this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap) {
       for (const auto& y : x.second) {
@@ -62,11 +64,11 @@ class MarketDataService : public Service {
           for (auto& subscription : subscriptionListGivenInstrumentGroup) {
             subscription.setTimeSent(now);
           }
-          std::map<std::string, std::vector<std::string>> wsConnectionIdListByInstrumentGroupMap = invertMapMulti(that->instrumentGroupByWsConnectionIdMap);
+          std::map<std::string, std::vector<uint64_t>> wsConnectionIdListByInstrumentGroupMap = invertMapMulti(that->instrumentGroupByWsConnectionIdMap);
           if (wsConnectionIdListByInstrumentGroupMap.find(instrumentGroup) != wsConnectionIdListByInstrumentGroupMap.end() &&
               that->subscriptionStatusByInstrumentGroupInstrumentMap.find(instrumentGroup) != that->subscriptionStatusByInstrumentGroupInstrumentMap.end()) {
             auto wsConnectionId = wsConnectionIdListByInstrumentGroupMap.at(instrumentGroup).at(0);
-            auto wsConnection = that->wsConnectionByIdMap.at(wsConnectionId);
+            WsConnection& wsConnection = that->wsConnectionByIdMap.at(wsConnectionId);
             for (const auto& subscription : subscriptionListGivenInstrumentGroup) {
               auto instrument = subscription.getInstrument();
               if (that->subscriptionStatusByInstrumentGroupInstrumentMap[instrumentGroup].find(instrument) !=
@@ -109,7 +111,7 @@ class MarketDataService : public Service {
           for (auto& subscription : subscriptionListGivenInstrumentGroup) {
             subscription.setTimeSent(now);
           }
-          std::map<std::string, std::vector<std::string>> wsConnectionIdListByInstrumentGroupMap = invertMapMulti(that->instrumentGroupByWsConnectionIdMap);
+          std::map<std::string, std::vector<uint64_t>> wsConnectionIdListByInstrumentGroupMap = invertMapMulti(that->instrumentGroupByWsConnectionIdMap);
           if (wsConnectionIdListByInstrumentGroupMap.find(instrumentGroup) != wsConnectionIdListByInstrumentGroupMap.end() &&
               that->subscriptionStatusByInstrumentGroupInstrumentMap.find(instrumentGroup) != that->subscriptionStatusByInstrumentGroupInstrumentMap.end()) {
             auto wsConnectionId = wsConnectionIdListByInstrumentGroupMap.at(instrumentGroup).at(0);
@@ -134,7 +136,7 @@ class MarketDataService : public Service {
             if (credential.empty()) {
               credential = that->credentialDefault;
             }
-            std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> streamPtr(nullptr);
+            std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>> streamPtr(nullptr);
             try {
               streamPtr = that->createWsStream(that->serviceContextPtr->ioContextPtr, that->serviceContextPtr->sslContextPtr);
             } catch (const beast::error_code& ec) {
@@ -156,6 +158,16 @@ class MarketDataService : public Service {
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
 #endif
+  void setMetricsRegistryPtr(std::shared_ptr<MetricsRegistry> metricsRegistryPtr) override {
+    Service::setMetricsRegistryPtr(metricsRegistryPtr);
+    for (auto type : {MarketDataMessage::Type::UNKNOWN, MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH, MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE,
+                      MarketDataMessage::Type::MARKET_DATA_EVENTS_AGG_TRADE, MarketDataMessage::Type::MARKET_DATA_EVENTS_CANDLESTICK}) {
+      auto labelMap = this->getMetricsLabelMap();
+      labelMap["type"] = MarketDataMessage::typeToString(type);
+      this->marketDataMessageCounterPtrByTypeList.at(static_cast<int>(type)) =
+          &metricsRegistryPtr->getCounter("ccapi_market_data_messages_total", labelMap, "Number of normalized market data messages processed.");
+    }
+  }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  protected:
@@ -182,7 +194,7 @@ class MarketDataService : public Service {
       return this->baseUrlWs + "|" + subscription.getField() + "|" + subscription.getSerializedOptions() + "|" + subscription.getSerializedCredential();
     }
   }
-  void prepareSubscription(const WsConnection& wsConnection, const Subscription& subscription) {
+  void prepareSubscription(WsConnection& wsConnection, const Subscription& subscription) {
     auto instrument = subscription.getInstrument();
     CCAPI_LOGGER_TRACE("instrument = " + instrument);
     std::string symbolId = instrument;
@@ -240,12 +252,12 @@ class MarketDataService : public Service {
         CCAPI_LOGGER_TRACE("correlationIdList = " + toString(correlationIdList));
         if (marketDataMessage.data.find(MarketDataMessage::DataType::BID) != marketDataMessage.data.end() ||
             marketDataMessage.data.find(MarketDataMessage::DataType::ASK) != marketDataMessage.data.end()) {
-          std::map<Decimal, std::string>& snapshotBid = this->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          std::map<Decimal, std::string>& snapshotAsk = this->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] &&
-              marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
+          auto& orderBookState = wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId];
+          std::map<Decimal, std::string>& snapshotBid = orderBookState.snapshotBid;
+          std::map<Decimal, std::string>& snapshotAsk = orderBookState.snapshotAsk;
+          if (orderBookState.processedInitialSnapshot && marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
             this->processOrderBookUpdate(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field, optionMap,
-                                         correlationIdList, snapshotBid, snapshotAsk);
+                                         correlationIdList, orderBookState);
             if (this->sessionOptions.enableCheckOrderBookChecksum &&
                 this->orderBookChecksumByConnectionIdSymbolIdMap.find(wsConnection.id) != this->orderBookChecksumByConnectionIdSymbolIdMap.end() &&
                 this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).find(symbolId) !=
@@ -272,9 +284,13 @@ class MarketDataService : public Service {
                 return;
               }
             }
+            if (!this->checkOrderBookRetained(orderBookState, optionMap)) {
+              this->onIncorrectStatesFound(wsConnection, hdl, textMessage, timeReceived, exchangeSubscriptionId, "order book retained levels exhausted");
+              return;
+            }
           } else if (marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED) {
             this->processOrderBookInitial(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field,
-                                          optionMap, correlationIdList, snapshotBid, snapshotAsk);
+                                          optionMap, correlationIdList, orderBookState);
           }
           CCAPI_LOGGER_TRACE("snapshotBid.size() = " + toString(snapshotBid.size()));
           CCAPI_LOGGER_TRACE("snapshotAsk.size() = " + toString(snapshotAsk.size()));
@@ -337,7 +353,7 @@ class MarketDataService : public Service {
   void connect(WsConnection& wsConnection) override {
     CCAPI_LOGGER_FUNCTION_ENTER;
     Service::connect(wsConnection);
-    this->instrumentGroupByWsConnectionIdMap.insert(std::pair<std::string, std::string>(wsConnection.id, wsConnection.group));
+    this->instrumentGroupByWsConnectionIdMap.insert(std::pair<uint64_t, std::string>(wsConnection.id, wsConnection.group));
     CCAPI_LOGGER_DEBUG("this->instrumentGroupByWsConnectionIdMap = " + toString(this->instrumentGroupByWsConnectionIdMap));
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
@@ -366,26 +382,14 @@ class MarketDataService : public Service {
     this->subscriptionListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->correlationIdListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.erase(wsConnection.id);
-    this->snapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->snapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->clearOrderBookMemoryUsage(wsConnection);
+    wsConnection.orderBookStateByChannelIdSymbolIdMap.clear();
     this->processedInitialTradeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    if (this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.end()) {
-      for (const auto& x : this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-        for (const auto& y : x.second) {
-          y.second->cancel();
-        }
-      }
-      this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    }
-    this->openByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->highByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->lowByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->closeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->conflateScheduleIdByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->calculatedCandlestickByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->barAggregatorByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->calculatedBarFlushTpByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->orderBookChecksumByConnectionIdSymbolIdMap.erase(wsConnection.id);
     this->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.erase(wsConnection.id);
     if (this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.find(wsConnection.id) !=
@@ -406,7 +410,7 @@ class MarketDataService : public Service {
     this->correlationIdByConnectionIdMap.erase(wsConnection.id);
     Service::onClose(hdl);
   }
-  virtual void subscribeToExchange(const WsConnection& wsConnection) {
+  virtual void subscribeToExchange(WsConnection& wsConnection) {
     CCAPI_LOGGER_INFO("exchange is " + this->exchangeName);
     std::vector<std::string> sendStringList;
     if (this->correlationIdByConnectionIdMap.find(wsConnection.id) == this->correlationIdByConnectionIdMap.end()) {
@@ -442,7 +446,7 @@ class MarketDataService : public Service {
     CCAPI_LOGGER_INFO("about to subscribe to exchange");
     this->subscribeToExchange(wsConnection);
   }
-  virtual void logonToExchange(const WsConnection& wsConnection, const TimePoint& now, const std::map<std::string, std::string>& credential) {
+  virtual void logonToExchange(WsConnection& wsConnection, const TimePoint& now, const std::map<std::string, std::string>& credential) {
     CCAPI_LOGGER_INFO("about to logon to exchange");
     CCAPI_LOGGER_INFO("exchange is " + this->exchangeName);
     auto subscriptionList = wsConnection.subscriptionList;
@@ -467,6 +471,9 @@ class MarketDataService : public Service {
     WsConnection& wsConnection = *wsConnectionPtr;
     event.setType(Event::Type::SUBSCRIPTION_DATA);
     for (auto& marketDataMessage : marketDataMessageList) {
+      if (this->metricsRegistryPtr) {
+        this->marketDataMessageCounterPtrByTypeList.at(static_cast<int>(marketDataMessage.type))->increment();
+      }
       if (marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_TRADE ||
           marketDataMessage.type == MarketDataMessage::Type::MARKET_DATA_EVENTS_AGG_TRADE ||
@@ -504,12 +511,12 @@ class MarketDataService : public Service {
         CCAPI_LOGGER_TRACE("correlationIdList = " + toString(correlationIdList));
         if (marketDataMessage.data.find(MarketDataMessage::DataType::BID) != marketDataMessage.data.end() ||
             marketDataMessage.data.find(MarketDataMessage::DataType::ASK) != marketDataMessage.data.end()) {
-          std::map<Decimal, std::string>& snapshotBid = this->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          std::map<Decimal, std::string>& snapshotAsk = this->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-          if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] &&
-              marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
+          auto& orderBookState = wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId];
+          std::map<Decimal, std::string>& snapshotBid = orderBookState.snapshotBid;
+          std::map<Decimal, std::string>& snapshotAsk = orderBookState.snapshotAsk;
+          if (orderBookState.processedInitialSnapshot && marketDataMessage.recapType == MarketDataMessage::RecapType::NONE) {
             this->processOrderBookUpdate(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field, optionMap,
-                                         correlationIdList, snapshotBid, snapshotAsk);
+                                         correlationIdList, orderBookState);
             if (this->sessionOptions.enableCheckOrderBookChecksum &&
                 this->orderBookChecksumByConnectionIdSymbolIdMap.find(wsConnection.id) != this->orderBookChecksumByConnectionIdSymbolIdMap.end() &&
                 this->orderBookChecksumByConnectionIdSymbolIdMap.at(wsConnection.id).find(symbolId) !=
@@ -536,9 +543,13 @@ class MarketDataService : public Service {
                 return;
               }
             }
+            if (!this->checkOrderBookRetained(orderBookState, optionMap)) {
+              this->onIncorrectStatesFound(wsConnectionPtr, textMessage, timeReceived, exchangeSubscriptionId, "order book retained levels exhausted");
+              return;
+            }
           } else if (marketDataMessage.recapType == MarketDataMessage::RecapType::SOLICITED) {
             this->processOrderBookInitial(wsConnection, channelId, symbolId, event, marketDataMessage.tp, timeReceived, marketDataMessage.data, field,
-                                          optionMap, correlationIdList, snapshotBid, snapshotAsk);
+                                          optionMap, correlationIdList, orderBookState);
           }
           CCAPI_LOGGER_TRACE("snapshotBid.size() = " + toString(snapshotBid.size()));
           CCAPI_LOGGER_TRACE("snapshotAsk.size() = " + toString(snapshotAsk.size()));
@@ -566,10 +577,14 @@ class MarketDataService : public Service {
       Event event;
       std::vector<MarketDataMessage> marketDataMessageList;
       this->processTextMessage(wsConnectionPtr, textMessage, timeReceived, event, marketDataMessageList);
+      this->recordLatency(LatencyStats::Stage::PARSE);
       if (!marketDataMessageList.empty()) {
         this->processMarketDataMessageList(wsConnectionPtr, textMessage, timeReceived, event, marketDataMessageList);
+        this->recordLatency(LatencyStats::Stage::ORDER_BOOK_UPDATE);
       }
       if (!event.getMessageList().empty()) {
+        this->setLatencyTrace(event);
+        this->setTimeReceivedKernel(event);
         this->eventHandler(event, nullptr);
       }
     } else {
@@ -583,6 +598,7 @@ class MarketDataService : public Service {
       element.insert(CCAPI_WEBSOCKET_MESSAGE_PAYLOAD, std::string(textMessage));
       message.setElementList({element});
       event.setMessageList({message});
+      this->setTimeReceivedKernel(event);
       this->eventHandler(event, nullptr);
     }
     this->onPongByMethod(PingPongMethod::WEBSOCKET_APPLICATION_LEVEL, wsConnectionPtr, timeReceived, false);
@@ -614,7 +630,7 @@ class MarketDataService : public Service {
   void connect(std::shared_ptr<WsConnection> wsConnectionPtr) override {
     CCAPI_LOGGER_FUNCTION_ENTER;
     Service::connect(wsConnectionPtr);
-    this->instrumentGroupByWsConnectionIdMap.insert(std::pair<std::string, std::string>(wsConnectionPtr->id, wsConnectionPtr->group));
+    this->instrumentGroupByWsConnectionIdMap.insert(std::pair<uint64_t, std::string>(wsConnectionPtr->id, wsConnectionPtr->group));
     CCAPI_LOGGER_DEBUG("this->instrumentGroupByWsConnectionIdMap = " + toString(this->instrumentGroupByWsConnectionIdMap));
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
@@ -646,26 +662,14 @@ class MarketDataService : public Service {
     this->subscriptionListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->correlationIdListByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap.erase(wsConnection.id);
-    this->snapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->snapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->clearOrderBookMemoryUsage(wsConnection);
+    wsConnection.orderBookStateByChannelIdSymbolIdMap.clear();
     this->processedInitialTradeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    if (this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.end()) {
-      for (const auto& x : this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
-        for (const auto& y : x.second) {
-          y.second->cancel();
-        }
-      }
-      this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    }
-    this->openByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->highByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->lowByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
-    this->closeByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->conflateScheduleIdByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->calculatedCandlestickByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->barAggregatorByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
+    this->calculatedBarFlushTpByConnectionIdChannelIdSymbolIdMap.erase(wsConnection.id);
     this->orderBookChecksumByConnectionIdSymbolIdMap.erase(wsConnection.id);
     this->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.erase(wsConnection.id);
     if (this->fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap.find(wsConnection.id) !=
@@ -1083,24 +1087,33 @@ class MarketDataService : public Service {
                                                   const std::string& field, std::vector<Element>& elementList) {
     if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
       Element element;
-      if (this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].empty()) {
+      Bar& bar = this->calculatedCandlestickByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
+      if (bar.empty()) {
         element.insert(CCAPI_OPEN_PRICE, CCAPI_CANDLESTICK_EMPTY);
         element.insert(CCAPI_HIGH_PRICE, CCAPI_CANDLESTICK_EMPTY);
         element.insert(CCAPI_LOW_PRICE, CCAPI_CANDLESTICK_EMPTY);
         element.insert(CCAPI_CLOSE_PRICE, CCAPI_CANDLESTICK_EMPTY);
+        element.insert(CCAPI_VOLUME, CCAPI_CANDLESTICK_EMPTY);
+        element.insert(CCAPI_QUOTE_VOLUME, CCAPI_CANDLESTICK_EMPTY);
+        element.insert(CCAPI_VWAP, CCAPI_CANDLESTICK_EMPTY);
+        element.insert(CCAPI_TRADE_COUNT, "0");
       } else {
-        element.insert(CCAPI_OPEN_PRICE, this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]);
-        element.insert(CCAPI_HIGH_PRICE, this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].toString());
-        element.insert(CCAPI_LOW_PRICE, this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].toString());
-        element.insert(CCAPI_CLOSE_PRICE, this->closeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]);
+        this->updateElementWithBar(bar, element);
       }
       elementList.emplace_back(std::move(element));
-      this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = "";
-      this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal();
-      this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal();
-      this->closeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = "";
+      bar.reset();
     }
   }
+  void updateElementWithBar(const Bar& bar, Element& element) {
+    element.insert(CCAPI_OPEN_PRICE, bar.getOpen());
+    element.insert(CCAPI_HIGH_PRICE, bar.getHigh());
+    element.insert(CCAPI_LOW_PRICE, bar.getLow());
+    element.insert(CCAPI_CLOSE_PRICE, bar.getClose());
+    element.insert(CCAPI_VOLUME, bar.getVolume());
+    element.insert(CCAPI_QUOTE_VOLUME, bar.getQuoteVolume());
+    element.insert(CCAPI_VWAP, bar.getVwap());
+    element.insert(CCAPI_TRADE_COUNT, std::to_string(bar.getTradeCount()));
+  }
   void copySnapshot(bool isBid, const std::map<Decimal, std::string>& original, std::map<Decimal, std::string>& copy, const int maxMarketDepth) {
     size_t nToCopy = std::min(original.size(), static_cast<size_t>(maxMarketDepth));
     if (isBid) {
@@ -1112,7 +1125,9 @@ class MarketDataService : public Service {
   void processOrderBookInitial(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event, const TimePoint& tp,
                                const TimePoint& timeReceived, MarketDataMessage::TypeForData& input, const std::string& field,
                                const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList,
-                               std::map<Decimal, std::string>& snapshotBid, std::map<Decimal, std::string>& snapshotAsk) {
+                               OrderBookState& orderBookState) {
+    auto& snapshotBid = orderBookState.snapshotBid;
+    auto& snapshotAsk = orderBookState.snapshotAsk;
     snapshotBid.clear();
     snapshotAsk.clear();
     int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
@@ -1139,6 +1154,10 @@ class MarketDataService : public Service {
         CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
       }
     }
+    orderBookState.isBidTruncated = false;
+    orderBookState.isAskTruncated = false;
+    this->retainSnapshot(orderBookState, maxMarketDepth);
+    this->updateOrderBookMemoryUsage(wsConnection, channelId, symbolId, snapshotBid, snapshotAsk);
     std::vector<Element> elementList;
     this->updateElementListWithInitialMarketDepth(field, optionMap, snapshotBid, snapshotAsk, elementList);
     if (!elementList.empty()) {
@@ -1153,21 +1172,19 @@ class MarketDataService : public Service {
       event.addMessages(newMessageList);
       CCAPI_LOGGER_TRACE("event.getMessageList() = " + toString(event.getMessageList()));
     }
-    this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+    orderBookState.processedInitialSnapshot = true;
     bool shouldConflate = optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS) != CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT;
     if (shouldConflate) {
-      this->copySnapshot(true, snapshotBid, this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId],
+      this->copySnapshot(true, snapshotBid, orderBookState.previousConflateSnapshotBid,
                          maxMarketDepth);
-      this->copySnapshot(false, snapshotAsk, this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId],
+      this->copySnapshot(false, snapshotAsk, orderBookState.previousConflateSnapshotAsk,
                          maxMarketDepth);
       CCAPI_LOGGER_TRACE(
-          "this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-          "symbolId) = " +
-          toString(this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
+          "orderBookState.previousConflateSnapshotBid = " +
+          toString(orderBookState.previousConflateSnapshotBid));
       CCAPI_LOGGER_TRACE(
-          "this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-          "symbolId) = " +
-          toString(this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
+          "orderBookState.previousConflateSnapshotAsk = " +
+          toString(orderBookState.previousConflateSnapshotAsk));
       TimePoint previousConflateTp = UtilTime::makeTimePointFromMilliseconds(
           std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count() / std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)) *
           std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)));
@@ -1176,16 +1193,18 @@ class MarketDataService : public Service {
         auto interval = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)));
         auto gracePeriod = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS)));
         CCAPI_LOGGER_TRACE("about to set conflate timer");
-        this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, channelId, symbolId, field, optionMap, correlationIdList);
+        this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, channelId, symbolId);
       }
     }
   }
   void processOrderBookUpdate(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event, const TimePoint& tp,
                               const TimePoint& timeReceived, MarketDataMessage::TypeForData& input, const std::string& field,
                               const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList,
-                              std::map<Decimal, std::string>& snapshotBid, std::map<Decimal, std::string>& snapshotAsk) {
+                              OrderBookState& orderBookState) {
+    auto& snapshotBid = orderBookState.snapshotBid;
+    auto& snapshotAsk = orderBookState.snapshotAsk;
     CCAPI_LOGGER_TRACE("input = " + MarketDataMessage::dataToString(input));
-    if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+    if (orderBookState.processedInitialSnapshot) {
       std::vector<Message> messageList;
       CCAPI_LOGGER_TRACE("optionMap = " + toString(optionMap));
       int maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
@@ -1196,7 +1215,7 @@ class MarketDataService : public Service {
       CCAPI_LOGGER_TRACE("before updating orderbook");
       CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
       CCAPI_LOGGER_TRACE("firstNToString(snapshotAsk, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAsk, maxMarketDepth));
-      if (this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+      if (orderBookState.l2UpdateIsReplace) {
         CCAPI_LOGGER_TRACE("l2Update is replace");
         if (input.find(MarketDataMessage::DataType::BID) != input.end()) {
           snapshotBid.clear();
@@ -1233,6 +1252,8 @@ class MarketDataService : public Service {
             this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
         this->alignSnapshot(snapshotBid, snapshotAsk, marketDepthSubscribedToExchange);
       }
+      this->retainSnapshot(orderBookState, maxMarketDepth);
+      this->updateOrderBookMemoryUsage(wsConnection, channelId, symbolId, snapshotBid, snapshotAsk);
       CCAPI_LOGGER_TRACE("after updating orderbook");
       CCAPI_LOGGER_TRACE("lastNToString(snapshotBid, " + toString(maxMarketDepth) + ") = " + lastNToString(snapshotBid, maxMarketDepth));
       CCAPI_LOGGER_TRACE("firstNToString(snapshotAsk, " + toString(maxMarketDepth) + ") = " + firstNToString(snapshotAsk, maxMarketDepth));
@@ -1256,21 +1277,19 @@ class MarketDataService : public Service {
         std::vector<Element> elementList;
         if (shouldConflate && intervalChanged) {
           const std::map<Decimal, std::string>& snapshotBidPreviousPrevious =
-              this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              orderBookState.previousConflateSnapshotBid;
           const std::map<Decimal, std::string>& snapshotAskPreviousPrevious =
-              this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
+              orderBookState.previousConflateSnapshotAsk;
           this->updateElementListWithUpdateMarketDepth(field, optionMap, snapshotBidPrevious, snapshotBidPreviousPrevious, snapshotAskPrevious,
                                                        snapshotAskPreviousPrevious, elementList, false);
-          this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = snapshotBidPrevious;
-          this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = snapshotAskPrevious;
+          orderBookState.previousConflateSnapshotBid = snapshotBidPrevious;
+          orderBookState.previousConflateSnapshotAsk = snapshotAskPrevious;
           CCAPI_LOGGER_TRACE(
-              "this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-              "symbolId) = " +
-              toString(this->previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
+              "orderBookState.previousConflateSnapshotBid = " +
+              toString(orderBookState.previousConflateSnapshotBid));
           CCAPI_LOGGER_TRACE(
-              "this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at("
-              "symbolId) = " +
-              toString(this->previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)));
+              "orderBookState.previousConflateSnapshotAsk = " +
+              toString(orderBookState.previousConflateSnapshotAsk));
         } else {
           this->updateElementListWithUpdateMarketDepth(field, optionMap, snapshotBid, snapshotBidPrevious, snapshotAsk, snapshotAskPrevious, elementList,
                                                        false);
@@ -1319,11 +1338,16 @@ class MarketDataService : public Service {
           auto interval = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS)));
           auto gracePeriod = std::chrono::milliseconds(std::stoi(optionMap.at(CCAPI_CONFLATE_GRACE_PERIOD_MILLISECONDS)));
           CCAPI_LOGGER_TRACE("about to set conflate timer");
-          this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, channelId, symbolId, field, optionMap, correlationIdList);
+          this->setConflateTimer(previousConflateTp, interval, gracePeriod, wsConnection, channelId, symbolId);
         }
       }
+      auto it = optionMap.find(CCAPI_CALCULATED_BAR_LIST);
+      if (it != optionMap.end() && !it->second.empty()) {
+        this->barAggregatorByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = BarAggregator(BarAggregator::parseSpecList(it->second));
+      }
       this->processedInitialTradeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
     }
+    this->processCalculatedBar(wsConnection, channelId, symbolId, event, tp, timeReceived, input, correlationIdList);
     bool intervalChanged =
         shouldConflate && conflateTp > this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
     CCAPI_LOGGER_TRACE("intervalChanged = " + toString(intervalChanged));
@@ -1353,10 +1377,10 @@ class MarketDataService : public Service {
       }
       if (shouldConflate) {
         this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = conflateTp;
-        this->updateCalculatedCandlestick(wsConnection, channelId, symbolId, field, input);
+        this->updateCalculatedCandlestick(wsConnection, channelId, symbolId, tp, field, input);
       }
     } else {
-      this->updateCalculatedCandlestick(wsConnection, channelId, symbolId, field, input);
+      this->updateCalculatedCandlestick(wsConnection, channelId, symbolId, tp, field, input);
     }
   }
   void processExchangeProvidedCandlestick(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event,
@@ -1398,29 +1422,21 @@ class MarketDataService : public Service {
       event.addMessages(messageList);
     }
   }
-  void updateCalculatedCandlestick(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, const std::string& field,
-                                   const MarketDataMessage::TypeForData& input) {
+  void updateCalculatedCandlestick(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, const TimePoint& tp,
+                                   const std::string& field, const MarketDataMessage::TypeForData& input) {
     if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
+      Bar& bar = this->calculatedCandlestickByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
       for (const auto& x : input) {
         auto type = x.first;
         auto detail = x.second;
         if (type == MarketDataMessage::DataType::TRADE || type == MarketDataMessage::DataType::AGG_TRADE) {
           for (const auto& y : detail) {
-            auto price = y.at(MarketDataMessage::DataFieldType::PRICE);
-            if (this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId].empty()) {
-              this->openByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = price;
-              this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal(price);
-              this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = Decimal(price);
-            } else {
-              Decimal decimalPrice(price);
-              if (decimalPrice > this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
-                this->highByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = decimalPrice;
-              }
-              if (decimalPrice < this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
-                this->lowByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = decimalPrice;
-              }
+            const auto& price = y.at(MarketDataMessage::DataFieldType::PRICE);
+            const auto& size = y.at(MarketDataMessage::DataFieldType::SIZE);
+            FixedPoint x, z;
+            if (!FixedPoint::parse(price, x) || !FixedPoint::parse(size, z) || !bar.update(tp, x, z, price)) {
+              CCAPI_LOGGER_WARN("skipped a trade that can't be aggregated: price = " + price + ", size = " + size);
             }
-            this->closeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = price;
           }
         } else {
           CCAPI_LOGGER_WARN("extra type " + MarketDataMessage::dataTypeToString(type));
@@ -1428,6 +1444,147 @@ class MarketDataService : public Service {
       }
     }
   }
+  // feeds the trades into the bars requested by CCAPI_CALCULATED_BAR_LIST and emits every bar that they closed as a candlestick message
+  void processCalculatedBar(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, Event& event, const TimePoint& tp,
+                            const TimePoint& timeReceived, const MarketDataMessage::TypeForData& input, const std::vector<std::string>& correlationIdList) {
+    auto it = this->barAggregatorByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id);
+    if (it == this->barAggregatorByConnectionIdChannelIdSymbolIdMap.end()) {
+      return;
+    }
+    auto it2 = it->second.find(channelId);
+    if (it2 == it->second.end()) {
+      return;
+    }
+    auto it3 = it2->second.find(symbolId);
+    if (it3 == it2->second.end()) {
+      return;
+    }
+    auto& barAggregator = it3->second;
+    std::vector<BarAggregator::ClosedBar> closedBarList;
+    for (const auto& x : input) {
+      if (x.first == MarketDataMessage::DataType::TRADE || x.first == MarketDataMessage::DataType::AGG_TRADE) {
+        for (const auto& y : x.second) {
+          barAggregator.update(tp, y.at(MarketDataMessage::DataFieldType::PRICE), y.at(MarketDataMessage::DataFieldType::SIZE), closedBarList);
+        }
+      }
+    }
+    this->setCalculatedBarTimer(wsConnection, channelId, symbolId, barAggregator.getNextFlushTp());
+    if (closedBarList.empty()) {
+      return;
+    }
+    std::vector<Message> messageList;
+    this->updateMessageListWithClosedBar(closedBarList, timeReceived, correlationIdList, messageList);
+    event.addMessages(messageList);
+  }
+  void updateMessageListWithClosedBar(const std::vector<BarAggregator::ClosedBar>& closedBarList, const TimePoint& timeReceived,
+                                      const std::vector<std::string>& correlationIdList, std::vector<Message>& messageList) {
+    for (const auto& closedBar : closedBarList) {
+      Element element;
+      element.insert(CCAPI_CALCULATED_BAR, closedBar.specName);
+      this->updateElementWithBar(closedBar.bar, element);
+      Message message;
+      message.setTimeReceived(timeReceived);
+      message.setType(Message::Type::MARKET_DATA_EVENTS_CANDLESTICK);
+      message.setRecapType(Message::RecapType::NONE);
+      message.setTime(closedBar.startTime);
+      std::vector<Element> elementList;
+      elementList.emplace_back(std::move(element));
+      message.setElementList(elementList);
+      message.setCorrelationIdList(correlationIdList);
+      messageList.emplace_back(std::move(message));
+    }
+  }
+  struct CalculatedBarTask {
+    uint64_t connectionId;
+    std::string channelId;
+    std::string symbolId;
+    TimePoint dueTp;
+  };
+  // makes sure that a time bar of a symbol is closed at the end of its interval even if no later trade arrives. A trade that is timestamped within an
+  // interval but arrives after it was closed opens a new bar for that interval.
+  void setCalculatedBarTimer(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, const TimePoint& dueTp) {
+    if (dueTp == TimePoint::max()) {
+      return;
+    }
+    auto& scheduledTp = this->calculatedBarFlushTpByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
+    if (scheduledTp == dueTp) {
+      return;
+    }
+    // an earlier schedule that is still pending reschedules itself when it fires
+    if (scheduledTp < dueTp && scheduledTp > UtilTime::now()) {
+      return;
+    }
+    scheduledTp = dueTp;
+    this->calculatedBarTimerWheel.schedule(dueTp, {wsConnection.id, channelId, symbolId, dueTp});
+    this->setCalculatedBarTimerWheelTimer();
+  }
+  void setCalculatedBarTimerWheelTimer() {
+    if (this->calculatedBarTimerWheel.empty()) {
+      return;
+    }
+    auto nextDueTp = this->calculatedBarTimerWheel.getNextDueTp();
+    if (this->calculatedBarTimerDueTp <= nextDueTp) {
+      return;
+    }
+    if (!this->calculatedBarTimerPtr) {
+      this->calculatedBarTimerPtr = std::make_shared<boost::asio::steady_timer>(*this->serviceContextPtr->ioContextPtr);
+    }
+    this->calculatedBarTimerDueTp = nextDueTp;
+    this->calculatedBarTimerPtr->expires_after(nextDueTp - UtilTime::now());
+    this->calculatedBarTimerPtr->async_wait([that = shared_from_base<MarketDataService>()](ErrorCode const& ec) {
+      if (ec) {
+        if (ec != boost::asio::error::operation_aborted) {
+          CCAPI_LOGGER_ERROR("calculated bar timer error: " + ec.message());
+          that->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::GENERIC_ERROR, ec, "timer");
+        }
+        return;
+      }
+      that->calculatedBarTimerDueTp = TimePoint::max();
+      that->onCalculatedBarTimer();
+    });
+  }
+  // closes the time bars whose interval has ended and emits them in one event
+  void onCalculatedBarTimer() {
+    CCAPI_LOGGER_FUNCTION_ENTER;
+    auto now = UtilTime::now();
+    std::vector<Message> messageList;
+    for (const auto& task : this->calculatedBarTimerWheel.advance(now)) {
+      // a task is stale if its subscription has gone or has been rescheduled since
+      const auto* scheduledTpPtr = findByConnectionIdChannelIdSymbolId(this->calculatedBarFlushTpByConnectionIdChannelIdSymbolIdMap, task.connectionId,
+                                                                       task.channelId, task.symbolId);
+      if (!scheduledTpPtr || *scheduledTpPtr != task.dueTp) {
+        continue;
+      }
+      auto it = this->wsConnectionByIdMap.find(task.connectionId);
+      auto it2 = this->barAggregatorByConnectionIdChannelIdSymbolIdMap.find(task.connectionId);
+      if (it == this->wsConnectionByIdMap.end() || it2 == this->barAggregatorByConnectionIdChannelIdSymbolIdMap.end()) {
+        continue;
+      }
+#ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
+      const WsConnection& wsConnection = it->second;
+#else
+      const WsConnection& wsConnection = *it->second;
+#endif
+      if (wsConnection.status != WsConnection::Status::OPEN) {
+        continue;
+      }
+      auto& barAggregator = it2->second.at(task.channelId).at(task.symbolId);
+      std::vector<BarAggregator::ClosedBar> closedBarList;
+      barAggregator.flush(now, closedBarList);
+      this->updateMessageListWithClosedBar(closedBarList, now,
+                                           this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(task.connectionId).at(task.channelId).at(task.symbolId),
+                                           messageList);
+      this->setCalculatedBarTimer(wsConnection, task.channelId, task.symbolId, barAggregator.getNextFlushTp());
+    }
+    if (!messageList.empty()) {
+      Event event;
+      event.setType(Event::Type::SUBSCRIPTION_DATA);
+      event.addMessages(messageList);
+      this->eventHandler(event, nullptr);
+    }
+    this->setCalculatedBarTimerWheelTimer();
+    CCAPI_LOGGER_FUNCTION_EXIT;
+  }
   virtual void alignSnapshot(std::map<Decimal, std::string>& snapshotBid, std::map<Decimal, std::string>& snapshotAsk, int marketDepthSubscribedToExchange) {
     CCAPI_LOGGER_TRACE("snapshotBid.size() = " + toString(snapshotBid.size()));
     if (snapshotBid.size() > marketDepthSubscribedToExchange) {
@@ -1440,6 +1597,82 @@ class MarketDataService : public Service {
     }
     CCAPI_LOGGER_TRACE("snapshotAsk.size() = " + toString(snapshotAsk.size()));
   }
+  // with SessionOptions::enableOrderBookRetention, keeps only the best maxMarketDepth + orderBookRetentionBufferLevels levels of each side of the books of
+  // exchanges whose updates stay valid when applied to a truncated book. The worst price kept on a truncated side is its boundary: the levels beyond it are
+  // unknown, so a level that an update adds beyond it is dropped rather than shown next to a gap.
+  void retainSnapshot(OrderBookState& orderBookState, int maxMarketDepth) {
+    if (!this->sessionOptions.enableOrderBookRetention || !this->canTruncateOrderBook) {
+      return;
+    }
+    size_t retainedDepth = maxMarketDepth + this->sessionOptions.orderBookRetentionBufferLevels;
+    auto& snapshotBid = orderBookState.snapshotBid;
+    auto& snapshotAsk = orderBookState.snapshotAsk;
+    if (orderBookState.isBidTruncated) {
+      snapshotBid.erase(snapshotBid.begin(), snapshotBid.lower_bound(orderBookState.bidBoundary));
+    }
+    if (orderBookState.isAskTruncated) {
+      snapshotAsk.erase(snapshotAsk.upper_bound(orderBookState.askBoundary), snapshotAsk.end());
+    }
+    if (snapshotBid.size() > retainedDepth) {
+      keepLastN(snapshotBid, retainedDepth);
+      orderBookState.isBidTruncated = true;
+      orderBookState.bidBoundary = snapshotBid.begin()->first;
+    }
+    if (snapshotAsk.size() > retainedDepth) {
+      keepFirstN(snapshotAsk, retainedDepth);
+      orderBookState.isAskTruncated = true;
+      orderBookState.askBoundary = snapshotAsk.rbegin()->first;
+    }
+  }
+  // a truncated side that has shrunk below maxMarketDepth levels inside its boundary can't show a contiguous top of book, so it has to be fetched anew
+  bool checkOrderBookRetained(const OrderBookState& orderBookState, const std::map<std::string, std::string>& optionMap) {
+    if (!this->sessionOptions.enableOrderBookRetention || !this->canTruncateOrderBook) {
+      return true;
+    }
+    size_t maxMarketDepth = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
+    return !(orderBookState.isBidTruncated && orderBookState.snapshotBid.size() < maxMarketDepth) &&
+           !(orderBookState.isAskTruncated && orderBookState.snapshotAsk.size() < maxMarketDepth);
+  }
+  // an estimate that counts the tree node and the price and size objects of every level but not the rare heap allocation of a long price or size string
+  static size_t estimateOrderBookMemoryUsage(size_t numLevel) { return numLevel * (4 * sizeof(void*) + sizeof(std::pair<const Decimal, std::string>)); }
+  // one pair of gauges per order book, since the same instrument can have several books, e.g. on different channels or connections
+  std::map<std::string, std::string> getOrderBookMetricsLabelMap(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId) {
+    auto labelMap = this->getMetricsLabelMap();
+    labelMap["connection"] = std::to_string(wsConnection.id);
+    labelMap["channel"] = channelId;
+    labelMap["instrument"] = symbolId;
+    return labelMap;
+  }
+  void updateOrderBookMemoryUsage(const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId,
+                                  const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk) {
+    if (!this->metricsRegistryPtr) {
+      return;
+    }
+    auto& gaugePtrPair = this->orderBookGaugePtrPairByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
+    if (!gaugePtrPair.first) {
+      auto labelMap = this->getOrderBookMetricsLabelMap(wsConnection, channelId, symbolId);
+      gaugePtrPair.first = &this->metricsRegistryPtr->getGauge("ccapi_order_book_levels", labelMap, "Number of price levels held in the order book.");
+      gaugePtrPair.second = &this->metricsRegistryPtr->getGauge("ccapi_order_book_bytes", labelMap, "Estimated memory held by the order book in bytes.");
+    }
+    size_t numLevel = snapshotBid.size() + snapshotAsk.size();
+    gaugePtrPair.first->set(numLevel);
+    gaugePtrPair.second->set(estimateOrderBookMemoryUsage(numLevel));
+  }
+  // the books of a closed connection are gone for good, a reconnect builds new ones under the new connection id
+  void clearOrderBookMemoryUsage(const WsConnection& wsConnection) {
+    auto it = this->orderBookGaugePtrPairByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id);
+    if (it == this->orderBookGaugePtrPairByConnectionIdChannelIdSymbolIdMap.end()) {
+      return;
+    }
+    for (const auto& x : it->second) {
+      for (const auto& y : x.second) {
+        auto labelMap = this->getOrderBookMetricsLabelMap(wsConnection, x.first, y.first);
+        this->metricsRegistryPtr->remove("ccapi_order_book_levels", labelMap);
+        this->metricsRegistryPtr->remove("ccapi_order_book_bytes", labelMap);
+      }
+    }
+    this->orderBookGaugePtrPairByConnectionIdChannelIdSymbolIdMap.erase(it);
+  }
   virtual bool checkOrderBookChecksum(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk,
                                       const std::string& receivedOrderBookChecksumStr, bool& shouldProcessRemainingMessage) {
     if (this->sessionOptions.enableCheckOrderBookChecksum) {
@@ -1494,85 +1727,153 @@ class MarketDataService : public Service {
       return Message::Type::UNKNOWN;
     }
   }
+  struct ConflateTask {
+    uint64_t connectionId;
+    std::string channelId;
+    std::string symbolId;
+    int64_t scheduleId;
+    TimePoint previousConflateTp;
+    std::chrono::milliseconds interval;
+    std::chrono::milliseconds gracePeriod;
+  };
+  // schedules the next conflated snapshot of a symbol on the service's timer wheel, superseding any snapshot of the same symbol that was scheduled earlier
   void setConflateTimer(const TimePoint& previousConflateTp, const std::chrono::milliseconds& interval, const std::chrono::milliseconds& gracePeriod,
-                        const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId, const std::string& field,
-                        const std::map<std::string, std::string>& optionMap, const std::vector<std::string>& correlationIdList) {
+                        const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     if (wsConnection.status == WsConnection::Status::OPEN) {
-      if (this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.find(wsConnection.id) != this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap.end() &&
-          this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id].find(channelId) !=
-              this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id].end() &&
-          this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId].find(symbolId) !=
-              this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId].end()) {
-        this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]->cancel();
-      }
-      long waitMilliseconds =
-          std::chrono::duration_cast<std::chrono::milliseconds>(previousConflateTp + interval + gracePeriod - std::chrono::system_clock::now()).count();
-      if (std::chrono::duration_cast<std::chrono::milliseconds>(interval + gracePeriod).count() > 0) {
-        while (waitMilliseconds <= 0) {
-          waitMilliseconds += std::chrono::duration_cast<std::chrono::milliseconds>(interval + gracePeriod).count();
+      auto dueTp = previousConflateTp + interval + gracePeriod;
+      auto now = UtilTime::now();
+      if ((interval + gracePeriod).count() > 0) {
+        while (dueTp <= now) {
+          dueTp += interval + gracePeriod;
+        }
+      }
+      if (dueTp > now) {
+        auto scheduleId = ++this->conflateScheduleIdCounter;
+        this->conflateScheduleIdByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = scheduleId;
+        this->conflateTimerWheel.schedule(dueTp, {wsConnection.id, channelId, symbolId, scheduleId, previousConflateTp, interval, gracePeriod});
+        this->setConflateTimerWheelTimer();
+      }
+    }
+    CCAPI_LOGGER_FUNCTION_EXIT;
+  }
+  void setConflateTimerWheelTimer() {
+    if (this->conflateTimerWheel.empty()) {
+      return;
+    }
+    auto nextDueTp = this->conflateTimerWheel.getNextDueTp();
+    if (this->conflateTimerDueTp <= nextDueTp) {
+      return;
+    }
+    if (!this->conflateTimerPtr) {
+      this->conflateTimerPtr = std::make_shared<boost::asio::steady_timer>(*this->serviceContextPtr->ioContextPtr);
+    }
+    this->conflateTimerDueTp = nextDueTp;
+    this->conflateTimerPtr->expires_after(nextDueTp - UtilTime::now());
+    this->conflateTimerPtr->async_wait([that = shared_from_base<MarketDataService>()](ErrorCode const& ec) {
+      if (ec) {
+        if (ec != boost::asio::error::operation_aborted) {
+          CCAPI_LOGGER_ERROR("conflate timer error: " + ec.message());
+          that->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::GENERIC_ERROR, ec, "timer");
         }
+        return;
+      }
+      that->conflateTimerDueTp = TimePoint::max();
+      that->onConflateTimer();
+    });
+  }
+  // the value of map[connectionId][channelId][symbolId], or nullptr if there is none; unlike operator[], it never inserts
+  template <class T>
+  static const typename T::mapped_type::mapped_type::mapped_type* findByConnectionIdChannelIdSymbolId(const T& map, const typename T::key_type& connectionId,
+                                                                                                       const std::string& channelId,
+                                                                                                       const std::string& symbolId) {
+    auto it = map.find(connectionId);
+    if (it == map.end()) {
+      return nullptr;
+    }
+    auto it2 = it->second.find(channelId);
+    if (it2 == it->second.end()) {
+      return nullptr;
+    }
+    auto it3 = it2->second.find(symbolId);
+    return it3 == it2->second.end() ? nullptr : &it3->second;
+  }
+  // emits the conflated snapshots of all symbols that are due in one event
+  void onConflateTimer() {
+    CCAPI_LOGGER_FUNCTION_ENTER;
+    auto now = UtilTime::now();
+    std::vector<Message> messageList;
+    for (const auto& conflateTask : this->conflateTimerWheel.advance(now)) {
+      const auto& connectionId = conflateTask.connectionId;
+      const auto& channelId = conflateTask.channelId;
+      const auto& symbolId = conflateTask.symbolId;
+      // a task is stale if its subscription has gone or has been rescheduled since
+      const auto* scheduleIdPtr =
+          findByConnectionIdChannelIdSymbolId(this->conflateScheduleIdByConnectionIdChannelIdSymbolIdMap, connectionId, channelId, symbolId);
+      if (!scheduleIdPtr || *scheduleIdPtr != conflateTask.scheduleId) {
+        continue;
+      }
+      auto it2 = this->wsConnectionByIdMap.find(connectionId);
+      if (it2 == this->wsConnectionByIdMap.end()) {
+        continue;
       }
-      if (waitMilliseconds > 0) {
-        TimerPtr timerPtr(new boost::asio::steady_timer(*this->serviceContextPtr->ioContextPtr, std::chrono::milliseconds(waitMilliseconds)));
-        timerPtr->async_wait(
-            [wsConnection, channelId, symbolId, field, optionMap, correlationIdList, previousConflateTp, interval, gracePeriod, this](ErrorCode const& ec) {
-              if (this->wsConnectionByIdMap.find(wsConnection.id) != this->wsConnectionByIdMap.end()) {
-                if (ec) {
-                  CCAPI_LOGGER_ERROR("wsConnection = " + toString(wsConnection) + ", conflate timer error: " + ec.message());
-                  this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::GENERIC_ERROR, ec, "timer");
-                } else {
-                  if (
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
-                      this->wsConnectionByIdMap.at(wsConnection.id).status == WsConnection::Status::OPEN
+      const WsConnection& wsConnection = it2->second;
 #else
-                      this->wsConnectionByIdMap.at(wsConnection.id)->status == WsConnection::Status::OPEN
+      const WsConnection& wsConnection = *it2->second;
 #endif
-                  ) {
-                    auto conflateTp = previousConflateTp + interval;
-                    if (conflateTp > this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId)) {
-                      Event event;
-                      event.setType(Event::Type::SUBSCRIPTION_DATA);
-                      std::vector<Element> elementList;
-                      if (field == CCAPI_MARKET_DEPTH) {
-                        std::map<Decimal, std::string>& snapshotBid = this->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-                        std::map<Decimal, std::string>& snapshotAsk = this->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-                        this->updateElementListWithUpdateMarketDepth(field, optionMap, snapshotBid, std::map<Decimal, std::string>(), snapshotAsk,
-                                                                     std::map<Decimal, std::string>(), elementList, true);
-                      } else if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
-                        this->updateElementListWithCalculatedCandlestick(wsConnection, channelId, symbolId, field, elementList);
-                      }
-                      CCAPI_LOGGER_TRACE("elementList = " + toString(elementList));
-                      this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId) = conflateTp;
-                      std::vector<Message> messageList;
-                      if (!elementList.empty()) {
-                        Message message;
-                        message.setTimeReceived(conflateTp);
-                        message.setType(this->convertFieldToMessageType(field));
-                        message.setRecapType(Message::RecapType::NONE);
-                        message.setTime(field == CCAPI_MARKET_DEPTH ? conflateTp : previousConflateTp);
-                        message.setElementList(elementList);
-                        message.setCorrelationIdList(correlationIdList);
-                        messageList.emplace_back(std::move(message));
-                      }
-                      if (!messageList.empty()) {
-                        event.addMessages(messageList);
-                        this->eventHandler(event, nullptr);
-                      }
-                    }
-                    auto now = UtilTime::now();
-                    while (conflateTp + interval + gracePeriod <= now) {
-                      conflateTp += interval;
-                    }
-                    CCAPI_LOGGER_TRACE("about to set conflate timer");
-                    this->setConflateTimer(conflateTp, interval, gracePeriod, wsConnection, channelId, symbolId, field, optionMap, correlationIdList);
-                  }
-                }
-              }
-            });
-        this->conflateTimerMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = timerPtr;
+      if (wsConnection.status != WsConnection::Status::OPEN) {
+        continue;
+      }
+      const auto& interval = conflateTask.interval;
+      const auto& gracePeriod = conflateTask.gracePeriod;
+      auto conflateTp = conflateTask.previousConflateTp + interval;
+      auto& previousConflateTp = this->previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap.at(connectionId).at(channelId).at(symbolId);
+      if (conflateTp > previousConflateTp) {
+        const auto& field = this->fieldByConnectionIdChannelIdSymbolIdMap.at(connectionId).at(channelId).at(symbolId);
+        const auto& optionMap = this->optionMapByConnectionIdChannelIdSymbolIdMap.at(connectionId).at(channelId).at(symbolId);
+        std::vector<Element> elementList;
+        if (field == CCAPI_MARKET_DEPTH) {
+          static const OrderBookState orderBookStateEmpty;
+          const auto* orderBookStatePtr = &orderBookStateEmpty;
+          auto it3 = wsConnection.orderBookStateByChannelIdSymbolIdMap.find(channelId);
+          if (it3 != wsConnection.orderBookStateByChannelIdSymbolIdMap.end()) {
+            auto it4 = it3->second.find(symbolId);
+            if (it4 != it3->second.end()) {
+              orderBookStatePtr = &it4->second;
+            }
+          }
+          this->updateElementListWithUpdateMarketDepth(field, optionMap, orderBookStatePtr->snapshotBid, orderBookStateEmpty.snapshotBid,
+                                                       orderBookStatePtr->snapshotAsk, orderBookStateEmpty.snapshotAsk, elementList, true);
+        } else if (field == CCAPI_TRADE || field == CCAPI_AGG_TRADE) {
+          this->updateElementListWithCalculatedCandlestick(wsConnection, channelId, symbolId, field, elementList);
+        }
+        CCAPI_LOGGER_TRACE("elementList = " + toString(elementList));
+        if (!elementList.empty()) {
+          Message message;
+          message.setTimeReceived(conflateTp);
+          message.setType(this->convertFieldToMessageType(field));
+          message.setRecapType(Message::RecapType::NONE);
+          message.setTime(field == CCAPI_MARKET_DEPTH ? conflateTp : conflateTask.previousConflateTp);
+          message.setElementList(elementList);
+          message.setCorrelationIdList(this->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(connectionId).at(channelId).at(symbolId));
+          messageList.emplace_back(std::move(message));
+        }
+        previousConflateTp = conflateTp;
+      }
+      while (conflateTp + interval + gracePeriod <= now) {
+        conflateTp += interval;
       }
+      CCAPI_LOGGER_TRACE("about to set conflate timer");
+      this->setConflateTimer(conflateTp, interval, gracePeriod, wsConnection, channelId, symbolId);
+    }
+    if (!messageList.empty()) {
+      Event event;
+      event.setType(Event::Type::SUBSCRIPTION_DATA);
+      event.addMessages(messageList);
+      this->eventHandler(event, nullptr);
     }
+    this->setConflateTimerWheelTimer();
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
   void processSuccessfulTextMessageRest(int statusCode, const Request& request, const std::string& textMessage, const TimePoint& timeReceived,
@@ -1724,10 +2025,10 @@ class MarketDataService : public Service {
       req.prepare_payload();
     }
   }
-  void processOrderBookWithVersionId(int64_t versionId, const WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId,
+  void processOrderBookWithVersionId(int64_t versionId, WsConnection& wsConnection, const std::string& channelId, const std::string& symbolId,
                                      const std::string& exchangeSubscriptionId, const std::map<std::string, std::string>& optionMap,
                                      std::vector<MarketDataMessage>& marketDataMessageList, const MarketDataMessage& marketDataMessage) {
-    if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+    if (wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].processedInitialSnapshot) {
       if (versionId > this->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap.at(wsConnection.id).at(exchangeSubscriptionId)) {
         marketDataMessageList.emplace_back(std::move(marketDataMessage));
         this->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = versionId;
@@ -1802,8 +2103,18 @@ class MarketDataService : public Service {
                 const auto& optionMap = that->optionMapByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
                 that->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = versionId;
                 const auto& correlationIdList = that->correlationIdListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
-                std::map<Decimal, std::string>& snapshotBid = that->snapshotBidByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
-                std::map<Decimal, std::string>& snapshotAsk = that->snapshotAskByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
+                // the captured connection is a copy, so the order book is written to the one that is still open
+                auto it = that->wsConnectionByIdMap.find(wsConnection.id);
+                if (it == that->wsConnectionByIdMap.end()) {
+                  return;
+                }
+#ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
+                auto& orderBookState = it->second.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId];
+#else
+                auto& orderBookState = it->second->orderBookStateByChannelIdSymbolIdMap[channelId][symbolId];
+#endif
+                std::map<Decimal, std::string>& snapshotBid = orderBookState.snapshotBid;
+                std::map<Decimal, std::string>& snapshotAsk = orderBookState.snapshotAsk;
                 snapshotBid.clear();
                 snapshotAsk.clear();
                 MarketDataMessage::TypeForData input;
@@ -1829,13 +2140,13 @@ class MarketDataService : public Service {
                 }
                 if (that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).find(exchangeSubscriptionId) !=
                     that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).end()) {
-                  auto it = that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id)
-                                .at(exchangeSubscriptionId)
-                                .upper_bound(versionId);
+                  auto it2 = that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id)
+                                 .at(exchangeSubscriptionId)
+                                 .upper_bound(versionId);
                   while (
-                      it !=
+                      it2 !=
                       that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).at(exchangeSubscriptionId).end()) {
-                    const auto& input = it->second;
+                    const auto& input = it2->second;
                     for (const auto& x : input) {
                       const auto& type = x.first;
                       const auto& detail = x.second;
@@ -1855,8 +2166,8 @@ class MarketDataService : public Service {
                         }
                       }
                     }
-                    that->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = it->first;
-                    it++;
+                    that->orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId] = it2->first;
+                    it2++;
                   }
                   that->marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap.at(wsConnection.id).erase(exchangeSubscriptionId);
                 }
@@ -1907,7 +2218,7 @@ class MarketDataService : public Service {
                 messageList.emplace_back(std::move(message));
                 event.addMessages(messageList);
                 that->eventHandler(event, nullptr);
-                that->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+                orderBookState.processedInitialSnapshot = true;
               } else {
                 that->buildOrderBookInitialOnFail(wsConnection, exchangeSubscriptionId, delayMilliseconds);
                 // if (delayMilliseconds > 0) {
@@ -1951,7 +2262,7 @@ class MarketDataService : public Service {
     }
     return interval;
   }
-  virtual std::vector<std::string> createSendStringListFromSubscriptionList(const WsConnection& wsConnection, const std::vector<Subscription>& subscriptionList,
+  virtual std::vector<std::string> createSendStringListFromSubscriptionList(WsConnection& wsConnection, const std::vector<Subscription>& subscriptionList,
                                                                             const TimePoint& now, const std::map<std::string, std::string>& credential) {
     return {};
   }
@@ -1967,38 +2278,39 @@ class MarketDataService : public Service {
   virtual std::string calculateOrderBookChecksum(const std::map<Decimal, std::string>& snapshotBid, const std::map<Decimal, std::string>& snapshotAsk) {
     return {};
   }
-  virtual std::vector<std::string> createSendStringList(const WsConnection& wsConnection) { return {}; }
-  virtual void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  virtual std::vector<std::string> createSendStringList(WsConnection& wsConnection) { return {}; }
+  virtual void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                          const Subscription& subscription, const std::map<std::string, std::string> optionMap) {}
   virtual void createFetchOrderBookInitialReq(http::request<http::string_body>& req, const std::string& symbolId, const TimePoint& now,
                                               const std::map<std::string, std::string>& credential) {}
   virtual void extractOrderBookInitialVersionId(int64_t& versionId, const rj::Document& document) {}
   virtual void extractOrderBookInitialData(MarketDataMessage::TypeForData& input, const rj::Document& document) {}
-  std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> fieldByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<std::string, std::string>>>> optionMapByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, int>>> marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::vector<Subscription>>>> subscriptionListByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::vector<std::string>>>> correlationIdListByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>> snapshotBidByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>> snapshotAskByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>>
-      previousConflateSnapshotBidByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::map<Decimal, std::string>>>>
-      previousConflateSnapshotAskByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> processedInitialTradeByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, TimePoint>>> previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, TimerPtr>>> conflateTimerMapByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::string>> orderBookChecksumByConnectionIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, std::string>>> fieldByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, std::map<std::string, std::string>>>> optionMapByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, int>>> marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, std::vector<Subscription>>>> subscriptionListByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, std::vector<std::string>>>> correlationIdListByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, std::string>>> channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, bool>>> processedInitialTradeByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, TimePoint>>> previousConflateTimeMapByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, int64_t>>> conflateScheduleIdByConnectionIdChannelIdSymbolIdMap;
+  int64_t conflateScheduleIdCounter{};
+  TimerWheel<ConflateTask> conflateTimerWheel;
+  TimerPtr conflateTimerPtr;
+  TimePoint conflateTimerDueTp{TimePoint::max()};
+  std::map<uint64_t, std::map<std::string, std::string>> orderBookChecksumByConnectionIdSymbolIdMap;
   bool shouldAlignSnapshot{};
+  bool canTruncateOrderBook{};
+  std::map<uint64_t, std::map<std::string, std::map<std::string, std::pair<MetricGauge*, MetricGauge*>>>>
+      orderBookGaugePtrPairByConnectionIdChannelIdSymbolIdMap;
   std::map<std::string, std::map<std::string, Subscription::Status>> subscriptionStatusByInstrumentGroupInstrumentMap;
-  std::map<std::string, std::string> instrumentGroupByWsConnectionIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> openByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, Decimal>>> highByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, Decimal>>> lowByConnectionIdChannelIdSymbolIdMap;
-  std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> closeByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::string> instrumentGroupByWsConnectionIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, Bar>>> calculatedCandlestickByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, BarAggregator>>> barAggregatorByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, TimePoint>>> calculatedBarFlushTpByConnectionIdChannelIdSymbolIdMap;
+  TimerWheel<CalculatedBarTask> calculatedBarTimerWheel;
+  TimerPtr calculatedBarTimerPtr;
+  TimePoint calculatedBarTimerDueTp{TimePoint::max()};
   std::string getRecentTradesTarget;
   std::string getHistoricalTradesTarget;
   std::string getRecentCandlesticksTarget;
@@ -2006,14 +2318,15 @@ class MarketDataService : public Service {
   std::string getMarketDepthTarget;
   std::string getInstrumentTarget;
   std::string getInstrumentsTarget;
-  std::map<std::string, int> exchangeJsonPayloadIdByConnectionIdMap;
-  std::map<std::string, std::map<int, std::vector<std::string>>> exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap;
+  std::map<uint64_t, int> exchangeJsonPayloadIdByConnectionIdMap;
+  std::map<uint64_t, std::map<int, std::vector<std::string>>> exchangeSubscriptionIdListByConnectionIdExchangeJsonPayloadIdMap;
   // only needed for generic public subscription
-  std::map<std::string, std::string> correlationIdByConnectionIdMap;
-  std::map<std::string, std::map<std::string, std::map<int64_t, MarketDataMessage::TypeForData>>>
+  std::map<uint64_t, std::string> correlationIdByConnectionIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<int64_t, MarketDataMessage::TypeForData>>>
       marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdVersionIdMap;
-  std::map<std::string, std::map<std::string, int64_t>> orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap;
-  std::map<std::string, std::map<std::string, TimerPtr>> fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap;
+  std::map<uint64_t, std::map<std::string, int64_t>> orderbookVersionIdByConnectionIdExchangeSubscriptionIdMap;
+  std::map<uint64_t, std::map<std::string, TimerPtr>> fetchMarketDepthInitialSnapshotTimerByConnectionIdExchangeSubscriptionIdMap;
+  std::array<MetricCounter*, 5> marketDataMessageCounterPtrByTypeList{};
 };
 } /* namespace ccapi */
 #endif
@@ -11,6 +11,10 @@ class MarketDataServiceBinanceBase : public MarketDataService {
                                ServiceContext* serviceContextPtr)
       : MarketDataService(eventHandler, sessionOptions, sessionConfigs, serviceContextPtr) {
     this->enableCheckPingPongWebsocketApplicationLevel = false;
+    this->rateLimiterPtr->setLimit(CCAPI_RATE_LIMIT_REQUEST_WEIGHT, 6000, std::chrono::minutes(1));
+    this->rateLimitUsedHeaderNameByBucketNameMap = {
+        {CCAPI_RATE_LIMIT_REQUEST_WEIGHT, "X-MBX-USED-WEIGHT-1M"},
+    };
   }
   virtual ~MarketDataServiceBinanceBase() {}
 #ifndef CCAPI_EXPOSE_INTERNAL
@@ -33,7 +37,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
     this->startSubscribe(wsConnectionPtr);
   }
 #endif
-  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
     auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
     auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
@@ -59,7 +63,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
       channelId = channelId + "_" + interval;
     }
   }
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
     rj::Document document;
     document.SetObject();
@@ -73,10 +77,10 @@ class MarketDataServiceBinanceBase : public MarketDataService {
         auto symbolId = subscriptionListByInstrument.first;
         auto exchangeSubscriptionId = UtilString::toLower(subscriptionListByInstrument.first) + "@";
         if (channelId.rfind(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_BOOK_TICKER, 0) == 0) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].l2UpdateIsReplace = true;
           exchangeSubscriptionId += CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_BOOK_TICKER;
         } else if (channelId.rfind(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_PARTIAL_BOOK_DEPTH, 0) == 0) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].l2UpdateIsReplace = true;
           int marketDepthSubscribedToExchange =
               this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id).at(channelId).at(symbolId);
           exchangeSubscriptionId += std::string(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_PARTIAL_BOOK_DEPTH) + std::to_string(marketDepthSubscribedToExchange);
@@ -119,10 +123,10 @@ class MarketDataServiceBinanceBase : public MarketDataService {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     if (document.IsObject() && document.HasMember("result") && document["result"].IsNull()) {
       event.setType(Event::Type::SUBSCRIPTION_STATUS);
       std::vector<Message> messageList;
@@ -153,7 +157,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
       message.setCorrelationIdList(correlationIdList);
       message.setType(Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
       event.setMessageList(messageList);
@@ -166,7 +170,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
       const rj::Value& data = document["data"];
       if (channelId == CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_BOOK_TICKER) {
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-        marketDataMessage.recapType = this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]
+        marketDataMessage.recapType = wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].processedInitialSnapshot
                                           ? MarketDataMessage::RecapType::NONE
                                           : MarketDataMessage::RecapType::SOLICITED;
         marketDataMessage.tp = this->isDerivatives ? TimePoint(std::chrono::milliseconds(std::stoll(data["T"].GetString()))) : timeReceived;
@@ -186,7 +190,7 @@ class MarketDataServiceBinanceBase : public MarketDataService {
         marketDataMessageList.emplace_back(std::move(marketDataMessage));
       } else if (channelId.rfind(CCAPI_WEBSOCKET_BINANCE_BASE_CHANNEL_PARTIAL_BOOK_DEPTH, 0) == 0) {
         marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-        marketDataMessage.recapType = this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]
+        marketDataMessage.recapType = wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].processedInitialSnapshot
                                           ? MarketDataMessage::RecapType::NONE
                                           : MarketDataMessage::RecapType::SOLICITED;
         marketDataMessage.tp = this->isDerivatives ? TimePoint(std::chrono::milliseconds(std::stoll(data["T"].GetString()))) : timeReceived;
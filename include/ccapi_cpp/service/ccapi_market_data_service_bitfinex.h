@@ -30,6 +30,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
     this->getRecentTradesTarget = "/v2/trades/{Symbol}/hist";
     this->getInstrumentsTarget = CCAPI_BITFINEX_GET_INSTRUMENTS_PATH;
     this->getInstrumentTarget = CCAPI_BITFINEX_GET_INSTRUMENTS_PATH;
+    this->canTruncateOrderBook = true;
   }
   virtual ~MarketDataServiceBitfinex() {}
 #ifndef CCAPI_EXPOSE_INTERNAL
@@ -67,7 +68,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
         CCAPI_LOGGER_WARN("incorrect initial sequence, wsConnection = " + toString(wsConnection));
         return false;
       }
-      this->sequenceByConnectionIdMap.insert(std::pair<std::string, int>(wsConnection.id, sequence));
+      this->sequenceByConnectionIdMap.insert(std::pair<uint64_t, int>(wsConnection.id, sequence));
       return true;
     } else {
       if (sequence - this->sequenceByConnectionIdMap[wsConnection.id] == 1) {
@@ -132,7 +133,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
         CCAPI_LOGGER_WARN("incorrect initial sequence, wsConnection = " + toString(*wsConnectionPtr));
         return false;
       }
-      this->sequenceByConnectionIdMap.insert(std::pair<std::string, int>(wsConnectionPtr->id, sequence));
+      this->sequenceByConnectionIdMap.insert(std::pair<uint64_t, int>(wsConnectionPtr->id, sequence));
       return true;
     } else {
       if (sequence - this->sequenceByConnectionIdMap[wsConnectionPtr->id] == 1) {
@@ -169,7 +170,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
     MarketDataService::onIncorrectStatesFound(wsConnectionPtr, textMessageView, timeReceived, exchangeSubscriptionId, reason);
   }
 #endif
-  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
     auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
     auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
@@ -184,13 +185,13 @@ class MarketDataServiceBitfinex : public MarketDataService {
       channelId = std::string(CCAPI_WEBSOCKET_BITFINEX_CHANNEL_CANDLES) + ":" + interval;
     }
   }
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override { return std::vector<std::string>(); }
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override { return std::vector<std::string>(); }
   void processTextMessage(std::shared_ptr<WsConnection> wsConnectionPtr, boost::beast::string_view textMessageView, const TimePoint& timeReceived, Event& event,
                           std::vector<MarketDataMessage>& marketDataMessageList) override {
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     if (document.IsArray() && document.Size() >= 1) {
       auto exchangeSubscriptionId = std::string(document[0].GetString());
       if (document.Size() >= 2 && document[1].IsString() && std::string(document[1].GetString()) == "hb") {
@@ -499,7 +500,7 @@ class MarketDataServiceBitfinex : public MarketDataService {
         message.setCorrelationIdList(correlationIdList);
         message.setType(eventStr == "subscribed" ? Message::Type::SUBSCRIPTION_STARTED : Message::Type::SUBSCRIPTION_FAILURE);
         Element element;
-        element.insert(eventStr == "subscribed" ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, textMessage);
+        element.insert(eventStr == "subscribed" ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
         event.setMessageList(messageList);
@@ -636,8 +637,8 @@ class MarketDataServiceBitfinex : public MarketDataService {
         CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
     }
   }
-  std::map<std::string, std::map<std::string, MarketDataMessage::TypeForData> > marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdMap;
-  std::map<std::string, int> sequenceByConnectionIdMap;
+  std::map<uint64_t, std::map<std::string, MarketDataMessage::TypeForData> > marketDataMessageDataBufferByConnectionIdExchangeSubscriptionIdMap;
+  std::map<uint64_t, int> sequenceByConnectionIdMap;
 };
 } /* namespace ccapi */
 #endif
@@ -39,7 +39,7 @@ class MarketDataServiceBitmart : public MarketDataService {
 
  private:
 #endif
-  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
     auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
     if (field == CCAPI_MARKET_DEPTH) {
@@ -67,7 +67,7 @@ class MarketDataServiceBitmart : public MarketDataService {
   }
 #endif
   bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*1000")); }
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
     rj::Document document;
     document.SetObject();
@@ -80,7 +80,7 @@ class MarketDataServiceBitmart : public MarketDataService {
         std::string symbolId = subscriptionListBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_BITMART_CHANNEL_PUBLIC_DEPTH5 || channelId == CCAPI_WEBSOCKET_BITMART_CHANNEL_PUBLIC_DEPTH20 ||
             channelId == CCAPI_WEBSOCKET_BITMART_CHANNEL_PUBLIC_DEPTH50) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId = UtilString::split(channelId, "?").at(0) + ":" + symbolId;
         args.PushBack(rj::Value(exchangeSubscriptionId.c_str(), allocator).Move(), allocator);
@@ -107,11 +107,11 @@ class MarketDataServiceBitmart : public MarketDataService {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     if (textMessage != "pong") {
       rj::Document document;
-      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
       auto it = document.FindMember("errorCode");
       std::string errorCode = it != document.MemberEnd() ? it->value.GetString() : "";
       if (errorCode.empty()) {
@@ -132,7 +132,7 @@ class MarketDataServiceBitmart : public MarketDataService {
           message.setCorrelationIdList(correlationIdList);
           message.setType(Message::Type::SUBSCRIPTION_STARTED);
           Element element;
-          element.insert(CCAPI_INFO_MESSAGE, textMessage);
+          element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           messageList.emplace_back(std::move(message));
           event.addMessages(messageList);
@@ -145,7 +145,7 @@ class MarketDataServiceBitmart : public MarketDataService {
             marketDataMessage.tp = TimePoint(std::chrono::milliseconds(std::stoll(datum["ms_t"].GetString())));
             marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
             marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
-            if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+            if (wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].processedInitialSnapshot) {
               marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
             } else {
               marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -196,7 +196,7 @@ class MarketDataServiceBitmart : public MarketDataService {
           message.setTimeReceived(timeReceived);
           message.setType(Message::Type::SUBSCRIPTION_FAILURE);
           Element element;
-          element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+          element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           const auto& channelId = splitted.at(1);
           const auto& symbolId = splitted.at(2);
@@ -310,7 +310,7 @@ class MarketDataServiceBitmart : public MarketDataService {
         CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
     }
   }
-  std::vector<std::string> createSendStringListFromSubscriptionList(const WsConnection& wsConnection, const std::vector<Subscription>& subscriptionList,
+  std::vector<std::string> createSendStringListFromSubscriptionList(WsConnection& wsConnection, const std::vector<Subscription>& subscriptionList,
                                                                     const TimePoint& now, const std::map<std::string, std::string>& credential) override {
     std::vector<std::string> sendStringList;
     rj::Document document;
@@ -339,7 +339,7 @@ class MarketDataServiceBitmart : public MarketDataService {
     return sendStringList;
   }
   std::string apiMemo;
-  std::map<std::string, std::map<std::string, std::map<std::string, bool>>> subscriptionStartedByConnectionIdChannelIdSymbolIdMap;
+  std::map<uint64_t, std::map<std::string, std::map<std::string, bool>>> subscriptionStartedByConnectionIdChannelIdSymbolIdMap;
 };
 } /* namespace ccapi */
 #endif
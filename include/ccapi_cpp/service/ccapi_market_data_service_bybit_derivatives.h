@@ -66,7 +66,7 @@ class MarketDataServiceBybitDerivatives : public MarketDataServiceBybitBase {
     }
     return interval;
   }
-  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
     const auto& marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
     const auto& instrumentType = subscription.getInstrumentType();
@@ -88,7 +88,7 @@ class MarketDataServiceBybitDerivatives : public MarketDataServiceBybitBase {
       channelId.replace(channelId.find(toReplace), toReplace.length(), interval);
     }
   }
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
     std::vector<std::string> exchangeSubscriptionIdList;
     rj::Document document;
@@ -139,10 +139,10 @@ class MarketDataServiceBybitDerivatives : public MarketDataServiceBybitBase {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     if (document.IsObject() && document.HasMember("op")) {
       std::string op = document["op"].GetString();
       if (op == "subscribe") {
@@ -177,7 +177,7 @@ class MarketDataServiceBybitDerivatives : public MarketDataServiceBybitBase {
         message.setCorrelationIdList(correlationIdList);
         message.setType(success ? Message::Type::SUBSCRIPTION_STARTED : Message::Type::SUBSCRIPTION_FAILURE);
         Element element;
-        element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, textMessage);
+        element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, std::string(textMessage));
         message.setElementList({element});
         messageList.emplace_back(std::move(message));
         event.setMessageList(messageList);
@@ -30,13 +30,14 @@ class MarketDataServiceCoinbase : public MarketDataService {
     this->getRecentTradesTarget = "/products/<product-id>/trades";
     this->getInstrumentTarget = "/products/<product-id>";
     this->getInstrumentsTarget = "/products";
+    this->canTruncateOrderBook = true;
   }
   virtual ~MarketDataServiceCoinbase() {}
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  private:
 #endif
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
     rj::Document document;
     document.SetObject();
@@ -85,10 +86,10 @@ class MarketDataServiceCoinbase : public MarketDataService {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     auto type = std::string(document["type"].GetString());
     if (type == "l2update") {
       auto symbolId = std::string(document["product_id"].GetString());
@@ -175,7 +176,7 @@ class MarketDataServiceCoinbase : public MarketDataService {
       message.setCorrelationIdList(correlationIdList);
       message.setType(Message::Type::SUBSCRIPTION_STARTED);
       Element element;
-      element.insert(CCAPI_INFO_MESSAGE, textMessage);
+      element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
       event.setMessageList(messageList);
@@ -186,7 +187,7 @@ class MarketDataServiceCoinbase : public MarketDataService {
       message.setTimeReceived(timeReceived);
       message.setType(Message::Type::SUBSCRIPTION_FAILURE);
       Element element;
-      element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+      element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
       message.setElementList({element});
       messageList.emplace_back(std::move(message));
       event.setMessageList(messageList);
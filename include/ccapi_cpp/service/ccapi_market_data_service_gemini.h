@@ -36,7 +36,7 @@ class MarketDataServiceGemini : public MarketDataService {
 
  private:
 #endif
-  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
     auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
     auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
@@ -48,7 +48,7 @@ class MarketDataServiceGemini : public MarketDataService {
       }
     }
   }
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override { return std::vector<std::string>(); }
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override { return std::vector<std::string>(); }
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
   void onOpen(wspp::connection_hdl hdl) override {
     MarketDataService::onOpen(hdl);
@@ -60,7 +60,7 @@ class MarketDataServiceGemini : public MarketDataService {
         auto symbolId = subscriptionListByInstrument.first;
         int marketDepthSubscribedToExchange = this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId];
         if (marketDepthSubscribedToExchange == 1) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].l2UpdateIsReplace = true;
         }
         auto exchangeSubscriptionId = wsConnection.url;
         this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnection.id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
@@ -92,7 +92,7 @@ class MarketDataServiceGemini : public MarketDataService {
         CCAPI_LOGGER_WARN("incorrect initial sequence, wsConnection = " + toString(wsConnection));
         return false;
       }
-      this->sequenceByConnectionIdMap.insert(std::pair<std::string, int>(wsConnection.id, sequence));
+      this->sequenceByConnectionIdMap.insert(std::pair<uint64_t, int>(wsConnection.id, sequence));
       return true;
     } else {
       if (sequence - this->sequenceByConnectionIdMap[wsConnection.id] == 1) {
@@ -129,7 +129,7 @@ class MarketDataServiceGemini : public MarketDataService {
         auto symbolId = subscriptionListByInstrument.first;
         int marketDepthSubscribedToExchange = this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnectionPtr->id][channelId][symbolId];
         if (marketDepthSubscribedToExchange == 1) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnectionPtr->id][channelId][symbolId] = true;
+          wsConnectionPtr->orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].l2UpdateIsReplace = true;
         }
         auto exchangeSubscriptionId = wsConnectionPtr->getUrl();
         this->channelIdSymbolIdByConnectionIdExchangeSubscriptionIdMap[wsConnectionPtr->id][exchangeSubscriptionId][CCAPI_CHANNEL_ID] = channelId;
@@ -161,7 +161,7 @@ class MarketDataServiceGemini : public MarketDataService {
         CCAPI_LOGGER_WARN("incorrect initial sequence, wsConnection = " + toString(*wsConnectionPtr));
         return false;
       }
-      this->sequenceByConnectionIdMap.insert(std::pair<std::string, int>(wsConnectionPtr->id, sequence));
+      this->sequenceByConnectionIdMap.insert(std::pair<uint64_t, int>(wsConnectionPtr->id, sequence));
       return true;
     } else {
       if (sequence - this->sequenceByConnectionIdMap[wsConnectionPtr->id] == 1) {
@@ -201,10 +201,10 @@ class MarketDataServiceGemini : public MarketDataService {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     auto type = std::string(document["type"].GetString());
     if (this->sessionOptions.enableCheckSequence) {
       int sequence = std::stoi(document["socket_sequence"].GetString());
@@ -401,7 +401,7 @@ class MarketDataServiceGemini : public MarketDataService {
         CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
     }
   }
-  std::map<std::string, int> sequenceByConnectionIdMap;
+  std::map<uint64_t, int> sequenceByConnectionIdMap;
 };
 } /* namespace ccapi */
 #endif
@@ -54,7 +54,7 @@ class MarketDataServiceOkx : public MarketDataService {
            subscription.getSerializedCredential();
   }
   bool doesHttpBodyContainError(const std::string& body) override { return !std::regex_search(body, std::regex("\"code\":\\s*\"0\"")); }
-  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
     auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
     auto conflateIntervalMilliseconds = std::stoi(optionMap.at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS));
@@ -85,7 +85,7 @@ class MarketDataServiceOkx : public MarketDataService {
 #else
   void pingOnApplicationLevel(std::shared_ptr<WsConnection> wsConnectionPtr, ErrorCode& ec) override { this->send(wsConnectionPtr, "ping", ec); }
 #endif
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
     rj::Document document;
     document.SetObject();
@@ -97,7 +97,7 @@ class MarketDataServiceOkx : public MarketDataService {
       for (const auto& subscriptionListBySymbolId : subscriptionListByChannelIdSymbolId.second) {
         std::string symbolId = subscriptionListBySymbolId.first;
         if (channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT || channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5) {
-          this->l2UpdateIsReplaceByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = true;
+          wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].l2UpdateIsReplace = true;
         }
         std::string exchangeSubscriptionId = UtilString::split(channelId, "?").at(0) + ":" + symbolId;
         rj::Value arg(rj::kObjectType);
@@ -149,11 +149,11 @@ class MarketDataServiceOkx : public MarketDataService {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     if (textMessage != "pong") {
       rj::Document document;
-      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+      document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
       auto it = document.FindMember("event");
       std::string eventStr = it != document.MemberEnd() ? it->value.GetString() : "";
       if (eventStr == "login") {
@@ -193,7 +193,7 @@ class MarketDataServiceOkx : public MarketDataService {
               message.setCorrelationIdList(correlationIdList);
               message.setType(Message::Type::SUBSCRIPTION_STARTED);
               Element element;
-              element.insert(CCAPI_INFO_MESSAGE, textMessage);
+              element.insert(CCAPI_INFO_MESSAGE, std::string(textMessage));
               message.setElementList({element});
               messageList.emplace_back(std::move(message));
               event.setMessageList(messageList);
@@ -204,7 +204,7 @@ class MarketDataServiceOkx : public MarketDataService {
               message.setTimeReceived(timeReceived);
               message.setType(Message::Type::SUBSCRIPTION_FAILURE);
               Element element;
-              element.insert(CCAPI_ERROR_MESSAGE, textMessage);
+              element.insert(CCAPI_ERROR_MESSAGE, std::string(textMessage));
               message.setElementList({element});
               messageList.emplace_back(std::move(message));
               event.setMessageList(messageList);
@@ -229,7 +229,7 @@ class MarketDataServiceOkx : public MarketDataService {
                 marketDataMessage.exchangeSubscriptionId = exchangeSubscriptionId;
                 marketDataMessage.type = MarketDataMessage::Type::MARKET_DATA_EVENTS_MARKET_DEPTH;
                 if (channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH1_L2_TBT || channelId == CCAPI_WEBSOCKET_OKX_CHANNEL_PUBLIC_DEPTH5) {
-                  if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId]) {
+                  if (wsConnection.orderBookStateByChannelIdSymbolIdMap[channelId][symbolId].processedInitialSnapshot) {
                     marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
                   } else {
                     marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
@@ -495,7 +495,7 @@ class MarketDataServiceOkx : public MarketDataService {
         CCAPI_LOGGER_FATAL(CCAPI_UNSUPPORTED_VALUE);
     }
   }
-  std::vector<std::string> createSendStringListFromSubscriptionList(const WsConnection& wsConnection, const std::vector<Subscription>& subscriptionList,
+  std::vector<std::string> createSendStringListFromSubscriptionList(WsConnection& wsConnection, const std::vector<Subscription>& subscriptionList,
                                                                     const TimePoint& now, const std::map<std::string, std::string>& credential) override {
     std::vector<std::string> sendStringList;
     rj::Document document;
@@ -54,7 +54,7 @@ class MarketDataServiceWhitebit : public MarketDataService {
     this->exchangeJsonPayloadIdByConnectionIdMap[wsConnectionPtr->id] += 1;
   }
 #endif
-  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, const WsConnection& wsConnection,
+  void prepareSubscriptionDetail(std::string& channelId, std::string& symbolId, const std::string& field, WsConnection& wsConnection,
                                  const Subscription& subscription, const std::map<std::string, std::string> optionMap) override {
     auto marketDepthRequested = std::stoi(optionMap.at(CCAPI_MARKET_DEPTH_MAX));
     if (field == CCAPI_MARKET_DEPTH) {
@@ -63,7 +63,7 @@ class MarketDataServiceWhitebit : public MarketDataService {
       this->marketDepthSubscribedToExchangeByConnectionIdChannelIdSymbolIdMap[wsConnection.id][channelId][symbolId] = marketDepthSubscribedToExchange;
     }
   }
-  std::vector<std::string> createSendStringList(const WsConnection& wsConnection) override {
+  std::vector<std::string> createSendStringList(WsConnection& wsConnection) override {
     std::vector<std::string> sendStringList;
     for (const auto& subscriptionListByChannelIdSymbolId : this->subscriptionListByConnectionIdChannelIdSymbolIdMap.at(wsConnection.id)) {
       auto channelId = subscriptionListByChannelIdSymbolId.first;
@@ -136,10 +136,10 @@ class MarketDataServiceWhitebit : public MarketDataService {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
     WsConnection& wsConnection = *wsConnectionPtr;
-    std::string textMessage(textMessageView);
+    boost::beast::string_view textMessage(textMessageView);
 #endif
     rj::Document document;
-    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.c_str());
+    document.Parse<rj::kParseNumbersAsStringsFlag>(textMessage.data(), textMessage.size());
     auto itId = document.FindMember("id");
     if (itId == document.MemberEnd() || itId->value.IsNull()) {
       std::string method = document["method"].GetString();
@@ -185,11 +185,11 @@ class MarketDataServiceWhitebit : public MarketDataService {
           auto tp = TimePoint(std::chrono::duration<int64_t>(timePair.first));
           tp += std::chrono::nanoseconds(timePair.second);
           marketDataMessage.tp = tp;
-          if (this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_TRADES][symbolId]) {
+          if (wsConnection.orderBookStateByChannelIdSymbolIdMap[CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_TRADES][symbolId].processedInitialSnapshot) {
             marketDataMessage.recapType = MarketDataMessage::RecapType::NONE;
           } else {
             marketDataMessage.recapType = MarketDataMessage::RecapType::SOLICITED;
-            this->processedInitialSnapshotByConnectionIdChannelIdSymbolIdMap[wsConnection.id][CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_TRADES][symbolId] = true;
+            wsConnection.orderBookStateByChannelIdSymbolIdMap[CCAPI_WEBSOCKET_WHITEBIT_CHANNEL_MARKET_TRADES][symbolId].processedInitialSnapshot = true;
           }
           MarketDataMessage::TypeForDataPoint dataPoint;
           dataPoint.insert({MarketDataMessage::DataFieldType::PRICE, UtilString::normalizeDecimalString(std::string(x["price"].GetString()))});
@@ -238,7 +238,7 @@ class MarketDataServiceWhitebit : public MarketDataService {
           message.setCorrelationIdList(correlationIdList);
           message.setType(success ? Message::Type::SUBSCRIPTION_STARTED : Message::Type::SUBSCRIPTION_FAILURE);
           Element element;
-          element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, textMessage);
+          element.insert(success ? CCAPI_INFO_MESSAGE : CCAPI_ERROR_MESSAGE, std::string(textMessage));
           message.setElementList({element});
           messageList.emplace_back(std::move(message));
           event.setMessageList(messageList);
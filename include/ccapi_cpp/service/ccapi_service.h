@@ -25,8 +25,10 @@
 #include "boost/beast/version.hpp"
 #include "ccapi_cpp/ccapi_decimal.h"
 #include "ccapi_cpp/ccapi_event.h"
+#include "ccapi_cpp/ccapi_latency_stats.h"
 #include "ccapi_cpp/ccapi_macro.h"
 #include "ccapi_cpp/ccapi_market_data_message.h"
+#include "ccapi_cpp/ccapi_metrics_registry.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
@@ -59,6 +61,7 @@
 #include "ccapi_cpp/ccapi_http_connection.h"
 #include "ccapi_cpp/ccapi_http_retry.h"
 #include "ccapi_cpp/ccapi_queue.h"
+#include "ccapi_cpp/ccapi_rate_limiter.h"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_session_configs.h"
 #include "ccapi_cpp/ccapi_session_options.h"
@@ -88,6 +91,17 @@ class Service : public std::enable_shared_from_this<Service> {
 #else
   typedef boost::system::error_code ErrorCode;  // a.k.a. beast::error_code
 #endif
+  // a request that waits in the rate limiter
+  struct RateLimitedRequest {
+    Request request;
+    http::request<http::string_body> req;
+    HttpRetry retry;
+    Queue<Event>* eventQueuePtr{};
+    TimePoint enqueueTp{std::chrono::seconds(0)};
+    // the limiter may be shared with other services of the exchange, so whoever releases the request hands it back to the service that queued it
+    std::weak_ptr<Service> serviceWeakPtr;
+  };
+  typedef RateLimiter<RateLimitedRequest> RequestRateLimiter;
   enum class PingPongMethod {
     WEBSOCKET_PROTOCOL_LEVEL,
     WEBSOCKET_APPLICATION_LEVEL,
@@ -145,6 +159,29 @@ class Service : public std::enable_shared_from_this<Service> {
   void purgeHttpConnectionPool() { this->httpConnectionPool.clear(); }
   void purgeHttpConnectionPool(const std::string& localIpAddress) { this->httpConnectionPool.erase(localIpAddress); }
   void purgeHttpConnectionPool(const std::string& localIpAddress, const std::string& baseUrl) { this->httpConnectionPool[localIpAddress].erase(baseUrl); }
+  void setLatencyStatsPtr(std::shared_ptr<LatencyStats> latencyStatsPtr) { this->latencyStatsPtr = latencyStatsPtr; }
+  const std::string& getHostRest() const { return this->hostRest; }
+  std::shared_ptr<RequestRateLimiter> getRateLimiterPtr() const { return this->rateLimiterPtr; }
+  // shares the rate limiter with the other services of the exchange that send to the same host, e.g. Binance's request weight per IP is used up by market
+  // data and execution management requests alike; the limits that only this service knows are added to the shared limiter
+  void setRateLimiterPtr(std::shared_ptr<RequestRateLimiter> rateLimiterPtr) {
+    rateLimiterPtr->mergeLimit(*this->rateLimiterPtr);
+    this->rateLimiterPtr = rateLimiterPtr;
+  }
+  // looks up the metrics that are updated on the hot path once, so that updating them afterwards doesn't take the registry's lock
+  virtual void setMetricsRegistryPtr(std::shared_ptr<MetricsRegistry> metricsRegistryPtr) {
+    this->metricsRegistryPtr = metricsRegistryPtr;
+    auto labelMap = this->getMetricsLabelMap();
+    this->websocketMessageReceivedCounterPtr =
+        &metricsRegistryPtr->getCounter("ccapi_websocket_messages_received_total", labelMap, "Number of websocket messages received.");
+    this->websocketByteReceivedCounterPtr =
+        &metricsRegistryPtr->getCounter("ccapi_websocket_bytes_received_total", labelMap, "Number of websocket payload bytes received.");
+    this->websocketReconnectCounterPtr = &metricsRegistryPtr->getCounter("ccapi_websocket_reconnects_total", labelMap, "Number of websocket reconnect attempts.");
+    this->httpConnectionPoolHitCounterPtr =
+        &metricsRegistryPtr->getCounter("ccapi_http_connection_pool_hits_total", labelMap, "Number of http requests sent on a pooled connection.");
+    this->httpConnectionPoolMissCounterPtr =
+        &metricsRegistryPtr->getCounter("ccapi_http_connection_pool_misses_total", labelMap, "Number of http requests that needed a new connection.");
+  }
   void forceCloseWebsocketConnections() {
     for (const auto& x : this->wsConnectionByIdMap) {
       ErrorCode ec;
@@ -160,6 +197,12 @@ class Service : public std::enable_shared_from_this<Service> {
       x.second->cancel();
     }
     sendRequestDelayTimerByCorrelationIdMap.clear();
+    if (this->rateLimiterTimerPtr) {
+      this->rateLimiterTimerPtr->cancel();
+    }
+    if (this->tcpQuickAckTimerPtr) {
+      this->tcpQuickAckTimerPtr->cancel();
+    }
     this->shouldContinue = false;
     for (const auto& x : this->wsConnectionByIdMap) {
       ErrorCode ec;
@@ -181,6 +224,9 @@ class Service : public std::enable_shared_from_this<Service> {
                                      const std::map<std::string, std::string>& credential) {}
   virtual void processSuccessfulTextMessageRest(int statusCode, const Request& request, const std::string& textMessage, const TimePoint& timeReceived,
                                                 Queue<Event>* eventQueuePtr) {}
+  // the number of orders that fit into one native batch request of the given operation; 1 means that the exchange has no such endpoint and the batch has to be
+  // fanned out into individual requests
+  virtual size_t getBatchSizeMax(Request::Operation operation) const { return 1; }
   std::shared_ptr<std::future<void>> sendRequest(Request& request, const bool useFuture, const TimePoint& now, long delayMilliseconds,
                                                  Queue<Event>* eventQueuePtr) {
     CCAPI_LOGGER_FUNCTION_ENTER;
@@ -197,7 +243,7 @@ class Service : public std::enable_shared_from_this<Service> {
       req = this->convertRequest(request, then);
     } catch (const std::runtime_error& e) {
       CCAPI_LOGGER_ERROR(std::string("e.what() = ") + e.what());
-      this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, e, {request.getCorrelationId()}, eventQueuePtr);
+      this->onRequestFailure(request, e, eventQueuePtr);
       std::promise<void>* promisePtrRaw = nullptr;
       if (useFuture) {
         promisePtrRaw = new std::promise<void>();
@@ -225,7 +271,7 @@ class Service : public std::enable_shared_from_this<Service> {
         } else {
           auto now = UtilTime::now();
           request.setTimeSent(now);
-          that->tryRequest(request, req, retry, eventQueuePtr);
+          that->tryRequestRateLimited(request, req, retry, eventQueuePtr);
         }
         that->sendRequestDelayTimerByCorrelationIdMap.erase(request.getCorrelationId());
       });
@@ -233,7 +279,7 @@ class Service : public std::enable_shared_from_this<Service> {
     } else {
       request.setTimeSent(now);
       net::post(*this->serviceContextPtr->ioContextPtr,
-                [that = shared_from_this(), request, req, retry, eventQueuePtr]() mutable { that->tryRequest(request, req, retry, eventQueuePtr); });
+                [that = shared_from_this(), request, req, retry, eventQueuePtr]() mutable { that->tryRequestRateLimited(request, req, retry, eventQueuePtr); });
     }
     std::shared_ptr<std::future<void>> futurePtr(nullptr);
     if (useFuture) {
@@ -287,6 +333,49 @@ class Service : public std::enable_shared_from_this<Service> {
     event.setMessageList({message});
     this->eventHandler(event, eventQueuePtr);
   }
+  // a batch request that fails as a whole fails each of its orders, so the failure is also reported under the correlation id of each order that carries its
+  // own one
+  void onBatchElementError(const Request& request, const std::string& statusCode, const std::string& errorMessage, Queue<Event>* eventQueuePtr) {
+    if (!Request::isBatchOperation(request.getOperation())) {
+      return;
+    }
+    Event event;
+    event.setType(Event::Type::RESPONSE);
+    Element element;
+    if (!statusCode.empty()) {
+      element.insert(CCAPI_HTTP_STATUS_CODE, statusCode);
+    }
+    element.insert(CCAPI_ERROR_MESSAGE, UtilString::trim(errorMessage));
+    auto now = UtilTime::now();
+    std::vector<Message> messageList;
+    for (size_t i = 0; i < request.getParamList().size(); ++i) {
+      auto correlationId = request.getBatchElementCorrelationId(i);
+      if (correlationId == request.getCorrelationId()) {
+        continue;
+      }
+      Message message;
+      message.setTimeReceived(now);
+      message.setType(Message::Type::RESPONSE_ERROR);
+      message.setCorrelationIdList({correlationId});
+      message.setElementList({element});
+      messageList.emplace_back(std::move(message));
+    }
+    if (!messageList.empty()) {
+      event.setMessageList(messageList);
+      this->eventHandler(event, eventQueuePtr);
+    }
+  }
+  // a request that has failed for good, i.e. without a retry to follow
+  void onRequestFailure(const Request& request, const std::string& errorMessage, Queue<Event>* eventQueuePtr) {
+    this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, errorMessage, {request.getCorrelationId()}, eventQueuePtr);
+    this->onBatchElementError(request, "", errorMessage, eventQueuePtr);
+  }
+  void onRequestFailure(const Request& request, const ErrorCode& ec, const std::string& what, Queue<Event>* eventQueuePtr) {
+    this->onRequestFailure(request, what + ": " + ec.message() + ", category: " + ec.category().name(), eventQueuePtr);
+  }
+  void onRequestFailure(const Request& request, const std::exception& e, Queue<Event>* eventQueuePtr) {
+    this->onRequestFailure(request, e.what(), eventQueuePtr);
+  }
 #ifndef CCAPI_EXPOSE_INTERNAL
 
  protected:
@@ -306,6 +395,62 @@ class Service : public std::enable_shared_from_this<Service> {
   typedef ServiceContext::TlsClient TlsClient;
 #endif
   typedef std::shared_ptr<net::steady_timer> TimerPtr;
+  // no-op unless latency stats are enabled and the current call stack originates from a websocket read
+  void recordLatency(LatencyStats::Stage stage) {
+    if (this->latencyStatsPtr && this->readTsc) {
+      this->latencyStatsPtr->record(stage, this->readTsc, TscClock::now());
+    }
+  }
+  void setLatencyTrace(Event& event) {
+    if (this->latencyStatsPtr && this->readTsc) {
+      event.setLatencyTrace(this->readTsc, this->latencyStatsPtr.get());
+    }
+  }
+  // no-op unless kernel receive timestamps are enabled and the current call stack originates from a websocket read
+  void setTimeReceivedKernel(Event& event) {
+    if (this->readKernelTp.time_since_epoch().count() == 0) {
+      return;
+    }
+    event.setTimeReceivedKernel(this->readKernelTp);
+  }
+  // the socket tuning profile of SessionOptions, applied to the sockets of websocket connections after they are opened and before they connect
+  void applySocketTuning(tcp::socket& socket) {
+    ErrorCode ec;
+    if (this->sessionOptions.socketReceiveBufferSize > 0) {
+      socket.set_option(net::socket_base::receive_buffer_size(this->sessionOptions.socketReceiveBufferSize), ec);
+    }
+    if (this->sessionOptions.socketSendBufferSize > 0) {
+      socket.set_option(net::socket_base::send_buffer_size(this->sessionOptions.socketSendBufferSize), ec);
+    }
+#ifdef __linux__
+    if (this->sessionOptions.socketBusyPollMicroseconds > 0) {
+      socket.set_option(net::detail::socket_option::integer<SOL_SOCKET, SO_BUSY_POLL>(this->sessionOptions.socketBusyPollMicroseconds), ec);
+    }
+#endif
+    if (ec) {
+      CCAPI_LOGGER_WARN("socket tuning: " + ec.message());
+    }
+  }
+  std::map<std::string, std::string> getMetricsLabelMap() const { return {{"exchange", this->exchangeName}, {"service", this->serviceName}}; }
+  void recordHttpRequestLatency(const Request& request, const TimePoint& now) {
+    if (!this->metricsRegistryPtr) {
+      return;
+    }
+    auto operation = request.getOperation();
+    auto it = this->httpRequestLatencyHistogramByOperationMap.find(operation);
+    if (it == this->httpRequestLatencyHistogramByOperationMap.end()) {
+      auto labelMap = this->getMetricsLabelMap();
+      labelMap["operation"] = Request::operationToString(operation);
+      it = this->httpRequestLatencyHistogramByOperationMap
+               .insert(std::make_pair(operation, &this->metricsRegistryPtr->getHistogram("ccapi_http_request_latency_nanoseconds", labelMap,
+                                                                                        "Time from sending an http request to receiving its response.")))
+               .first;
+    }
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - request.getTimeSent()).count();
+    if (latency >= 0) {
+      it->second->record(latency);
+    }
+  }
   void setHostRestFromUrlRest(std::string baseUrlRest) {
     auto hostPort = this->extractHostFromUrl(baseUrlRest);
     this->hostRest = hostPort.first;
@@ -427,6 +572,7 @@ class Service : public std::enable_shared_from_this<Service> {
     beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
     // #endif
     CCAPI_LOGGER_TRACE("before ssl async_handshake");
+    this->serviceContextPtr->tlsSessionCache.beforeHandshake(stream.native_handle());
     stream.async_handshake(ssl::stream_base::client,
                            beast::bind_front_handler(&Service::onSslHandshake, shared_from_this(), httpConnectionPtr, req, errorHandler, responseHandler));
     CCAPI_LOGGER_TRACE("after ssl async_handshake");
@@ -435,6 +581,7 @@ class Service : public std::enable_shared_from_this<Service> {
                       std::function<void(const beast::error_code&)> errorHandler, std::function<void(const http::response<http::string_body>&)> responseHandler,
                       beast::error_code ec) {
     CCAPI_LOGGER_TRACE("ssl async_handshake callback start");
+    this->serviceContextPtr->tlsSessionCache.afterHandshake(httpConnectionPtr->streamPtr->native_handle(), !ec);
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
       errorHandler(ec);
@@ -507,9 +654,9 @@ class Service : public std::enable_shared_from_this<Service> {
   }
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
 #else
-  std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> createWsStream(net::io_context* iocPtr, net::ssl::context* ctxPtr) {
-    std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> streamPtr(
-        new beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>(*iocPtr, *ctxPtr));
+  std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>> createWsStream(net::io_context* iocPtr, net::ssl::context* ctxPtr) {
+    std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>> streamPtr(
+        new beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>(*iocPtr, *ctxPtr));
     return streamPtr;
   }
 #endif
@@ -544,7 +691,10 @@ class Service : public std::enable_shared_from_this<Service> {
         beast::get_lowest_layer(stream).socket().open(net::ip::tcp::v4(), ec);
         if (ec) {
           CCAPI_LOGGER_TRACE("fail");
-          this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "socket open", {request.getCorrelationId()}, eventQueuePtr);
+          if (this->isHedgedFailureSuppressed(retry, true)) {
+            return;
+          }
+          this->onRequestFailure(request, ec, "socket open", eventQueuePtr);
           return;
         }
       }
@@ -552,8 +702,10 @@ class Service : public std::enable_shared_from_this<Service> {
       tcp::endpoint existingLocalEndpoint = beast::get_lowest_layer(stream).socket().local_endpoint(ec);
       if (ec) {
         CCAPI_LOGGER_TRACE("fail");
-        this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "socket get local endpoint", {request.getCorrelationId()},
-                      eventQueuePtr);
+        if (this->isHedgedFailureSuppressed(retry, true)) {
+          return;
+        }
+        this->onRequestFailure(request, ec, "socket get local endpoint", eventQueuePtr);
         return;
       }
       tcp::endpoint localEndpoint(net::ip::address::from_string(localIpAddress),
@@ -564,7 +716,10 @@ class Service : public std::enable_shared_from_this<Service> {
         beast::get_lowest_layer(stream).socket().bind(localEndpoint, ec);
         if (ec) {
           CCAPI_LOGGER_TRACE("fail");
-          this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "socket bind", {request.getCorrelationId()}, eventQueuePtr);
+          if (this->isHedgedFailureSuppressed(retry, true)) {
+            return;
+          }
+          this->onRequestFailure(request, ec, "socket bind", eventQueuePtr);
           return;
         }
       }
@@ -582,7 +737,10 @@ class Service : public std::enable_shared_from_this<Service> {
                            tcp::resolver::results_type tcpNewResolverResults) {
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
-      this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "DNS resolve", {request.getCorrelationId()}, eventQueuePtr);
+      if (this->isHedgedFailureSuppressed(retry, true)) {
+        return;
+      }
+      this->onRequestFailure(request, ec, "DNS resolve", eventQueuePtr);
       return;
     }
     CCAPI_LOGGER_TRACE("before asyncConnectWorkaround");
@@ -613,7 +771,10 @@ class Service : public std::enable_shared_from_this<Service> {
     std::advance(it, tcpNewResolverResultsIndex);
     if (it == tcpNewResolverResults.end()) {
       ErrorCode ec = net::error::make_error_code(net::error::misc_errors::not_found);
-      this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "connect", {request.getCorrelationId()}, eventQueuePtr);
+      if (this->isHedgedFailureSuppressed(retry, true)) {
+        return;
+      }
+      this->onRequestFailure(request, ec, "connect", eventQueuePtr);
       return;
     }
     CCAPI_LOGGER_TRACE("before async_connect");
@@ -631,7 +792,10 @@ class Service : public std::enable_shared_from_this<Service> {
       CCAPI_LOGGER_TRACE("fail");
       if (ec == net::error::make_error_code(net::error::basic_errors::operation_aborted)) {
         CCAPI_LOGGER_TRACE("fail");
-        this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "connect attempt timeout", {request.getCorrelationId()}, eventQueuePtr);
+        if (this->isHedgedFailureSuppressed(retry, true)) {
+          return;
+        }
+        this->onRequestFailure(request, ec, "connect attempt timeout", eventQueuePtr);
         return;
       }
       this->asyncConnectWorkaround(httpConnectionPtr, timerPtr, request, req, retry, eventQueuePtr, tcpNewResolverResults, tcpNewResolverResultsIndex + 1);
@@ -644,6 +808,7 @@ class Service : public std::enable_shared_from_this<Service> {
     beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
     // #endif
     CCAPI_LOGGER_TRACE("before ssl async_handshake");
+    this->serviceContextPtr->tlsSessionCache.beforeHandshake(stream.native_handle());
     stream.async_handshake(ssl::stream_base::client,
                            beast::bind_front_handler(&Service::onSslHandshake_2, shared_from_this(), httpConnectionPtr, request, req, retry, eventQueuePtr));
     CCAPI_LOGGER_TRACE("after ssl async_handshake");
@@ -651,9 +816,13 @@ class Service : public std::enable_shared_from_this<Service> {
   void onSslHandshake_2(std::shared_ptr<HttpConnection> httpConnectionPtr, Request request, http::request<http::string_body> req, HttpRetry retry,
                         Queue<Event>* eventQueuePtr, beast::error_code ec) {
     CCAPI_LOGGER_TRACE("ssl async_handshake callback start");
+    this->serviceContextPtr->tlsSessionCache.afterHandshake(httpConnectionPtr->streamPtr->native_handle(), !ec);
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
-      this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "ssl handshake", {request.getCorrelationId()}, eventQueuePtr);
+      if (this->isHedgedFailureSuppressed(retry, true)) {
+        return;
+      }
+      this->onRequestFailure(request, ec, "ssl handshake", eventQueuePtr);
       return;
     }
     CCAPI_LOGGER_TRACE("ssl handshaked");
@@ -677,6 +846,9 @@ class Service : public std::enable_shared_from_this<Service> {
     boost::ignore_unused(bytes_transferred);
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
+      if (this->isHedgedFailureSuppressed(retry, false)) {
+        return;
+      }
       this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "write", {request.getCorrelationId()}, eventQueuePtr);
       this->httpConnectionPool[request.getLocalIpAddress()][request.getBaseUrl()].clear();
       auto now = UtilTime::now();
@@ -704,14 +876,18 @@ class Service : public std::enable_shared_from_this<Service> {
     boost::ignore_unused(bytes_transferred);
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
+      if (this->isHedgedFailureSuppressed(retry, false)) {
+        return;
+      }
       this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "read", {request.getCorrelationId()}, eventQueuePtr);
       this->httpConnectionPool[request.getLocalIpAddress()][request.getBaseUrl()].clear();
       auto now = UtilTime::now();
       auto req = this->convertRequest(request, now);
       retry.numRetry += 1;
-      this->tryRequest(request, req, retry, eventQueuePtr);
+      this->tryRequestRateLimited(request, req, retry, eventQueuePtr);
       return;
     }
+    this->recordHttpRequestLatency(request, now);
     if (!this->sessionOptions.enableOneHttpConnectionPerRequest) {
       httpConnectionPtr->lastReceiveDataTp = now;
       const auto& localIpAddress = request.getLocalIpAddress();
@@ -739,6 +915,19 @@ class Service : public std::enable_shared_from_this<Service> {
 #endif
     int statusCode = resPtr->result_int();
     std::string body = resPtr->body();
+    if (this->sessionOptions.enableRateLimiter && !this->rateLimiterPtr->empty()) {
+      this->updateRateLimiter(*resPtr, now);
+    }
+    if (retry.hedgePtr && statusCode / 100 != 3) {
+      bool isSuccess = statusCode / 100 == 2 && !this->doesHttpBodyContainError(body);
+      if (this->isHedgedHttpResponseSuppressed(retry, statusCode, isSuccess)) {
+        CCAPI_LOGGER_DEBUG("dropped the response of a hedged duplicate of request " + request.toString());
+        return;
+      }
+      if (isSuccess) {
+        this->recordHedgedRequestLatency(request.getOperation(), now - request.getTimeSent());
+      }
+    }
     try {
       if (statusCode / 100 == 2) {
         this->processSuccessfulTextMessageRest(statusCode, request, body, now, eventQueuePtr);
@@ -763,18 +952,22 @@ class Service : public std::enable_shared_from_this<Service> {
           retry.numRedirect += 1;
           CCAPI_LOGGER_WARN("redirect from request " + request.toString() + " to url " + url.toString());
           this->tryRequest(request, req, retry, eventQueuePtr);
+        } else {
+          this->onBatchElementError(request, std::to_string(statusCode), body, eventQueuePtr);
         }
         this->onResponseError(request, statusCode, body, eventQueuePtr);
         return;
       } else if (statusCode / 100 == 4) {
         this->onResponseError(request, statusCode, body, eventQueuePtr);
+        this->onBatchElementError(request, std::to_string(statusCode), body, eventQueuePtr);
       } else if (statusCode / 100 == 5) {
         this->onResponseError(request, statusCode, body, eventQueuePtr);
         retry.numRetry += 1;
-        this->tryRequest(request, *reqPtr, retry, eventQueuePtr);
+        this->tryRequestRateLimited(request, *reqPtr, retry, eventQueuePtr);
         return;
       } else {
         this->onResponseError(request, statusCode, "unhandled response", eventQueuePtr);
+        this->onBatchElementError(request, std::to_string(statusCode), "unhandled response", eventQueuePtr);
       }
     } catch (const std::exception& e) {
       CCAPI_LOGGER_ERROR(e.what());
@@ -796,6 +989,96 @@ class Service : public std::enable_shared_from_this<Service> {
     }
   }
   virtual bool doesHttpBodyContainError(const std::string& body) { return false; }
+  // cancels go first and informational requests last, so that under throttling the exposure is reduced before anything else
+  RateLimiter<RateLimitedRequest>::Priority getRateLimitPriority(const Request& request) {
+    switch (request.getOperation()) {
+      case Request::Operation::CANCEL_ORDER:
+      case Request::Operation::CANCEL_OPEN_ORDERS:
+      case Request::Operation::CANCEL_ORDERS_BATCH:
+        return RateLimiter<RateLimitedRequest>::Priority::HIGH;
+      case Request::Operation::CREATE_ORDER:
+      case Request::Operation::CREATE_ORDERS_BATCH:
+        return RateLimiter<RateLimitedRequest>::Priority::NORMAL;
+      default:
+        return RateLimiter<RateLimitedRequest>::Priority::LOW;
+    }
+  }
+  // the amounts that a request takes from the rate limiter's buckets; costs of buckets that an exchange doesn't define are ignored
+  virtual RateLimiter<RateLimitedRequest>::CostList getRateLimitCostList(const Request& request) { return {{CCAPI_RATE_LIMIT_REQUEST_WEIGHT, 1}}; }
+  // aligns the rate limiter with the usage that the exchange reports in the response headers and backs off entirely after 429 or 418
+  virtual void updateRateLimiter(const http::response<http::string_body>& res, const TimePoint& now) {
+    for (const auto& x : this->rateLimitUsedHeaderNameByBucketNameMap) {
+      auto it = res.base().find(x.second);
+      if (it != res.base().end()) {
+        this->rateLimiterPtr->setUsed(x.first, std::strtod(std::string(it->value()).c_str(), nullptr), now);
+      }
+    }
+    int statusCode = res.result_int();
+    if (statusCode == 429 || statusCode == 418) {
+      long long retryAfterSeconds = 1;
+      auto it = res.base().find(http::field::retry_after);
+      if (it != res.base().end()) {
+        retryAfterSeconds = std::max(std::strtoll(std::string(it->value()).c_str(), nullptr, 10), 1LL);
+      }
+      CCAPI_LOGGER_WARN("rate limited by exchange " + this->exchangeName + " with status code " + std::to_string(statusCode) + ", backing off for " +
+                        std::to_string(retryAfterSeconds) + " seconds");
+      this->rateLimiterPtr->block(now + std::chrono::seconds(retryAfterSeconds));
+    }
+  }
+  // goes through the rate limiter if it is enabled and the exchange's limits are known; a request that had to wait is converted again so that its timestamp and
+  // signature are fresh
+  void tryRequestRateLimited(const Request& request, http::request<http::string_body>& req, const HttpRetry& retry, Queue<Event>* eventQueuePtr) {
+    if (!this->sessionOptions.enableRateLimiter || this->rateLimiterPtr->empty()) {
+      this->tryRequest(request, req, retry, eventQueuePtr);
+      return;
+    }
+    auto now = UtilTime::now();
+    this->rateLimiterPtr->push(this->getRateLimitPriority(request), this->getRateLimitCostList(request),
+                               {request, req, retry, eventQueuePtr, now, shared_from_this()});
+    this->releaseRateLimitedRequests(now);
+  }
+  void releaseRateLimitedRequests(const TimePoint& now) {
+    for (auto& x : this->rateLimiterPtr->pop(now)) {
+      if (x.retry.hedgePtr && x.retry.hedgePtr->settled) {
+        // a duplicate whose request has been answered while it was waiting
+        continue;
+      }
+      auto servicePtr = x.serviceWeakPtr.lock();
+      if (!servicePtr) {
+        continue;
+      }
+      if (x.enqueueTp != now) {
+        try {
+          x.req = servicePtr->convertRequest(x.request, now);
+        } catch (const std::runtime_error& e) {
+          CCAPI_LOGGER_ERROR(std::string("e.what() = ") + e.what());
+          servicePtr->onRequestFailure(x.request, e, x.eventQueuePtr);
+          if (x.retry.promisePtr) {
+            x.retry.promisePtr->set_value();
+          }
+          continue;
+        }
+      }
+      servicePtr->tryRequest(x.request, x.req, x.retry, x.eventQueuePtr);
+    }
+    if (this->rateLimiterPtr->getNumPending() == 0) {
+      return;
+    }
+    if (!this->rateLimiterTimerPtr) {
+      this->rateLimiterTimerPtr = std::make_shared<net::steady_timer>(*this->serviceContextPtr->ioContextPtr);
+    }
+    this->rateLimiterTimerPtr->expires_after(this->rateLimiterPtr->getNextReleaseTp(now) - now);
+    this->rateLimiterTimerPtr->async_wait([that = shared_from_this()](ErrorCode const& ec) {
+      if (ec) {
+        if (ec != net::error::operation_aborted) {
+          CCAPI_LOGGER_ERROR("rate limiter timer error: " + ec.message());
+          that->onError(Event::Type::REQUEST_STATUS, Message::Type::GENERIC_ERROR, ec, "timer");
+        }
+        return;
+      }
+      that->releaseRateLimitedRequests(UtilTime::now());
+    });
+  }
   void tryRequest(const Request& request, http::request<http::string_body>& req, const HttpRetry& retry, Queue<Event>* eventQueuePtr) {
     CCAPI_LOGGER_FUNCTION_ENTER;
 #if defined(CCAPI_ENABLE_LOG_DEBUG) || defined(CCAPI_ENABLE_LOG_TRACE)
@@ -804,6 +1087,14 @@ class Service : public std::enable_shared_from_this<Service> {
     CCAPI_LOGGER_DEBUG("req = \n" + oss.str());
 #endif
     CCAPI_LOGGER_TRACE("retry = " + toString(retry));
+    if (this->sessionOptions.enableHedgedRequest && !retry.hedgePtr &&
+        (request.getOperation() == Request::Operation::CANCEL_ORDER || request.getOperation() == Request::Operation::CANCEL_OPEN_ORDERS)) {
+      HttpRetry hedgedRetry(retry);
+      hedgedRetry.hedgePtr = std::make_shared<HttpHedge>();
+      this->setHedgeTimer(request, hedgedRetry, eventQueuePtr);
+      this->tryRequest(request, req, hedgedRetry, eventQueuePtr);
+      return;
+    }
     if (retry.numRetry <= this->sessionOptions.httpMaxNumRetry && retry.numRedirect <= this->sessionOptions.httpMaxNumRedirect) {
       try {
         const auto& localIpAddress = request.getLocalIpAddress();
@@ -813,13 +1104,19 @@ class Service : public std::enable_shared_from_this<Service> {
                                                              this->httpConnectionPool[localIpAddress][requestBaseUrl].back()->lastReceiveDataTp)
                     .count() >= this->sessionOptions.httpConnectionKeepAliveTimeoutSeconds) {
           this->httpConnectionPool[localIpAddress][requestBaseUrl].clear();
+          if (this->httpConnectionPoolMissCounterPtr) {
+            this->httpConnectionPoolMissCounterPtr->increment();
+          }
           std::shared_ptr<beast::ssl_stream<beast::tcp_stream>> streamPtr(nullptr);
           try {
             streamPtr = this->createStream<beast::ssl_stream<beast::tcp_stream>>(this->serviceContextPtr->ioContextPtr, this->serviceContextPtr->sslContextPtr,
                                                                                  this->hostRest);
           } catch (const beast::error_code& ec) {
             CCAPI_LOGGER_TRACE("fail");
-            this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, ec, "create stream", {request.getCorrelationId()}, eventQueuePtr);
+            if (this->isHedgedFailureSuppressed(retry, true)) {
+              return;
+            }
+            this->onRequestFailure(request, ec, "create stream", eventQueuePtr);
             return;
           }
           std::string host, port;
@@ -837,25 +1134,110 @@ class Service : public std::enable_shared_from_this<Service> {
         } else {
           std::shared_ptr<HttpConnection> httpConnectionPtr = this->httpConnectionPool[localIpAddress][requestBaseUrl].back();
           this->httpConnectionPool[localIpAddress][requestBaseUrl].pop_back();
+          if (this->httpConnectionPoolHitCounterPtr) {
+            this->httpConnectionPoolHitCounterPtr->increment();
+          }
           CCAPI_LOGGER_TRACE("about to perform request with existing httpConnectionPtr " + toString(*httpConnectionPtr) +
                              " for localIpAddress = " + localIpAddress + ", requestBaseUrl = " + toString(requestBaseUrl));
           this->startWrite_2(httpConnectionPtr, request, req, retry, eventQueuePtr);
         }
       } catch (const std::exception& e) {
         CCAPI_LOGGER_ERROR(std::string("e.what() = ") + e.what());
-        this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, e, {request.getCorrelationId()}, eventQueuePtr);
+        this->onRequestFailure(request, e, eventQueuePtr);
       }
     } else {
       std::string errorMessage = retry.numRetry > this->sessionOptions.httpMaxNumRetry ? "max retry exceeded" : "max redirect exceeded";
       CCAPI_LOGGER_ERROR(errorMessage);
       CCAPI_LOGGER_DEBUG("retry = " + toString(retry));
-      this->onError(Event::Type::REQUEST_STATUS, Message::Type::REQUEST_FAILURE, std::runtime_error(errorMessage), {request.getCorrelationId()}, eventQueuePtr);
+      this->onRequestFailure(request, errorMessage, eventQueuePtr);
       if (retry.promisePtr) {
         retry.promisePtr->set_value();
       }
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
+  // the hedge delay is a percentile of the operation's recent successful response latencies, so that only the slowest few percent of requests get duplicated
+  std::chrono::milliseconds getHedgeDelay(Request::Operation operation) {
+    const auto& latencyList = this->hedgedRequestLatencyListByOperationMap[operation];
+    if (latencyList.size() < CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MIN) {
+      return std::chrono::milliseconds(this->sessionOptions.hedgedRequestDelayMillisecondsDefault);
+    }
+    std::vector<TimePoint::duration> sortedLatencyList(latencyList.begin(), latencyList.end());
+    auto index = std::min(static_cast<size_t>(this->sessionOptions.hedgedRequestDelayPercentile * sortedLatencyList.size()), sortedLatencyList.size() - 1);
+    std::nth_element(sortedLatencyList.begin(), sortedLatencyList.begin() + index, sortedLatencyList.end());
+    return std::max(std::chrono::ceil<std::chrono::milliseconds>(sortedLatencyList[index]), std::chrono::milliseconds(1));
+  }
+  void recordHedgedRequestLatency(Request::Operation operation, TimePoint::duration latency) {
+    auto& latencyList = this->hedgedRequestLatencyListByOperationMap[operation];
+    latencyList.push_back(latency);
+    if (latencyList.size() > CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MAX) {
+      latencyList.pop_front();
+    }
+  }
+  void setHedgeTimer(const Request& request, const HttpRetry& retry, Queue<Event>* eventQueuePtr) {
+    retry.hedgePtr->timerPtr = std::make_shared<net::steady_timer>(*this->serviceContextPtr->ioContextPtr, this->getHedgeDelay(request.getOperation()));
+    retry.hedgePtr->timerPtr->async_wait([that = shared_from_this(), request, retry, eventQueuePtr](ErrorCode const& ec) {
+      if (ec || retry.hedgePtr->settled) {
+        return;
+      }
+      Request duplicate(request);
+      if (!that->sessionOptions.hedgedRequestLocalIpAddress.empty()) {
+        duplicate.setLocalIpAddress(that->sessionOptions.hedgedRequestLocalIpAddress);
+      }
+      auto now = UtilTime::now();
+      duplicate.setTimeSent(now);
+      http::request<http::string_body> req;
+      try {
+        req = that->convertRequest(duplicate, now);
+      } catch (const std::runtime_error& e) {
+        CCAPI_LOGGER_ERROR(std::string("e.what() = ") + e.what());
+        return;
+      }
+      CCAPI_LOGGER_INFO("no response within the hedge delay, about to send a duplicate of request " + request.toString());
+      retry.hedgePtr->numInFlight += 1;
+      that->tryRequestRateLimited(duplicate, req, retry, eventQueuePtr);
+    });
+  }
+  // Only a success settles a hedged request while another attempt is still outstanding. An error, whether a 4xx or a 2xx whose body reports an error, is
+  // dropped like a failure of the connection so that the other attempt can still succeed, and delivered only if it comes from the last attempt. A 5xx is
+  // retried.
+  bool isHedgedHttpResponseSuppressed(const HttpRetry& retry, int statusCode, bool isSuccess) {
+    if (statusCode / 100 == 5) {
+      return this->isHedgedFailureSuppressed(retry, false);
+    }
+    return isSuccess ? this->isHedgedResponseSuppressed(retry) : this->isHedgedFailureSuppressed(retry, true);
+  }
+  // the first successful response of a hedged request is delivered and the later ones are dropped
+  bool isHedgedResponseSuppressed(const HttpRetry& retry) {
+    if (!retry.hedgePtr) {
+      return false;
+    }
+    if (retry.hedgePtr->settled) {
+      return true;
+    }
+    retry.hedgePtr->settled = true;
+    retry.hedgePtr->timerPtr->cancel();
+    return false;
+  }
+  // a failure of a hedged request is dropped while another duplicate is still outstanding; a failure that isn't going to be retried settles the request so that
+  // no duplicate follows the error
+  bool isHedgedFailureSuppressed(const HttpRetry& retry, bool isTerminal) {
+    if (!retry.hedgePtr) {
+      return false;
+    }
+    if (retry.hedgePtr->settled) {
+      return true;
+    }
+    if (retry.hedgePtr->numInFlight > 1) {
+      retry.hedgePtr->numInFlight -= 1;
+      return true;
+    }
+    if (isTerminal) {
+      retry.hedgePtr->settled = true;
+      retry.hedgePtr->timerPtr->cancel();
+    }
+    return false;
+  }
   http::request<http::string_body> convertRequest(const Request& request, const TimePoint& now) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     auto credential = request.getCredential();
@@ -928,14 +1310,9 @@ class Service : public std::enable_shared_from_this<Service> {
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
   SslContextPtr onTlsInit(wspp::connection_hdl hdl) { return this->serviceContextPtr->sslContextPtr; }
   WsConnection& getWsConnectionFromConnectionPtr(TlsClient::connection_ptr connectionPtr) {
-    return this->wsConnectionByIdMap.at(this->connectionAddressToString(connectionPtr));
-  }
-  std::string connectionAddressToString(const TlsClient::connection_ptr con) {
-    const void* address = static_cast<const void*>(con.get());
-    std::stringstream ss;
-    ss << address;
-    return ss.str();
+    return this->wsConnectionByIdMap.at(this->connectionAddressToId(connectionPtr));
   }
+  uint64_t connectionAddressToId(const TlsClient::connection_ptr con) { return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(con.get())); }
   void close(WsConnection& wsConnection, wspp::connection_hdl hdl, wspp::close::status::value const code, std::string const& reason, ErrorCode& ec) {
     if (wsConnection.status == WsConnection::Status::CLOSING) {
       CCAPI_LOGGER_WARN("websocket connection is already in the state of closing");
@@ -948,7 +1325,7 @@ class Service : public std::enable_shared_from_this<Service> {
   virtual void connect(WsConnection& wsConnection) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     wsConnection.status = WsConnection::Status::CONNECTING;
-    CCAPI_LOGGER_DEBUG("connection initialization on dummy id " + wsConnection.id);
+    CCAPI_LOGGER_DEBUG("connection initialization on dummy id " + toString(wsConnection.id));
     std::string url = wsConnection.url;
     CCAPI_LOGGER_DEBUG("url = " + url);
     this->serviceContextPtr->tlsClientPtr->set_tls_init_handler(std::bind(&Service::onTlsInit, shared_from_this(), std::placeholders::_1));
@@ -958,12 +1335,12 @@ class Service : public std::enable_shared_from_this<Service> {
     for (const auto& kv : wsConnection.headers) {
       con->append_header(kv.first, kv.second);
     }
-    wsConnection.id = this->connectionAddressToString(con);
-    CCAPI_LOGGER_DEBUG("connection initialization on actual id " + wsConnection.id);
+    wsConnection.id = this->connectionAddressToId(con);
+    CCAPI_LOGGER_DEBUG("connection initialization on actual id " + toString(wsConnection.id));
     if (ec) {
       CCAPI_LOGGER_FATAL("connection initialization error: " + ec.message());
     }
-    this->wsConnectionByIdMap.insert(std::pair<std::string, WsConnection>(wsConnection.id, wsConnection));
+    this->wsConnectionByIdMap.insert(std::pair<uint64_t, WsConnection>(wsConnection.id, wsConnection));
     CCAPI_LOGGER_DEBUG("this->wsConnectionByIdMap = " + toString(this->wsConnectionByIdMap));
     con->set_open_handler(std::bind(&Service::onOpen, shared_from_this(), std::placeholders::_1));
     con->set_fail_handler(std::bind(&Service::onFail, shared_from_this(), std::placeholders::_1));
@@ -997,7 +1374,7 @@ class Service : public std::enable_shared_from_this<Service> {
     CCAPI_LOGGER_DEBUG("correlationIdList = " + toString(correlationIdList));
     message.setCorrelationIdList(correlationIdList);
     Element element;
-    element.insert(CCAPI_CONNECTION_ID, wsConnection.id);
+    element.insert(CCAPI_CONNECTION_ID, std::to_string(wsConnection.id));
     element.insert(CCAPI_CONNECTION_URL, wsConnection.url);
     message.setElementList({element});
     event.setMessageList({message});
@@ -1088,7 +1465,7 @@ class Service : public std::enable_shared_from_this<Service> {
     message.setTimeReceived(now);
     message.setType(Message::Type::SESSION_CONNECTION_DOWN);
     Element element;
-    element.insert(CCAPI_CONNECTION_ID, wsConnection.id);
+    element.insert(CCAPI_CONNECTION_ID, std::to_string(wsConnection.id));
     element.insert(CCAPI_CONNECTION_URL, wsConnection.url);
     element.insert(CCAPI_REASON, reason);
     message.setElementList({element});
@@ -1280,7 +1657,7 @@ class Service : public std::enable_shared_from_this<Service> {
     CCAPI_LOGGER_FUNCTION_ENTER;
     WsConnection& wsConnection = *wsConnectionPtr;
     wsConnection.status = WsConnection::Status::CONNECTING;
-    CCAPI_LOGGER_DEBUG("connection initialization on id " + wsConnection.id);
+    CCAPI_LOGGER_DEBUG("connection initialization on id " + toString(wsConnection.id));
     std::string url = wsConnection.getUrl();
     CCAPI_LOGGER_DEBUG("url = " + url);
     this->startResolveWs(wsConnectionPtr);
@@ -1304,7 +1681,7 @@ class Service : public std::enable_shared_from_this<Service> {
     this->startConnectWs(wsConnectionPtr, this->sessionOptions.websocketConnectTimeoutMilliseconds, tcpNewResolverResultsWs);
   }
   void startConnectWs(std::shared_ptr<WsConnection> wsConnectionPtr, long timeoutMilliseconds, tcp::resolver::results_type tcpResolverResults) {
-    beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>& stream = *wsConnectionPtr->streamPtr;
+    beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>& stream = *wsConnectionPtr->streamPtr;
     if (timeoutMilliseconds > 0) {
       beast::get_lowest_layer(stream).expires_after(std::chrono::milliseconds(timeoutMilliseconds));
     }
@@ -1316,10 +1693,39 @@ class Service : public std::enable_shared_from_this<Service> {
       this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, ec, "set SNI Hostname", wsConnectionPtr->correlationIdList);
       return;
     }
+    this->connectWs(wsConnectionPtr, tcpResolverResults, 0);
+  }
+  // the resolved endpoints are tried one at a time rather than by a range connect, which reopens the socket for every endpoint, so that the socket tuning is
+  // applied between opening the socket and connecting it: the receive buffer size only takes effect on the TCP window scale when it is set before the SYN
+  void connectWs(std::shared_ptr<WsConnection> wsConnectionPtr, tcp::resolver::results_type tcpResolverResults, size_t tcpResolverResultsIndex) {
+    beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>& stream = *wsConnectionPtr->streamPtr;
+    auto it = tcpResolverResults.begin();
+    std::advance(it, tcpResolverResultsIndex);
+    tcp::endpoint endpoint = *it;
+    tcp::socket& socket = beast::get_lowest_layer(stream).socket();
+    ErrorCode ec;
+    socket.close(ec);
+    socket.open(endpoint.protocol(), ec);
+    if (ec) {
+      this->onConnectWsEndpoint(wsConnectionPtr, tcpResolverResults, tcpResolverResultsIndex, endpoint, ec);
+      return;
+    }
+    this->applySocketTuning(socket);
     CCAPI_LOGGER_TRACE("before async_connect");
-    beast::get_lowest_layer(stream).async_connect(tcpResolverResults, beast::bind_front_handler(&Service::onConnectWs, shared_from_this(), wsConnectionPtr));
+    beast::get_lowest_layer(stream).async_connect(endpoint, beast::bind_front_handler(&Service::onConnectWsEndpoint, shared_from_this(), wsConnectionPtr,
+                                                                                      tcpResolverResults, tcpResolverResultsIndex, endpoint));
     CCAPI_LOGGER_TRACE("after async_connect");
   }
+  void onConnectWsEndpoint(std::shared_ptr<WsConnection> wsConnectionPtr, tcp::resolver::results_type tcpResolverResults, size_t tcpResolverResultsIndex,
+                           tcp::endpoint endpoint, beast::error_code ec) {
+    // a timeout covers all of the endpoints, as it would for a range connect
+    if (ec && ec != net::error::operation_aborted && ec != beast::error::timeout && tcpResolverResultsIndex + 1 < tcpResolverResults.size()) {
+      CCAPI_LOGGER_DEBUG("connect to " + endpoint.address().to_string() + " failed: " + ec.message() + ", trying the next endpoint");
+      this->connectWs(wsConnectionPtr, tcpResolverResults, tcpResolverResultsIndex + 1);
+      return;
+    }
+    this->onConnectWs(wsConnectionPtr, ec, endpoint);
+  }
   void onConnectWs(std::shared_ptr<WsConnection> wsConnectionPtr, beast::error_code ec, tcp::resolver::results_type::endpoint_type ep) {
     CCAPI_LOGGER_TRACE("async_connect callback start");
     if (ec) {
@@ -1332,26 +1738,33 @@ class Service : public std::enable_shared_from_this<Service> {
     wsConnectionPtr->hostHttpHeaderValue =
         this->hostHttpHeaderValueIgnorePort ? wsConnectionPtr->host : wsConnectionPtr->host + ':' + std::to_string(ep.port());
     CCAPI_LOGGER_TRACE("wsConnectionPtr->hostHttpHeaderValue = " + wsConnectionPtr->hostHttpHeaderValue);
-    beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>& stream = *wsConnectionPtr->streamPtr;
+    beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>& stream = *wsConnectionPtr->streamPtr;
     beast::get_lowest_layer(stream).socket().set_option(tcp::no_delay(true));
     CCAPI_LOGGER_TRACE("before ssl async_handshake");
+    this->serviceContextPtr->tlsSessionCache.beforeHandshake(stream.next_layer().native_handle());
     stream.next_layer().async_handshake(ssl::stream_base::client, beast::bind_front_handler(&Service::onSslHandshakeWs, shared_from_this(), wsConnectionPtr));
     CCAPI_LOGGER_TRACE("after ssl async_handshake");
   }
   void onSslHandshakeWs(std::shared_ptr<WsConnection> wsConnectionPtr, beast::error_code ec) {
     CCAPI_LOGGER_TRACE("ssl async_handshake callback start");
+    this->serviceContextPtr->tlsSessionCache.afterHandshake(wsConnectionPtr->streamPtr->next_layer().native_handle(), !ec);
     if (ec) {
       CCAPI_LOGGER_TRACE("fail");
       this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, ec, "ssl handshake", wsConnectionPtr->correlationIdList);
       return;
     }
     CCAPI_LOGGER_TRACE("ssl handshaked");
-    beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>& stream = *wsConnectionPtr->streamPtr;
+    beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>& stream = *wsConnectionPtr->streamPtr;
     beast::get_lowest_layer(stream).expires_never();
     beast::websocket::stream_base::timeout opt{std::chrono::milliseconds(this->sessionOptions.websocketConnectTimeoutMilliseconds),
                                                std::chrono::milliseconds(this->sessionOptions.pongWebsocketProtocolLevelTimeoutMilliseconds), true};
 
     stream.set_option(opt);
+    if (this->sessionOptions.enableWebsocketPermessageDeflate) {
+      beast::websocket::permessage_deflate pmd;
+      pmd.client_enable = true;
+      stream.set_option(pmd);
+    }
     stream.set_option(beast::websocket::stream_base::decorator([wsConnectionPtr](beast::websocket::request_type& req) {
       req.set(http::field::user_agent, std::string(BOOST_BEAST_VERSION_STRING));
       for (const auto& kv : wsConnectionPtr->headers) {
@@ -1371,6 +1784,9 @@ class Service : public std::enable_shared_from_this<Service> {
       return;
     }
     CCAPI_LOGGER_TRACE("ws handshaked");
+    if (this->sessionOptions.enableKernelReceiveTimestamp && !beast::get_lowest_layer(*wsConnectionPtr->streamPtr).enableReceiveTimestamp()) {
+      CCAPI_LOGGER_WARN("kernel receive timestamps are unavailable for connection " + toString(*wsConnectionPtr));
+    }
     this->onOpen(wsConnectionPtr);
     this->wsConnectionByIdMap.insert(std::make_pair(wsConnectionPtr->id, wsConnectionPtr));
     CCAPI_LOGGER_TRACE("about to start read");
@@ -1383,8 +1799,7 @@ class Service : public std::enable_shared_from_this<Service> {
   void startReadWs(std::shared_ptr<WsConnection> wsConnectionPtr) {
     auto& stream = *wsConnectionPtr->streamPtr;
     CCAPI_LOGGER_TRACE("before async_read");
-    auto& connectionId = wsConnectionPtr->id;
-    auto& readMessageBuffer = this->readMessageBufferByConnectionIdMap[connectionId];
+    auto& readMessageBuffer = wsConnectionPtr->readMessageBuffer;
     stream.async_read(readMessageBuffer, beast::bind_front_handler(&Service::onReadWs, shared_from_this(), wsConnectionPtr));
     CCAPI_LOGGER_TRACE("after async_read");
   }
@@ -1404,8 +1819,7 @@ class Service : public std::enable_shared_from_this<Service> {
         message.setType(Message::Type::SESSION_CONNECTION_DOWN);
         message.setCorrelationIdList(wsConnectionPtr->correlationIdList);
         Element element(true);
-        auto& connectionId = wsConnectionPtr->id;
-        element.insert(CCAPI_CONNECTION_ID, connectionId);
+        element.insert(CCAPI_CONNECTION_ID, std::to_string(wsConnectionPtr->id));
         message.setElementList({element});
         event.setMessageList({message});
         this->eventHandler(event, nullptr);
@@ -1417,14 +1831,59 @@ class Service : public std::enable_shared_from_this<Service> {
       CCAPI_LOGGER_WARN("should not process remaining message on closing");
       return;
     }
-    auto& connectionId = wsConnectionPtr->id;
-    auto& readMessageBuffer = this->readMessageBufferByConnectionIdMap[connectionId];
-    this->onMessage(wsConnectionPtr, (const char*)readMessageBuffer.data().data(), readMessageBuffer.size());
+    auto& readMessageBuffer = wsConnectionPtr->readMessageBuffer;
+    if (this->latencyStatsPtr) {
+      this->readTsc = TscClock::now();
+    }
+    auto& lowestLayer = beast::get_lowest_layer(*wsConnectionPtr->streamPtr);
+    if (lowestLayer.isReceiveTimestampEnabled()) {
+      this->readKernelTp = lowestLayer.getReceiveTp();
+    }
+    if (this->websocketMessageReceivedCounterPtr) {
+      this->websocketMessageReceivedCounterPtr->increment();
+      this->websocketByteReceivedCounterPtr->increment(readMessageBuffer.size());
+    }
+    this->onMessage(wsConnectionPtr, wsConnectionPtr->padReadMessage(), readMessageBuffer.size());
+    this->readTsc = 0;
+    this->readKernelTp = TimePoint(std::chrono::seconds(0));
     readMessageBuffer.consume(readMessageBuffer.size());
     this->startReadWs(wsConnectionPtr);
     this->onPongByMethod(PingPongMethod::WEBSOCKET_PROTOCOL_LEVEL, wsConnectionPtr, now, false);
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
+#ifdef __linux__
+  void enterTcpQuickAck(WsConnection& wsConnection) {
+    ErrorCode ec;
+    beast::get_lowest_layer(*wsConnection.streamPtr).socket().set_option(net::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true), ec);
+    if (ec) {
+      CCAPI_LOGGER_WARN("tcp quick ack: " + ec.message());
+    }
+  }
+  // the kernel may leave quick ack mode at any time, so it is re-entered on every open socket periodically rather than on every read
+  void setTcpQuickAckTimer() {
+    if (!this->tcpQuickAckTimerPtr) {
+      this->tcpQuickAckTimerPtr = std::make_shared<net::steady_timer>(*this->serviceContextPtr->ioContextPtr);
+    }
+    this->tcpQuickAckTimerPtr->expires_after(std::chrono::milliseconds(this->sessionOptions.tcpQuickAckRearmIntervalMilliseconds));
+    this->tcpQuickAckTimerPtr->async_wait([that = shared_from_this()](ErrorCode const& ec) {
+      if (ec) {
+        if (ec != net::error::operation_aborted) {
+          CCAPI_LOGGER_ERROR("tcp quick ack timer error: " + ec.message());
+          that->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::GENERIC_ERROR, ec, "timer");
+        }
+        return;
+      }
+      for (const auto& x : that->wsConnectionByIdMap) {
+        if (x.second->status == WsConnection::Status::OPEN) {
+          that->enterTcpQuickAck(*x.second);
+        }
+      }
+      if (that->shouldContinue) {
+        that->setTcpQuickAckTimer();
+      }
+    });
+  }
+#endif
   virtual void onOpen(std::shared_ptr<WsConnection> wsConnectionPtr) {
     CCAPI_LOGGER_FUNCTION_ENTER;
     auto now = UtilTime::now();
@@ -1442,11 +1901,19 @@ class Service : public std::enable_shared_from_this<Service> {
     CCAPI_LOGGER_DEBUG("correlationIdList = " + toString(correlationIdList));
     message.setCorrelationIdList(correlationIdList);
     Element element;
-    element.insert(CCAPI_CONNECTION_ID, wsConnection.id);
+    element.insert(CCAPI_CONNECTION_ID, std::to_string(wsConnection.id));
     element.insert(CCAPI_CONNECTION_URL, wsConnection.getUrl());
     message.setElementList({element});
     event.setMessageList({message});
     this->eventHandler(event, nullptr);
+#ifdef __linux__
+    if (this->sessionOptions.enableTcpQuickAck) {
+      this->enterTcpQuickAck(wsConnection);
+      if (this->sessionOptions.tcpQuickAckRearmIntervalMilliseconds > 0 && !this->tcpQuickAckTimerPtr) {
+        this->setTcpQuickAckTimer();
+      }
+    }
+#endif
     if (this->enableCheckPingPongWebsocketProtocolLevel) {
       this->setPingPongTimer(PingPongMethod::WEBSOCKET_PROTOCOL_LEVEL, wsConnectionPtr,
                              [wsConnectionPtr, that = shared_from_this()](ErrorCode& ec) { that->ping(wsConnectionPtr, "", ec); });
@@ -1469,7 +1936,7 @@ class Service : public std::enable_shared_from_this<Service> {
     memcpy(writeMessageBuffer.data() + n, data, dataSize);
     writeMessageBufferBoundary.push_back(dataSize);
     n += dataSize;
-    CCAPI_LOGGER_TRACE("connectionId = " + connectionId);
+    CCAPI_LOGGER_TRACE("connectionId = " + toString(connectionId));
     CCAPI_LOGGER_DEBUG("about to send " + std::string(data, dataSize));
     CCAPI_LOGGER_TRACE("writeMessageBufferWrittenLength = " + toString(writeMessageBufferWrittenLength));
     if (writeMessageBufferWrittenLength == 0) {
@@ -1530,6 +1997,9 @@ class Service : public std::enable_shared_from_this<Service> {
             auto thatWsConnectionPtr = that->createWsConnectionPtr(wsConnectionPtr);
             that->prepareConnect(thatWsConnectionPtr);
             that->connectNumRetryOnFailByConnectionUrlMap[urlBase] += 1;
+            if (that->websocketReconnectCounterPtr) {
+              that->websocketReconnectCounterPtr->increment();
+            }
           } catch (const beast::error_code& ec) {
             CCAPI_LOGGER_TRACE("fail");
             that->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::SUBSCRIPTION_FAILURE, ec, "create stream", wsConnectionPtr->correlationIdList);
@@ -1542,7 +2012,7 @@ class Service : public std::enable_shared_from_this<Service> {
   }
   std::shared_ptr<WsConnection> createWsConnectionPtr(std::shared_ptr<WsConnection> wsConnectionPtr) {
     std::shared_ptr<WsConnection> thatWsConnectionPtr = wsConnectionPtr;
-    std::shared_ptr<beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>>> streamPtr(nullptr);
+    std::shared_ptr<beast::websocket::stream<beast::ssl_stream<TimestampingTcpStream>>> streamPtr(nullptr);
     try {
       streamPtr = this->createWsStream(this->serviceContextPtr->ioContextPtr, this->serviceContextPtr->sslContextPtr);
     } catch (const beast::error_code& ec) {
@@ -1581,7 +2051,7 @@ class Service : public std::enable_shared_from_this<Service> {
       this->connectRetryOnFailTimerByConnectionIdMap.at(wsConnection.id)->cancel();
       this->connectRetryOnFailTimerByConnectionIdMap.erase(wsConnection.id);
     }
-    this->readMessageBufferByConnectionIdMap.erase(wsConnection.id);
+    wsConnection.readMessageBuffer.clear();
     this->writeMessageBufferByConnectionIdMap.erase(wsConnection.id);
     this->writeMessageBufferWrittenLengthByConnectionIdMap.erase(wsConnection.id);
   }
@@ -1602,7 +2072,7 @@ class Service : public std::enable_shared_from_this<Service> {
     message.setTimeReceived(now);
     message.setType(Message::Type::SESSION_CONNECTION_DOWN);
     Element element;
-    element.insert(CCAPI_CONNECTION_ID, wsConnection.id);
+    element.insert(CCAPI_CONNECTION_ID, std::to_string(wsConnection.id));
     element.insert(CCAPI_CONNECTION_URL, wsConnection.getUrl());
     element.insert(CCAPI_REASON, reason);
     message.setElementList({element});
@@ -1620,10 +2090,15 @@ class Service : public std::enable_shared_from_this<Service> {
     this->wsConnectionByIdMap.erase(wsConnectionPtr->id);
     if (this->shouldContinue.load()) {
       this->prepareConnect(thisWsConnectionPtr);
+      if (this->websocketReconnectCounterPtr) {
+        this->websocketReconnectCounterPtr->increment();
+      }
     }
     CCAPI_LOGGER_FUNCTION_EXIT;
   }
-  void onMessage(std::shared_ptr<WsConnection> wsConnectionPtr, const char* data, size_t dataSize) {
+  // data is the connection's read buffer itself, see WsConnection::padReadMessage; text messages are handed on as views of it, so no copy of the payload is
+  // made between the socket and the parser
+  void onMessage(std::shared_ptr<WsConnection> wsConnectionPtr, char* data, size_t dataSize) {
     auto now = UtilTime::now();
     WsConnection& wsConnection = *wsConnectionPtr;
     CCAPI_LOGGER_DEBUG("received a message from connection " + toString(wsConnection));
@@ -1648,14 +2123,24 @@ class Service : public std::enable_shared_from_this<Service> {
     defined(CCAPI_ENABLE_SERVICE_EXECUTION_MANAGEMENT) &&                                                                                             \
         (defined(CCAPI_ENABLE_EXCHANGE_HUOBI_USDT_SWAP) || defined(CCAPI_ENABLE_EXCHANGE_HUOBI_COIN_SWAP) || defined(CCAPI_ENABLE_EXCHANGE_BITMART))
       if (this->needDecompressWebsocketMessage) {
-        std::string decompressed;
+        auto& inflaterPtr = wsConnectionPtr->inflaterPtr;
+        if (!inflaterPtr) {
+          inflaterPtr = std::make_shared<InflateStream>();
+          inflaterPtr->setWindowBitsOverride(this->inflater.getWindowBitsOverride());
+          ErrorCode ec = inflaterPtr->init();
+          if (ec) {
+            CCAPI_LOGGER_FATAL(ec.message());
+          }
+        }
+        boost::beast::string_view decompressed;
         boost::beast::string_view payload(data, dataSize);
         try {
-          ErrorCode ec = this->inflater.decompress(reinterpret_cast<const uint8_t*>(&payload[0]), payload.size(), decompressed);
+          ErrorCode ec = inflaterPtr->decompress(reinterpret_cast<const uint8_t*>(&payload[0]), payload.size(), decompressed);
           if (ec) {
             CCAPI_LOGGER_FATAL(ec.message());
           }
-          CCAPI_LOGGER_DEBUG("decompressed = " + decompressed);
+          CCAPI_LOGGER_DEBUG("decompressed = " + std::string(decompressed));
+          this->recordLatency(LatencyStats::Stage::DECOMPRESS);
           this->onTextMessage(wsConnectionPtr, decompressed, now);
         } catch (const std::exception& e) {
           std::stringstream ss;
@@ -1666,7 +2151,7 @@ class Service : public std::enable_shared_from_this<Service> {
           CCAPI_LOGGER_ERROR("binaryMessage = " + ss.str());
           this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::GENERIC_ERROR, e);
         }
-        ErrorCode ec = this->inflater.inflate_reset();
+        ErrorCode ec = inflaterPtr->inflate_reset();
         if (ec) {
           this->onError(Event::Type::SUBSCRIPTION_STATUS, Message::Type::GENERIC_ERROR, ec, "decompress");
         }
@@ -1821,32 +2306,47 @@ class Service : public std::enable_shared_from_this<Service> {
   std::map<std::string, std::map<std::string, std::deque<std::shared_ptr<HttpConnection>>>> httpConnectionPool;
   std::map<std::string, std::string> credentialDefault;
   std::map<std::string, TimerPtr> sendRequestDelayTimerByCorrelationIdMap;
+  std::shared_ptr<RequestRateLimiter> rateLimiterPtr{std::make_shared<RequestRateLimiter>()};
+  std::map<std::string, std::string> rateLimitUsedHeaderNameByBucketNameMap;
+  TimerPtr rateLimiterTimerPtr;
+  TimerPtr tcpQuickAckTimerPtr;
+  std::map<Request::Operation, std::deque<TimePoint::duration>> hedgedRequestLatencyListByOperationMap;
 #ifdef CCAPI_LEGACY_USE_WEBSOCKETPP
-  std::map<std::string, WsConnection> wsConnectionByIdMap;
+  std::map<uint64_t, WsConnection> wsConnectionByIdMap;
 #else
-  std::map<std::string, std::shared_ptr<WsConnection>> wsConnectionByIdMap;  // TODO(cryptochassis): for consistency, to be renamed to wsConnectionPtrByIdMap
-  std::map<std::string, beast::flat_buffer> readMessageBufferByConnectionIdMap;
-  std::map<std::string, std::array<char, CCAPI_WEBSOCKET_WRITE_BUFFER_SIZE>> writeMessageBufferByConnectionIdMap;
-  std::map<std::string, size_t> writeMessageBufferWrittenLengthByConnectionIdMap;
-  std::map<std::string, std::vector<size_t>> writeMessageBufferBoundaryByConnectionIdMap;
+  std::map<uint64_t, std::shared_ptr<WsConnection>> wsConnectionByIdMap;  // TODO(cryptochassis): for consistency, to be renamed to wsConnectionPtrByIdMap
+  std::map<uint64_t, std::array<char, CCAPI_WEBSOCKET_WRITE_BUFFER_SIZE>> writeMessageBufferByConnectionIdMap;
+  std::map<uint64_t, size_t> writeMessageBufferWrittenLengthByConnectionIdMap;
+  std::map<uint64_t, std::vector<size_t>> writeMessageBufferBoundaryByConnectionIdMap;
 #endif
-  std::map<std::string, bool> wsConnectionPendingPingingByConnectionIdMap;
-  std::map<std::string, bool> shouldProcessRemainingMessageOnClosingByConnectionIdMap;
+  std::map<uint64_t, bool> wsConnectionPendingPingingByConnectionIdMap;
+  std::map<uint64_t, bool> shouldProcessRemainingMessageOnClosingByConnectionIdMap;
   std::map<std::string, int> connectNumRetryOnFailByConnectionUrlMap;
-  std::map<std::string, TimerPtr> connectRetryOnFailTimerByConnectionIdMap;
-  std::map<std::string, std::map<PingPongMethod, TimePoint>> lastPongTpByMethodByConnectionIdMap;
-  std::map<std::string, std::map<PingPongMethod, TimerPtr>> pingTimerByMethodByConnectionIdMap;
-  std::map<std::string, std::map<PingPongMethod, TimerPtr>> pongTimeOutTimerByMethodByConnectionIdMap;
+  std::map<uint64_t, TimerPtr> connectRetryOnFailTimerByConnectionIdMap;
+  std::map<uint64_t, std::map<PingPongMethod, TimePoint>> lastPongTpByMethodByConnectionIdMap;
+  std::map<uint64_t, std::map<PingPongMethod, TimerPtr>> pingTimerByMethodByConnectionIdMap;
+  std::map<uint64_t, std::map<PingPongMethod, TimerPtr>> pongTimeOutTimerByMethodByConnectionIdMap;
   std::map<PingPongMethod, long> pingIntervalMillisecondsByMethodMap;
   std::map<PingPongMethod, long> pongTimeoutMillisecondsByMethodMap;
   std::atomic<bool> shouldContinue{true};
-  std::map<std::string, std::map<std::string, std::string>> extraPropertyByConnectionIdMap;
+  std::map<uint64_t, std::map<std::string, std::string>> extraPropertyByConnectionIdMap;
   bool enableCheckPingPongWebsocketProtocolLevel{};
   bool enableCheckPingPongWebsocketApplicationLevel{};
   std::map<Request::Operation, Message::Type> requestOperationToMessageTypeMap;
   // std::regex convertNumberToStringInJsonRegex{"(\\[|,|\":)\\s?(-?\\d+\\.?\\d*)"};
   // std::string convertNumberToStringInJsonRewrite{"$1\"$2\""};
   bool needDecompressWebsocketMessage{};
+  std::shared_ptr<LatencyStats> latencyStatsPtr;
+  uint64_t readTsc{};
+  TimePoint readKernelTp{std::chrono::seconds(0)};
+  std::string serviceName;
+  std::shared_ptr<MetricsRegistry> metricsRegistryPtr;
+  MetricCounter* websocketMessageReceivedCounterPtr{};
+  MetricCounter* websocketByteReceivedCounterPtr{};
+  MetricCounter* websocketReconnectCounterPtr{};
+  MetricCounter* httpConnectionPoolHitCounterPtr{};
+  MetricCounter* httpConnectionPoolMissCounterPtr{};
+  std::map<Request::Operation, LatencyHistogram*> httpRequestLatencyHistogramByOperationMap;
 #if defined(CCAPI_ENABLE_SERVICE_MARKET_DATA) &&                                                                                                      \
         (defined(CCAPI_ENABLE_EXCHANGE_HUOBI) || defined(CCAPI_ENABLE_EXCHANGE_HUOBI_USDT_SWAP) || defined(CCAPI_ENABLE_EXCHANGE_HUOBI_COIN_SWAP)) || \
     defined(CCAPI_ENABLE_SERVICE_EXECUTION_MANAGEMENT) &&                                                                                             \
@@ -1855,7 +2355,7 @@ class Service : public std::enable_shared_from_this<Service> {
   struct monostate {};
   websocketpp::extensions_workaround::permessage_deflate::enabled<monostate> inflater;
 #else
-  InflateStream inflater;
+  InflateStream inflater;  // only holds the configuration: every connection inflates with its own copy
 #endif
 #endif
 };
@@ -69,10 +69,19 @@ class ServiceContext CCAPI_FINAL {
 
 } /* namespace ccapi */
 #else
+#include "ccapi_cpp/ccapi_macro.h"
+#include "boost/asio/executor_work_guard.hpp"
+#include "boost/asio/io_context.hpp"
+#include "boost/asio/ssl.hpp"
 #include "ccapi_cpp/ccapi_logger.h"
+#include "ccapi_cpp/ccapi_tls_session_cache.h"
+#if defined(CCAPI_USE_IO_URING) && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+#error "CCAPI_USE_IO_URING needs boost 1.78 or later and must be defined before any boost asio header is included"
+#endif
 namespace ccapi {
 /**
- * Defines the service that the service depends on.
+ * Defines the service that the service depends on. With macro CCAPI_USE_IO_URING (Linux 5.10 or later, link with liburing) the io_context runs every socket
+ * on io_uring instead of epoll; asio chooses its backend at compile time, so the whole program uses the same one.
  */
 class ServiceContext CCAPI_FINAL {
  public:
@@ -118,8 +127,23 @@ class ServiceContext CCAPI_FINAL {
     delete this->ioContextPtr;
     delete this->sslContextPtr;
   }
+  static std::string getIoBackendName() {
+#ifdef BOOST_ASIO_HAS_IO_URING_AS_DEFAULT
+    return "io_uring";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+    return "epoll";
+#else
+    return "default";
+#endif
+  }
+  // lets the connections made with sslContextPtr resume the TLS sessions of earlier connections to the same host
+  void enableTlsSessionResumption() {
+    if (!this->tlsSessionCache.isEnabled()) {
+      this->tlsSessionCache.attach(this->sslContextPtr->native_handle());
+    }
+  }
   void start() {
-    CCAPI_LOGGER_INFO("about to start client asio io_context run loop");
+    CCAPI_LOGGER_INFO("about to start client asio io_context run loop using " + getIoBackendName());
     this->ioContextPtr->run();
     CCAPI_LOGGER_INFO("just exited client asio io_context run loop");
   }
@@ -130,6 +154,7 @@ class ServiceContext CCAPI_FINAL {
   IoContextPtr ioContextPtr{nullptr};
   ExecutorWorkGuardPtr executorWorkGuardPtr{nullptr};
   SslContextPtr sslContextPtr{nullptr};
+  TlsSessionCache tlsSessionCache;
   // IoContextPtr ioContextPtr{new IoContext()};
   // ExecutorWorkGuardPtr executorWorkGuardPtr{new ExecutorWorkGuard(ioContextPtr->get_executor())};
   // SslContextPtr sslContextPtr{new SslContext(SslContext::tls_client)};
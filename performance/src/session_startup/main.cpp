@@ -0,0 +1,45 @@
+// Measures how long a Session with every exchange of the market data and execution management services compiled in takes to start, with eager and with
+// lazy service construction, and how long the first use of one exchange then takes. Nothing is sent over the network. The exchange that is used first can be
+// chosen with the EXCHANGE environment variable.
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "ccapi_cpp/ccapi_session.h"
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // This line is needed.
+} /* namespace ccapi */
+using ::ccapi::Session;
+using ::ccapi::SessionConfigs;
+using ::ccapi::SessionOptions;
+using ::ccapi::UtilSystem;
+void measure(bool enableLazyServiceConstruction, int numIteration, const std::string& exchange) {
+  double startSeconds = 0, firstUseSeconds = 0;
+  size_t numService = 0;
+  for (int i = 0; i < numIteration; ++i) {
+    SessionOptions sessionOptions;
+    sessionOptions.enableLazyServiceConstruction = enableLazyServiceConstruction;
+    SessionConfigs sessionConfigs;
+    auto start = std::chrono::steady_clock::now();
+    Session session(sessionOptions, sessionConfigs);
+    auto started = std::chrono::steady_clock::now();
+    numService = session.getServiceList().size();
+    session.getService(CCAPI_MARKET_DATA, exchange);
+    auto used = std::chrono::steady_clock::now();
+    startSeconds += std::chrono::duration<double>(started - start).count();
+    firstUseSeconds += std::chrono::duration<double>(used - started).count();
+    session.stop();
+  }
+  std::cout << (enableLazyServiceConstruction ? "lazy " : "eager") << " service construction: " << numService << " services constructed at startup, startup "
+            << std::fixed << std::setprecision(3) << startSeconds / numIteration * 1e3 << " milliseconds, first use of " << exchange << " "
+            << firstUseSeconds / numIteration * 1e3 << " milliseconds" << std::endl;
+}
+int main(int argc, char** argv) {
+  const int numIteration = UtilSystem::getEnvAsInt("NUM_ITERATIONS", 20);
+  const std::string exchange = UtilSystem::getEnvAsString("EXCHANGE", CCAPI_EXCHANGE_NAME_BINANCE);
+  measure(false, numIteration, exchange);
+  measure(true, numIteration, exchange);
+  return EXIT_SUCCESS;
+}
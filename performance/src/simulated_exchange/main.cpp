@@ -0,0 +1,172 @@
+// Measures how many market data events per second SimulatedExchange replays, with NUM_OPEN_ORDER orders resting on each side and one order created and one
+// cancelled every ORDER_INTERVAL events. A synthetic stream of events (order book snapshots of 10 levels and trades, around a random walk) is generated up
+// front, both as pre-parsed ticks and as the messages of a subscription, so that only the replay itself is timed; NUM_EVENT events are replayed by cycling
+// through the first 65536 of them, which keeps the messages in memory small.
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "app/simulated_exchange.h"
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // This line is needed.
+} /* namespace ccapi */
+using ::ccapi::Element;
+using ::ccapi::Event;
+using ::ccapi::FixedPoint;
+using ::ccapi::Message;
+using ::ccapi::Request;
+using ::ccapi::SimulatedExchange;
+using ::ccapi::TimePoint;
+using ::ccapi::UtilSystem;
+using ::ccapi::UtilTime;
+struct MarketDataEvent {
+  TimePoint tp;
+  bool isTrade{};
+  std::vector<std::pair<int64_t, int64_t> > bidList, askList;
+  int64_t priceTick{}, size{};
+  bool isBuyerMaker{};
+};
+std::string toPrice(int64_t priceTick) { return FixedPoint::toString(priceTick, 2); }
+std::string toQuantity(int64_t size) { return FixedPoint::toString(size, 3); }
+Message toMessage(const MarketDataEvent& event) {
+  Message message;
+  message.setTime(event.tp);
+  message.setRecapType(Message::RecapType::NONE);
+  std::vector<Element> elementList;
+  if (event.isTrade) {
+    message.setType(Message::Type::MARKET_DATA_EVENTS_TRADE);
+    Element element;
+    element.insert(CCAPI_LAST_PRICE, toPrice(event.priceTick));
+    element.insert(CCAPI_LAST_SIZE, toQuantity(event.size));
+    element.insert(CCAPI_IS_BUYER_MAKER, event.isBuyerMaker ? "1" : "0");
+    elementList.push_back(element);
+  } else {
+    message.setType(Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+    for (const auto& level : event.bidList) {
+      Element element;
+      element.insert(CCAPI_BEST_BID_N_PRICE, toPrice(level.first));
+      element.insert(CCAPI_BEST_BID_N_SIZE, toQuantity(level.second));
+      elementList.push_back(element);
+    }
+    for (const auto& level : event.askList) {
+      Element element;
+      element.insert(CCAPI_BEST_ASK_N_PRICE, toPrice(level.first));
+      element.insert(CCAPI_BEST_ASK_N_SIZE, toQuantity(level.second));
+      elementList.push_back(element);
+    }
+  }
+  message.setElementList(elementList);
+  return message;
+}
+Request createOrder(bool isBuy, int64_t priceTick, const TimePoint& tp, const std::string& clientOrderId) {
+  Request request(Request::Operation::CREATE_ORDER, "binance", "BTCUSDT");
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, isBuy ? CCAPI_EM_ORDER_SIDE_BUY : CCAPI_EM_ORDER_SIDE_SELL},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, toPrice(priceTick)},
+      {CCAPI_EM_ORDER_QUANTITY, "0.010"},
+      {CCAPI_EM_CLIENT_ORDER_ID, clientOrderId},
+  });
+  request.setTimeSent(tp);
+  return request;
+}
+Request cancelOrder(const std::string& clientOrderId, const TimePoint& tp) {
+  Request request(Request::Operation::CANCEL_ORDER, "binance", "BTCUSDT");
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, clientOrderId}});
+  request.setTimeSent(tp);
+  return request;
+}
+// feedEvent replays an event, the i-th of the replay
+template <typename F>
+void run(const std::string& name, const std::vector<MarketDataEvent>& eventList, int numEvent, int numOpenOrder, int orderInterval, F feedEvent) {
+  SimulatedExchange exchange("0.01", "0.001", "BTC", "USDT");
+  std::vector<Event> outputEventList;
+  int clientOrderIndex = 0;
+  int64_t midPriceTick = eventList.front().bidList.front().first;
+  // orders rest below the bids and above the asks, so that most of them stay in the book
+  for (int i = 0; i < numOpenOrder; ++i) {
+    exchange.sendRequest(createOrder(true, midPriceTick - 20 - i, eventList.front().tp, std::to_string(clientOrderIndex++)), outputEventList);
+    exchange.sendRequest(createOrder(false, midPriceTick + 20 + i, eventList.front().tp, std::to_string(clientOrderIndex++)), outputEventList);
+  }
+  size_t numOutputEvent = 0;
+  int oldestClientOrderIndex = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numEvent; ++i) {
+    const auto& event = eventList[i % eventList.size()];
+    feedEvent(exchange, event, i, outputEventList);
+    if (orderInterval > 0 && i % orderInterval == 0) {
+      int64_t priceTick = event.isTrade ? event.priceTick : event.bidList.front().first;
+      bool isBuy = i / orderInterval % 2 == 0;
+      exchange.sendRequest(createOrder(isBuy, isBuy ? priceTick - 20 : priceTick + 20, event.tp, std::to_string(clientOrderIndex++)), outputEventList);
+      exchange.sendRequest(cancelOrder(std::to_string(oldestClientOrderIndex++), event.tp), outputEventList);
+    }
+    numOutputEvent += outputEventList.size();
+    outputEventList.clear();
+  }
+  auto end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << std::left << std::setw(40) << name << std::right << std::setw(14) << std::fixed << std::setprecision(0) << numEvent / seconds
+            << " events/s (" << numOutputEvent << " events emitted, " << exchange.getNumOpenOrder() << " orders open)" << std::endl;
+}
+int main(int argc, char** argv) {
+  int numEvent = UtilSystem::getEnvAsInt("NUM_EVENT", 1000000);
+  int numOpenOrder = UtilSystem::getEnvAsInt("NUM_OPEN_ORDER", 100);
+  int orderInterval = UtilSystem::getEnvAsInt("ORDER_INTERVAL", 100);
+  std::mt19937 randomEngine(20230601);
+  std::uniform_int_distribution<int> stepDistribution(-1, 1);
+  std::uniform_int_distribution<int64_t> sizeDistribution(1, 5000);
+  std::uniform_int_distribution<int> kindDistribution(0, 3);
+  std::vector<MarketDataEvent> eventList(std::min(numEvent, 65536));
+  TimePoint tp = UtilTime::parse("2023-06-01T12:00:00.000000000Z");
+  int64_t bestBidPriceTick = 2700000;
+  for (auto& event : eventList) {
+    tp += std::chrono::microseconds(100);
+    event.tp = tp;
+    bestBidPriceTick += stepDistribution(randomEngine);
+    // one in four events is a trade at the touch
+    event.isTrade = kindDistribution(randomEngine) == 0;
+    if (event.isTrade) {
+      event.isBuyerMaker = stepDistribution(randomEngine) < 0;
+      event.priceTick = event.isBuyerMaker ? bestBidPriceTick : bestBidPriceTick + 1;
+      event.size = sizeDistribution(randomEngine);
+    } else {
+      for (int i = 0; i < 10; ++i) {
+        event.bidList.emplace_back(bestBidPriceTick - i, sizeDistribution(randomEngine));
+        event.askList.emplace_back(bestBidPriceTick + 1 + i, sizeDistribution(randomEngine));
+      }
+    }
+  }
+  // the first event must be a snapshot, so that the initial orders are placed around it
+  if (eventList.front().isTrade) {
+    eventList.front().isTrade = false;
+    eventList.front().bidList = {{bestBidPriceTick, 1000}};
+    eventList.front().askList = {{bestBidPriceTick + 1, 1000}};
+  }
+  std::vector<Message> messageList;
+  messageList.reserve(eventList.size());
+  for (const auto& event : eventList) {
+    messageList.push_back(toMessage(event));
+  }
+  std::cout << "NUM_EVENT = " << numEvent << ", NUM_OPEN_ORDER = " << numOpenOrder << ", ORDER_INTERVAL = " << orderInterval << std::endl;
+  // the time keeps advancing across the cycles of the pre-parsed events
+  auto startTp = eventList.front().tp;
+  run("onMarketDepth/onTrade", eventList, numEvent, numOpenOrder, orderInterval,
+      [&](SimulatedExchange& exchange, const MarketDataEvent& event, int i, std::vector<Event>& outputEventList) {
+        auto eventTp = startTp + std::chrono::microseconds(100) * i;
+        if (event.isTrade) {
+          exchange.onTrade(eventTp, event.priceTick, event.size, event.isBuyerMaker, outputEventList);
+        } else {
+          exchange.onMarketDepth(eventTp, event.bidList, event.askList, outputEventList);
+        }
+      });
+  run("processMarketDataMessage", eventList, numEvent, numOpenOrder, orderInterval,
+      [&](SimulatedExchange& exchange, const MarketDataEvent& event, int i, std::vector<Event>& outputEventList) {
+        exchange.processMarketDataMessage(messageList[i % messageList.size()], outputEventList);
+      });
+  return EXIT_SUCCESS;
+}
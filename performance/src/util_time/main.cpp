@@ -0,0 +1,103 @@
+#include "ccapi_cpp/ccapi_util_private.h"
+namespace ccapi {
+// The implementations that UtilTime used before its fixed-width kernels, kept here as the baseline.
+class LegacyUtilTime CCAPI_FINAL {
+ public:
+  static TimePoint parse(const std::string& input) {
+    std::tm time{};
+    time.tm_year = std::strtol(&input[0], nullptr, 10) - 1900;
+    time.tm_mon = std::strtol(&input[5], nullptr, 10) - 1;
+    time.tm_mday = std::strtol(&input[8], nullptr, 10);
+    if (input.length() > 10) {
+      time.tm_hour = std::strtol(&input[11], nullptr, 10);
+      time.tm_min = std::strtol(&input[14], nullptr, 10);
+      time.tm_sec = std::strtol(&input[17], nullptr, 10);
+    }
+    time.tm_isdst = 0;
+    long nanoseconds = 0;
+    if (input.length() > 20) {
+      std::string trail = input.substr(20);
+      if (trail.back() == 'Z') {
+        trail.pop_back();
+      }
+      if (!trail.empty()) {
+        nanoseconds = std::stoll(UtilString::rightPadTo(trail, 9, '0'));
+      }
+    }
+    return TimePoint(std::chrono::system_clock::from_time_t(timegm(&time))) + std::chrono::nanoseconds(nanoseconds);
+  }
+  static std::pair<long long, long long> divideMilli(const std::string& milliseconds) {
+    if (milliseconds.find('.') != std::string::npos) {
+      std::string millisecondsCopy = milliseconds;
+      UtilString::rtrimInPlace(millisecondsCopy, '0');
+      UtilString::rtrimInPlace(millisecondsCopy, '.');
+      auto found = millisecondsCopy.find('.');
+      return std::make_pair(std::stoll(millisecondsCopy.substr(0, found)),
+                            found != std::string::npos ? std::stoll(UtilString::rightPadTo(millisecondsCopy.substr(found + 1), 6, '0')) : 0);
+    } else {
+      return std::make_pair(std::stoll(milliseconds), 0);
+    }
+  }
+  static std::string padded(int value, size_t width) {
+    auto str = std::to_string(value);
+    return std::string(width - str.length(), '0') + str;
+  }
+  static std::string getISOTimestamp(const TimePoint& tp) {
+    int year, month, day, hour, minute, second, fractionalSecond;
+    UtilTime::timePointToParts<std::chrono::nanoseconds>(tp, year, month, day, hour, minute, second, fractionalSecond);
+    return std::to_string(year) + "-" + padded(month, 2) + "-" + padded(day, 2) + "T" + padded(hour, 2) + ":" + padded(minute, 2) + ":" + padded(second, 2) +
+           "." + padded(fractionalSecond, 9) + "Z";
+  }
+  static std::string convertTimePointToFIXTime(const TimePoint& tp) {
+    int year, month, day, hour, minute, second, millisecond;
+    UtilTime::timePointToParts(tp, year, month, day, hour, minute, second, millisecond);
+    return std::to_string(year) + padded(month, 2) + padded(day, 2) + "-" + padded(hour, 2) + ":" + padded(minute, 2) + ":" + padded(second, 2) + "." +
+           padded(millisecond, 3);
+  }
+};
+} /* namespace ccapi */
+using ::ccapi::LegacyUtilTime;
+using ::ccapi::TimePoint;
+using ::ccapi::UtilSystem;
+using ::ccapi::UtilTime;
+template <typename F>
+void run(const std::string& name, int numIteration, F f) {
+  long long sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numIteration; ++i) {
+    sink += f(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double nanosecondsPerOperation = std::chrono::duration<double, std::nano>(end - start).count() / numIteration;
+  std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << std::fixed << std::setprecision(1) << nanosecondsPerOperation
+            << " ns/op (checksum " << sink << ")" << std::endl;
+}
+int main(int argc, char** argv) {
+  int numIteration = UtilSystem::getEnvAsInt("NUM_ITERATION", 1000000);
+  // timestamps in a market data stream are mostly within the same day and strictly increasing
+  std::vector<std::string> isoTimestampList;
+  std::vector<std::string> epochMillisecondsList;
+  std::vector<TimePoint> timePointList;
+  TimePoint tp = UtilTime::parse("2023-06-01T12:00:00.000000000Z");
+  for (int i = 0; i < 1024; ++i) {
+    tp += std::chrono::microseconds(1234567);
+    timePointList.push_back(tp);
+    isoTimestampList.push_back(UtilTime::getISOTimestamp(tp));
+    epochMillisecondsList.push_back(std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count() / 1000) + "." +
+                                    std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count() % 1000));
+  }
+  auto mask = isoTimestampList.size() - 1;
+  run("LegacyUtilTime::parse", numIteration, [&](int i) { return LegacyUtilTime::parse(isoTimestampList[i & mask]).time_since_epoch().count(); });
+  run("UtilTime::parse", numIteration, [&](int i) { return UtilTime::parse(isoTimestampList[i & mask]).time_since_epoch().count(); });
+  run("LegacyUtilTime::divideMilli", numIteration, [&](int i) { return LegacyUtilTime::divideMilli(epochMillisecondsList[i & mask]).second; });
+  run("UtilTime::divideMilli", numIteration, [&](int i) { return UtilTime::divideMilli(epochMillisecondsList[i & mask]).second; });
+  run("LegacyUtilTime::getISOTimestamp", numIteration, [&](int i) { return LegacyUtilTime::getISOTimestamp(timePointList[i & mask]).size(); });
+  run("UtilTime::getISOTimestamp", numIteration, [&](int i) { return UtilTime::getISOTimestamp(timePointList[i & mask]).size(); });
+  char buffer[30];
+  run("UtilTime::writeISOTimestamp", numIteration, [&](int i) { return UtilTime::writeISOTimestamp(timePointList[i & mask], buffer) + buffer[25]; });
+  run("LegacyUtilTime::convertTimePointToFIXTime", numIteration,
+      [&](int i) { return LegacyUtilTime::convertTimePointToFIXTime(timePointList[i & mask]).size(); });
+  run("UtilTime::convertTimePointToFIXTime", numIteration, [&](int i) { return UtilTime::convertTimePointToFIXTime(timePointList[i & mask]).size(); });
+  run("UtilTime::writeFIXTime", numIteration, [&](int i) { return UtilTime::writeFIXTime(timePointList[i & mask], buffer) + buffer[20]; });
+  return EXIT_SUCCESS;
+}
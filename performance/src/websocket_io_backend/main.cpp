@@ -0,0 +1,171 @@
+// Measures the cost of the io_context backend on the websocket read path: a mock exchange server streams depth-like JSON messages over a number of local
+// websocket connections and the client, which runs on its own io_context like a Session does, records the latency of every message. Build it once with the
+// default epoll reactor (websocket_io_backend_epoll) and once with CCAPI_USE_IO_URING (websocket_io_backend_io_uring) and compare. To count syscalls per
+// message, run it under e.g. `perf stat -e raw_syscalls:sys_enter -t <client thread id>` or `strace -c -f` and divide by the number of messages it prints.
+#include <sys/resource.h>
+
+#include <atomic>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_latency_stats.h"
+#include "ccapi_cpp/service/ccapi_service_context.h"
+namespace ccapi {
+Logger* Logger::logger = nullptr;  // This line is needed.
+namespace net = boost::asio;
+namespace beast = boost::beast;
+using tcp = net::ip::tcp;
+typedef beast::websocket::stream<beast::tcp_stream> WsStream;
+inline uint64_t nowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+// Sends numMessage messages on each accepted connection, one every intervalMicroseconds (0 means as fast as possible), each carrying its send time.
+class MockExchangeServer : public std::enable_shared_from_this<MockExchangeServer> {
+ public:
+  MockExchangeServer(net::io_context& ioContext, int numMessage, int intervalMicroseconds)
+      : ioContext(ioContext), acceptor(ioContext, tcp::endpoint(net::ip::make_address("127.0.0.1"), 0)), numMessage(numMessage),
+        intervalMicroseconds(intervalMicroseconds) {}
+  unsigned short getPort() const { return this->acceptor.local_endpoint().port(); }
+  void startAccept() {
+    this->acceptor.async_accept([that = shared_from_this()](beast::error_code ec, tcp::socket socket) {
+      if (ec) {
+        return;
+      }
+      auto wsStreamPtr = std::make_shared<WsStream>(std::move(socket));
+      wsStreamPtr->async_accept([that, wsStreamPtr](beast::error_code ec) {
+        if (!ec) {
+          auto timerPtr = std::make_shared<net::steady_timer>(that->ioContext);
+          that->send(wsStreamPtr, timerPtr, 0);
+        }
+      });
+      that->startAccept();
+    });
+  }
+
+ private:
+  void send(std::shared_ptr<WsStream> wsStreamPtr, std::shared_ptr<net::steady_timer> timerPtr, int i) {
+    if (i == this->numMessage) {
+      wsStreamPtr->async_close(beast::websocket::close_code::normal, [wsStreamPtr](beast::error_code) {});
+      return;
+    }
+    auto messagePtr = std::make_shared<std::string>(R"({"ch":"market.btcusdt.depth.step0","ts":)" + std::to_string(nowNanoseconds()) +
+                                                    R"(,"tick":{"bids":[["30000.01","0.5"],["30000","1.2"],["29999.5","3"]],)"
+                                                    R"("asks":[["30000.02","0.7"],["30000.5","2"],["30001","4.1"]]}})");
+    wsStreamPtr->async_write(net::buffer(*messagePtr), [that = shared_from_this(), wsStreamPtr, timerPtr, messagePtr, i](beast::error_code ec, std::size_t) {
+      if (ec) {
+        return;
+      }
+      if (that->intervalMicroseconds > 0) {
+        timerPtr->expires_after(std::chrono::microseconds(that->intervalMicroseconds));
+        timerPtr->async_wait([that, wsStreamPtr, timerPtr, i](beast::error_code) { that->send(wsStreamPtr, timerPtr, i + 1); });
+      } else {
+        that->send(wsStreamPtr, timerPtr, i + 1);
+      }
+    });
+  }
+  net::io_context& ioContext;
+  tcp::acceptor acceptor;
+  int numMessage;
+  int intervalMicroseconds;
+};
+// Reads until the server closes the connection and records the latency of every message; the latency is taken after the send time has been parsed, as a
+// service would.
+class Client : public std::enable_shared_from_this<Client> {
+ public:
+  Client(net::io_context& ioContext, LatencyHistogram& latencyHistogram, std::atomic<long>& numMessage)
+      : wsStream(ioContext), latencyHistogram(latencyHistogram), numMessage(numMessage) {}
+  void start(unsigned short port) {
+    beast::get_lowest_layer(this->wsStream)
+        .async_connect(tcp::endpoint(net::ip::make_address("127.0.0.1"), port), [that = shared_from_this()](beast::error_code ec) {
+          if (ec) {
+            std::cerr << "connect: " << ec.message() << std::endl;
+            return;
+          }
+          beast::get_lowest_layer(that->wsStream).socket().set_option(tcp::no_delay(true));
+          that->wsStream.async_handshake("127.0.0.1", "/", [that](beast::error_code ec) {
+            if (ec) {
+              std::cerr << "handshake: " << ec.message() << std::endl;
+              return;
+            }
+            that->read();
+          });
+        });
+  }
+
+ private:
+  void read() {
+    this->wsStream.async_read(this->buffer, [that = shared_from_this()](beast::error_code ec, std::size_t) {
+      if (ec) {
+        return;
+      }
+      std::string_view message(static_cast<const char*>(that->buffer.data().data()), that->buffer.size());
+      auto pos = message.find("\"ts\":");
+      if (pos != std::string_view::npos) {
+        that->latencyHistogram.record(nowNanoseconds() - std::strtoull(message.data() + pos + 5, nullptr, 10));
+        ++that->numMessage;
+      }
+      that->buffer.consume(that->buffer.size());
+      that->read();
+    });
+  }
+  WsStream wsStream;
+  beast::flat_buffer buffer;
+  LatencyHistogram& latencyHistogram;
+  std::atomic<long>& numMessage;
+};
+} /* namespace ccapi */
+using ::ccapi::Client;
+using ::ccapi::LatencyHistogram;
+using ::ccapi::MockExchangeServer;
+using ::ccapi::ServiceContext;
+using ::ccapi::UtilSystem;
+int main(int argc, char** argv) {
+  const int numConnection = UtilSystem::getEnvAsInt("NUM_CONNECTIONS", 100);
+  const int numMessagePerConnection = UtilSystem::getEnvAsInt("NUM_MESSAGES_PER_CONNECTION", 10000);
+  const int intervalMicroseconds = UtilSystem::getEnvAsInt("MESSAGE_INTERVAL_MICROSECONDS", 100);
+  std::cout << "Backend is " << ServiceContext::getIoBackendName() << ", number of connections is " << numConnection
+            << ", number of messages per connection is " << numMessagePerConnection << ", message interval is " << intervalMicroseconds << " microseconds"
+            << std::endl;
+  boost::asio::io_context serverIoContext;
+  auto serverPtr = std::make_shared<MockExchangeServer>(serverIoContext, numMessagePerConnection, intervalMicroseconds);
+  serverPtr->startAccept();
+  std::thread serverThread([&serverIoContext]() { serverIoContext.run(); });
+  ServiceContext serviceContext;
+  LatencyHistogram latencyHistogram;
+  std::atomic<long> numMessage{};
+  for (int i = 0; i < numConnection; ++i) {
+    std::make_shared<Client>(*serviceContext.ioContextPtr, latencyHistogram, numMessage)->start(serverPtr->getPort());
+  }
+  struct rusage usageStart, usageEnd;
+  getrusage(RUSAGE_SELF, &usageStart);
+  auto start = std::chrono::steady_clock::now();
+  std::thread clientThread([&serviceContext]() { serviceContext.start(); });
+  const long numMessageExpected = static_cast<long>(numConnection) * numMessagePerConnection;
+  while (numMessage < numMessageExpected) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  auto end = std::chrono::steady_clock::now();
+  getrusage(RUSAGE_SELF, &usageEnd);
+  serviceContext.stop();
+  clientThread.join();
+  serverIoContext.stop();
+  serverThread.join();
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "Received " << numMessage << " messages in " << std::fixed << std::setprecision(3) << seconds << " seconds ("
+            << static_cast<long>(numMessage / seconds) << " messages per second)" << std::endl;
+  std::cout << "Latency in nanoseconds: p50 = " << latencyHistogram.getValueAtPercentile(50)
+            << ", p99 = " << latencyHistogram.getValueAtPercentile(99) << ", p99.9 = " << latencyHistogram.getValueAtPercentile(99.9)
+            << ", max = " << latencyHistogram.getMax() << std::endl;
+  std::cout << "Context switches per 1000 messages (both threads): voluntary = "
+            << 1000.0 * (usageEnd.ru_nvcsw - usageStart.ru_nvcsw) / numMessage << ", involuntary = "
+            << 1000.0 * (usageEnd.ru_nivcsw - usageStart.ru_nivcsw) / numMessage << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -1,5 +1,10 @@
 #include "app/common.h"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
 #include "gtest/gtest.h"
 namespace ccapi {
 TEST(AppUtilTest, linearInterpolate) {
@@ -16,4 +21,131 @@ TEST(AppUtilTest, roundInputRoundUp_2) { EXPECT_EQ(AppUtil::roundInput(0.0974990
 
 TEST(AppUtilTest, roundInputRoundDown_2) { EXPECT_EQ(AppUtil::roundInput(0.097499008778091811322, "0.00000001", false), "0.09749900"); }
 
+class CsvWriterTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    std::remove(this->filename.c_str());
+    std::remove(this->binaryFilename.c_str());
+  }
+  std::string readFile(const std::string& filePath) {
+    std::ifstream f(filePath, std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+  }
+  static uint64_t readVarint(const std::string& data, size_t& i) {
+    uint64_t value = 0;
+    for (int shift = 0; i < data.size(); shift += 7) {
+      auto byte = static_cast<unsigned char>(data[i++]);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        break;
+      }
+    }
+    return value;
+  }
+  std::string filename{"csv_writer_test.csv"};
+  std::string binaryFilename{"csv_writer_test.bin"};
+};
+
+TEST_F(CsvWriterTest, csvRoundTrip) {
+  {
+    CsvWriter csvWriter;
+    csvWriter.open(this->filename, std::ios_base::app);
+    EXPECT_TRUE(csvWriter.isOpen());
+    csvWriter.writeRow({"TIME", "PRICE", "SIZE"});
+    csvWriter.writeRows({{"2021-07-01T00:00:00.000Z", "100", "0.1"}, {"2021-07-01T00:00:01.000Z", "101", ""}});
+    csvWriter.writeString("a,b\n");
+    csvWriter.close();
+    EXPECT_FALSE(csvWriter.isOpen());
+  }
+  EXPECT_EQ(this->readFile(this->filename), "TIME,PRICE,SIZE\n2021-07-01T00:00:00.000Z,100,0.1\n2021-07-01T00:00:01.000Z,101,\na,b\n");
+  {
+    CsvWriter csvWriter;
+    csvWriter.open(this->filename, std::ios_base::app);
+    csvWriter.writeRow({"c"});
+  }
+  EXPECT_EQ(this->readFile(this->filename), "TIME,PRICE,SIZE\n2021-07-01T00:00:00.000Z,100,0.1\n2021-07-01T00:00:01.000Z,101,\na,b\nc\n");
+  {
+    CsvWriter csvWriter;
+    csvWriter.open(this->filename, std::ios_base::out);
+    csvWriter.writeRow({"d"});
+  }
+  EXPECT_EQ(this->readFile(this->filename), "d\n");
+}
+
+TEST_F(CsvWriterTest, binaryRoundTrip) {
+  std::vector<std::vector<std::string>> rows{
+      {"TIME", "PRICE", "SIZE"},
+      {"2021-07-01T00:00:00.000Z", "100", "0.1"},
+      {},
+      {"", std::string(300, 'x')},
+  };
+  {
+    CsvWriter csvWriter;
+    csvWriter.writeBinary = true;
+    csvWriter.open(this->filename);
+    csvWriter.writeRows(rows);
+  }
+  std::string data = this->readFile(this->binaryFilename);
+  std::vector<std::vector<std::string>> decodedRows;
+  size_t i = 0;
+  while (i < data.size()) {
+    std::vector<std::string> row(readVarint(data, i));
+    for (auto& column : row) {
+      auto length = readVarint(data, i);
+      ASSERT_LE(i + length, data.size());
+      column = data.substr(i, length);
+      i += length;
+    }
+    decodedRows.push_back(row);
+  }
+  EXPECT_EQ(decodedRows, rows);
+  EXPECT_EQ(this->readFile(this->filename), "TIME,PRICE,SIZE\n2021-07-01T00:00:00.000Z,100,0.1\n\n," + std::string(300, 'x') + "\n");
+}
+
+TEST_F(CsvWriterTest, closeDrainsQueue) {
+  std::string expected;
+  CsvWriter csvWriter;
+  // a buffer smaller than the data and a write interval that never elapses, so that only close can hand the tail of the data to the kernel
+  csvWriter.bufferSize = 4096;
+  csvWriter.writeIntervalMilliseconds = 3600000;
+  csvWriter.open(this->filename);
+  for (int i = 0; i < 10000; ++i) {
+    csvWriter.writeRow({std::to_string(i), "100", "0.1"});
+    expected += std::to_string(i) + ",100,0.1\n";
+    if (i % 1000 == 0) {
+      csvWriter.flush();
+    }
+  }
+  csvWriter.close();
+  EXPECT_EQ(this->readFile(this->filename), expected);
+  csvWriter.writeRow({"dropped"});
+  csvWriter.close();
+  EXPECT_EQ(this->readFile(this->filename), expected);
+}
+
+TEST_F(CsvWriterTest, writeIntervalWakesIdleWriter) {
+  CsvWriter csvWriter;
+  csvWriter.writeIntervalMilliseconds = 50;
+  csvWriter.fsyncIntervalMilliseconds = 100;
+  csvWriter.open(this->filename);
+  csvWriter.writeRow({"a"});
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  // neither flush nor close: the idle writer must have woken up for the write interval by itself
+  EXPECT_EQ(this->readFile(this->filename), "a\n");
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  csvWriter.writeRow({"b"});
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(this->readFile(this->filename), "a\nb\n");
+  csvWriter.close();
+}
+
+TEST_F(CsvWriterTest, openFailure) {
+  CsvWriter csvWriter;
+  csvWriter.open("nonexistent_directory/csv_writer_test.csv");
+  EXPECT_FALSE(csvWriter.isOpen());
+  csvWriter.writeRow({"dropped"});
+  csvWriter.flush();
+  csvWriter.close();
+}
+
 } /* namespace ccapi */
@@ -0,0 +1,191 @@
+#include "app/historical_market_data_downloader.h"
+
+#include <cstdio>
+
+#include "gtest/gtest.h"
+namespace ccapi {
+// serves a trade every 7 seconds, and three trades at the same time every 1000 seconds, from pages of at most LIMIT trades that start at the oldest (or, if
+// isNewestFirst, the newest) trade in the requested range, or of at most maxPageSize trades if it is set, answering each request right away
+class HistoricalMarketDataDownloaderFakeSession {
+ public:
+  Queue<Event>& getEventQueue() { return this->eventQueue; }
+  void sendRequest(Request& request) {
+    {
+      ++this->numRequest;
+      Event event;
+      event.setType(Event::Type::RESPONSE);
+      Message message;
+      message.setCorrelationIdList({request.getCorrelationId()});
+      if (this->numFailure > 0) {
+        --this->numFailure;
+        message.setType(Message::Type::RESPONSE_ERROR);
+        event.setMessageList({message});
+        this->eventQueue.pushBack(event);
+        return;
+      }
+      const auto& param = request.getFirstParamWithDefault();
+      auto startTp = UtilTime::makeTimePoint(UtilTime::divide(param.at(CCAPI_START_TIME_SECONDS)));
+      auto endTp = UtilTime::makeTimePoint(UtilTime::divide(param.at(CCAPI_END_TIME_SECONDS)));
+      size_t limit = std::stoi(param.at(CCAPI_LIMIT));
+      if (this->maxPageSize > 0) {
+        limit = std::min(limit, this->maxPageSize);
+      }
+      std::vector<Message> messageList;
+      auto it = std::lower_bound(this->tradeList.begin(), this->tradeList.end(), startTp,
+                                 [](const std::pair<TimePoint, std::string>& a, const TimePoint& b) { return a.first < b; });
+      for (; it != this->tradeList.end() && it->first <= endTp; ++it) {
+        message.setType(Message::Type::GET_HISTORICAL_TRADES);
+        message.setTime(it->first);
+        Element element;
+        element.insert(CCAPI_LAST_PRICE, "100");
+        element.insert(CCAPI_LAST_SIZE, "0.1");
+        element.insert(CCAPI_IS_BUYER_MAKER, "1");
+        element.insert(CCAPI_TRADE_ID, it->second);
+        message.setElementList({element});
+        messageList.push_back(message);
+      }
+      if (this->isNewestFirst) {
+        std::reverse(messageList.begin(), messageList.end());
+      }
+      if (messageList.size() > limit) {
+        messageList.resize(limit);
+      }
+      if (messageList.empty()) {
+        message.setType(Message::Type::GET_HISTORICAL_TRADES);
+        message.setElementList({});
+        messageList.push_back(message);
+      }
+      event.setMessageList(messageList);
+      this->eventQueue.pushBack(event);
+    }
+  }
+  void addTrades(const TimePoint& startTp, const TimePoint& endTp) {
+    for (auto tp = startTp; tp < endTp; tp += std::chrono::seconds(7)) {
+      this->tradeList.emplace_back(tp + std::chrono::milliseconds(123), std::to_string(this->tradeList.size()));
+    }
+    for (auto tp = startTp; tp < endTp; tp += std::chrono::seconds(1000)) {
+      for (int i = 0; i < 3; ++i) {
+        this->tradeList.emplace_back(tp + std::chrono::milliseconds(500), std::to_string(this->tradeList.size()));
+      }
+    }
+    std::stable_sort(this->tradeList.begin(), this->tradeList.end(),
+                     [](const std::pair<TimePoint, std::string>& a, const std::pair<TimePoint, std::string>& b) { return a.first < b.first; });
+  }
+  std::vector<std::pair<TimePoint, std::string> > tradeList;
+  Queue<Event> eventQueue;
+  bool isNewestFirst{};
+  size_t maxPageSize{};
+  int numFailure{};
+  int numRequest{};
+};
+class HistoricalMarketDataDownloaderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    this->downloader.exchange = "okx";
+    this->downloader.instrument = "BTC-USDT";
+    this->downloader.baseAsset = "BTC";
+    this->downloader.quoteAsset = "USDT";
+    this->downloader.historicalMarketDataStartDateTp = UtilTime::parse("2021-07-01");
+    this->downloader.historicalMarketDataEndDateTp = UtilTime::parse("2021-07-03");
+    this->downloader.limit = 100;
+    this->downloader.retryDelayMilliseconds = 0;
+    this->session.addTrades(this->downloader.historicalMarketDataStartDateTp, this->downloader.historicalMarketDataEndDateTp);
+  }
+  void TearDown() override {
+    std::remove(this->downloader.getFilePath(UtilTime::parse("2021-07-01")).c_str());
+    std::remove(this->downloader.getFilePath(UtilTime::parse("2021-07-02")).c_str());
+  }
+  std::vector<std::string> readFile(const std::string& filePath) {
+    std::vector<std::string> lineList;
+    std::ifstream f(filePath);
+    std::string line;
+    while (std::getline(f, line)) {
+      lineList.push_back(line);
+    }
+    return lineList;
+  }
+  void verifyFile(const std::string& date) {
+    auto lineList = this->readFile(this->downloader.getFilePath(UtilTime::parse(date)));
+    ASSERT_FALSE(lineList.empty());
+    EXPECT_EQ(lineList.at(0), "time_seconds,price,size,is_buyer_maker");
+    auto dateTp = UtilTime::parse(date);
+    std::vector<std::string> expectedLineList;
+    for (const auto& x : this->session.tradeList) {
+      if (x.first >= dateTp && x.first < dateTp + std::chrono::hours(24)) {
+        expectedLineList.push_back(HistoricalMarketDataDownloader::convertTimePointToSecondsString(x.first) + ",100,0.1,1");
+      }
+    }
+    EXPECT_EQ(std::vector<std::string>(lineList.begin() + 1, lineList.end()), expectedLineList);
+  }
+  HistoricalMarketDataDownloader downloader;
+  HistoricalMarketDataDownloaderFakeSession session;
+};
+TEST_F(HistoricalMarketDataDownloaderTest, getFilePath) {
+  EXPECT_EQ(this->downloader.getFilePath(UtilTime::parse("2021-07-01")), "./okx__btc-usdt__2021-07-01__trade.csv");
+  this->downloader.historicalMarketDataDirectory = "data";
+  this->downloader.historicalMarketDataFilePrefix = "chassis__";
+  this->downloader.historicalMarketDataFileSuffix = "__chassis";
+  this->downloader.operation = Request::Operation::GET_HISTORICAL_CANDLESTICKS;
+  EXPECT_EQ(this->downloader.getFilePath(UtilTime::parse("2021-07-01")), "data/chassis__okx__btc-usdt__2021-07-01__candlestick__chassis.csv");
+  this->downloader = HistoricalMarketDataDownloader();
+}
+TEST_F(HistoricalMarketDataDownloaderTest, convertTimePointToSecondsString) {
+  EXPECT_EQ(HistoricalMarketDataDownloader::convertTimePointToSecondsString(UtilTime::makeTimePointFromMilliseconds(1625097621647)), "1625097621.647");
+  EXPECT_EQ(HistoricalMarketDataDownloader::convertTimePointToSecondsString(UtilTime::makeTimePointFromMilliseconds(1625097621050)), "1625097621.05");
+  EXPECT_EQ(HistoricalMarketDataDownloader::convertTimePointToSecondsString(UtilTime::makeTimePointFromSeconds(1625097621)), "1625097621");
+}
+TEST_F(HistoricalMarketDataDownloaderTest, downloadOldestFirst) {
+  EXPECT_EQ(this->downloader.download(this->session), 2);
+  this->verifyFile("2021-07-01");
+  this->verifyFile("2021-07-02");
+}
+TEST_F(HistoricalMarketDataDownloaderTest, downloadNewestFirst) {
+  this->session.isNewestFirst = true;
+  this->downloader.maxNumConcurrentRequest = 3;
+  EXPECT_EQ(this->downloader.download(this->session), 2);
+  this->verifyFile("2021-07-01");
+  this->verifyFile("2021-07-02");
+}
+TEST_F(HistoricalMarketDataDownloaderTest, downloadPageSizeCappedBelowLimit) {
+  this->session.maxPageSize = 30;
+  EXPECT_EQ(this->downloader.download(this->session), 2);
+  this->verifyFile("2021-07-01");
+  this->verifyFile("2021-07-02");
+  this->session.isNewestFirst = true;
+  this->downloader.maxNumConcurrentRequest = 3;
+  std::remove(this->downloader.getFilePath(UtilTime::parse("2021-07-01")).c_str());
+  std::remove(this->downloader.getFilePath(UtilTime::parse("2021-07-02")).c_str());
+  EXPECT_EQ(this->downloader.download(this->session), 2);
+  this->verifyFile("2021-07-01");
+  this->verifyFile("2021-07-02");
+}
+TEST_F(HistoricalMarketDataDownloaderTest, retry) {
+  this->session.numFailure = 20;
+  EXPECT_EQ(this->downloader.download(this->session), 2);
+  this->verifyFile("2021-07-01");
+  this->verifyFile("2021-07-02");
+  this->session.numFailure = 1000;
+  this->downloader.historicalMarketDataEndDateTp = UtilTime::parse("2021-07-04");
+  this->downloader.maxNumRetry = 2;
+  EXPECT_EQ(this->downloader.download(this->session), 0);
+  EXPECT_FALSE(std::ifstream(this->downloader.getFilePath(UtilTime::parse("2021-07-03"))));
+}
+TEST_F(HistoricalMarketDataDownloaderTest, resume) {
+  this->downloader.historicalMarketDataEndDateTp = UtilTime::parse("2021-07-02");
+  EXPECT_EQ(this->downloader.download(this->session), 1);
+  int numRequest = this->session.numRequest;
+  this->downloader.historicalMarketDataEndDateTp = UtilTime::parse("2021-07-03");
+  EXPECT_EQ(this->downloader.download(this->session), 1);
+  EXPECT_EQ(this->downloader.download(this->session), 0);
+  EXPECT_EQ(this->session.numRequest, 2 * numRequest);
+  this->verifyFile("2021-07-01");
+  this->verifyFile("2021-07-02");
+}
+TEST_F(HistoricalMarketDataDownloaderTest, skipDayNotEnded) {
+  auto todayTp = UtilTime::parse(UtilTime::getISOTimestamp<std::chrono::seconds>(UtilTime::now()).substr(0, 10));
+  this->downloader.historicalMarketDataStartDateTp = todayTp;
+  this->downloader.historicalMarketDataEndDateTp = todayTp + std::chrono::hours(24);
+  EXPECT_EQ(this->downloader.download(this->session), 0);
+  EXPECT_EQ(this->session.numRequest, 0);
+}
+} /* namespace ccapi */
@@ -0,0 +1,144 @@
+#include "app/rolling_price_series.h"
+
+#include <cmath>
+#include <deque>
+#include <random>
+#include <utility>
+
+#include "gtest/gtest.h"
+namespace ccapi {
+// the same series, recomputed from scratch on every query
+class NaiveRollingPriceSeries {
+ public:
+  explicit NaiveRollingPriceSeries(size_t capacity) : capacity(std::max<size_t>(capacity, 2)) {}
+  void update(int key, double price) {
+    if (!this->intervalList.empty() && this->intervalList.back().first == key) {
+      this->intervalList.back().second = price;
+      return;
+    }
+    if (this->intervalList.size() == this->capacity) {
+      this->intervalList.pop_front();
+    }
+    this->intervalList.emplace_back(key, price);
+  }
+  void eraseUpTo(int key) {
+    while (!this->intervalList.empty() && this->intervalList.front().first <= key) {
+      this->intervalList.pop_front();
+    }
+  }
+  std::vector<double> getReturnList() const {
+    std::vector<double> returnList;
+    for (size_t i = 0; i + 1 < this->intervalList.size(); ++i) {
+      returnList.push_back((this->intervalList[i + 1].second - this->intervalList[i].second) / this->intervalList[i].second);
+    }
+    return returnList;
+  }
+  // two-pass Pearson correlation coefficient of the pairs of consecutive returns
+  bool getLagOneCorrelationCoefficient(double& output) const {
+    auto returnList = this->getReturnList();
+    if (returnList.size() < 3) {
+      return false;
+    }
+    size_t n = returnList.size() - 1;
+    double meanX = 0, meanY = 0;
+    for (size_t i = 0; i < n; ++i) {
+      meanX += returnList[i] / n;
+      meanY += returnList[i + 1] / n;
+    }
+    double covariance = 0, varianceX = 0, varianceY = 0;
+    for (size_t i = 0; i < n; ++i) {
+      covariance += (returnList[i] - meanX) * (returnList[i + 1] - meanY);
+      varianceX += (returnList[i] - meanX) * (returnList[i] - meanX);
+      varianceY += (returnList[i + 1] - meanY) * (returnList[i + 1] - meanY);
+    }
+    if (varianceX == 0 || varianceY == 0) {
+      return false;
+    }
+    output = covariance / std::sqrt(varianceX * varianceY);
+    return true;
+  }
+  size_t capacity;
+  std::deque<std::pair<int, double> > intervalList;
+};
+void expectEquivalent(const RollingPriceSeries& series, const NaiveRollingPriceSeries& naiveSeries, int& numCoefficient) {
+  ASSERT_EQ(series.size(), naiveSeries.intervalList.size());
+  for (size_t i = 0; i < series.size(); ++i) {
+    ASSERT_EQ(series.getPrice(i), naiveSeries.intervalList[i].second);
+  }
+  auto returnList = naiveSeries.getReturnList();
+  ASSERT_EQ(series.getNumReturn(), returnList.size());
+  double sumReturn = 0, sumSquaredReturn = 0, sumLagOneProduct = 0, sumGain = 0, sumLoss = 0;
+  int numGain = 0, numLoss = 0;
+  for (size_t i = 0; i < returnList.size(); ++i) {
+    double r = returnList[i];
+    sumReturn += r;
+    sumSquaredReturn += r * r;
+    if (i > 0) {
+      sumLagOneProduct += returnList[i - 1] * r;
+    }
+    if (r > 0) {
+      sumGain += r;
+      ++numGain;
+    } else if (r < 0) {
+      sumLoss -= r;
+      ++numLoss;
+    }
+  }
+  EXPECT_NEAR(series.getSumReturn(), sumReturn, 1e-12);
+  EXPECT_NEAR(series.getSumSquaredReturn(), sumSquaredReturn, 1e-12);
+  EXPECT_NEAR(series.getSumLagOneProduct(), sumLagOneProduct, 1e-12);
+  EXPECT_NEAR(series.getSumGain(), sumGain, 1e-12);
+  EXPECT_NEAR(series.getSumLoss(), sumLoss, 1e-12);
+  EXPECT_EQ(series.getNumGain(), numGain);
+  EXPECT_EQ(series.getNumLoss(), numLoss);
+  double coefficient = 0, naiveCoefficient = 0;
+  bool hasCoefficient = series.getLagOneCorrelationCoefficient(coefficient);
+  bool hasNaiveCoefficient = naiveSeries.getLagOneCorrelationCoefficient(naiveCoefficient);
+  if (hasCoefficient) {
+    ASSERT_TRUE(hasNaiveCoefficient);
+    EXPECT_NEAR(coefficient, naiveCoefficient, 1e-6);
+    ++numCoefficient;
+  }
+}
+TEST(RollingPriceSeriesTest, randomizedEquivalence) {
+  std::mt19937 randomEngine(20211231);
+  std::uniform_real_distribution<double> returnDistribution(-0.01, 0.01);
+  std::uniform_int_distribution<int> operationDistribution(0, 99);
+  for (size_t capacity : {2, 3, 5, 17, 64}) {
+    RollingPriceSeries series(capacity);
+    NaiveRollingPriceSeries naiveSeries(capacity);
+    int key = 0, numCoefficient = 0;
+    double price = 100;
+    for (int i = 0; i < 5000; ++i) {
+      int operation = operationDistribution(randomEngine);
+      if (operation < 60) {
+        // a new interval, sometimes skipping a few keys
+        key += 1 + (operation < 5 ? operation : 0);
+        price *= 1 + returnDistribution(randomEngine);
+        series.update(key, price);
+        naiveSeries.update(key, price);
+      } else if (operation < 90) {
+        // the price of the last interval changes, sometimes back to the previous one
+        price = operation < 65 && naiveSeries.intervalList.size() > 1 ? naiveSeries.intervalList[naiveSeries.intervalList.size() - 2].second
+                                                                        : price * (1 + returnDistribution(randomEngine));
+        series.update(key, price);
+        naiveSeries.update(key, price);
+      } else if (operation < 98) {
+        int eraseKey = key - static_cast<int>(capacity) + operation % 4;
+        series.eraseUpTo(eraseKey);
+        naiveSeries.eraseUpTo(eraseKey);
+      } else {
+        series.eraseUpTo(key);
+        naiveSeries.eraseUpTo(key);
+      }
+      expectEquivalent(series, naiveSeries, numCoefficient);
+      if (::testing::Test::HasFatalFailure()) {
+        FAIL() << "capacity = " << capacity << ", i = " << i;
+      }
+    }
+    if (capacity >= 5) {
+      EXPECT_GT(numCoefficient, 1000);
+    }
+  }
+}
+} /* namespace ccapi */
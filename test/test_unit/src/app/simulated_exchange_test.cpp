@@ -0,0 +1,162 @@
+#include "app/simulated_exchange.h"
+
+#include "gtest/gtest.h"
+namespace ccapi {
+class SimulatedExchangeTest : public ::testing::Test {
+ public:
+  SimulatedExchangeTest() : exchange("0.01", "0.001", "BTC", "USDT") {}
+  Request createOrder(const std::string& side, const std::string& price, const std::string& quantity, const std::string& clientOrderId = "") {
+    Request request(Request::Operation::CREATE_ORDER, "binance", "BTCUSDT");
+    std::map<std::string, std::string> param = {
+        {CCAPI_EM_ORDER_SIDE, side},
+        {CCAPI_EM_ORDER_LIMIT_PRICE, price},
+        {CCAPI_EM_ORDER_QUANTITY, quantity},
+    };
+    if (!clientOrderId.empty()) {
+      param[CCAPI_EM_CLIENT_ORDER_ID] = clientOrderId;
+    }
+    request.appendParam(param);
+    request.setTimeSent(this->now);
+    return request;
+  }
+  Request cancelOrder(const std::string& name, const std::string& value) {
+    Request request(Request::Operation::CANCEL_ORDER, "binance", "BTCUSDT");
+    request.appendParam({{name, value}});
+    request.setTimeSent(this->now);
+    return request;
+  }
+  std::vector<Element> getElementList(Message::Type messageType) const {
+    std::vector<Element> elementList;
+    for (const auto& event : this->eventList) {
+      for (const auto& message : event.getMessageList()) {
+        if (message.getType() == messageType) {
+          elementList.insert(elementList.end(), message.getElementList().begin(), message.getElementList().end());
+        }
+      }
+    }
+    return elementList;
+  }
+  SimulatedExchange exchange;
+  std::vector<Event> eventList;
+  TimePoint now{UtilTime::makeTimePointFromMilliseconds(1000)};
+};
+TEST_F(SimulatedExchangeTest, toTickAndToQuantity) {
+  int64_t x;
+  EXPECT_TRUE(this->exchange.toTick("100.01", x));
+  EXPECT_EQ(x, 10001);
+  EXPECT_TRUE(this->exchange.toTick("100.015", x));
+  EXPECT_EQ(x, 10002);
+  EXPECT_TRUE(this->exchange.toTick("1e2", x));
+  EXPECT_EQ(x, 10000);
+  EXPECT_TRUE(this->exchange.toQuantity("1.2344", x));
+  EXPECT_EQ(x, 1234);
+  EXPECT_FALSE(this->exchange.toQuantity("-1", x));
+  EXPECT_FALSE(this->exchange.toTick("abc", x));
+}
+TEST_F(SimulatedExchangeTest, take) {
+  this->exchange.onMarketDepth(this->now, {{10000, 1000}}, {{10001, 2000}, {10002, 3000}}, this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_BUY, "100.02", "4"), this->eventList);
+  auto tradeList = this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE);
+  ASSERT_EQ(tradeList.size(), 2);
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_PRICE), "100.01");
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE), "2");
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_IS_MAKER), "0");
+  EXPECT_EQ(tradeList[1].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_PRICE), "100.02");
+  EXPECT_EQ(tradeList[1].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE), "2");
+  auto orderUpdateList = this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE);
+  EXPECT_EQ(orderUpdateList.back().getValue(CCAPI_EM_ORDER_STATUS), APP_EVENT_HANDLER_BASE_ORDER_STATUS_FILLED);
+  EXPECT_EQ(orderUpdateList.back().getValue(CCAPI_EM_ORDER_REMAINING_QUANTITY), "0");
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 0);
+}
+TEST_F(SimulatedExchangeTest, queuePositionAndPartialFill) {
+  this->exchange.onMarketDepth(this->now, {{10000, 5000}}, {{10001, 2000}}, this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_BUY, "100", "1"), this->eventList);
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 1);
+  // 3 of the 5 ahead of the order are traded away
+  this->exchange.onTrade(this->now, 10000, 3000, true, this->eventList);
+  EXPECT_TRUE(this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE).empty());
+  // the level shrinks to 1, so at most 1 is still ahead of the order
+  this->exchange.onMarketDepth(this->now, {{10000, 1000}}, {{10001, 2000}}, this->eventList);
+  this->exchange.onTrade(this->now, 10000, 1500, true, this->eventList);
+  auto tradeList = this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE);
+  ASSERT_EQ(tradeList.size(), 1);
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE), "0.5");
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_IS_MAKER), "1");
+  auto orderUpdateList = this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE);
+  EXPECT_EQ(orderUpdateList.back().getValue(CCAPI_EM_ORDER_STATUS), APP_EVENT_HANDLER_BASE_ORDER_STATUS_PARTIALLY_FILLED);
+  EXPECT_EQ(orderUpdateList.back().getValue(CCAPI_EM_ORDER_CUMULATIVE_FILLED_QUANTITY), "0.5");
+  // a trade through the order's price executes the rest
+  this->exchange.onTrade(this->now, 9999, 100, true, this->eventList);
+  tradeList = this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE);
+  ASSERT_EQ(tradeList.size(), 2);
+  EXPECT_EQ(tradeList[1].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_PRICE), "100");
+  EXPECT_EQ(tradeList[1].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE), "0.5");
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 0);
+}
+TEST_F(SimulatedExchangeTest, queuePriority) {
+  this->exchange.onMarketDepth(this->now, {{9990, 1000}}, {{10010, 1000}}, this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_SELL, "100.05", "1", "a"), this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_SELL, "100.05", "1", "b"), this->eventList);
+  this->eventList.clear();
+  this->exchange.onTrade(this->now, 10005, 1500, false, this->eventList);
+  auto tradeList = this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE);
+  ASSERT_EQ(tradeList.size(), 2);
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_EM_CLIENT_ORDER_ID), "a");
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE), "1");
+  EXPECT_EQ(tradeList[1].getValue(CCAPI_EM_CLIENT_ORDER_ID), "b");
+  EXPECT_EQ(tradeList[1].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_SIZE), "0.5");
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 1);
+}
+TEST_F(SimulatedExchangeTest, crossedBook) {
+  this->exchange.onMarketDepth(this->now, {{10000, 1000}}, {{10001, 2000}}, this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_BUY, "100", "1"), this->eventList);
+  this->exchange.onMarketDepth(this->now, {{9998, 1000}}, {{9999, 2000}}, this->eventList);
+  auto tradeList = this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE);
+  ASSERT_EQ(tradeList.size(), 1);
+  EXPECT_EQ(tradeList[0].getValue(CCAPI_EM_ORDER_LAST_EXECUTED_PRICE), "100");
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 0);
+}
+TEST_F(SimulatedExchangeTest, cancel) {
+  this->exchange.onMarketDepth(this->now, {{10000, 1000}}, {{10001, 2000}}, this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_BUY, "99", "1", "a"), this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_BUY, "99", "1", "b"), this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_SELL, "101", "1", "c"), this->eventList);
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 3);
+  auto orderId = this->getElementList(Message::Type::CREATE_ORDER).at(0).getValue(CCAPI_EM_ORDER_ID);
+  this->eventList.clear();
+  this->exchange.sendRequest(this->cancelOrder(CCAPI_EM_ORDER_ID, orderId), this->eventList);
+  auto elementList = this->getElementList(Message::Type::CANCEL_ORDER);
+  ASSERT_EQ(elementList.size(), 1);
+  EXPECT_EQ(elementList[0].getValue(CCAPI_EM_CLIENT_ORDER_ID), "a");
+  EXPECT_EQ(elementList[0].getValue(CCAPI_EM_ORDER_STATUS), APP_EVENT_HANDLER_BASE_ORDER_STATUS_CANCELED);
+  this->eventList.clear();
+  this->exchange.sendRequest(this->cancelOrder(CCAPI_EM_CLIENT_ORDER_ID, "c"), this->eventList);
+  elementList = this->getElementList(Message::Type::CANCEL_ORDER);
+  ASSERT_EQ(elementList.size(), 1);
+  EXPECT_EQ(elementList[0].getValue(CCAPI_EM_CLIENT_ORDER_ID), "c");
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 1);
+  this->eventList.clear();
+  this->exchange.sendRequest(this->cancelOrder(CCAPI_EM_CLIENT_ORDER_ID, "a"), this->eventList);
+  EXPECT_EQ(this->getElementList(Message::Type::RESPONSE_ERROR).size(), 1);
+  this->eventList.clear();
+  Request request(Request::Operation::CANCEL_OPEN_ORDERS, "binance", "BTCUSDT");
+  request.setTimeSent(this->now);
+  this->exchange.sendRequest(request, this->eventList);
+  elementList = this->getElementList(Message::Type::CANCEL_OPEN_ORDERS);
+  ASSERT_EQ(elementList.size(), 1);
+  EXPECT_EQ(elementList[0].getValue(CCAPI_EM_CLIENT_ORDER_ID), "b");
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 0);
+}
+TEST_F(SimulatedExchangeTest, latency) {
+  this->exchange.latencyModel.orderEntryLatency = std::chrono::milliseconds(10);
+  this->exchange.onMarketDepth(this->now, {{10000, 1000}}, {{10001, 2000}}, this->eventList);
+  this->exchange.sendRequest(this->createOrder(CCAPI_EM_ORDER_SIDE_BUY, "100.01", "1"), this->eventList);
+  EXPECT_TRUE(this->getElementList(Message::Type::CREATE_ORDER).empty());
+  // the ask is gone by the time the order arrives
+  this->exchange.onMarketDepth(this->now + std::chrono::milliseconds(5), {{10000, 1000}}, {{10002, 2000}}, this->eventList);
+  this->exchange.onTrade(this->now + std::chrono::milliseconds(10), 10002, 100, false, this->eventList);
+  EXPECT_EQ(this->getElementList(Message::Type::CREATE_ORDER).size(), 1);
+  EXPECT_TRUE(this->getElementList(Message::Type::EXECUTION_MANAGEMENT_EVENTS_PRIVATE_TRADE).empty());
+  EXPECT_EQ(this->exchange.getNumOpenOrder(), 1);
+}
+} /* namespace ccapi */
@@ -0,0 +1,148 @@
+#include "ccapi_cpp/ccapi_bar_aggregator.h"
+
+#include "gtest/gtest.h"
+namespace ccapi {
+TEST(FixedPointTest, parseAndToString) {
+  auto x = FixedPoint::parse("123.4500");
+  EXPECT_EQ(x.mantissa, 12345);
+  EXPECT_EQ(x.scale, 2);
+  EXPECT_EQ(x.toString(), "123.45");
+  EXPECT_EQ(FixedPoint::parse("100").toString(), "100");
+  EXPECT_EQ(FixedPoint::parse("0.0001").toString(), "0.0001");
+  EXPECT_EQ(FixedPoint::parse("1e-5").toString(), "0.00001");
+  EXPECT_EQ(FixedPoint::parse("1.5").compare(FixedPoint::parse("1.50001")), -1);
+  EXPECT_EQ(FixedPoint::parse("2").compare(FixedPoint::parse("2.000")), 0);
+}
+TEST(FixedPointTest, parseInvalid) {
+  FixedPoint x;
+  EXPECT_FALSE(FixedPoint::parse("-1.5", x));
+  EXPECT_FALSE(FixedPoint::parse("", x));
+  EXPECT_FALSE(FixedPoint::parse("1.2.3", x));
+  EXPECT_FALSE(FixedPoint::parse("12345678901234567890", x));
+  EXPECT_FALSE(FixedPoint::parse("0.0000000000000000001", x));
+  EXPECT_TRUE(FixedPoint::parse("123456789012345678", x));
+  EXPECT_EQ(x.mantissa, 123456789012345678);
+  EXPECT_TRUE(FixedPoint::parse("0000.123456789012345678000", x));
+  EXPECT_EQ(x.mantissa, 123456789012345678);
+  EXPECT_EQ(x.scale, 18);
+  EXPECT_THROW(FixedPoint::parse("-1"), std::invalid_argument);
+}
+TEST(FixedPointTest, overflow) {
+  int64_t x;
+  EXPECT_FALSE(FixedPoint::multiply(INT64_MAX / 2, 3, x));
+  EXPECT_FALSE(FixedPoint::add(INT64_MAX, 1, x));
+  EXPECT_FALSE(FixedPoint::rescale(10, 0, 18, x));
+  EXPECT_TRUE(FixedPoint::rescale(1234, 3, 1, x));
+  EXPECT_EQ(x, 12);
+  EXPECT_EQ(FixedPoint::parse("10").compare(FixedPoint::parse("0.000000000000000001")), 1);
+  EXPECT_EQ(FixedPoint::parse("0.000000000000000001").compare(FixedPoint::parse("10")), -1);
+}
+TEST(BarTest, update) {
+  Bar bar;
+  EXPECT_TRUE(bar.empty());
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000);
+  bar.update(tp, FixedPoint::parse("100.5"), FixedPoint::parse("2"));
+  bar.update(tp, FixedPoint::parse("101.25"), FixedPoint::parse("0.5"));
+  bar.update(tp, FixedPoint::parse("99"), FixedPoint::parse("1"));
+  EXPECT_EQ(bar.getOpen(), "100.5");
+  EXPECT_EQ(bar.getHigh(), "101.25");
+  EXPECT_EQ(bar.getLow(), "99");
+  EXPECT_EQ(bar.getClose(), "99");
+  EXPECT_EQ(bar.getVolume(), "3.5");
+  EXPECT_EQ(bar.getQuoteVolume(), "350.625");
+  EXPECT_EQ(bar.getVwap(), "100.178571");
+  EXPECT_EQ(bar.getTradeCount(), 3);
+  bar.reset();
+  EXPECT_TRUE(bar.empty());
+}
+TEST(BarTest, updateWithPriceString) {
+  Bar bar;
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000);
+  bar.update(tp, FixedPoint::parse("100.50"), FixedPoint::parse("2"), "100.50");
+  bar.update(tp, FixedPoint::parse("101.250"), FixedPoint::parse("0.5"), "101.250");
+  bar.update(tp, FixedPoint::parse("99.00"), FixedPoint::parse("1"), "99.00");
+  bar.update(tp, FixedPoint::parse("100.00"), FixedPoint::parse("1"), "100.00");
+  EXPECT_EQ(bar.getOpen(), "100.50");
+  EXPECT_EQ(bar.getHigh(), "101.250");
+  EXPECT_EQ(bar.getLow(), "99.00");
+  EXPECT_EQ(bar.getClose(), "100.00");
+  EXPECT_EQ(bar.getVolume(), "4.5");
+  bar.reset();
+  bar.update(tp, FixedPoint::parse("1.0"), FixedPoint::parse("1"));
+  EXPECT_EQ(bar.getOpen(), "1");
+}
+TEST(BarTest, updateOverflow) {
+  Bar bar;
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000);
+  EXPECT_TRUE(bar.update(tp, FixedPoint::parse("30000"), FixedPoint::parse("1")));
+  // the price can't get 18 decimals without overflowing the high, so the trade is refused
+  EXPECT_FALSE(bar.update(tp, FixedPoint::parse("0.000000000000000001"), FixedPoint::parse("1")));
+  EXPECT_EQ(bar.getTradeCount(), 1);
+  EXPECT_EQ(bar.getLow(), "30000");
+  EXPECT_FALSE(bar.update(tp, FixedPoint::parse("1"), FixedPoint{INT64_MAX, 0}));
+  EXPECT_EQ(bar.getVolume(), "1");
+  // 30000.12345678 * 123456.78901234 exceeds 64 bits at 16 decimals, so the quote volume keeps fewer decimals
+  EXPECT_TRUE(bar.update(tp, FixedPoint::parse("30000.12345678"), FixedPoint::parse("123456.78901234")));
+  EXPECT_EQ(bar.getVolume(), "123457.78901234");
+  EXPECT_EQ(bar.getClose(), "30000.12345678");
+  EXPECT_EQ(bar.getQuoteVolume(), "3703748911.947840602");
+  EXPECT_EQ(bar.getVwap(), "30000.12345");
+}
+TEST(BarAggregatorTest, parseSpecList) {
+  auto specList = BarAggregator::parseSpecList("1s,5m,volume:100,dollar:1000000");
+  ASSERT_EQ(specList.size(), 4);
+  EXPECT_EQ(specList[0].intervalMilliseconds, 1000);
+  EXPECT_EQ(specList[1].intervalMilliseconds, 300000);
+  EXPECT_EQ(specList[2].type, BarAggregator::Type::VOLUME);
+  EXPECT_EQ(specList[3].type, BarAggregator::Type::DOLLAR);
+  EXPECT_EQ(specList[3].name, "dollar:1000000");
+  EXPECT_THROW(BarAggregator::parseSpecList("5x"), std::runtime_error);
+}
+TEST(BarAggregatorTest, timeBar) {
+  BarAggregator barAggregator(BarAggregator::parseSpecList("1s,1m"));
+  std::vector<BarAggregator::ClosedBar> closedBarList;
+  barAggregator.update(UtilTime::makeTimePointFromMilliseconds(60100), "10", "1", closedBarList);
+  barAggregator.update(UtilTime::makeTimePointFromMilliseconds(60900), "12", "1", closedBarList);
+  EXPECT_TRUE(closedBarList.empty());
+  barAggregator.update(UtilTime::makeTimePointFromMilliseconds(61000), "11", "1", closedBarList);
+  ASSERT_EQ(closedBarList.size(), 1);
+  EXPECT_EQ(closedBarList[0].specName, "1s");
+  EXPECT_EQ(closedBarList[0].startTime, UtilTime::makeTimePointFromMilliseconds(60000));
+  EXPECT_EQ(closedBarList[0].bar.getHigh(), "12");
+  EXPECT_EQ(closedBarList[0].bar.getTradeCount(), 2);
+  closedBarList.clear();
+  barAggregator.flush(UtilTime::makeTimePointFromMilliseconds(120000), closedBarList);
+  ASSERT_EQ(closedBarList.size(), 2);
+  EXPECT_EQ(closedBarList[0].specName, "1s");
+  EXPECT_EQ(closedBarList[1].specName, "1m");
+  EXPECT_EQ(closedBarList[1].bar.getOpen(), "10");
+  EXPECT_EQ(closedBarList[1].bar.getClose(), "11");
+  EXPECT_EQ(closedBarList[1].bar.getTradeCount(), 3);
+}
+TEST(BarAggregatorTest, volumeAndDollarBar) {
+  BarAggregator barAggregator(BarAggregator::parseSpecList("volume:2.5,dollar:30"));
+  std::vector<BarAggregator::ClosedBar> closedBarList;
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000);
+  barAggregator.update(tp, "10", "1.5", closedBarList);
+  EXPECT_TRUE(closedBarList.empty());
+  barAggregator.update(tp, "20", "1", closedBarList);
+  ASSERT_EQ(closedBarList.size(), 2);
+  EXPECT_EQ(closedBarList[0].specName, "volume:2.5");
+  EXPECT_EQ(closedBarList[0].bar.getVolume(), "2.5");
+  EXPECT_EQ(closedBarList[1].specName, "dollar:30");
+  EXPECT_EQ(closedBarList[1].bar.getQuoteVolume(), "35");
+  EXPECT_TRUE(barAggregator.getBarList()[0].empty());
+}
+TEST(BarAggregatorTest, getNextFlushTp) {
+  BarAggregator barAggregator(BarAggregator::parseSpecList("1s,1m,volume:100"));
+  std::vector<BarAggregator::ClosedBar> closedBarList;
+  EXPECT_EQ(barAggregator.getNextFlushTp(), TimePoint::max());
+  barAggregator.update(UtilTime::makeTimePointFromMilliseconds(60100), "10", "1", closedBarList);
+  EXPECT_EQ(barAggregator.getNextFlushTp(), UtilTime::makeTimePointFromMilliseconds(61000));
+  barAggregator.flush(UtilTime::makeTimePointFromMilliseconds(61000), closedBarList);
+  EXPECT_EQ(closedBarList.size(), 1);
+  EXPECT_EQ(barAggregator.getNextFlushTp(), UtilTime::makeTimePointFromMilliseconds(120000));
+  barAggregator.update(UtilTime::makeTimePointFromMilliseconds(61000), "-1", "1", closedBarList);
+  EXPECT_EQ(barAggregator.getBarList()[1].getTradeCount(), 1);
+}
+} /* namespace ccapi */
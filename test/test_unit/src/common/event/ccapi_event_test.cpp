@@ -37,5 +37,19 @@ TEST(EventTest, addMessagesSomeAddSome) {
   EXPECT_EQ(e.getMessageList().at(0).getType(), Message::Type::SESSION_CONNECTION_UP);
   EXPECT_EQ(e.getMessageList().at(1).getType(), Message::Type::MARKET_DATA_EVENTS_TRADE);
 }
+TEST(EventTest, addMessagesFromEvent) {
+  Message m1;
+  m1.setType(Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+  Message m2;
+  m2.setType(Message::Type::MARKET_DATA_EVENTS_TRADE);
+  Event e1;
+  e1.setMessageList({m1});
+  Event e2;
+  e2.setMessageList({m2});
+  e1.addMessages(e2);
+  EXPECT_EQ(e1.getMessageList().size(), 2);
+  EXPECT_EQ(e1.getMessageList().at(0).getType(), Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+  EXPECT_EQ(e1.getMessageList().at(1).getType(), Message::Type::MARKET_DATA_EVENTS_TRADE);
+}
 
 } /* namespace ccapi */
@@ -0,0 +1,140 @@
+#include "ccapi_cpp/ccapi_event_batch.h"
+
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+using ::testing::ElementsAre;
+namespace ccapi {
+Event makeMarketDepthEvent(const std::string& correlationId, long long seconds, const std::vector<std::pair<std::string, std::string> >& bidList,
+                           const std::vector<std::pair<std::string, std::string> >& askList) {
+  Message message;
+  message.setType(Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+  message.setTime(TimePoint(std::chrono::seconds(seconds)));
+  message.setTimeReceived(TimePoint(std::chrono::seconds(seconds + 1)));
+  message.setCorrelationIdList({correlationId});
+  std::vector<Element> elementList;
+  for (const auto& x : bidList) {
+    Element element;
+    element.insert(CCAPI_BEST_BID_N_PRICE, x.first);
+    element.insert(CCAPI_BEST_BID_N_SIZE, x.second);
+    elementList.push_back(element);
+  }
+  for (const auto& x : askList) {
+    Element element;
+    element.insert(CCAPI_BEST_ASK_N_PRICE, x.first);
+    element.insert(CCAPI_BEST_ASK_N_SIZE, x.second);
+    elementList.push_back(element);
+  }
+  message.setElementList(elementList);
+  Event event;
+  event.setType(Event::Type::SUBSCRIPTION_DATA);
+  event.setMessageList({message});
+  return event;
+}
+TEST(EventBatchTest, marketDepth) {
+  EventBatch batch;
+  batch.add(makeMarketDepthEvent("a", 10, {{"100.5", "1"}, {"100", "2"}}, {{"101", "3"}}));
+  batch.add(makeMarketDepthEvent("b", 20, {{CCAPI_BEST_BID_N_PRICE_EMPTY, CCAPI_BEST_BID_N_SIZE_EMPTY}}, {{"50", "4"}}));
+  EXPECT_EQ(batch.getNumDepthRow(), 4);
+  EXPECT_THAT(batch.getDepthMessageIndex(), ElementsAre(0, 0, 0, 1));
+  EXPECT_THAT(batch.getDepthCorrelationIdIndex(), ElementsAre(0, 0, 0, 1));
+  EXPECT_THAT(batch.getCorrelationIdList(), ElementsAre("a", "b"));
+  EXPECT_THAT(batch.getDepthTime(), ElementsAre(10000000000LL, 10000000000LL, 10000000000LL, 20000000000LL));
+  EXPECT_THAT(batch.getDepthTimeReceived(), ElementsAre(11000000000LL, 11000000000LL, 11000000000LL, 21000000000LL));
+  EXPECT_THAT(batch.getDepthSide(), ElementsAre(0, 0, 1, 1));
+  EXPECT_THAT(batch.getDepthLevel(), ElementsAre(0, 1, 0, 0));
+  EXPECT_THAT(batch.getDepthPrice(), ElementsAre(100.5, 100, 101, 50));
+  EXPECT_THAT(batch.getDepthSize(), ElementsAre(1, 2, 3, 4));
+}
+TEST(EventBatchTest, trade) {
+  Message message;
+  message.setType(Message::Type::MARKET_DATA_EVENTS_TRADE);
+  message.setTime(TimePoint(std::chrono::milliseconds(1500)));
+  message.setCorrelationIdList({"a"});
+  Element element1;
+  element1.insert(CCAPI_LAST_PRICE, "20000.1");
+  element1.insert(CCAPI_LAST_SIZE, "0.25");
+  element1.insert(CCAPI_IS_BUYER_MAKER, "1");
+  Element element2;
+  element2.insert(CCAPI_LAST_PRICE, "20000.2");
+  element2.insert(CCAPI_LAST_SIZE, "0.5");
+  element2.insert(CCAPI_IS_BUYER_MAKER, "0");
+  message.setElementList({element1, element2});
+  Event event;
+  event.setType(Event::Type::SUBSCRIPTION_DATA);
+  event.setMessageList({message});
+  EventBatch batch;
+  batch.add(event);
+  EXPECT_EQ(batch.getNumTradeRow(), 2);
+  EXPECT_THAT(batch.getTradeCorrelationIdIndex(), ElementsAre(0, 0));
+  EXPECT_THAT(batch.getTradeTime(), ElementsAre(1500000000LL, 1500000000LL));
+  EXPECT_THAT(batch.getTradePrice(), ElementsAre(20000.1, 20000.2));
+  EXPECT_THAT(batch.getTradeSize(), ElementsAre(0.25, 0.5));
+  EXPECT_THAT(batch.getTradeIsBuyerMaker(), ElementsAre(1, 0));
+}
+TEST(EventBatchTest, drain) {
+  Queue<Event> eventQueue;
+  Event statusEvent;
+  statusEvent.setType(Event::Type::SUBSCRIPTION_STATUS);
+  statusEvent.setMessageList({Message()});
+  eventQueue.pushBack(statusEvent);
+  eventQueue.pushBack(makeMarketDepthEvent("a", 10, {{"100", "1"}}, {{"101", "1"}}));
+  Message candlestickMessage;
+  candlestickMessage.setType(Message::Type::MARKET_DATA_EVENTS_CANDLESTICK);
+  Event candlestickEvent;
+  candlestickEvent.setType(Event::Type::SUBSCRIPTION_DATA);
+  candlestickEvent.setMessageList({candlestickMessage});
+  eventQueue.pushBack(candlestickEvent);
+  EventBatch batch;
+  EXPECT_EQ(batch.drain(eventQueue), 3);
+  EXPECT_TRUE(eventQueue.empty());
+  EXPECT_EQ(batch.getNumDepthRow(), 2);
+  EXPECT_EQ(batch.getOtherEventList().size(), 1);
+  EXPECT_EQ(batch.getOtherEventList().at(0).getType(), Event::Type::SUBSCRIPTION_STATUS);
+  EXPECT_EQ(batch.getOtherMessageList().size(), 1);
+  EXPECT_EQ(batch.getOtherMessageList().at(0).getType(), Message::Type::MARKET_DATA_EVENTS_CANDLESTICK);
+  eventQueue.pushBack(makeMarketDepthEvent("b", 20, {{"100", "1"}}, {}));
+  EXPECT_EQ(batch.drain(eventQueue), 1);
+  EXPECT_EQ(batch.getNumDepthRow(), 1);
+  EXPECT_THAT(batch.getDepthCorrelationIdIndex(), ElementsAre(1));
+  EXPECT_TRUE(batch.getOtherEventList().empty());
+  auto startTp = std::chrono::steady_clock::now();
+  EXPECT_EQ(batch.drain(eventQueue, 20), 0);
+  EXPECT_GE(std::chrono::steady_clock::now() - startTp, std::chrono::milliseconds(20));
+  EXPECT_EQ(batch.getNumDepthRow(), 0);
+}
+TEST(EventBatchTest, drainWakesUpOnPush) {
+  Queue<Event> eventQueue;
+  EventBatch batch;
+  std::thread thread([&eventQueue] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    eventQueue.pushBack(makeMarketDepthEvent("a", 10, {{"100", "1"}}, {}));
+  });
+  auto startTp = std::chrono::steady_clock::now();
+  EXPECT_EQ(batch.drain(eventQueue, 10000), 1);
+  EXPECT_LT(std::chrono::steady_clock::now() - startTp, std::chrono::seconds(5));
+  EXPECT_EQ(batch.getNumDepthRow(), 1);
+  thread.join();
+}
+TEST(EventBatchTest, holdColumns) {
+  Queue<Event> eventQueue;
+  EventBatch batch;
+  EXPECT_TRUE(batch.holdColumns());
+  EXPECT_TRUE(batch.holdColumns());
+  EXPECT_THROW(batch.drain(eventQueue), std::runtime_error);
+  batch.releaseColumns();
+  EXPECT_THROW(batch.drain(eventQueue), std::runtime_error);
+  batch.releaseColumns();
+  EXPECT_EQ(batch.drain(eventQueue), 0);
+  std::thread thread([&eventQueue, &batch] { EXPECT_EQ(batch.drain(eventQueue, 10000), 1); });
+  while (batch.numColumnHold.load() >= 0) {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(batch.holdColumns());
+  eventQueue.pushBack(makeMarketDepthEvent("a", 10, {{"100", "1"}}, {}));
+  thread.join();
+  EXPECT_TRUE(batch.holdColumns());
+  batch.releaseColumns();
+}
+} /* namespace ccapi */
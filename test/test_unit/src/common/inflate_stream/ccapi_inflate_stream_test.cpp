@@ -0,0 +1,41 @@
+#include "ccapi_cpp/ccapi_inflate_stream.h"
+
+#include "gtest/gtest.h"
+namespace ccapi {
+// compresses input the way a websocket peer does: raw deflate, flushed at the end of the message
+std::string deflateRaw(const std::string& input) {
+  z_stream dstate{};
+  deflateInit2(&dstate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  std::string output(deflateBound(&dstate, input.size()) + 16, '\0');
+  dstate.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(input.data()));
+  dstate.avail_in = input.size();
+  dstate.next_out = reinterpret_cast<unsigned char*>(&output[0]);
+  dstate.avail_out = output.size();
+  deflate(&dstate, Z_SYNC_FLUSH);
+  output.resize(output.size() - dstate.avail_out);
+  deflateEnd(&dstate);
+  return output;
+}
+TEST(InflateStreamTest, decompressReusesOutput) {
+  InflateStream inflater;
+  inflater.init();
+  std::string first(3000000, 'a');
+  auto compressed = deflateRaw(first);
+  boost::beast::string_view decompressed;
+  inflater.decompress(reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size(), decompressed);
+  EXPECT_EQ(std::string(decompressed), first);
+  EXPECT_EQ(decompressed.data()[decompressed.size()], '\0');
+  inflater.inflate_reset();
+  const char* outputData = decompressed.data();
+  std::string second("{\"ch\":\"market.btcusdt.trade.detail\"}");
+  compressed = deflateRaw(second);
+  inflater.decompress(reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size(), decompressed);
+  EXPECT_EQ(std::string(decompressed), second);
+  EXPECT_EQ(decompressed.data(), outputData);
+  EXPECT_EQ(decompressed.data()[decompressed.size()], '\0');
+  inflater.inflate_reset();
+  std::string output("x");
+  inflater.decompress(reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size(), output);
+  EXPECT_EQ(output, "x" + second);
+}
+} /* namespace ccapi */
@@ -0,0 +1,171 @@
+#include "ccapi_cpp/ccapi_instrument_registry.h"
+
+#include <cstdio>
+
+#include "gtest/gtest.h"
+namespace ccapi {
+Message makeInstrumentsMessage(const std::vector<std::vector<std::string> >& instrumentList, const std::string& correlationId = "") {
+  Message message;
+  message.setType(Message::Type::GET_INSTRUMENTS);
+  message.setCorrelationIdList({correlationId});
+  std::vector<Element> elementList;
+  for (const auto& x : instrumentList) {
+    Element element;
+    element.insert(CCAPI_INSTRUMENT, x.at(0));
+    element.insert(CCAPI_ORDER_PRICE_INCREMENT, x.at(1));
+    element.insert(CCAPI_ORDER_QUANTITY_INCREMENT, x.at(2));
+    elementList.push_back(element);
+  }
+  message.setElementList(elementList);
+  return message;
+}
+// answers every GET_INSTRUMENTS request with one instrument named after its exchange, or with an error if isFailing
+class FakeSession {
+ public:
+  void sendRequest(std::vector<Request>& requestList, Queue<Event>* eventQueuePtr) {
+    for (const auto& request : requestList) {
+      Event event;
+      event.setType(Event::Type::RESPONSE);
+      if (this->isFailing) {
+        Message message;
+        message.setType(Message::Type::RESPONSE_ERROR);
+        message.setCorrelationIdList({request.getCorrelationId()});
+        event.setMessageList({message});
+      } else {
+        event.setMessageList({makeInstrumentsMessage({{request.getExchange() + "-usd", "0.01", "0.001"}}, request.getCorrelationId())});
+      }
+      eventQueuePtr->pushBack(event);
+    }
+    ++this->numCall;
+  }
+  bool isFailing{};
+  int numCall{};
+};
+TEST(InstrumentInfoTest, scale) {
+  auto instrumentInfo = InstrumentInfo::create("binance", {{CCAPI_INSTRUMENT, "BTCUSDT"},
+                                                           {CCAPI_ORDER_PRICE_INCREMENT, "0.01000000"},
+                                                           {CCAPI_ORDER_QUANTITY_INCREMENT, "0.00001000"}});
+  EXPECT_EQ(instrumentInfo.priceScale, 2);
+  EXPECT_EQ(instrumentInfo.priceIncrementUnits, 1);
+  EXPECT_EQ(instrumentInfo.getPriceScaleFactor(), 100);
+  EXPECT_EQ(instrumentInfo.quantityScale, 5);
+  EXPECT_EQ(instrumentInfo.getQuantityScaleFactor(), 100000);
+  auto halfTick = InstrumentInfo::create("kraken", {{CCAPI_INSTRUMENT, "XBT/USD"}, {CCAPI_ORDER_PRICE_INCREMENT, "0.5"}, {CCAPI_ORDER_QUANTITY_INCREMENT, "1e-8"}});
+  EXPECT_EQ(halfTick.priceScale, 1);
+  EXPECT_EQ(halfTick.priceIncrementUnits, 5);
+  EXPECT_EQ(halfTick.quantityScale, 8);
+  EXPECT_EQ(halfTick.quantityIncrementUnits, 1);
+  auto unknown = InstrumentInfo::create("gemini", {{CCAPI_INSTRUMENT, "btcusd"}});
+  int64_t x = 0;
+  EXPECT_FALSE(unknown.convertPriceToInteger("1", x));
+  EXPECT_EQ(unknown.roundPrice("1.234"), "1.234");
+}
+TEST(InstrumentInfoTest, convert) {
+  auto instrumentInfo =
+      InstrumentInfo::create("binance", {{CCAPI_INSTRUMENT, "BTCUSDT"}, {CCAPI_ORDER_PRICE_INCREMENT, "0.01"}, {CCAPI_ORDER_QUANTITY_INCREMENT, "0.001"}});
+  int64_t x = 0;
+  EXPECT_TRUE(instrumentInfo.convertPriceToInteger("30000.5", x));
+  EXPECT_EQ(x, 3000050);
+  EXPECT_TRUE(instrumentInfo.convertPriceToInteger("30000.50000000", x));
+  EXPECT_EQ(x, 3000050);
+  EXPECT_EQ(instrumentInfo.convertIntegerToPrice(x), "30000.5");
+  EXPECT_TRUE(instrumentInfo.convertQuantityToInteger("2", x));
+  EXPECT_EQ(x, 2000);
+  EXPECT_EQ(instrumentInfo.convertIntegerToQuantity(x), "2");
+  EXPECT_FALSE(instrumentInfo.convertPriceToInteger("30000.505", x));
+  EXPECT_FALSE(instrumentInfo.convertPriceToInteger("-1", x));
+  EXPECT_FALSE(instrumentInfo.convertPriceToInteger("123456789012345678901", x));
+  EXPECT_TRUE(instrumentInfo.isPriceOnGrid(3000050));
+  auto halfTick = InstrumentInfo::create("kraken", {{CCAPI_INSTRUMENT, "XBT/USD"}, {CCAPI_ORDER_PRICE_INCREMENT, "0.5"}});
+  EXPECT_TRUE(halfTick.convertPriceToInteger("30000.5", x));
+  EXPECT_TRUE(halfTick.isPriceOnGrid(x));
+  EXPECT_TRUE(halfTick.convertPriceToInteger("30000.2", x));
+  EXPECT_FALSE(halfTick.isPriceOnGrid(x));
+}
+TEST(InstrumentInfoTest, round) {
+  auto instrumentInfo =
+      InstrumentInfo::create("kraken", {{CCAPI_INSTRUMENT, "XBT/USD"}, {CCAPI_ORDER_PRICE_INCREMENT, "0.5"}, {CCAPI_ORDER_QUANTITY_INCREMENT, "0.001"}});
+  EXPECT_EQ(instrumentInfo.roundPrice("30000.7"), "30000.5");
+  EXPECT_EQ(instrumentInfo.roundPrice("30000.7", true), "30001");
+  EXPECT_EQ(instrumentInfo.roundPrice("30000.5", true), "30000.5");
+  EXPECT_EQ(instrumentInfo.roundPrice("30000.51", true), "30001");
+  EXPECT_EQ(instrumentInfo.roundPrice("30000.01"), "30000");
+  EXPECT_EQ(instrumentInfo.roundQuantity("1.23456"), "1.234");
+  EXPECT_EQ(instrumentInfo.roundQuantity("0.0009"), "0");
+}
+TEST(InstrumentRegistryTest, update) {
+  InstrumentRegistry instrumentRegistry;
+  EXPECT_EQ(instrumentRegistry.update("binance", makeInstrumentsMessage({{"BTCUSDT", "0.01", "0.00001"}, {"ETHUSDT", "0.01", "0.0001"}})), 2);
+  EXPECT_EQ(instrumentRegistry.update("okx", makeInstrumentsMessage({{"BTC-USDT", "0.1", "0.00000001"}})), 1);
+  EXPECT_EQ(instrumentRegistry.size(), 3);
+  EXPECT_EQ(instrumentRegistry.getList("binance").size(), 2);
+  auto instrumentInfo = instrumentRegistry.get("binance", "BTCUSDT");
+  ASSERT_TRUE(instrumentInfo);
+  EXPECT_EQ(instrumentInfo->priceScale, 2);
+  EXPECT_FALSE(instrumentRegistry.get("binance", "BTC-USDT"));
+  EXPECT_FALSE(instrumentRegistry.get("kraken", "BTCUSDT"));
+  instrumentRegistry.update("binance", makeInstrumentsMessage({{"BTCUSDT", "0.1", "0.00001"}}));
+  EXPECT_EQ(instrumentRegistry.get("binance", "BTCUSDT")->priceScale, 1);
+  // a pointer that has been handed out keeps its contents
+  EXPECT_EQ(instrumentInfo->priceScale, 2);
+  Message message;
+  message.setType(Message::Type::RESPONSE_ERROR);
+  EXPECT_EQ(instrumentRegistry.update("binance", message), 0);
+}
+TEST(InstrumentRegistryTest, saveAndLoad) {
+  std::string filePath = "ccapi_instrument_registry_test.tsv";
+  {
+    InstrumentRegistry instrumentRegistry;
+    instrumentRegistry.update("binance", makeInstrumentsMessage({{"BTCUSDT", "0.01", "0.00001"}, {"ETHUSDT", "0.01", "0.0001"}}));
+    instrumentRegistry.update("kraken", makeInstrumentsMessage({{"XBT/USD", "0.5", "1e-8"}}));
+    EXPECT_TRUE(instrumentRegistry.save(filePath));
+  }
+  InstrumentRegistry instrumentRegistry;
+  EXPECT_EQ(instrumentRegistry.load(filePath), 3);
+  auto instrumentInfo = instrumentRegistry.get("kraken", "XBT/USD");
+  ASSERT_TRUE(instrumentInfo);
+  EXPECT_EQ(instrumentInfo->priceIncrement, "0.5");
+  EXPECT_EQ(instrumentInfo->quantityScale, 8);
+  EXPECT_EQ(instrumentInfo->baseAsset, "");
+  EXPECT_EQ(instrumentRegistry.get("binance", "ETHUSDT")->quantityScale, 4);
+  std::remove(filePath.c_str());
+  EXPECT_EQ(instrumentRegistry.load(filePath), -1);
+}
+TEST(InstrumentRegistryTest, refresh) {
+  InstrumentRegistry instrumentRegistry;
+  FakeSession session;
+  EXPECT_EQ(instrumentRegistry.refresh(session, {Request(Request::Operation::GET_INSTRUMENTS, "binance"), Request(Request::Operation::GET_INSTRUMENTS, "okx")}),
+            2);
+  EXPECT_TRUE(instrumentRegistry.get("binance", "binance-usd"));
+  EXPECT_TRUE(instrumentRegistry.get("okx", "okx-usd"));
+  EXPECT_GT(instrumentRegistry.getLastRefreshTp(), TimePoint(std::chrono::seconds(0)));
+}
+TEST(InstrumentRegistryTest, refreshFailure) {
+  InstrumentRegistry instrumentRegistry;
+  FakeSession session;
+  session.isFailing = true;
+  EXPECT_EQ(instrumentRegistry.refresh(session, {Request(Request::Operation::GET_INSTRUMENTS, "binance")}), 0);
+  EXPECT_EQ(instrumentRegistry.getLastRefreshTp(), TimePoint(std::chrono::seconds(0)));
+  session.isFailing = false;
+  EXPECT_EQ(instrumentRegistry.refresh(session, {Request(Request::Operation::GET_INSTRUMENTS, "binance")}), 1);
+  auto lastRefreshTp = instrumentRegistry.getLastRefreshTp();
+  EXPECT_GT(lastRefreshTp, TimePoint(std::chrono::seconds(0)));
+  session.isFailing = true;
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_EQ(instrumentRegistry.refresh(session, {Request(Request::Operation::GET_INSTRUMENTS, "binance")}), 0);
+  EXPECT_EQ(instrumentRegistry.getLastRefreshTp(), lastRefreshTp);
+  EXPECT_TRUE(instrumentRegistry.get("binance", "binance-usd"));
+}
+TEST(InstrumentRegistryTest, startRefresh) {
+  std::string filePath = "ccapi_instrument_registry_refresh_test.tsv";
+  InstrumentRegistry instrumentRegistry;
+  FakeSession session;
+  instrumentRegistry.startRefresh(session, {Request(Request::Operation::GET_INSTRUMENTS, "binance")}, 10, filePath);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  instrumentRegistry.stopRefresh();
+  EXPECT_GE(session.numCall, 2);
+  InstrumentRegistry loaded;
+  EXPECT_EQ(loaded.load(filePath), 1);
+  std::remove(filePath.c_str());
+}
+} /* namespace ccapi */
@@ -0,0 +1,67 @@
+#include "ccapi_cpp/ccapi_latency_stats.h"
+
+#include "gtest/gtest.h"
+namespace ccapi {
+TEST(LatencyHistogramTest, bucketIndexSmallValue) {
+  for (uint64_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(LatencyHistogram::bucketIndex(i), i);
+    EXPECT_EQ(LatencyHistogram::bucketLowerBound(i), i);
+    EXPECT_EQ(LatencyHistogram::bucketWidth(i), 1);
+  }
+}
+TEST(LatencyHistogramTest, bucketIndexLargeValue) {
+  for (uint64_t value : std::vector<uint64_t>{16, 17, 31, 32, 33, 1000, 123456789, uint64_t(1) << 40, UINT64_MAX}) {
+    int index = LatencyHistogram::bucketIndex(value);
+    ASSERT_LT(index, LatencyHistogram::numBucket);
+    uint64_t lowerBound = LatencyHistogram::bucketLowerBound(index);
+    EXPECT_LE(lowerBound, value);
+    EXPECT_LE(value - lowerBound, LatencyHistogram::bucketWidth(index) - 1);
+    EXPECT_LE(LatencyHistogram::bucketWidth(index) * 16, lowerBound);
+  }
+}
+TEST(LatencyHistogramTest, empty) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.getCount(), 0);
+  EXPECT_EQ(histogram.getMin(), 0);
+  EXPECT_EQ(histogram.getMax(), 0);
+  EXPECT_EQ(histogram.getValueAtPercentile(50), 0);
+}
+TEST(LatencyHistogramTest, percentile) {
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.record(i * 1000);
+  }
+  EXPECT_EQ(histogram.getCount(), 1000);
+  EXPECT_EQ(histogram.getSum(), 500500000);
+  EXPECT_EQ(histogram.getMin(), 1000);
+  EXPECT_EQ(histogram.getMax(), 1000000);
+  EXPECT_NEAR(histogram.getValueAtPercentile(50), 500000, 500000 / 16);
+  EXPECT_NEAR(histogram.getValueAtPercentile(99), 990000, 990000 / 16);
+  EXPECT_EQ(histogram.getValueAtPercentile(100), 1000000);
+  histogram.reset();
+  EXPECT_EQ(histogram.getCount(), 0);
+  EXPECT_EQ(histogram.getMin(), 0);
+}
+TEST(LatencyStatsTest, summary) {
+  LatencyStats latencyStats("binance");
+  latencyStats.record(LatencyStats::Stage::PARSE, 100, 300);
+  latencyStats.record(LatencyStats::Stage::PARSE, 0, 300);
+  latencyStats.record(LatencyStats::Stage::PARSE, 400, 300);
+  auto summaryList = latencyStats.getSummaryList();
+  ASSERT_EQ(summaryList.size(), LatencyStats::numStage);
+  EXPECT_EQ(summaryList.at(static_cast<int>(LatencyStats::Stage::PARSE)).stage, "PARSE");
+  EXPECT_EQ(summaryList.at(static_cast<int>(LatencyStats::Stage::PARSE)).exchange, "binance");
+  EXPECT_EQ(summaryList.at(static_cast<int>(LatencyStats::Stage::PARSE)).count, 1);
+  EXPECT_EQ(summaryList.at(static_cast<int>(LatencyStats::Stage::DECOMPRESS)).count, 0);
+}
+TEST(LatencyStatsTest, calibratedAtConstruction) {
+  LatencyStats latencyStats("binance");
+  auto startTsc = TscClock::now();
+  auto startTp = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - startTp < std::chrono::microseconds(200)) {
+  }
+  double nanosecondsPerTick = latencyStats.getNanosecondsPerTick();
+  auto elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTp).count();
+  EXPECT_NEAR((TscClock::now() - startTsc) * nanosecondsPerTick, elapsedNanoseconds, elapsedNanoseconds * 0.2);
+}
+} /* namespace ccapi */
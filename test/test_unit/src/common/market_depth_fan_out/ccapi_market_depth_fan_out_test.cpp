@@ -0,0 +1,174 @@
+#include "ccapi_cpp/ccapi_market_depth_fan_out.h"
+
+#include "gtest/gtest.h"
+namespace ccapi {
+Message makeMarketDepthMessage(const std::string& correlationId, long long milliseconds, const std::vector<std::pair<std::string, std::string> >& bidList,
+                               const std::vector<std::pair<std::string, std::string> >& askList, bool isInitial = false) {
+  Message message;
+  message.setType(Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+  message.setRecapType(isInitial ? Message::RecapType::SOLICITED : Message::RecapType::NONE);
+  message.setTime(UtilTime::makeTimePointFromMilliseconds(milliseconds));
+  std::vector<Element> elementList;
+  for (const auto& x : bidList) {
+    Element element;
+    element.insert(CCAPI_BEST_BID_N_PRICE, x.first);
+    element.insert(CCAPI_BEST_BID_N_SIZE, x.second);
+    elementList.push_back(element);
+  }
+  for (const auto& x : askList) {
+    Element element;
+    element.insert(CCAPI_BEST_ASK_N_PRICE, x.first);
+    element.insert(CCAPI_BEST_ASK_N_SIZE, x.second);
+    elementList.push_back(element);
+  }
+  message.setElementList(elementList);
+  message.setCorrelationIdList({correlationId});
+  return message;
+}
+Event makeEvent(const Message& message) {
+  Event event;
+  event.setType(Event::Type::SUBSCRIPTION_DATA);
+  event.setMessageList({message});
+  return event;
+}
+TEST(MarketDepthFanOutTest, merge) {
+  MarketDepthFanOut fanOut;
+  std::vector<Subscription> subscriptionList = {
+      Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=1", "a"),
+      Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=10&CONFLATE_INTERVAL_MILLISECONDS=1000", "b"),
+      Subscription("okx", "BTC-USDT", "TRADE", "", "c"),
+      Subscription("okx", "ETH-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=5", "d"),
+      Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=5&MARKET_DEPTH_RETURN_UPDATE=1", "e"),
+  };
+  auto output = fanOut.merge(subscriptionList);
+  ASSERT_EQ(output.size(), 4);
+  EXPECT_EQ(output.at(0).getCorrelationId(), "c");
+  EXPECT_EQ(output.at(1).getCorrelationId(), "e");
+  const auto& upstream = output.at(2);
+  EXPECT_EQ(upstream.getInstrument(), "BTC-USDT");
+  EXPECT_EQ(upstream.getOptionMap().at(CCAPI_MARKET_DEPTH_MAX), "10");
+  EXPECT_EQ(upstream.getOptionMap().at(CCAPI_CONFLATE_INTERVAL_MILLISECONDS), CCAPI_CONFLATE_INTERVAL_MILLISECONDS_DEFAULT);
+  EXPECT_EQ(output.at(3).getCorrelationId(), "d");
+  EXPECT_EQ(fanOut.viewListByUpstreamCorrelationIdMap.at(upstream.getCorrelationId()).size(), 2);
+}
+TEST(MarketDepthFanOutTest, depth) {
+  MarketDepthFanOut fanOut;
+  auto upstream = fanOut.merge({
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=1", "a"),
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=2", "b"),
+                               })
+                      .at(0);
+  auto event = makeEvent(makeMarketDepthMessage(upstream.getCorrelationId(), 1000, {{"100", "1"}, {"99", "1"}}, {{"101", "1"}, {"102", "1"}}, true));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 2);
+  EXPECT_EQ(event.getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"a"}));
+  EXPECT_EQ(event.getMessageList().at(0).getRecapType(), Message::RecapType::SOLICITED);
+  ASSERT_EQ(event.getMessageList().at(0).getElementList().size(), 2);
+  EXPECT_EQ(event.getMessageList().at(0).getElementList().at(1).getValue(CCAPI_BEST_ASK_N_PRICE), "101");
+  EXPECT_EQ(event.getMessageList().at(1).getCorrelationIdList(), std::vector<std::string>({"b"}));
+  EXPECT_EQ(event.getMessageList().at(1).getElementList().size(), 4);
+  event = makeEvent(makeMarketDepthMessage(upstream.getCorrelationId(), 1100, {{"100", "1"}, {"99", "2"}}, {{"101", "1"}, {"102", "1"}}));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 1);
+  EXPECT_EQ(event.getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"b"}));
+  EXPECT_EQ(event.getMessageList().at(0).getRecapType(), Message::RecapType::NONE);
+  event = makeEvent(makeMarketDepthMessage(upstream.getCorrelationId(), 1200, {{"100", "1"}, {"99", "2"}}, {{"101", "1"}, {"102", "3"}}));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  event = makeEvent(makeMarketDepthMessage(upstream.getCorrelationId(), 1300, {{"100", "1"}, {"99", "2"}}, {{"101", "1"}, {"102", "3"}}));
+  EXPECT_FALSE(fanOut.fanOut(event));
+  EXPECT_TRUE(event.getMessageList().empty());
+}
+TEST(MarketDepthFanOutTest, conflate) {
+  MarketDepthFanOut fanOut;
+  auto upstream = fanOut.merge({
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=1", "a"),
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "CONFLATE_INTERVAL_MILLISECONDS=1000", "b"),
+                               })
+                      .at(0);
+  const auto& correlationId = upstream.getCorrelationId();
+  auto event = makeEvent(makeMarketDepthMessage(correlationId, 1500, {{"100", "1"}}, {{"101", "1"}}, true));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  EXPECT_EQ(event.getMessageList().size(), 2);
+  event = makeEvent(makeMarketDepthMessage(correlationId, 1600, {{"100", "2"}}, {{"101", "1"}}));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 1);
+  EXPECT_EQ(event.getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"a"}));
+  event = makeEvent(makeMarketDepthMessage(correlationId, 1700, {{"100", "3"}}, {{"101", "1"}}));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 1);
+  event = makeEvent(makeMarketDepthMessage(correlationId, 2100, {{"100", "4"}}, {{"101", "1"}}));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 2);
+  const auto& message = event.getMessageList().at(1);
+  EXPECT_EQ(message.getCorrelationIdList(), std::vector<std::string>({"b"}));
+  EXPECT_EQ(message.getTime(), UtilTime::makeTimePointFromMilliseconds(2000));
+  EXPECT_EQ(message.getElementList().at(0).getValue(CCAPI_BEST_BID_N_SIZE), "3");
+}
+TEST(MarketDepthFanOutTest, flush) {
+  MarketDepthFanOut fanOut;
+  auto upstream = fanOut.merge({
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=1", "a"),
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=2", "b"),
+                               })
+                      .at(0);
+  EXPECT_FALSE(fanOut.isFlushNeeded());
+  Event event;
+  EXPECT_EQ(fanOut.flush(event, UtilTime::makeTimePointFromMilliseconds(1000)), TimePoint::max());
+  EXPECT_TRUE(event.getMessageList().empty());
+  upstream = fanOut.merge({
+                              Subscription("okx", "ETH-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=1", "c"),
+                              Subscription("okx", "ETH-USDT", "MARKET_DEPTH", "CONFLATE_INTERVAL_MILLISECONDS=1000", "d"),
+                          })
+                 .at(0);
+  EXPECT_TRUE(fanOut.isFlushNeeded());
+  const auto& correlationId = upstream.getCorrelationId();
+  event = makeEvent(makeMarketDepthMessage(correlationId, 1500, {{"100", "1"}}, {{"101", "1"}}, true));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  EXPECT_EQ(fanOut.flush(event, UtilTime::makeTimePointFromMilliseconds(1600)), UtilTime::makeTimePointFromMilliseconds(2000));
+  EXPECT_TRUE(event.getMessageList().empty());
+  event = makeEvent(makeMarketDepthMessage(correlationId, 1700, {{"100", "3"}}, {{"101", "1"}}));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 1);
+  // the upstream goes quiet: the change is delivered at the end of its interval rather than with the next upstream message
+  EXPECT_EQ(fanOut.flush(event, UtilTime::makeTimePointFromMilliseconds(1999)), UtilTime::makeTimePointFromMilliseconds(2000));
+  EXPECT_TRUE(event.getMessageList().empty());
+  EXPECT_EQ(fanOut.flush(event, UtilTime::makeTimePointFromMilliseconds(2001)), UtilTime::makeTimePointFromMilliseconds(3000));
+  EXPECT_EQ(event.getType(), Event::Type::SUBSCRIPTION_DATA);
+  ASSERT_EQ(event.getMessageList().size(), 1);
+  const auto& message = event.getMessageList().at(0);
+  EXPECT_EQ(message.getType(), Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+  EXPECT_EQ(message.getCorrelationIdList(), std::vector<std::string>({"d"}));
+  EXPECT_EQ(message.getTime(), UtilTime::makeTimePointFromMilliseconds(2000));
+  EXPECT_EQ(message.getElementList().at(0).getValue(CCAPI_BEST_BID_N_SIZE), "3");
+  // delivered once: neither a later flush nor the next upstream message repeats it
+  EXPECT_EQ(fanOut.flush(event, UtilTime::makeTimePointFromMilliseconds(3500)), UtilTime::makeTimePointFromMilliseconds(4000));
+  EXPECT_TRUE(event.getMessageList().empty());
+  event = makeEvent(makeMarketDepthMessage(correlationId, 4100, {{"100", "3"}}, {{"101", "2"}}));
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 1);
+  EXPECT_EQ(event.getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"c"}));
+}
+TEST(MarketDepthFanOutTest, status) {
+  MarketDepthFanOut fanOut;
+  auto upstream = fanOut.merge({
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=1", "a"),
+                                   Subscription("okx", "BTC-USDT", "MARKET_DEPTH", "MARKET_DEPTH_MAX=5", "b"),
+                               })
+                      .at(0);
+  Event event;
+  event.setType(Event::Type::SUBSCRIPTION_STATUS);
+  Message message;
+  message.setType(Message::Type::SUBSCRIPTION_STARTED);
+  message.setCorrelationIdList({upstream.getCorrelationId()});
+  event.setMessageList({message});
+  ASSERT_TRUE(fanOut.fanOut(event));
+  ASSERT_EQ(event.getMessageList().size(), 1);
+  EXPECT_EQ(event.getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"a", "b"}));
+  Event otherEvent;
+  otherEvent.setType(Event::Type::SUBSCRIPTION_STATUS);
+  message.setCorrelationIdList({"c"});
+  otherEvent.setMessageList({message});
+  ASSERT_TRUE(fanOut.fanOut(otherEvent));
+  EXPECT_EQ(otherEvent.getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"c"}));
+}
+} /* namespace ccapi */
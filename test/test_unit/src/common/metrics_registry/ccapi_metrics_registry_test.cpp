@@ -0,0 +1,99 @@
+#include "ccapi_cpp/ccapi_metrics_registry.h"
+
+#include "ccapi_cpp/ccapi_metrics_http_server.h"
+#include "gtest/gtest.h"
+namespace ccapi {
+TEST(MetricsRegistryTest, counter) {
+  MetricsRegistry metricsRegistry;
+  auto& counter = metricsRegistry.getCounter("ccapi_test_total", {{"exchange", "binance"}});
+  counter.increment();
+  counter.increment(2);
+  EXPECT_EQ(&metricsRegistry.getCounter("ccapi_test_total", {{"exchange", "binance"}}), &counter);
+  EXPECT_NE(&metricsRegistry.getCounter("ccapi_test_total", {{"exchange", "okx"}}), &counter);
+  auto sampleList = metricsRegistry.getSampleList();
+  ASSERT_EQ(sampleList.size(), 2);
+  EXPECT_EQ(sampleList.at(0).name, "ccapi_test_total");
+  EXPECT_EQ(sampleList.at(0).labelMap.at("exchange"), "binance");
+  EXPECT_EQ(sampleList.at(0).type, MetricsRegistry::Type::COUNTER);
+  EXPECT_DOUBLE_EQ(sampleList.at(0).value, 3);
+  EXPECT_DOUBLE_EQ(sampleList.at(1).value, 0);
+}
+TEST(MetricsRegistryTest, gauge) {
+  MetricsRegistry metricsRegistry;
+  auto& gauge = metricsRegistry.getGauge("ccapi_test");
+  gauge.set(5);
+  gauge.increment(2.5);
+  gauge.decrement();
+  EXPECT_DOUBLE_EQ(gauge.getValue(), 6.5);
+}
+TEST(MetricsRegistryTest, remove) {
+  MetricsRegistry metricsRegistry;
+  metricsRegistry.getGauge("ccapi_test", {{"a", "1"}}).set(1);
+  metricsRegistry.getGauge("ccapi_test", {{"a", "2"}}).set(2);
+  metricsRegistry.remove("ccapi_test", {{"a", "1"}});
+  auto sampleList = metricsRegistry.getSampleList();
+  ASSERT_EQ(sampleList.size(), 1);
+  EXPECT_EQ(sampleList.at(0).labelMap, (std::map<std::string, std::string>{{"a", "2"}}));
+  EXPECT_DOUBLE_EQ(metricsRegistry.getGauge("ccapi_test", {{"a", "1"}}).getValue(), 0);
+}
+TEST(MetricsRegistryTest, typeMismatch) {
+  MetricsRegistry metricsRegistry;
+  metricsRegistry.getCounter("ccapi_test");
+  EXPECT_THROW(metricsRegistry.getGauge("ccapi_test"), std::runtime_error);
+}
+TEST(MetricsRegistryTest, callback) {
+  MetricsRegistry metricsRegistry;
+  double value = 1;
+  metricsRegistry.setCallback(MetricsRegistry::Type::GAUGE, "ccapi_test", {}, "", [&value]() { return value; });
+  value = 7;
+  auto sampleList = metricsRegistry.getSampleList();
+  ASSERT_EQ(sampleList.size(), 1);
+  EXPECT_DOUBLE_EQ(sampleList.at(0).value, 7);
+  metricsRegistry.removeCallback("ccapi_test");
+  EXPECT_TRUE(metricsRegistry.getSampleList().empty());
+}
+TEST(MetricsRegistryTest, toPrometheusText) {
+  MetricsRegistry metricsRegistry;
+  metricsRegistry.getCounter("ccapi_test_total", {{"exchange", "bin\"ance"}}, "A test counter.").increment(3);
+  metricsRegistry.getHistogram("ccapi_test_nanoseconds", {{"operation", "CREATE_ORDER"}}).record(1000);
+  EXPECT_EQ(metricsRegistry.toPrometheusText(),
+            "# TYPE ccapi_test_nanoseconds summary\n"
+            "ccapi_test_nanoseconds{operation=\"CREATE_ORDER\",quantile=\"0.5\"} 1000\n"
+            "ccapi_test_nanoseconds{operation=\"CREATE_ORDER\",quantile=\"0.9\"} 1000\n"
+            "ccapi_test_nanoseconds{operation=\"CREATE_ORDER\",quantile=\"0.99\"} 1000\n"
+            "ccapi_test_nanoseconds{operation=\"CREATE_ORDER\",quantile=\"0.999\"} 1000\n"
+            "ccapi_test_nanoseconds_sum{operation=\"CREATE_ORDER\"} 1000\n"
+            "ccapi_test_nanoseconds_count{operation=\"CREATE_ORDER\"} 1\n"
+            "# HELP ccapi_test_total A test counter.\n"
+            "# TYPE ccapi_test_total counter\n"
+            "ccapi_test_total{exchange=\"bin\\\"ance\"} 3\n");
+}
+TEST(MetricsRegistryTest, valueToText) {
+  EXPECT_EQ(MetricsRegistry::valueToText(3), "3");
+  EXPECT_EQ(MetricsRegistry::valueToText(-2.5), "-2.5");
+  EXPECT_EQ(MetricsRegistry::valueToText(1e20), "1e+20");
+  EXPECT_EQ(MetricsRegistry::valueToText(std::numeric_limits<double>::infinity()), "+Inf");
+  EXPECT_EQ(MetricsRegistry::valueToText(-std::numeric_limits<double>::infinity()), "-Inf");
+  EXPECT_EQ(MetricsRegistry::valueToText(std::numeric_limits<double>::quiet_NaN()), "NaN");
+}
+TEST(MetricsHttpServerTest, idleClientTimesOut) {
+  boost::asio::io_context ioContext;
+  auto metricsHttpServerPtr = std::make_shared<MetricsHttpServer>(ioContext, std::make_shared<MetricsRegistry>(), 100);
+  metricsHttpServerPtr->start("127.0.0.1", 0);
+  boost::asio::ip::tcp::socket socket(ioContext);
+  socket.connect(metricsHttpServerPtr->acceptor.local_endpoint());
+  char data;
+  boost::system::error_code readEc;
+  bool isRead = false;
+  socket.async_read_some(boost::asio::buffer(&data, 1), [&](const boost::system::error_code& ec, std::size_t) {
+    readEc = ec;
+    isRead = true;
+    metricsHttpServerPtr->stop();
+  });
+  auto startTp = std::chrono::steady_clock::now();
+  ioContext.run_for(std::chrono::seconds(5));
+  EXPECT_TRUE(isRead);
+  EXPECT_TRUE(readEc);
+  EXPECT_LT(std::chrono::steady_clock::now() - startTp, std::chrono::seconds(2));
+}
+} /* namespace ccapi */
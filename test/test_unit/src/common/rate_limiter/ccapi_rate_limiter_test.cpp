@@ -0,0 +1,88 @@
+#include "ccapi_cpp/ccapi_rate_limiter.h"
+
+#include "gtest/gtest.h"
+namespace ccapi {
+typedef RateLimiter<int>::Priority Priority;
+TEST(RateLimiterTest, releaseWithinLimit) {
+  RateLimiter<int> rateLimiter;
+  rateLimiter.setLimit("WEIGHT", 10, std::chrono::seconds(1));
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 4}}, 1);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 4}}, 2);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 4}}, 3);
+  EXPECT_EQ(rateLimiter.pop(tp), std::vector<int>({1, 2}));
+  EXPECT_EQ(rateLimiter.getNumPending(), 1);
+  EXPECT_EQ(rateLimiter.getNextReleaseTp(tp), tp + std::chrono::milliseconds(200));
+  EXPECT_TRUE(rateLimiter.pop(tp + std::chrono::milliseconds(100)).empty());
+  EXPECT_EQ(rateLimiter.pop(tp + std::chrono::milliseconds(200)), std::vector<int>({3}));
+  EXPECT_EQ(rateLimiter.getNumPending(), 0);
+}
+TEST(RateLimiterTest, priority) {
+  RateLimiter<int> rateLimiter;
+  rateLimiter.setLimit("WEIGHT", 2, std::chrono::seconds(1));
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 1}}, 1);
+  rateLimiter.push(Priority::LOW, {{"WEIGHT", 1}}, 2);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 1}}, 3);
+  rateLimiter.push(Priority::HIGH, {{"WEIGHT", 1}}, 4);
+  EXPECT_EQ(rateLimiter.pop(tp), std::vector<int>({4, 1}));
+  EXPECT_EQ(rateLimiter.pop(tp + std::chrono::milliseconds(500)), std::vector<int>({3}));
+  EXPECT_TRUE(rateLimiter.pop(tp + std::chrono::milliseconds(500)).empty());
+  EXPECT_EQ(rateLimiter.getNextReleaseTp(tp + std::chrono::milliseconds(500)), tp + std::chrono::milliseconds(1200));
+  EXPECT_EQ(rateLimiter.pop(tp + std::chrono::milliseconds(1200)), std::vector<int>({2}));
+}
+TEST(RateLimiterTest, lowPriorityLeavesReserve) {
+  RateLimiter<int> rateLimiter(0.5);
+  rateLimiter.setLimit("WEIGHT", 10, std::chrono::seconds(1));
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  for (int i = 0; i < 10; ++i) {
+    rateLimiter.push(Priority::LOW, {{"WEIGHT", 1}}, i);
+  }
+  EXPECT_EQ(rateLimiter.pop(tp).size(), 5);
+  EXPECT_DOUBLE_EQ(rateLimiter.getNumToken("WEIGHT", tp), 5);
+  rateLimiter.push(Priority::HIGH, {{"WEIGHT", 4}}, 100);
+  EXPECT_EQ(rateLimiter.pop(tp), std::vector<int>({100}));
+}
+TEST(RateLimiterTest, multipleBuckets) {
+  RateLimiter<int> rateLimiter;
+  rateLimiter.setLimit("WEIGHT", 100, std::chrono::seconds(1));
+  rateLimiter.setLimit("ORDER", 1, std::chrono::seconds(1));
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 1}, {"ORDER", 1}}, 1);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 1}, {"ORDER", 1}}, 2);
+  rateLimiter.push(Priority::NORMAL, {{"WEIGHT", 1}, {"UNKNOWN", 1000}}, 3);
+  EXPECT_EQ(rateLimiter.pop(tp), std::vector<int>({1}));
+  EXPECT_EQ(rateLimiter.getNextReleaseTp(tp), tp + std::chrono::seconds(1));
+  EXPECT_EQ(rateLimiter.pop(tp + std::chrono::seconds(1)), std::vector<int>({2, 3}));
+}
+TEST(RateLimiterTest, setUsed) {
+  RateLimiter<int> rateLimiter;
+  rateLimiter.setLimit("WEIGHT", 10, std::chrono::seconds(1));
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  rateLimiter.setUsed("WEIGHT", 8, tp);
+  EXPECT_DOUBLE_EQ(rateLimiter.getNumToken("WEIGHT", tp), 2);
+  rateLimiter.setUsed("WEIGHT", 1, tp);
+  EXPECT_DOUBLE_EQ(rateLimiter.getNumToken("WEIGHT", tp), 2);
+}
+TEST(RateLimiterTest, block) {
+  RateLimiter<int> rateLimiter;
+  rateLimiter.setLimit("WEIGHT", 10, std::chrono::seconds(1));
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  rateLimiter.block(tp + std::chrono::seconds(5));
+  rateLimiter.push(Priority::HIGH, {{"WEIGHT", 1}}, 1);
+  EXPECT_TRUE(rateLimiter.pop(tp).empty());
+  EXPECT_EQ(rateLimiter.getNextReleaseTp(tp), tp + std::chrono::seconds(5));
+  EXPECT_EQ(rateLimiter.pop(tp + std::chrono::seconds(5)), std::vector<int>({1}));
+}
+TEST(RateLimiterTest, mergeLimit) {
+  RateLimiter<int> rateLimiter;
+  rateLimiter.setLimit("WEIGHT", 10, std::chrono::seconds(1));
+  RateLimiter<int> other;
+  other.setLimit("WEIGHT", 100, std::chrono::seconds(1));
+  other.setLimit("ORDER", 1, std::chrono::seconds(1));
+  rateLimiter.mergeLimit(other);
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  EXPECT_DOUBLE_EQ(rateLimiter.getNumToken("WEIGHT", tp), 10);
+  EXPECT_DOUBLE_EQ(rateLimiter.getNumToken("ORDER", tp), 1);
+}
+} /* namespace ccapi */
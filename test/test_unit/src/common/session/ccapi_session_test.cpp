@@ -0,0 +1,105 @@
+#include "ccapi_cpp/ccapi_session.h"
+
+#include <future>
+
+#include "gtest/gtest.h"
+namespace ccapi {
+Event makeEvent(Event::Type type, const std::string& correlationId) {
+  Message message;
+  message.setType(type == Event::Type::SUBSCRIPTION_DATA ? Message::Type::MARKET_DATA_EVENTS_TRADE : Message::Type::SUBSCRIPTION_STARTED);
+  message.setCorrelationIdList({correlationId});
+  Event event;
+  event.setType(type);
+  event.setMessageList({message});
+  return event;
+}
+// records the type and the correlation ids of every event handed to it by the event dispatcher
+class SessionTestEventHandler : public EventHandler {
+ public:
+  explicit SessionTestEventHandler(size_t numEventExpected) : numEventExpected(numEventExpected) {}
+  bool processEvent(const Event& event, Session* sessionPtr) override {
+    std::vector<std::string> correlationIdList;
+    for (const auto& message : event.getMessageList()) {
+      correlationIdList.push_back(message.getCorrelationIdList().at(0));
+    }
+    std::lock_guard<std::mutex> lock(this->m);
+    this->eventList.emplace_back(event.getType(), correlationIdList);
+    if (this->eventList.size() == this->numEventExpected) {
+      this->promise.set_value();
+    }
+    return true;
+  }
+  size_t numEventExpected;
+  std::vector<std::pair<Event::Type, std::vector<std::string> > > eventList;
+  std::mutex m;
+  std::promise<void> promise;
+};
+class SessionTest : public ::testing::Test {
+ public:
+  void SetUp() override { this->sessionOptions.enableEventCoalescing = true; }
+  // raises the events on the io thread, like the services do, sleeping between two events for sleepMicroseconds
+  void raiseEvents(Session& session, const std::vector<std::pair<Event::Type, std::string> >& eventList, int sleepMicroseconds = 0) {
+    boost::asio::post(*session.serviceContextPtr->ioContextPtr, [&session, eventList, sleepMicroseconds]() {
+      for (const auto& x : eventList) {
+        if (sleepMicroseconds > 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(sleepMicroseconds));
+        }
+        auto event = makeEvent(x.first, x.second);
+        session.onEvent(event, nullptr);
+      }
+    });
+  }
+  SessionOptions sessionOptions;
+  SessionConfigs sessionConfigs;
+};
+TEST_F(SessionTest, coalesceEvent) {
+  SessionTestEventHandler eventHandler(3);
+  auto future = eventHandler.promise.get_future();
+  Session session(this->sessionOptions, this->sessionConfigs, &eventHandler);
+  this->raiseEvents(session, {{Event::Type::SUBSCRIPTION_DATA, "a"},
+                              {Event::Type::SUBSCRIPTION_DATA, "b"},
+                              {Event::Type::SUBSCRIPTION_STATUS, "c"},
+                              {Event::Type::SUBSCRIPTION_DATA, "d"},
+                              {Event::Type::SUBSCRIPTION_DATA, "e"}});
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  session.stop();
+  std::vector<std::pair<Event::Type, std::vector<std::string> > > expectedEventList{{Event::Type::SUBSCRIPTION_DATA, {"a", "b"}},
+                                                                                    {Event::Type::SUBSCRIPTION_STATUS, {"c"}},
+                                                                                    {Event::Type::SUBSCRIPTION_DATA, {"d", "e"}}};
+  EXPECT_EQ(eventHandler.eventList, expectedEventList);
+}
+TEST_F(SessionTest, coalesceEventMaxDelay) {
+  this->sessionOptions.eventCoalescingMaxDelayMicroseconds = 1;
+  SessionTestEventHandler eventHandler(2);
+  auto future = eventHandler.promise.get_future();
+  Session session(this->sessionOptions, this->sessionConfigs, &eventHandler);
+  this->raiseEvents(session,
+                    {{Event::Type::SUBSCRIPTION_DATA, "a"},
+                     {Event::Type::SUBSCRIPTION_DATA, "b"},
+                     {Event::Type::SUBSCRIPTION_DATA, "c"},
+                     {Event::Type::SUBSCRIPTION_DATA, "d"}},
+                    100);
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  session.stop();
+  std::vector<std::pair<Event::Type, std::vector<std::string> > > expectedEventList{{Event::Type::SUBSCRIPTION_DATA, {"a", "b"}},
+                                                                                    {Event::Type::SUBSCRIPTION_DATA, {"c", "d"}}};
+  EXPECT_EQ(eventHandler.eventList, expectedEventList);
+}
+TEST_F(SessionTest, coalesceEventPendingAtStop) {
+  SessionTestEventHandler eventHandler(1);
+  {
+    Session session(this->sessionOptions, this->sessionConfigs, &eventHandler);
+    std::promise<void> promise;
+    auto future = promise.get_future();
+    boost::asio::post(*session.serviceContextPtr->ioContextPtr, [&session, &promise]() {
+      auto event = makeEvent(Event::Type::SUBSCRIPTION_DATA, "a");
+      session.onEvent(event, nullptr);
+      session.serviceContextPtr->ioContextPtr->stop();
+      promise.set_value();
+    });
+    future.wait();
+    session.stop();
+  }
+  EXPECT_TRUE(eventHandler.eventList.empty());
+}
+} /* namespace ccapi */
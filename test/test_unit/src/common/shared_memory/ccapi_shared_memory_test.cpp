@@ -0,0 +1,144 @@
+#include "ccapi_cpp/ccapi_shared_memory_event.h"
+
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+namespace ccapi {
+class SharedMemoryTest : public ::testing::Test {
+ public:
+  void SetUp() override { this->name = "/ccapi_shared_memory_test_" + std::to_string(::getpid()); }
+  std::string name;
+};
+TEST_F(SharedMemoryTest, ringReadWrite) {
+  SharedMemoryRing producer;
+  producer.create(this->name, 128, 8);
+  SharedMemoryRing consumer;
+  ASSERT_TRUE(consumer.open(this->name));
+  std::string record;
+  uint64_t numLost = 0;
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::EMPTY);
+  producer.write("abc", 3);
+  producer.write("de", 2);
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OK);
+  EXPECT_EQ(record, "abc");
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OK);
+  EXPECT_EQ(record, "de");
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::EMPTY);
+}
+TEST_F(SharedMemoryTest, ringRecordLargerThanSlot) {
+  SharedMemoryRing producer;
+  producer.create(this->name, 128, 8);
+  SharedMemoryRing consumer;
+  ASSERT_TRUE(consumer.open(this->name));
+  std::string input(producer.getMaxChunkSize() * 2 + 10, 'x');
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<char>('a' + i % 26);
+  }
+  producer.write(input.data(), input.size());
+  std::string record;
+  uint64_t numLost = 0;
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OK);
+  EXPECT_EQ(record, input);
+}
+TEST_F(SharedMemoryTest, ringOverrun) {
+  SharedMemoryRing producer;
+  producer.create(this->name, 128, 8);
+  SharedMemoryRing consumer;
+  ASSERT_TRUE(consumer.open(this->name));
+  for (int i = 0; i < 20; ++i) {
+    std::string x = std::to_string(i);
+    producer.write(x.data(), x.size());
+  }
+  std::string record;
+  uint64_t numLost = 0;
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OVERRUN);
+  EXPECT_EQ(numLost, 16);
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OK);
+  EXPECT_EQ(record, "16");
+}
+TEST_F(SharedMemoryTest, ringOverrunCountsRecords) {
+  SharedMemoryRing producer;
+  producer.create(this->name, 128, 8);
+  SharedMemoryRing consumer;
+  ASSERT_TRUE(consumer.open(this->name));
+  for (int i = 0; i < 10; ++i) {
+    std::string x(producer.getMaxChunkSize() + 1, static_cast<char>('a' + i));
+    producer.write(x.data(), x.size());
+  }
+  std::string record;
+  uint64_t numLost = 0;
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OVERRUN);
+  EXPECT_EQ(numLost, 8);
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OK);
+  EXPECT_EQ(record, std::string(producer.getMaxChunkSize() + 1, 'i'));
+}
+TEST_F(SharedMemoryTest, ringRecordLargerThanRing) {
+  SharedMemoryRing producer;
+  producer.create(this->name, 128, 8);
+  SharedMemoryRing consumer;
+  ASSERT_TRUE(consumer.open(this->name));
+  std::string input(producer.getMaxRecordSize() + 1, 'x');
+  EXPECT_FALSE(producer.write(input.data(), input.size()));
+  EXPECT_TRUE(producer.write(input.data(), input.size() - 1));
+  std::string record;
+  uint64_t numLost = 0;
+  EXPECT_EQ(consumer.read(record, numLost), SharedMemoryRing::ReadStatus::OK);
+  EXPECT_EQ(record, input.substr(1));
+}
+TEST_F(SharedMemoryTest, ringOpenBeforeCreate) {
+  SharedMemoryRing consumer;
+  EXPECT_FALSE(consumer.open(this->name));
+}
+TEST_F(SharedMemoryTest, codecRoundTrip) {
+  Event event;
+  event.setType(Event::Type::SUBSCRIPTION_DATA);
+  Message message;
+  message.setType(Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH);
+  message.setRecapType(Message::RecapType::NONE);
+  message.setTime(UtilTime::makeTimePointFromMilliseconds(1000000));
+  message.setTimeReceived(UtilTime::makeTimePointFromMilliseconds(1000001));
+  message.setCorrelationIdList({"a", "b"});
+  Element element;
+  element.insert(CCAPI_BEST_BID_N_PRICE, "100.1");
+  element.insert(CCAPI_BEST_BID_N_SIZE, "2");
+  message.setElementList({element});
+  event.setMessageList({message});
+  std::string buffer;
+  SharedMemoryEventCodec::encode(event, buffer);
+  Event decoded;
+  ASSERT_TRUE(SharedMemoryEventCodec::decode(buffer, decoded));
+  EXPECT_EQ(decoded.toString(), event.toString());
+  EXPECT_FALSE(SharedMemoryEventCodec::decode(buffer.substr(0, buffer.size() - 1), decoded));
+}
+class SharedMemoryTestEventHandler : public EventHandler {
+ public:
+  bool processEvent(const Event& event, Session* sessionPtr) override {
+    this->eventList.push_back(event);
+    return true;
+  }
+  std::vector<Event> eventList;
+};
+TEST_F(SharedMemoryTest, publishAndSubscribe) {
+  SharedMemoryPublisher publisher(this->name, 256, 64);
+  SharedMemoryTestEventHandler eventHandler;
+  SharedMemorySubscriber subscriber(this->name, &eventHandler);
+  EXPECT_EQ(subscriber.poll(), 0);
+  Event marketDataEvent;
+  marketDataEvent.setType(Event::Type::SUBSCRIPTION_DATA);
+  Message message;
+  message.setType(Message::Type::MARKET_DATA_EVENTS_TRADE);
+  Element element;
+  element.insert(CCAPI_LAST_PRICE, "100");
+  message.setElementList({element});
+  marketDataEvent.setMessageList({message});
+  Event privateEvent(marketDataEvent);
+  Message privateMessage(message);
+  privateMessage.setType(Message::Type::EXECUTION_MANAGEMENT_EVENTS_ORDER_UPDATE);
+  privateEvent.setMessageList({privateMessage});
+  publisher.publish(marketDataEvent);
+  publisher.publish(privateEvent);
+  EXPECT_EQ(subscriber.poll(), 1);
+  ASSERT_EQ(eventHandler.eventList.size(), 1);
+  EXPECT_EQ(eventHandler.eventList.at(0).toString(), marketDataEvent.toString());
+}
+} /* namespace ccapi */
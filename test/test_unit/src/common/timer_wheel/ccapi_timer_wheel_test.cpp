@@ -0,0 +1,39 @@
+#include "ccapi_cpp/ccapi_timer_wheel.h"
+
+#include "gtest/gtest.h"
+namespace ccapi {
+TEST(TimerWheelTest, advance) {
+  TimerWheel<int> timerWheel(std::chrono::milliseconds(1), 8);
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  timerWheel.schedule(tp + std::chrono::milliseconds(5), 5);
+  timerWheel.schedule(tp + std::chrono::milliseconds(3), 3);
+  timerWheel.schedule(tp + std::chrono::milliseconds(3), 33);
+  EXPECT_EQ(timerWheel.getSize(), 3);
+  EXPECT_EQ(timerWheel.getNextDueTp(), tp + std::chrono::milliseconds(3));
+  EXPECT_TRUE(timerWheel.advance(tp + std::chrono::milliseconds(2)).empty());
+  EXPECT_EQ(timerWheel.advance(tp + std::chrono::milliseconds(4)), std::vector<int>({3, 33}));
+  EXPECT_EQ(timerWheel.getNextDueTp(), tp + std::chrono::milliseconds(5));
+  EXPECT_EQ(timerWheel.advance(tp + std::chrono::milliseconds(100)), std::vector<int>({5}));
+  EXPECT_TRUE(timerWheel.empty());
+}
+TEST(TimerWheelTest, moreThanOneRevolution) {
+  TimerWheel<int> timerWheel(std::chrono::milliseconds(1), 8);
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  timerWheel.schedule(tp + std::chrono::milliseconds(1), 1);
+  timerWheel.schedule(tp + std::chrono::milliseconds(9), 9);
+  timerWheel.schedule(tp + std::chrono::milliseconds(17), 17);
+  EXPECT_EQ(timerWheel.advance(tp + std::chrono::milliseconds(1)), std::vector<int>({1}));
+  EXPECT_TRUE(timerWheel.advance(tp + std::chrono::milliseconds(8)).empty());
+  EXPECT_EQ(timerWheel.advance(tp + std::chrono::milliseconds(9)), std::vector<int>({9}));
+  EXPECT_EQ(timerWheel.advance(tp + std::chrono::milliseconds(30)), std::vector<int>({17}));
+}
+TEST(TimerWheelTest, scheduleEarlierThanCurrent) {
+  TimerWheel<int> timerWheel(std::chrono::milliseconds(10), 4);
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000000);
+  timerWheel.schedule(tp + std::chrono::milliseconds(100), 100);
+  timerWheel.schedule(tp + std::chrono::milliseconds(15), 15);
+  EXPECT_EQ(timerWheel.getNextDueTp(), tp + std::chrono::milliseconds(20));
+  EXPECT_EQ(timerWheel.advance(tp + std::chrono::milliseconds(20)), std::vector<int>({15}));
+  EXPECT_EQ(timerWheel.advance(tp + std::chrono::milliseconds(100)), std::vector<int>({100}));
+}
+} /* namespace ccapi */
@@ -0,0 +1,89 @@
+#include "ccapi_cpp/ccapi_timestamping_tcp_stream.h"
+
+#include <functional>
+#include <thread>
+
+#include "boost/beast/websocket.hpp"
+#include "gtest/gtest.h"
+namespace ccapi {
+class TimestampingTcpStreamTest : public ::testing::Test {
+ public:
+  // a websocket server on the loopback interface that sends numMessage messages of increasing size a few milliseconds apart and then closes
+  void startServer(int numMessage) {
+    this->acceptor.open(boost::asio::ip::tcp::v4());
+    this->acceptor.bind(boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+    this->acceptor.listen();
+    this->serverThread = std::thread([this, numMessage]() {
+      boost::beast::websocket::stream<boost::asio::ip::tcp::socket> ws(this->acceptor.accept());
+      ws.accept();
+      for (int i = 0; i < numMessage; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ws.write(boost::asio::buffer(std::string(3000 * (i + 1), 'x')));
+      }
+      ws.close(boost::beast::websocket::close_code::normal);
+    });
+  }
+  void TearDown() override {
+    if (this->serverThread.joinable()) {
+      this->serverThread.join();
+    }
+  }
+  // reads until the server closes; returns the receive time observed after each message
+  std::vector<TimePoint> readAll(bool enableReceiveTimestamp, std::vector<size_t>& sizeList) {
+    boost::asio::io_context ioContext;
+    boost::beast::websocket::stream<TimestampingTcpStream> ws(ioContext);
+    boost::beast::get_lowest_layer(ws).connect(this->acceptor.local_endpoint());
+    ws.handshake("127.0.0.1", "/");
+    if (enableReceiveTimestamp) {
+      EXPECT_TRUE(boost::beast::get_lowest_layer(ws).enableReceiveTimestamp());
+    }
+    std::vector<TimePoint> output;
+    boost::beast::flat_buffer buffer;
+    std::function<void()> read = [&]() {
+      ws.async_read(buffer, [&](boost::beast::error_code ec, size_t n) {
+        if (ec) {
+          EXPECT_EQ(ec, boost::beast::websocket::error::closed);
+          return;
+        }
+        output.push_back(boost::beast::get_lowest_layer(ws).getReceiveTp());
+        sizeList.push_back(n);
+        buffer.consume(n);
+        read();
+      });
+    };
+    read();
+    ioContext.run();
+    return output;
+  }
+  boost::asio::io_context acceptorIoContext;
+  boost::asio::ip::tcp::acceptor acceptor{acceptorIoContext};
+  std::thread serverThread;
+};
+TEST_F(TimestampingTcpStreamTest, disabled) {
+  this->startServer(3);
+  std::vector<size_t> sizeList;
+  auto tpList = this->readAll(false, sizeList);
+  EXPECT_EQ(sizeList, std::vector<size_t>({3000, 6000, 9000}));
+  for (const auto& tp : tpList) {
+    EXPECT_EQ(tp.time_since_epoch().count(), 0);
+  }
+}
+#ifdef __linux__
+TEST_F(TimestampingTcpStreamTest, enabled) {
+  auto startTp = UtilTime::now();
+  this->startServer(5);
+  std::vector<size_t> sizeList;
+  auto tpList = this->readAll(true, sizeList);
+  auto endTp = UtilTime::now();
+  EXPECT_EQ(sizeList, std::vector<size_t>({3000, 6000, 9000, 12000, 15000}));
+  ASSERT_EQ(tpList.size(), 5);
+  for (size_t i = 0; i < tpList.size(); ++i) {
+    EXPECT_GE(tpList.at(i), startTp);
+    EXPECT_LE(tpList.at(i), endTp);
+    if (i > 0) {
+      EXPECT_GT(tpList.at(i), tpList.at(i - 1));
+    }
+  }
+}
+#endif
+} /* namespace ccapi */
@@ -0,0 +1,88 @@
+#include "ccapi_cpp/ccapi_tls_session_cache.h"
+
+#include "gtest/gtest.h"
+#include "openssl/evp.h"
+#include "openssl/x509.h"
+namespace ccapi {
+class TlsSessionCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    EVP_PKEY_CTX* keyCtx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    EVP_PKEY_keygen_init(keyCtx);
+    EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyCtx, NID_X9_62_prime256v1);
+    EVP_PKEY_keygen(keyCtx, &this->key);
+    EVP_PKEY_CTX_free(keyCtx);
+    this->certificate = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(this->certificate), 1);
+    X509_gmtime_adj(X509_getm_notBefore(this->certificate), 0);
+    X509_gmtime_adj(X509_getm_notAfter(this->certificate), 3600);
+    X509_set_pubkey(this->certificate, this->key);
+    X509_NAME_add_entry_by_txt(X509_get_subject_name(this->certificate), "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(this->certificate, X509_get_subject_name(this->certificate));
+    X509_sign(this->certificate, this->key, EVP_sha256());
+    this->serverCtx = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_use_certificate(this->serverCtx, this->certificate);
+    SSL_CTX_use_PrivateKey(this->serverCtx, this->key);
+    this->clientCtx = SSL_CTX_new(TLS_client_method());
+  }
+  void TearDown() override {
+    SSL_CTX_free(this->clientCtx);
+    SSL_CTX_free(this->serverCtx);
+    X509_free(this->certificate);
+    EVP_PKEY_free(this->key);
+  }
+  // performs a handshake over an in-memory bio pair and lets the client read the session tickets sent after it; returns whether the session was resumed
+  bool connect(TlsSessionCache& tlsSessionCache, const std::string& serverName) {
+    SSL* client = SSL_new(this->clientCtx);
+    SSL* server = SSL_new(this->serverCtx);
+    BIO *clientBio, *serverBio;
+    BIO_new_bio_pair(&clientBio, 0, &serverBio, 0);
+    SSL_set_bio(client, clientBio, clientBio);
+    SSL_set_bio(server, serverBio, serverBio);
+    SSL_set_connect_state(client);
+    SSL_set_accept_state(server);
+    SSL_set_tlsext_host_name(client, serverName.c_str());
+    tlsSessionCache.beforeHandshake(client);
+    bool isClientDone = false, isServerDone = false;
+    for (int i = 0; i < 100 && !(isClientDone && isServerDone); ++i) {
+      isClientDone = isClientDone || SSL_do_handshake(client) == 1;
+      isServerDone = isServerDone || SSL_do_handshake(server) == 1;
+    }
+    EXPECT_TRUE(isClientDone && isServerDone);
+    tlsSessionCache.afterHandshake(client, isClientDone);
+    char c;
+    SSL_read(client, &c, 1);
+    bool resumed = SSL_session_reused(client);
+    SSL_free(client);
+    SSL_free(server);
+    return resumed;
+  }
+  EVP_PKEY* key{};
+  X509* certificate{};
+  SSL_CTX* serverCtx{};
+  SSL_CTX* clientCtx{};
+};
+TEST_F(TlsSessionCacheTest, disabled) {
+  TlsSessionCache tlsSessionCache;
+  EXPECT_FALSE(this->connect(tlsSessionCache, "a.example.com"));
+  EXPECT_FALSE(this->connect(tlsSessionCache, "a.example.com"));
+  EXPECT_EQ(tlsSessionCache.size(), 0);
+  EXPECT_EQ(tlsSessionCache.getNumFullHandshake(), 0);
+}
+TEST_F(TlsSessionCacheTest, resume) {
+  TlsSessionCache tlsSessionCache;
+  tlsSessionCache.attach(this->clientCtx);
+  EXPECT_FALSE(this->connect(tlsSessionCache, "a.example.com"));
+  EXPECT_EQ(tlsSessionCache.size(), 1);
+  EXPECT_TRUE(this->connect(tlsSessionCache, "a.example.com"));
+  EXPECT_TRUE(this->connect(tlsSessionCache, "a.example.com"));
+  EXPECT_FALSE(this->connect(tlsSessionCache, "b.example.com"));
+  EXPECT_EQ(tlsSessionCache.size(), 2);
+  EXPECT_EQ(tlsSessionCache.getNumFullHandshake(), 2);
+  EXPECT_EQ(tlsSessionCache.getNumResumedHandshake(), 2);
+  EXPECT_DOUBLE_EQ(tlsSessionCache.getResumptionHitRate(), 0.5);
+  EXPECT_GE(tlsSessionCache.getHandshakeSecondsSaved(), 0);
+  tlsSessionCache.clear();
+  EXPECT_FALSE(this->connect(tlsSessionCache, "a.example.com"));
+}
+} /* namespace ccapi */
@@ -136,6 +136,10 @@ TEST(UtilTimeTest, divideSecondsStr_4) {
   std::string str("1634929946.123");
   EXPECT_EQ(UtilTime::divide(str), (std::make_pair<long long, long long>(1634929946, 123000000)));
 }
+TEST(UtilTimeTest, divideSecondsStr_5) {
+  std::string str("1634929946.1234567891");
+  EXPECT_EQ(UtilTime::divide(str), (std::make_pair<long long, long long>(1634929946, 123456789)));
+}
 TEST(UtilTimeTest, divideMilliSecondsStr_1) {
   std::string str("1634929946000");
   EXPECT_EQ(UtilTime::divideMilli(str), (std::make_pair<long long, long long>(1634929946000, 0)));
@@ -156,6 +160,11 @@ TEST(UtilTimeTest, divideMilliSecondsStr_5) {
   std::string str("1634929946010.123");
   EXPECT_EQ(UtilTime::divideMilli(str), (std::make_pair<long long, long long>(1634929946010, 123000)));
 }
+TEST(UtilTimeTest, divideOutOfRange) {
+  EXPECT_EQ(UtilTime::divide("9223372036854775807.5"), (std::make_pair<long long, long long>(9223372036854775807, 500000000)));
+  EXPECT_THROW(UtilTime::divide("9223372036854775808"), std::out_of_range);
+  EXPECT_THROW(UtilTime::divideMilli("16349299460101634929946010.123"), std::out_of_range);
+}
 TEST(UtilTimeTest, getISOTimestamp_1) {
   std::string str("2019-11-21T01:38:23Z");
   EXPECT_EQ(UtilTime::getISOTimestamp<std::chrono::seconds>(UtilTime::parse(str)), str);
@@ -200,6 +209,31 @@ TEST(UtilTimeTest, getISOTimestamp_11) {
   std::string str("2019-11-21T01:38:23Z");
   EXPECT_EQ(UtilTime::getISOTimestamp<std::chrono::milliseconds>(UtilTime::parse(str)), "2019-11-21T01:38:23.000Z");
 }
+TEST(UtilTimeTest, getISOTimestamp_12) {
+  std::string str("2024-02-29T23:59:59.5Z");
+  EXPECT_EQ(UtilTime::getISOTimestamp<std::chrono::milliseconds>(UtilTime::parse(str)), "2024-02-29T23:59:59.500Z");
+}
+TEST(UtilTimeTest, writeISOTimestamp) {
+  char buffer[30];
+  auto tp = UtilTime::parse("2019-11-21T01:38:23.123456789Z");
+  EXPECT_EQ(std::string(buffer, UtilTime::writeISOTimestamp(tp, buffer)), "2019-11-21T01:38:23.123456789Z");
+  EXPECT_EQ(std::string(buffer, UtilTime::writeISOTimestamp<std::chrono::microseconds>(tp, buffer)), "2019-11-21T01:38:23.123456Z");
+  EXPECT_EQ(std::string(buffer, UtilTime::writeISOTimestamp<std::chrono::seconds>(tp, buffer)), "2019-11-21T01:38:23Z");
+}
+TEST(UtilTimeTest, parseInputTooLong) { EXPECT_THROW(UtilTime::parse("2019-11-21T01:38:23.1234567891Z"), std::invalid_argument); }
+TEST(UtilTimeTest, parseAcrossDays) {
+  EXPECT_EQ(UtilTime::getUnixTimestamp(UtilTime::parse("1970-01-01T00:00:00Z")), 0);
+  EXPECT_EQ(UtilTime::getUnixTimestamp(UtilTime::parse("2021-10-22T19:12:26Z")), 1634929946);
+  EXPECT_EQ(UtilTime::getUnixTimestamp(UtilTime::parse("2021-10-23T19:12:26Z")), 1634929946 + 86400);
+  EXPECT_EQ(UtilTime::getUnixTimestamp(UtilTime::parse("2021-10-22T19:12:26Z")), 1634929946);
+}
+TEST(UtilTimeTest, convertTimePointToFIXTime) {
+  EXPECT_EQ(UtilTime::convertTimePointToFIXTime(UtilTime::parse("2020-09-25T15:55:28.093490622Z")), "20200925-15:55:28.093");
+}
+TEST(UtilTimeTest, parseFIXTime) {
+  EXPECT_EQ(UtilTime::parseFIXTime("20200925-15:55:28.093490622"), UtilTime::parse("2020-09-25T15:55:28.093490622Z"));
+  EXPECT_EQ(UtilTime::parseFIXTime("20200925-15:55:28"), UtilTime::parse("2020-09-25T15:55:28Z"));
+}
 TEST(UtilTimeTest, convertMillisecondsStrToSecondsStr) {
   EXPECT_EQ(UtilTime::convertMillisecondsStrToSecondsStr("169782573039"), "169782573.039");
   EXPECT_EQ(UtilTime::convertMillisecondsStrToSecondsStr("169782573030"), "169782573.030");
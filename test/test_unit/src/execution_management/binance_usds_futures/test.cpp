@@ -35,6 +35,16 @@ void verifySignature(const std::string& paramString, const std::string& apiSecre
   EXPECT_EQ(Hmac::hmac(Hmac::ShaVersion::SHA256, apiSecret, paramStringWithoutSignature, true), signature);
 }
 
+TEST_F(ExecutionManagementServiceBinanceUsdsFuturesTest, setRateLimiterPtr) {
+  auto rateLimiterPtr = std::make_shared<Service::RequestRateLimiter>();
+  rateLimiterPtr->setLimit(CCAPI_RATE_LIMIT_REQUEST_WEIGHT, 1000, std::chrono::minutes(1));
+  this->service->setRateLimiterPtr(rateLimiterPtr);
+  EXPECT_EQ(this->service->getRateLimiterPtr(), rateLimiterPtr);
+  EXPECT_DOUBLE_EQ(rateLimiterPtr->getNumToken(CCAPI_RATE_LIMIT_REQUEST_WEIGHT, this->now), 1000);
+  EXPECT_DOUBLE_EQ(rateLimiterPtr->getNumToken(CCAPI_RATE_LIMIT_ORDER_COUNT_10S, this->now), 300);
+  EXPECT_DOUBLE_EQ(rateLimiterPtr->getNumToken(CCAPI_RATE_LIMIT_ORDER_COUNT_1M, this->now), 1200);
+}
+
 TEST_F(ExecutionManagementServiceBinanceUsdsFuturesTest, convertTextMessageToMessageRestGetOrder) {
   Request request(Request::Operation::GET_ORDER, CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES, "BTCUSDT", "foo", this->credential);
   std::string textMessage =
@@ -74,6 +84,87 @@ TEST_F(ExecutionManagementServiceBinanceUsdsFuturesTest, convertTextMessageToMes
   EXPECT_EQ(element.getValue(CCAPI_EM_ORDER_CUMULATIVE_FILLED_PRICE_TIMES_QUANTITY), "0.01");
 }
 
+TEST_F(ExecutionManagementServiceBinanceUsdsFuturesTest, convertRequestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES, "BTCUSDT", "foo", this->credential);
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_BUY},
+      {CCAPI_EM_ORDER_QUANTITY, "1"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "20000"},
+      {CCAPI_EM_ORDER_CORRELATION_ID, "bar"},
+  });
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_SELL},
+      {CCAPI_EM_ORDER_QUANTITY, "2"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "30000"},
+  });
+  auto req = this->service->convertRequest(request, this->now);
+  EXPECT_EQ(req.method(), http::verb::post);
+  verifyApiKey(req, this->credential.at(CCAPI_BINANCE_USDS_FUTURES_API_KEY));
+  auto splitted = UtilString::split(req.target().to_string(), "?");
+  EXPECT_EQ(splitted.at(0), "/fapi/v1/batchOrders");
+  auto paramMap = Url::convertQueryStringToMap(splitted.at(1));
+  rj::Document document;
+  document.Parse<rj::kParseNumbersAsStringsFlag>(paramMap.at("batchOrders").c_str());
+  EXPECT_EQ(document.Size(), 2);
+  EXPECT_EQ(std::string(document[0]["symbol"].GetString()), "BTCUSDT");
+  EXPECT_EQ(std::string(document[0]["side"].GetString()), "BUY");
+  EXPECT_EQ(std::string(document[0]["price"].GetString()), "20000");
+  EXPECT_EQ(std::string(document[0]["type"].GetString()), "LIMIT");
+  EXPECT_FALSE(document[0].HasMember(CCAPI_EM_ORDER_CORRELATION_ID));
+  EXPECT_EQ(std::string(document[1]["quantity"].GetString()), "2");
+  EXPECT_EQ(paramMap.at("timestamp"), std::to_string(this->timestamp));
+  verifySignature(splitted.at(1), this->credential.at(CCAPI_BINANCE_USDS_FUTURES_API_SECRET));
+}
+
+TEST_F(ExecutionManagementServiceBinanceUsdsFuturesTest, convertRequestCancelOrdersBatch) {
+  Request request(Request::Operation::CANCEL_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES, "BTCUSDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_ORDER_ID, "1917641"}});
+  request.appendParam({{CCAPI_EM_ORDER_ID, "1917642"}});
+  auto req = this->service->convertRequest(request, this->now);
+  EXPECT_EQ(req.method(), http::verb::delete_);
+  auto splitted = UtilString::split(req.target().to_string(), "?");
+  EXPECT_EQ(splitted.at(0), "/fapi/v1/batchOrders");
+  auto paramMap = Url::convertQueryStringToMap(splitted.at(1));
+  EXPECT_EQ(paramMap.at("orderIdList"), "[1917641,1917642]");
+  EXPECT_EQ(paramMap.at("symbol"), "BTCUSDT");
+  verifySignature(splitted.at(1), this->credential.at(CCAPI_BINANCE_USDS_FUTURES_API_SECRET));
+}
+
+TEST_F(ExecutionManagementServiceBinanceUsdsFuturesTest, convertTextMessageToMessageRestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES, "BTCUSDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  request.appendParam({{CCAPI_EM_ORDER_CORRELATION_ID, "baz"}});
+  std::string textMessage =
+      R"(
+  [
+    {
+      "clientOrderId": "abc",
+      "cumQuote": "0",
+      "executedQty": "0",
+      "orderId": 1917641,
+      "origQty": "1",
+      "price": "20000",
+      "side": "BUY",
+      "status": "NEW",
+      "symbol": "BTCUSDT",
+      "updateTime": 1579276756075
+    },
+    {
+      "code": -2022,
+      "msg": "ReduceOnly Order is rejected."
+    }
+  ]
+  )";
+  auto messageList = this->service->convertTextMessageToMessageRest(request, textMessage, this->now);
+  EXPECT_EQ(messageList.size(), 2);
+  EXPECT_EQ(messageList.at(0).getType(), Message::Type::CREATE_ORDER);
+  EXPECT_EQ(messageList.at(0).getCorrelationIdList(), std::vector<std::string>({"bar"}));
+  EXPECT_EQ(messageList.at(0).getElementList().at(0).getValue(CCAPI_EM_ORDER_ID), "1917641");
+  EXPECT_EQ(messageList.at(1).getType(), Message::Type::RESPONSE_ERROR);
+  EXPECT_EQ(messageList.at(1).getCorrelationIdList(), std::vector<std::string>({"baz"}));
+  EXPECT_EQ(messageList.at(1).getElementList().at(0).getValue(CCAPI_ERROR_MESSAGE), "ReduceOnly Order is rejected.");
+}
+
 TEST_F(ExecutionManagementServiceBinanceUsdsFuturesTest, createEventExecutionTypeTrade) {
   Subscription subscription(CCAPI_EXCHANGE_NAME_BINANCE_USDS_FUTURES, "BTCUSDT", CCAPI_EM_PRIVATE_TRADE);
   std::string textMessage = R"(
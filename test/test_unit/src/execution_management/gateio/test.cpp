@@ -123,6 +123,157 @@ TEST_F(ExecutionManagementServiceGateioTest, convertTextMessageToMessageRestCrea
   EXPECT_EQ(element.getValue(CCAPI_EM_ORDER_ID), "12332324");
 }
 
+TEST_F(ExecutionManagementServiceGateioTest, getBatchSizeMax) {
+  EXPECT_EQ(this->service->getBatchSizeMax(Request::Operation::CREATE_ORDERS_BATCH), 10);
+  EXPECT_EQ(this->service->getBatchSizeMax(Request::Operation::CANCEL_ORDERS_BATCH), 20);
+}
+
+TEST_F(ExecutionManagementServiceGateioTest, convertRequestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_GATEIO, "BTC_USDT", "foo", this->credential);
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_BUY},
+      {CCAPI_EM_ORDER_QUANTITY, "1"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "0.1"},
+      {CCAPI_EM_CLIENT_ORDER_ID, "t-123456"},
+      {CCAPI_EM_ORDER_CORRELATION_ID, "bar"},
+  });
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_SELL},
+      {CCAPI_EM_ORDER_QUANTITY, "2"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "0.2"},
+  });
+  auto req = this->service->convertRequest(request, this->now);
+  EXPECT_EQ(req.method(), http::verb::post);
+  verifyApiKeyEtc(req, this->credential.at(CCAPI_GATEIO_API_KEY), this->timestamp);
+  EXPECT_EQ(req.base().at("X-Gate-Channel-Id").to_string(), CCAPI_GATEIO_API_CHANNEL_ID);
+  EXPECT_EQ(req.target(), "/api/v4/spot/batch_orders");
+  rj::Document document;
+  document.Parse<rj::kParseNumbersAsStringsFlag>(req.body().c_str());
+  EXPECT_EQ(document.Size(), 2);
+  EXPECT_EQ(std::string(document[0]["currency_pair"].GetString()), "BTC_USDT");
+  EXPECT_EQ(std::string(document[0]["side"].GetString()), "buy");
+  EXPECT_EQ(std::string(document[0]["price"].GetString()), "0.1");
+  EXPECT_EQ(std::string(document[0]["amount"].GetString()), "1");
+  EXPECT_EQ(std::string(document[0]["text"].GetString()), "t-123456");
+  EXPECT_FALSE(document[0].HasMember(CCAPI_EM_ORDER_CORRELATION_ID));
+  EXPECT_EQ(std::string(document[1]["currency_pair"].GetString()), "BTC_USDT");
+  EXPECT_EQ(std::string(document[1]["side"].GetString()), "sell");
+  EXPECT_EQ(std::string(document[1]["amount"].GetString()), "2");
+  verifySignature(req, this->credential.at(CCAPI_GATEIO_API_SECRET));
+}
+
+TEST_F(ExecutionManagementServiceGateioTest, convertRequestCancelOrdersBatch) {
+  Request request(Request::Operation::CANCEL_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_GATEIO, "BTC_USDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_ORDER_ID, "12332324"}, {CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "t-123456"}});
+  auto req = this->service->convertRequest(request, this->now);
+  EXPECT_EQ(req.method(), http::verb::post);
+  verifyApiKeyEtc(req, this->credential.at(CCAPI_GATEIO_API_KEY), this->timestamp);
+  EXPECT_EQ(req.target(), "/api/v4/spot/cancel_batch_orders");
+  rj::Document document;
+  document.Parse<rj::kParseNumbersAsStringsFlag>(req.body().c_str());
+  EXPECT_EQ(document.Size(), 2);
+  EXPECT_EQ(std::string(document[0]["currency_pair"].GetString()), "BTC_USDT");
+  EXPECT_EQ(std::string(document[0]["id"].GetString()), "12332324");
+  EXPECT_FALSE(document[0].HasMember(CCAPI_EM_ORDER_CORRELATION_ID));
+  EXPECT_EQ(std::string(document[1]["currency_pair"].GetString()), "BTC_USDT");
+  EXPECT_EQ(std::string(document[1]["id"].GetString()), "t-123456");
+  verifySignature(req, this->credential.at(CCAPI_GATEIO_API_SECRET));
+}
+
+TEST_F(ExecutionManagementServiceGateioTest, convertTextMessageToMessageRestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_GATEIO, "BTC_USDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "t-123456"}, {CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "t-123457"}});
+  std::string textMessage =
+      R"(
+    [
+      {
+        "text": "t-123456",
+        "succeeded": true,
+        "label": "",
+        "message": "",
+        "id": "12332324",
+        "create_time": "1548000000",
+        "update_time": "1548000100",
+        "create_time_ms": 1548000000123,
+        "update_time_ms": 1548000100123,
+        "currency_pair": "BTC_USDT",
+        "status": "open",
+        "type": "limit",
+        "account": "spot",
+        "side": "buy",
+        "amount": "1",
+        "price": "0.1",
+        "time_in_force": "gtc",
+        "iceberg": "0",
+        "left": "1",
+        "filled_total": "0",
+        "fee": "0",
+        "fee_currency": "BTC",
+        "point_fee": "0",
+        "gt_fee": "0",
+        "gt_discount": false,
+        "rebated_fee": "0",
+        "rebated_fee_currency": "USDT"
+      },
+      {
+        "text": "t-123457",
+        "succeeded": false,
+        "label": "BALANCE_NOT_ENOUGH",
+        "message": "Not enough balance"
+      }
+    ]
+  )";
+  EXPECT_FALSE(this->service->doesHttpBodyContainErrorBatch(textMessage));
+  auto messageList = this->service->convertTextMessageToMessageRest(request, textMessage, this->now);
+  EXPECT_EQ(messageList.size(), 2);
+  EXPECT_EQ(messageList.at(0).getType(), Message::Type::CREATE_ORDER);
+  EXPECT_EQ(messageList.at(0).getCorrelationIdList(), std::vector<std::string>({"bar"}));
+  const auto& element0 = messageList.at(0).getElementList().at(0);
+  EXPECT_EQ(element0.getValue(CCAPI_EM_ORDER_ID), "12332324");
+  EXPECT_EQ(element0.getValue(CCAPI_EM_CLIENT_ORDER_ID), "t-123456");
+  EXPECT_EQ(element0.getValue(CCAPI_EM_ORDER_SIDE), CCAPI_EM_ORDER_SIDE_BUY);
+  EXPECT_FALSE(element0.has(CCAPI_ERROR_MESSAGE));
+  EXPECT_EQ(messageList.at(1).getType(), Message::Type::RESPONSE_ERROR);
+  EXPECT_EQ(messageList.at(1).getCorrelationIdList(), std::vector<std::string>({"foo"}));
+  const auto& element1 = messageList.at(1).getElementList().at(0);
+  EXPECT_EQ(element1.getValue(CCAPI_EM_CLIENT_ORDER_ID), "t-123457");
+  EXPECT_EQ(element1.getValue(CCAPI_ERROR_MESSAGE), "BALANCE_NOT_ENOUGH: Not enough balance");
+}
+
+TEST_F(ExecutionManagementServiceGateioTest, convertTextMessageToMessageRestCancelOrdersBatch) {
+  Request request(Request::Operation::CANCEL_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_GATEIO, "BTC_USDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_ORDER_ID, "12332324"}, {CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  request.appendParam({{CCAPI_EM_ORDER_ID, "12332325"}, {CCAPI_EM_ORDER_CORRELATION_ID, "baz"}});
+  std::string textMessage =
+      R"(
+    [
+      {
+        "currency_pair": "BTC_USDT",
+        "id": "12332324",
+        "succeeded": true
+      },
+      {
+        "currency_pair": "BTC_USDT",
+        "id": "12332325",
+        "succeeded": false,
+        "label": "ORDER_NOT_FOUND",
+        "message": "Order not found"
+      }
+    ]
+  )";
+  auto messageList = this->service->convertTextMessageToMessageRest(request, textMessage, this->now);
+  EXPECT_EQ(messageList.size(), 2);
+  EXPECT_EQ(messageList.at(0).getType(), Message::Type::CANCEL_ORDER);
+  EXPECT_EQ(messageList.at(0).getCorrelationIdList(), std::vector<std::string>({"bar"}));
+  EXPECT_EQ(messageList.at(0).getElementList().at(0).getValue(CCAPI_EM_ORDER_ID), "12332324");
+  EXPECT_EQ(messageList.at(1).getType(), Message::Type::RESPONSE_ERROR);
+  EXPECT_EQ(messageList.at(1).getCorrelationIdList(), std::vector<std::string>({"baz"}));
+  EXPECT_EQ(messageList.at(1).getElementList().at(0).getValue(CCAPI_EM_ORDER_ID), "12332325");
+  EXPECT_EQ(messageList.at(1).getElementList().at(0).getValue(CCAPI_ERROR_MESSAGE), "ORDER_NOT_FOUND: Order not found");
+}
+
 TEST_F(ExecutionManagementServiceGateioTest, convertRequestCancelOrderByOrderId) {
   Request request(Request::Operation::CANCEL_ORDER, CCAPI_EXCHANGE_NAME_GATEIO, "BTC_USDT", "foo", this->credential);
   std::map<std::string, std::string> param{
@@ -107,6 +107,126 @@ TEST_F(ExecutionManagementServiceKucoinTest, convertTextMessageToMessageRestCrea
   EXPECT_EQ(element.getValue(CCAPI_EM_ORDER_ID), "5bd6e9286d99522a52e458de");
 }
 
+TEST_F(ExecutionManagementServiceKucoinTest, getBatchSizeMax) {
+  EXPECT_EQ(this->service->getBatchSizeMax(Request::Operation::CREATE_ORDERS_BATCH), 5);
+  EXPECT_EQ(this->service->getBatchSizeMax(Request::Operation::CANCEL_ORDERS_BATCH), 1);
+}
+
+TEST_F(ExecutionManagementServiceKucoinTest, convertRequestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_KUCOIN, "BTC-USDT", "foo", this->credential);
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_BUY},
+      {CCAPI_EM_ORDER_QUANTITY, "1"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "0.1"},
+      {CCAPI_EM_CLIENT_ORDER_ID, "a"},
+      {CCAPI_EM_ORDER_CORRELATION_ID, "bar"},
+  });
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_SELL},
+      {CCAPI_EM_ORDER_QUANTITY, "2"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "0.2"},
+      {CCAPI_EM_CLIENT_ORDER_ID, "b"},
+  });
+  auto req = this->service->convertRequest(request, this->now);
+  EXPECT_EQ(req.method(), http::verb::post);
+  verifyApiKeyEtc(req, this->credential.at(CCAPI_KUCOIN_API_KEY), this->credential.at(CCAPI_KUCOIN_API_SECRET),
+                  this->credential.at(CCAPI_KUCOIN_API_PASSPHRASE), this->credential.at(CCAPI_KUCOIN_API_KEY_VERSION), this->timestamp);
+  EXPECT_EQ(req.target(), "/api/v1/orders/multi");
+  rj::Document document;
+  document.Parse<rj::kParseNumbersAsStringsFlag>(req.body().c_str());
+  EXPECT_EQ(std::string(document["symbol"].GetString()), "BTC-USDT");
+  const rj::Value& orderList = document["orderList"];
+  EXPECT_EQ(orderList.Size(), 2);
+  EXPECT_EQ(std::string(orderList[0]["clientOid"].GetString()), "a");
+  EXPECT_EQ(std::string(orderList[0]["side"].GetString()), "buy");
+  EXPECT_EQ(std::string(orderList[0]["price"].GetString()), "0.1");
+  EXPECT_EQ(std::string(orderList[0]["size"].GetString()), "1");
+  EXPECT_FALSE(orderList[0].HasMember(CCAPI_EM_ORDER_CORRELATION_ID));
+  EXPECT_EQ(std::string(orderList[1]["clientOid"].GetString()), "b");
+  EXPECT_EQ(std::string(orderList[1]["side"].GetString()), "sell");
+  EXPECT_EQ(std::string(orderList[1]["price"].GetString()), "0.2");
+  EXPECT_EQ(std::string(orderList[1]["size"].GetString()), "2");
+  verifySignature(req, this->credential.at(CCAPI_KUCOIN_API_SECRET));
+}
+
+TEST_F(ExecutionManagementServiceKucoinTest, convertTextMessageToMessageRestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_KUCOIN, "BTC-USDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "a"}, {CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "b"}});
+  std::string textMessage =
+      R"(
+    {
+      "code": "200000",
+      "data": {
+        "data": [
+          {
+            "symbol": "BTC-USDT",
+            "type": "limit",
+            "side": "buy",
+            "price": "0.1",
+            "size": "1",
+            "funds": null,
+            "stp": "",
+            "stop": "",
+            "stopPrice": null,
+            "timeInForce": "GTC",
+            "cancelAfter": 0,
+            "postOnly": false,
+            "hidden": false,
+            "iceberge": false,
+            "iceberg": false,
+            "visibleSize": null,
+            "channel": "API",
+            "id": "611a6a309281bc000674d3c0",
+            "status": "success",
+            "failMsg": null,
+            "clientOid": "a"
+          },
+          {
+            "symbol": "BTC-USDT",
+            "type": "limit",
+            "side": "sell",
+            "price": "0.2",
+            "size": "2",
+            "funds": null,
+            "stp": "",
+            "stop": "",
+            "stopPrice": null,
+            "timeInForce": "GTC",
+            "cancelAfter": 0,
+            "postOnly": false,
+            "hidden": false,
+            "iceberge": false,
+            "iceberg": false,
+            "visibleSize": null,
+            "channel": "API",
+            "id": null,
+            "status": "fail",
+            "failMsg": "Balance insufficient!",
+            "clientOid": "b"
+          }
+        ]
+      }
+    }
+  )";
+  EXPECT_FALSE(this->service->doesHttpBodyContainErrorBatch(textMessage));
+  auto messageList = this->service->convertTextMessageToMessageRest(request, textMessage, this->now);
+  EXPECT_EQ(messageList.size(), 2);
+  EXPECT_EQ(messageList.at(0).getType(), Message::Type::CREATE_ORDER);
+  EXPECT_EQ(messageList.at(0).getCorrelationIdList(), std::vector<std::string>({"bar"}));
+  const auto& element0 = messageList.at(0).getElementList().at(0);
+  EXPECT_EQ(element0.getValue(CCAPI_EM_ORDER_ID), "611a6a309281bc000674d3c0");
+  EXPECT_EQ(element0.getValue(CCAPI_EM_CLIENT_ORDER_ID), "a");
+  EXPECT_EQ(element0.getValue(CCAPI_EM_ORDER_SIDE), CCAPI_EM_ORDER_SIDE_BUY);
+  EXPECT_FALSE(element0.has(CCAPI_ERROR_MESSAGE));
+  EXPECT_EQ(messageList.at(1).getType(), Message::Type::RESPONSE_ERROR);
+  EXPECT_EQ(messageList.at(1).getCorrelationIdList(), std::vector<std::string>({"foo"}));
+  const auto& element1 = messageList.at(1).getElementList().at(0);
+  EXPECT_FALSE(element1.has(CCAPI_EM_ORDER_ID));
+  EXPECT_EQ(element1.getValue(CCAPI_EM_CLIENT_ORDER_ID), "b");
+  EXPECT_EQ(element1.getValue(CCAPI_ERROR_MESSAGE), "Balance insufficient!");
+}
+
 TEST_F(ExecutionManagementServiceKucoinTest, convertRequestCancelOrderByOrderId) {
   Request request(Request::Operation::CANCEL_ORDER, CCAPI_EXCHANGE_NAME_KUCOIN, "BTC-USDT", "foo", this->credential);
   std::map<std::string, std::string> param{
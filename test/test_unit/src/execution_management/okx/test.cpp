@@ -107,6 +107,120 @@ TEST_F(ExecutionManagementServiceOkxTest, convertTextMessageToMessageRestCreateO
   EXPECT_EQ(element.getValue(CCAPI_EM_ORDER_ID), "12345689");
 }
 
+TEST_F(ExecutionManagementServiceOkxTest, convertRequestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_OKX, "BTC-USDT", "foo", this->credential);
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_BUY},
+      {CCAPI_EM_ORDER_QUANTITY, "2"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "2.15"},
+      {CCAPI_EM_ORDER_CORRELATION_ID, "bar"},
+  });
+  request.appendParam({
+      {CCAPI_EM_ORDER_SIDE, CCAPI_EM_ORDER_SIDE_SELL},
+      {CCAPI_EM_ORDER_QUANTITY, "1"},
+      {CCAPI_EM_ORDER_LIMIT_PRICE, "2.25"},
+  });
+  auto req = this->service->convertRequest(request, this->now);
+  EXPECT_EQ(req.method(), http::verb::post);
+  verifyApiKeyEtc(req, this->credential.at(CCAPI_OKX_API_KEY), this->credential.at(CCAPI_OKX_API_PASSPHRASE), this->timestampStr);
+  EXPECT_EQ(req.target(), "/api/v5/trade/batch-orders");
+  rj::Document document;
+  document.Parse<rj::kParseNumbersAsStringsFlag>(req.body().c_str());
+  EXPECT_EQ(document.Size(), 2);
+  EXPECT_EQ(std::string(document[0]["instId"].GetString()), "BTC-USDT");
+  EXPECT_EQ(std::string(document[0]["side"].GetString()), "buy");
+  EXPECT_EQ(std::string(document[0]["px"].GetString()), "2.15");
+  EXPECT_EQ(std::string(document[0]["ordType"].GetString()), "limit");
+  EXPECT_FALSE(document[0].HasMember(CCAPI_EM_ORDER_CORRELATION_ID));
+  EXPECT_EQ(std::string(document[1]["side"].GetString()), "sell");
+  EXPECT_EQ(std::string(document[1]["sz"].GetString()), "1");
+  verifySignature(req, this->credential.at(CCAPI_OKX_API_SECRET));
+}
+
+TEST_F(ExecutionManagementServiceOkxTest, convertTextMessageToMessageRestCreateOrdersBatch) {
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_OKX, "BTC-USDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "oktswap6"}, {CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "oktswap7"}});
+  std::string textMessage =
+      R"(
+    {
+      "code": "2",
+      "msg": "",
+      "data": [
+        {
+          "clOrdId": "oktswap6",
+          "ordId": "12345689",
+          "tag": "",
+          "sCode": "0",
+          "sMsg": ""
+        },
+        {
+          "clOrdId": "oktswap7",
+          "ordId": "",
+          "tag": "",
+          "sCode": "51008",
+          "sMsg": "Order placement failed due to insufficient balance"
+        }
+      ]
+    }
+  )";
+  EXPECT_FALSE(this->service->doesHttpBodyContainErrorBatch(textMessage));
+  auto messageList = this->service->convertTextMessageToMessageRest(request, textMessage, this->now);
+  EXPECT_EQ(messageList.size(), 2);
+  EXPECT_EQ(messageList.at(0).getType(), Message::Type::CREATE_ORDER);
+  EXPECT_EQ(messageList.at(0).getCorrelationIdList(), std::vector<std::string>({"bar"}));
+  EXPECT_EQ(messageList.at(0).getElementList().at(0).getValue(CCAPI_EM_ORDER_ID), "12345689");
+  EXPECT_EQ(messageList.at(1).getType(), Message::Type::RESPONSE_ERROR);
+  EXPECT_EQ(messageList.at(1).getCorrelationIdList(), std::vector<std::string>({"foo"}));
+  EXPECT_EQ(messageList.at(1).getElementList().at(0).getValue(CCAPI_EM_CLIENT_ORDER_ID), "oktswap7");
+  EXPECT_EQ(messageList.at(1).getElementList().at(0).getValue(CCAPI_ERROR_MESSAGE), "Order placement failed due to insufficient balance");
+}
+
+TEST_F(ExecutionManagementServiceOkxTest, createOrdersBatchFailureIsReportedPerOrder) {
+  std::vector<Event> eventList;
+  auto service = std::make_shared<ExecutionManagementServiceOkx>([&eventList](Event& event, Queue<Event>*) { eventList.push_back(event); }, SessionOptions(),
+                                                                 SessionConfigs(), &this->serviceContext);
+  Request request(Request::Operation::CREATE_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_OKX, "BTC-USDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "oktswap6"}, {CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "oktswap7"}, {CCAPI_EM_ORDER_CORRELATION_ID, "baz"}});
+  request.appendParam({{CCAPI_EM_CLIENT_ORDER_ID, "oktswap8"}});
+  service->processSuccessfulTextMessageRest(200, request, R"({"code":"50011","msg":"Too Many Requests","data":[]})", this->now, nullptr);
+  ASSERT_EQ(eventList.size(), 2);
+  EXPECT_EQ(eventList.at(0).getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"foo"}));
+  const auto& messageList = eventList.at(1).getMessageList();
+  ASSERT_EQ(messageList.size(), 2);
+  EXPECT_EQ(messageList.at(0).getType(), Message::Type::RESPONSE_ERROR);
+  EXPECT_EQ(messageList.at(0).getCorrelationIdList(), std::vector<std::string>({"bar"}));
+  EXPECT_EQ(messageList.at(0).getElementList().at(0).getValue(CCAPI_HTTP_STATUS_CODE), "200");
+  EXPECT_EQ(messageList.at(1).getCorrelationIdList(), std::vector<std::string>({"baz"}));
+  EXPECT_EQ(messageList.at(1).getElementList().at(0).getValue(CCAPI_ERROR_MESSAGE), R"({"code":"50011","msg":"Too Many Requests","data":[]})");
+  eventList.clear();
+  service->onRequestFailure(request, "max retry exceeded", nullptr);
+  ASSERT_EQ(eventList.size(), 2);
+  EXPECT_EQ(eventList.at(0).getType(), Event::Type::REQUEST_STATUS);
+  EXPECT_EQ(eventList.at(0).getMessageList().at(0).getType(), Message::Type::REQUEST_FAILURE);
+  EXPECT_EQ(eventList.at(0).getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"foo"}));
+  EXPECT_EQ(eventList.at(1).getType(), Event::Type::RESPONSE);
+  ASSERT_EQ(eventList.at(1).getMessageList().size(), 2);
+  EXPECT_EQ(eventList.at(1).getMessageList().at(1).getCorrelationIdList(), std::vector<std::string>({"baz"}));
+  EXPECT_EQ(eventList.at(1).getMessageList().at(1).getElementList().at(0).getValue(CCAPI_ERROR_MESSAGE), "max retry exceeded");
+  EXPECT_FALSE(eventList.at(1).getMessageList().at(1).getElementList().at(0).has(CCAPI_HTTP_STATUS_CODE));
+}
+
+TEST_F(ExecutionManagementServiceOkxTest, sendRequestByWebsocketRejectsBatch) {
+  std::vector<Event> eventList;
+  auto service = std::make_shared<ExecutionManagementServiceOkx>([&eventList](Event& event, Queue<Event>*) { eventList.push_back(event); }, SessionOptions(),
+                                                                 SessionConfigs(), &this->serviceContext);
+  Request request(Request::Operation::CANCEL_ORDERS_BATCH, CCAPI_EXCHANGE_NAME_OKX, "BTC-USDT", "foo", this->credential);
+  request.appendParam({{CCAPI_EM_ORDER_ID, "1"}, {CCAPI_EM_ORDER_CORRELATION_ID, "bar"}});
+  service->sendRequestByWebsocket(request, this->now);
+  ASSERT_EQ(eventList.size(), 2);
+  EXPECT_EQ(eventList.at(0).getMessageList().at(0).getType(), Message::Type::REQUEST_FAILURE);
+  EXPECT_EQ(eventList.at(0).getMessageList().at(0).getElementList().at(0).getValue(CCAPI_ERROR_MESSAGE),
+            "batch operation CANCEL_ORDERS_BATCH can only be sent by rest");
+  EXPECT_EQ(eventList.at(1).getMessageList().at(0).getCorrelationIdList(), std::vector<std::string>({"bar"}));
+}
+
 TEST_F(ExecutionManagementServiceOkxTest, convertRequestCancelOrderByOrderId) {
   Request request(Request::Operation::CANCEL_ORDER, CCAPI_EXCHANGE_NAME_OKX, "BTC-USDT", "foo", this->credential);
   std::map<std::string, std::string> param{
@@ -734,6 +848,79 @@ TEST_F(ExecutionManagementServiceOkxTest, createEventWebsocketTradeCancelOrder)
   Element element = elementList.at(0);
   EXPECT_EQ(element.getValue(CCAPI_EM_ORDER_ID), "325631903554482176");
 }
+
+TEST_F(ExecutionManagementServiceOkxTest, getHedgeDelay) {
+  EXPECT_EQ(this->service->getHedgeDelay(Request::Operation::CANCEL_ORDER), std::chrono::milliseconds(100));
+  for (int i = 1; i < CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MIN; ++i) {
+    this->service->recordHedgedRequestLatency(Request::Operation::CANCEL_ORDER, std::chrono::milliseconds(i));
+  }
+  EXPECT_EQ(this->service->getHedgeDelay(Request::Operation::CANCEL_ORDER), std::chrono::milliseconds(100));
+  this->service->recordHedgedRequestLatency(Request::Operation::CANCEL_ORDER, std::chrono::milliseconds(CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MIN));
+  // the 95th percentile of 1, 2, ..., 20 milliseconds
+  EXPECT_EQ(this->service->getHedgeDelay(Request::Operation::CANCEL_ORDER), std::chrono::milliseconds(20));
+  EXPECT_EQ(this->service->getHedgeDelay(Request::Operation::CANCEL_OPEN_ORDERS), std::chrono::milliseconds(100));
+  for (int i = 0; i < CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MAX; ++i) {
+    this->service->recordHedgedRequestLatency(Request::Operation::CANCEL_ORDER, std::chrono::microseconds(1500 + i % 10));
+  }
+  // the old samples have been evicted and the delay is rounded up to whole milliseconds
+  EXPECT_EQ(this->service->hedgedRequestLatencyListByOperationMap.at(Request::Operation::CANCEL_ORDER).size(), CCAPI_HEDGED_REQUEST_LATENCY_NUM_SAMPLE_MAX);
+  EXPECT_EQ(this->service->getHedgeDelay(Request::Operation::CANCEL_ORDER), std::chrono::milliseconds(2));
+}
+
+class ExecutionManagementServiceOkxHedgeTest : public ExecutionManagementServiceOkxTest {
+ public:
+  void SetUp() override {
+    ExecutionManagementServiceOkxTest::SetUp();
+    this->retry.hedgePtr = std::make_shared<HttpHedge>();
+    this->retry.hedgePtr->timerPtr = std::make_shared<boost::asio::steady_timer>(*this->serviceContext.ioContextPtr);
+    // the original request and its duplicate are both outstanding
+    this->retry.hedgePtr->numInFlight = 2;
+  }
+  bool isSuppressed(int statusCode, const std::string& body) {
+    return this->service->isHedgedHttpResponseSuppressed(this->retry, statusCode, statusCode / 100 == 2 && !this->service->doesHttpBodyContainError(body));
+  }
+  HttpRetry retry;
+  std::string successBody{R"({"code":"0","msg":"","data":[{"clOrdId":"","ordId":"312269865356374016","sCode":"0","sMsg":""}]})"};
+  std::string errorBody{R"({"code":"1","msg":"","data":[{"clOrdId":"","ordId":"312269865356374016","sCode":"51400","sMsg":"Cancellation failed"}]})"};
+};
+
+TEST_F(ExecutionManagementServiceOkxHedgeTest, successSettles) {
+  EXPECT_FALSE(this->isSuppressed(200, this->successBody));
+  EXPECT_TRUE(this->retry.hedgePtr->settled);
+  EXPECT_TRUE(this->isSuppressed(200, this->successBody));
+  EXPECT_TRUE(this->isSuppressed(400, "{}"));
+}
+
+TEST_F(ExecutionManagementServiceOkxHedgeTest, errorBodyDoesNotSettleWhileAnotherAttemptIsInFlight) {
+  EXPECT_TRUE(this->isSuppressed(200, this->errorBody));
+  EXPECT_FALSE(this->retry.hedgePtr->settled);
+  EXPECT_EQ(this->retry.hedgePtr->numInFlight, 1);
+  EXPECT_FALSE(this->isSuppressed(200, this->successBody));
+  EXPECT_TRUE(this->retry.hedgePtr->settled);
+}
+
+TEST_F(ExecutionManagementServiceOkxHedgeTest, clientErrorDoesNotSettleWhileAnotherAttemptIsInFlight) {
+  EXPECT_TRUE(this->isSuppressed(400, R"({"code":"50001","msg":"Service temporarily unavailable"})"));
+  EXPECT_FALSE(this->retry.hedgePtr->settled);
+  // the error of the last attempt is delivered and settles the request
+  EXPECT_FALSE(this->isSuppressed(200, this->errorBody));
+  EXPECT_TRUE(this->retry.hedgePtr->settled);
+  EXPECT_TRUE(this->isSuppressed(200, this->successBody));
+}
+
+TEST_F(ExecutionManagementServiceOkxHedgeTest, serverErrorIsRetriedWithoutSettling) {
+  this->retry.hedgePtr->numInFlight = 1;
+  EXPECT_FALSE(this->isSuppressed(503, ""));
+  EXPECT_FALSE(this->retry.hedgePtr->settled);
+  EXPECT_FALSE(this->isSuppressed(200, this->successBody));
+  EXPECT_TRUE(this->retry.hedgePtr->settled);
+}
+
+TEST_F(ExecutionManagementServiceOkxHedgeTest, notHedged) {
+  HttpRetry retry;
+  EXPECT_FALSE(this->service->isHedgedHttpResponseSuppressed(retry, 200, false));
+  EXPECT_FALSE(this->service->isHedgedHttpResponseSuppressed(retry, 400, false));
+}
 } /* namespace ccapi */
 #endif
 #endif
@@ -52,5 +52,110 @@ TEST_F(MarketDataServiceTest, updateOrderBookNoInsert) {
   this->service->updateOrderBook(snapshot, price, size);
   EXPECT_TRUE(snapshot.empty());
 }
+TEST_F(MarketDataServiceTest, retainSnapshot) {
+  this->service->sessionOptions.enableOrderBookRetention = true;
+  this->service->sessionOptions.orderBookRetentionBufferLevels = 1;
+  this->service->canTruncateOrderBook = true;
+  OrderBookState orderBookState;
+  std::map<std::string, std::string> optionMap{{CCAPI_MARKET_DEPTH_MAX, "2"}};
+  auto& snapshotBid = orderBookState.snapshotBid;
+  auto& snapshotAsk = orderBookState.snapshotAsk;
+  snapshotBid = {{Decimal("1"), "1"}, {Decimal("2"), "1"}, {Decimal("3"), "1"}, {Decimal("4"), "1"}};
+  snapshotAsk = {{Decimal("5"), "1"}, {Decimal("6"), "1"}};
+  this->service->retainSnapshot(orderBookState, 2);
+  EXPECT_THAT(snapshotBid, ElementsAre(Pair(Decimal("2"), "1"), Pair(Decimal("3"), "1"), Pair(Decimal("4"), "1")));
+  EXPECT_EQ(snapshotAsk.size(), 2);
+  EXPECT_TRUE(this->service->checkOrderBookRetained(orderBookState, optionMap));
+  snapshotAsk.erase(Decimal("5"));
+  EXPECT_TRUE(this->service->checkOrderBookRetained(orderBookState, optionMap));
+  snapshotBid.erase(Decimal("4"));
+  EXPECT_TRUE(this->service->checkOrderBookRetained(orderBookState, optionMap));
+  snapshotBid.erase(Decimal("3"));
+  EXPECT_FALSE(this->service->checkOrderBookRetained(orderBookState, optionMap));
+}
+TEST_F(MarketDataServiceTest, retainSnapshotDropsUpdateBeyondBoundary) {
+  this->service->sessionOptions.enableOrderBookRetention = true;
+  this->service->sessionOptions.orderBookRetentionBufferLevels = 1;
+  this->service->canTruncateOrderBook = true;
+  OrderBookState orderBookState;
+  std::map<std::string, std::string> optionMap{{CCAPI_MARKET_DEPTH_MAX, "2"}};
+  auto& snapshotBid = orderBookState.snapshotBid;
+  auto& snapshotAsk = orderBookState.snapshotAsk;
+  snapshotBid = {{Decimal("1"), "1"}, {Decimal("2"), "1"}, {Decimal("3"), "1"}, {Decimal("4"), "1"}, {Decimal("5"), "1"}};
+  snapshotAsk = {{Decimal("6"), "1"}, {Decimal("7"), "1"}, {Decimal("8"), "1"}, {Decimal("9"), "1"}};
+  this->service->retainSnapshot(orderBookState, 2);
+  EXPECT_THAT(snapshotBid, ElementsAre(Pair(Decimal("3"), "1"), Pair(Decimal("4"), "1"), Pair(Decimal("5"), "1")));
+  EXPECT_THAT(snapshotAsk, ElementsAre(Pair(Decimal("6"), "1"), Pair(Decimal("7"), "1"), Pair(Decimal("8"), "1")));
+  // the top levels are deleted and levels are added beyond the boundaries, where the exchange still has the levels 2 and 9 that were dropped
+  Decimal bidPrice("5");
+  std::string bidSize("0");
+  this->service->updateOrderBook(snapshotBid, bidPrice, bidSize);
+  Decimal deepBidPrice("1.5");
+  std::string deepBidSize("1");
+  this->service->updateOrderBook(snapshotBid, deepBidPrice, deepBidSize);
+  Decimal deepAskPrice("9.5");
+  std::string deepAskSize("1");
+  this->service->updateOrderBook(snapshotAsk, deepAskPrice, deepAskSize);
+  Decimal insideAskPrice("7.5");
+  std::string insideAskSize("1");
+  this->service->updateOrderBook(snapshotAsk, insideAskPrice, insideAskSize);
+  this->service->retainSnapshot(orderBookState, 2);
+  EXPECT_THAT(snapshotBid, ElementsAre(Pair(Decimal("3"), "1"), Pair(Decimal("4"), "1")));
+  EXPECT_THAT(snapshotAsk, ElementsAre(Pair(Decimal("6"), "1"), Pair(Decimal("7"), "1"), Pair(Decimal("7.5"), "1")));
+  EXPECT_TRUE(this->service->checkOrderBookRetained(orderBookState, optionMap));
+  // the ask side was truncated again at 7.5, so 8 is now beyond its boundary too
+  Decimal askPrice("8");
+  std::string askSize("2");
+  this->service->updateOrderBook(snapshotAsk, askPrice, askSize);
+  bidPrice = Decimal("4");
+  this->service->updateOrderBook(snapshotBid, bidPrice, bidSize);
+  this->service->retainSnapshot(orderBookState, 2);
+  EXPECT_THAT(snapshotBid, ElementsAre(Pair(Decimal("3"), "1")));
+  EXPECT_THAT(snapshotAsk, ElementsAre(Pair(Decimal("6"), "1"), Pair(Decimal("7"), "1"), Pair(Decimal("7.5"), "1")));
+  EXPECT_FALSE(this->service->checkOrderBookRetained(orderBookState, optionMap));
+}
+TEST_F(MarketDataServiceTest, calculatedCandlestickKeepsExchangePriceString) {
+  WsConnection wsConnection;
+  auto tp = UtilTime::makeTimePointFromMilliseconds(1000);
+  MarketDataMessage::TypeForData input;
+  for (const auto& x : std::vector<std::pair<std::string, std::string> >{{"100.50", "2"}, {"101.250", "0.5"}, {"-1", "1"}, {"99.00", "1"}, {"100.00", "1"}}) {
+    input[MarketDataMessage::DataType::TRADE].push_back(
+        {{MarketDataMessage::DataFieldType::PRICE, x.first}, {MarketDataMessage::DataFieldType::SIZE, x.second}});
+  }
+  this->service->updateCalculatedCandlestick(wsConnection, "trade", "BTC-USD", tp, CCAPI_TRADE, input);
+  std::vector<Element> elementList;
+  this->service->updateElementListWithCalculatedCandlestick(wsConnection, "trade", "BTC-USD", CCAPI_TRADE, elementList);
+  ASSERT_EQ(elementList.size(), 1);
+  const auto& element = elementList.at(0);
+  EXPECT_EQ(element.getValue(CCAPI_OPEN_PRICE), "100.50");
+  EXPECT_EQ(element.getValue(CCAPI_HIGH_PRICE), "101.250");
+  EXPECT_EQ(element.getValue(CCAPI_LOW_PRICE), "99.00");
+  EXPECT_EQ(element.getValue(CCAPI_CLOSE_PRICE), "100.00");
+  EXPECT_EQ(element.getValue(CCAPI_VOLUME), "4.5");
+  EXPECT_EQ(element.getValue(CCAPI_TRADE_COUNT), "4");
+  elementList.clear();
+  this->service->updateElementListWithCalculatedCandlestick(wsConnection, "trade", "BTC-USD", CCAPI_TRADE, elementList);
+  ASSERT_EQ(elementList.size(), 1);
+  EXPECT_EQ(elementList.at(0).getValue(CCAPI_OPEN_PRICE), CCAPI_CANDLESTICK_EMPTY);
+}
+TEST_F(MarketDataServiceTest, orderBookMemoryUsagePerBook) {
+  auto metricsRegistryPtr = std::make_shared<MetricsRegistry>();
+  this->service->setMetricsRegistryPtr(metricsRegistryPtr);
+  WsConnection wsConnection;
+  std::map<Decimal, std::string> snapshotBid{{Decimal("1"), "1"}, {Decimal("2"), "1"}};
+  std::map<Decimal, std::string> snapshotAsk{{Decimal("3"), "1"}};
+  this->service->updateOrderBookMemoryUsage(wsConnection, "depth5", "BTC-USD", snapshotBid, snapshotAsk);
+  this->service->updateOrderBookMemoryUsage(wsConnection, "depth50", "BTC-USD", snapshotBid, {});
+  auto getNumLevel = [&](const std::string& channelId) {
+    return metricsRegistryPtr->getGauge("ccapi_order_book_levels", this->service->getOrderBookMetricsLabelMap(wsConnection, channelId, "BTC-USD")).getValue();
+  };
+  EXPECT_DOUBLE_EQ(getNumLevel("depth5"), 3);
+  EXPECT_DOUBLE_EQ(getNumLevel("depth50"), 2);
+  this->service->clearOrderBookMemoryUsage(wsConnection);
+  for (const auto& x : metricsRegistryPtr->getSampleList()) {
+    EXPECT_NE(x.name, "ccapi_order_book_levels");
+    EXPECT_NE(x.name, "ccapi_order_book_bytes");
+  }
+}
 } /* namespace ccapi */
 #endif